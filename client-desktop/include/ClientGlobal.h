@@ -43,6 +43,7 @@ namespace ZapFR
             static const QString FeedsRefreshBehaviour = "feeds.refreshbehaviour";
             static const QString FeedsAutoRefreshEnabled = "feeds.autorefresh.enabled";
             static const QString FeedsAutoRefreshInterval = "feeds.autorefresh.interval";
+            static const QString FeedsAutoRefreshAdaptive = "feeds.autorefresh.adaptive";
             static const QString FeedsLogLevel = "feeds.loglevel";
         } // namespace Setting
 
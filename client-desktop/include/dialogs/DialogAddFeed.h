@@ -19,6 +19,9 @@
 #ifndef ZAPFR_CLIENT_DIALOGADDFEED_H
 #define ZAPFR_CLIENT_DIALOGADDFEED_H
 
+#include <memory>
+#include <mutex>
+
 #include <QAbstractButton>
 
 #include "../ClientGlobal.h"
@@ -71,8 +74,18 @@ namespace ZapFR
             QAbstractButton* mAddFeedButton{nullptr};
             std::unique_ptr<QStandardItemModel> mDiscoveredFeedsModel{nullptr};
 
+            // an aborted discovery (by a newer one, or by the dialog going away) winds down in the background without reporting back
+            struct DiscoveryRun
+            {
+                std::mutex mutex{};
+                bool aborted{false};
+            };
+            std::shared_ptr<DiscoveryRun> mDiscoveryRun{nullptr};
+
             QString url() const;
             void addDiscoveredFeed(const ZapFR::Engine::DiscoveredFeed& discoveredFeed);
+            void discoveryFinished(const std::vector<ZapFR::Engine::DiscoveredFeed>& unverifiedFeeds);
+            void abortDiscovery();
             void clearDiscoveredFeeds();
             void updateAddButtonState();
         };
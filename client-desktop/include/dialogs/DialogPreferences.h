@@ -53,6 +53,7 @@ namespace ZapFR
             RefreshBehaviour refreshBehaviour() const;
             uint64_t autoRefreshInterval() const;
             bool autoRefreshEnabled() const;
+            bool autoRefreshAdaptive() const;
             bool detectBrowsersEnabled() const;
             bool hideLocalSource() const;
             bool minimizeInsteadOfClose() const;
@@ -21,6 +21,8 @@
 
 #include <QWidget>
 
+#include "ZapFR/base/Feed.h"
+
 namespace Ui
 {
     class WidgetPropertiesPaneFeed;
@@ -50,6 +52,8 @@ namespace ZapFR
             Ui::WidgetPropertiesPaneFeed* ui;
             uint64_t mSourceID{0};
             uint64_t mFeedID{0};
+
+            void populateTelemetry(uint64_t feedID, const std::vector<ZapFR::Engine::Feed::Telemetry>& telemetry);
         };
     } // namespace Client
 } // namespace ZapFR
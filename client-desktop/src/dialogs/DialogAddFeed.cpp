@@ -61,11 +61,14 @@ ZapFR::Client::DialogAddFeed::DialogAddFeed(QWidget* parent) : DialogWithSources
 
 ZapFR::Client::DialogAddFeed::~DialogAddFeed()
 {
+    abortDiscovery();
     delete ui;
 }
 
 void ZapFR::Client::DialogAddFeed::reset(uint64_t selectedSourceID, uint64_t selectedFolderID)
 {
+    abortDiscovery();
+    ui->pushButtonDiscover->setEnabled(true);
     clearDiscoveredFeeds();
     updateAddButtonState();
     setPreselectedSourceAndFolderIDs(selectedSourceID, selectedFolderID);
@@ -97,18 +100,68 @@ std::vector<std::string> ZapFR::Client::DialogAddFeed::feedURLsToAdd() const
 void ZapFR::Client::DialogAddFeed::discoverFeeds()
 {
     clearDiscoveredFeeds();
-    ui->pushButtonDiscover->setEnabled(false);
 
     auto url = this->url();
     if (url.isEmpty())
     {
         return;
     }
-    auto fd = ZapFR::Engine::FeedDiscovery(url.toStdString());
-    fd.discover();
-    const auto& discoveredFeeds = fd.discoveredFeeds();
+    ui->pushButtonDiscover->setEnabled(false);
+    abortDiscovery();
+
+    // candidates are probed in the background, and each feed is listed as soon as it's confirmed; the callbacks come from background threads
+    // and only post to the dialog as long as their run isn't aborted, which the destructor takes care of
+    auto run = std::make_shared<DiscoveryRun>();
+    mDiscoveryRun = run;
+    ZapFR::Engine::FeedDiscovery::discoverInBackground(
+        url.toStdString(),
+        [=, this](const ZapFR::Engine::DiscoveredFeed& discoveredFeed)
+        {
+            std::lock_guard<std::mutex> lock(run->mutex);
+            if (!run->aborted)
+            {
+                QMetaObject::invokeMethod(this,
+                                          [=, this]()
+                                          {
+                                              if (mDiscoveryRun == run)
+                                              {
+                                                  addDiscoveredFeed(discoveredFeed);
+                                                  updateAddButtonState();
+                                              }
+                                          });
+            }
+        },
+        [=, this](const std::vector<ZapFR::Engine::DiscoveredFeed>& unverifiedFeeds)
+        {
+            std::lock_guard<std::mutex> lock(run->mutex);
+            if (!run->aborted)
+            {
+                QMetaObject::invokeMethod(this,
+                                          [=, this]()
+                                          {
+                                              if (mDiscoveryRun == run)
+                                              {
+                                                  discoveryFinished(unverifiedFeeds);
+                                              }
+                                          });
+            }
+        },
+        [run]()
+        {
+            std::lock_guard<std::mutex> lock(run->mutex);
+            return run->aborted;
+        });
+}
 
-    if (discoveredFeeds.empty())
+void ZapFR::Client::DialogAddFeed::discoveryFinished(const std::vector<ZapFR::Engine::DiscoveredFeed>& unverifiedFeeds)
+{
+    // candidates that couldn't be probed before the deadline are still offered
+    for (const auto& discoveredFeed : unverifiedFeeds)
+    {
+        addDiscoveredFeed(discoveredFeed);
+    }
+
+    if (mDiscoveredFeedsModel->rowCount() == 0)
     {
         QMessageBox mb(this);
         mb.setWindowTitle(tr("Discovery failed"));
@@ -128,17 +181,20 @@ void ZapFR::Client::DialogAddFeed::discoverFeeds()
             addDiscoveredFeed(forcedFeed);
         }
     }
-    else
-    {
-        for (const auto& discoveredFeed : discoveredFeeds)
-        {
-            addDiscoveredFeed(discoveredFeed);
-        }
-    }
     updateAddButtonState();
     ui->pushButtonDiscover->setEnabled(true);
 }
 
+void ZapFR::Client::DialogAddFeed::abortDiscovery()
+{
+    if (mDiscoveryRun != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(mDiscoveryRun->mutex);
+        mDiscoveryRun->aborted = true;
+    }
+    mDiscoveryRun = nullptr;
+}
+
 void ZapFR::Client::DialogAddFeed::addDiscoveredFeed(const ZapFR::Engine::DiscoveredFeed& discoveredFeed)
 {
     auto discoveredURL = QString::fromStdString(discoveredFeed.url);
@@ -92,6 +92,7 @@ void ZapFR::Client::DialogPreferences::reset()
     auto ar = ZapFR::Engine::AutoRefresh::getInstance();
     ui->spinBoxAutoRefreshInterval->setValue(static_cast<int32_t>(ar->feedRefreshInterval() / 60));
     ui->checkBoxAutoRefreshEnabled->setChecked(ar->isEnabled());
+    ui->checkBoxAutoRefreshAdaptive->setChecked(ar->isAdaptive());
 
     switch (ZapFR::Engine::Log::logLevel())
     {
@@ -172,6 +173,11 @@ bool ZapFR::Client::DialogPreferences::autoRefreshEnabled() const
     return ui->checkBoxAutoRefreshEnabled->isChecked();
 }
 
+bool ZapFR::Client::DialogPreferences::autoRefreshAdaptive() const
+{
+    return ui->checkBoxAutoRefreshAdaptive->isChecked();
+}
+
 bool ZapFR::Client::DialogPreferences::detectBrowsersEnabled() const
 {
     return ui->checkBoxDetectBrowsers->isChecked();
@@ -33,6 +33,7 @@
 #include "ZapFR/Log.h"
 #include "ZapFR/base/Folder.h"
 #include "ZapFR/base/Post.h"
+#include "ZapFR/feed_handling/FeedDiscovery.h"
 #include "ZapFR/local/FeedLocal.h"
 #include "ZapFR/local/ScriptLocal.h"
 #include "dialogs/DialogAddSource.h"
@@ -201,6 +202,7 @@ void ZapFR::Client::MainWindow::closeEvent(QCloseEvent* event)
             mStartupDetectBrowsersThread->join();
         }
         ZapFR::Engine::Agent::getInstance()->joinAll();
+        ZapFR::Engine::FeedDiscovery::joinAll();
     }
 }
 
@@ -237,6 +239,7 @@ void ZapFR::Client::MainWindow::saveSettings() const
     auto ar = ZapFR::Engine::AutoRefresh::getInstance();
     root.insert(Setting::FeedsAutoRefreshInterval, static_cast<int32_t>(ar->feedRefreshInterval()));
     root.insert(Setting::FeedsAutoRefreshEnabled, ar->isEnabled());
+    root.insert(Setting::FeedsAutoRefreshAdaptive, ar->isAdaptive());
     root.insert(Setting::FeedsLogLevel, ZapFR::Engine::Log::logLevel());
 
     auto sf = QFile(settingsFile());
@@ -331,6 +334,13 @@ void ZapFR::Client::MainWindow::restoreSettings()
                 }
                 ZapFR::Engine::AutoRefresh::getInstance()->setEnabled(enableAutoRefresh);
 
+                auto adaptiveAutoRefresh{true};
+                if (root.contains(Setting::FeedsAutoRefreshAdaptive))
+                {
+                    adaptiveAutoRefresh = root.value(Setting::FeedsAutoRefreshAdaptive).toBool();
+                }
+                ZapFR::Engine::AutoRefresh::getInstance()->setAdaptive(adaptiveAutoRefresh);
+
                 uint64_t autoRefreshInterval{ZapFR::Engine::DefaultFeedAutoRefreshInterval};
                 if (root.contains(Setting::FeedsAutoRefreshInterval))
                 {
@@ -929,6 +939,7 @@ void ZapFR::Client::MainWindow::showPreferences()
                         auto ar = ZapFR::Engine::AutoRefresh::getInstance();
                         ar->setEnabled(mDialogPreferences->autoRefreshEnabled());
                         ar->setFeedRefreshInterval(mDialogPreferences->autoRefreshInterval());
+                        ar->setAdaptive(mDialogPreferences->autoRefreshAdaptive());
 
                         ZapFR::Engine::Log::setLogLevel(mDialogPreferences->logLevel());
 
@@ -16,6 +16,8 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <QLocale>
+
 #include "widgets/WidgetPropertiesPaneFeed.h"
 #include "FeedIconCache.h"
 #include "Utilities.h"
@@ -143,6 +145,95 @@ void ZapFR::Client::WidgetPropertiesPaneFeed::reset(const QMap<QString, QVariant
     {
         ui->labelStatNewestPostValue->setText(tr("Unknown"));
     }
+
+    for (auto label : {ui->labelTelemetryRefreshesValue, ui->labelTelemetryNotModifiedValue, ui->labelTelemetryTransferredValue, ui->labelTelemetryNetworkValue,
+                       ui->labelTelemetryProcessingValue, ui->labelTelemetryItemsValue})
+    {
+        label->setText("");
+    }
+    ZapFR::Engine::Agent::getInstance()->queueGetFeedTelemetry(
+        mSourceID, mFeedID,
+        [&](uint64_t /*sourceID*/, uint64_t feedID, const std::vector<ZapFR::Engine::Feed::Telemetry>& telemetry)
+        { QMetaObject::invokeMethod(this, [=, this]() { populateTelemetry(feedID, telemetry); }); });
+}
+
+void ZapFR::Client::WidgetPropertiesPaneFeed::populateTelemetry(uint64_t feedID, const std::vector<ZapFR::Engine::Feed::Telemetry>& telemetry)
+{
+    if (feedID != mFeedID) // another feed got selected in the meantime
+    {
+        return;
+    }
+
+    if (telemetry.empty())
+    {
+        ui->labelTelemetryRefreshesValue->setText(tr("No refreshes recorded yet"));
+        return;
+    }
+
+    uint64_t failed{0};
+    uint64_t notModified{0};
+    uint64_t unchanged{0};
+    uint64_t pushed{0};
+    uint64_t transferredBytes{0};
+    uint64_t bodyBytes{0};
+    uint64_t dnsTime{0};
+    uint64_t connectTime{0};
+    uint64_t tlsTime{0};
+    uint64_t firstByteTime{0};
+    uint64_t parseTime{0};
+    uint64_t ingestTime{0};
+    uint64_t ingestCount{0};
+    uint64_t newItems{0};
+    uint64_t updatedItems{0};
+    for (const auto& t : telemetry)
+    {
+        switch (t.result)
+        {
+            case ZapFR::Engine::Feed::Telemetry::Result::Failed:
+                failed++;
+                break;
+            case ZapFR::Engine::Feed::Telemetry::Result::NotModified:
+                notModified++;
+                break;
+            case ZapFR::Engine::Feed::Telemetry::Result::Unchanged:
+                unchanged++;
+                break;
+            case ZapFR::Engine::Feed::Telemetry::Result::Pushed:
+                pushed++;
+                [[fallthrough]];
+            case ZapFR::Engine::Feed::Telemetry::Result::Parsed:
+                ingestCount++;
+                parseTime += t.parseTime;
+                ingestTime += t.ingestTime;
+                break;
+        }
+        transferredBytes += t.transferredBytes;
+        bodyBytes += t.bodyBytes;
+        dnsTime += t.dnsTime;
+        connectTime += t.connectTime;
+        tlsTime += t.tlsTime;
+        firstByteTime += t.firstByteTime;
+        newItems += t.newItems;
+        updatedItems += t.updatedItems;
+    }
+
+    auto count = telemetry.size();
+    const auto percentage = [&](uint64_t part) { return static_cast<int>((part * 100) / count); };
+    const auto averageSize = [&](uint64_t total) { return QLocale().formattedDataSize(static_cast<qint64>(total / count)); };
+    const auto milliseconds = [](uint64_t total, uint64_t divisor) { return QString::number(divisor > 0 ? static_cast<double>(total) / divisor / 1000.0 : 0.0, 'f', 1); };
+
+    ui->labelTelemetryRefreshesValue->setText(tr("%1 (%2 failed, %3 pushed)").arg(count).arg(failed).arg(pushed));
+    ui->labelTelemetryNotModifiedValue->setText(
+        tr("%1% (%2% not modified, %3% unchanged body)").arg(percentage(notModified + unchanged)).arg(percentage(notModified)).arg(percentage(unchanged)));
+    ui->labelTelemetryTransferredValue->setText(tr("%1 on average (%2 decompressed)").arg(averageSize(transferredBytes)).arg(averageSize(bodyBytes)));
+    ui->labelTelemetryNetworkValue->setText(tr("DNS %1 ms, connect %2 ms, TLS %3 ms, first byte %4 ms on average")
+                                                .arg(milliseconds(dnsTime, count))
+                                                .arg(milliseconds(connectTime, count))
+                                                .arg(milliseconds(tlsTime, count))
+                                                .arg(milliseconds(firstByteTime, count)));
+    ui->labelTelemetryProcessingValue->setText(
+        tr("Parsing %1 ms, ingesting %2 ms on average").arg(milliseconds(parseTime, ingestCount)).arg(milliseconds(ingestTime, ingestCount)));
+    ui->labelTelemetryItemsValue->setText(tr("%1 new, %2 updated").arg(newItems).arg(updatedItems));
 }
 
 void ZapFR::Client::WidgetPropertiesPaneFeed::save()
@@ -0,0 +1,57 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_ADAPTIVEREFRESH_H
+#define ZAPFR_ENGINE_ADAPTIVEREFRESH_H
+
+#include <optional>
+#include <vector>
+
+#include <Poco/DateTime.h>
+#include <Poco/Timestamp.h>
+
+#include "ZapFR/Global.h"
+#include "ZapFR/feed_handling/FeedParser.h"
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // derives a per-feed refresh interval from how often the feed publishes, what the feed itself advertises, and the HTTP caching headers
+        class AdaptiveRefresh
+        {
+          public:
+            struct Input
+            {
+                std::vector<Poco::Timestamp> postDates{};    // publication dates of the most recent posts
+                std::optional<uint64_t> freshnessLifetime{}; // from Cache-Control: max-age or Expires, in seconds
+                FeedParser::RefreshHints hints{};
+                uint64_t defaultInterval{DefaultFeedAutoRefreshInterval};
+            };
+
+            static uint64_t calculateInterval(const Input& input, const Poco::DateTime& now = Poco::DateTime());
+
+            static constexpr uint64_t MinInterval{5 * 60};
+            static constexpr uint64_t MaxInterval{24 * 60 * 60};
+            static constexpr uint64_t PostHistorySize{20};
+            static constexpr uint64_t MinPostsForEstimate{3};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_ADAPTIVEREFRESH_H
@@ -19,7 +19,10 @@
 #ifndef ZAPFR_ENGINE_AGENT_H
 #define ZAPFR_ENGINE_AGENT_H
 
+#include <atomic>
+#include <chrono>
 #include <deque>
+#include <map>
 #include <optional>
 
 #include <Poco/ThreadPool.h>
@@ -28,8 +31,10 @@
 #include "AgentRunnable.h"
 #include "ZapFR/Flag.h"
 #include "ZapFR/Global.h"
+#include "ZapFR/base/Feed.h"
 #include "ZapFR/base/Folder.h"
 #include "ZapFR/base/Script.h"
+#include "ZapFR/local/FeedLocal.h"
 
 namespace ZapFR
 {
@@ -86,6 +91,7 @@ namespace ZapFR
 
             // querying feeds
             void queueGetFeed(uint64_t sourceID, uint64_t feedID, std::function<void(uint64_t, Feed*)> finishedCallback);
+            void queueGetFeedTelemetry(uint64_t sourceID, uint64_t feedID, std::function<void(uint64_t, uint64_t, const std::vector<Feed::Telemetry>&)> finishedCallback);
 
             // querying folders
             void queueGetFolder(uint64_t sourceID, uint64_t folderID, std::function<void(Folder*)> finishedCallback);
@@ -119,7 +125,12 @@ namespace ZapFR
                                std::function<void(uint64_t, const std::unordered_map<uint64_t, uint64_t>&)> finishedCallback);
             void queueGetFeedUnreadCount(uint64_t sourceID, uint64_t feedID, std::function<void(uint64_t, uint64_t, uint64_t)> finishedCallback);
             void queueRemoveFeed(uint64_t sourceID, uint64_t feedID, std::function<void(uint64_t, uint64_t)> finishedCallback);
-            void queueRefreshFeed(uint64_t sourceID, uint64_t feedID, std::function<void(uint64_t, Feed* refreshedFeed)> finishedCallback);
+            void queueRefreshFeed(uint64_t sourceID, uint64_t feedID, std::function<void(uint64_t, Feed* refreshedFeed)> finishedCallback,
+                                  std::optional<std::chrono::steady_clock::time_point> notBefore = {});
+            void queueIngestFeed(uint64_t sourceID, uint64_t feedID, FeedLocal::FetchedData&& fetchedData,
+                                 std::function<void(uint64_t, Feed* refreshedFeed)> finishedCallback);
+            void queueIngestPushedFeed(uint64_t sourceID, uint64_t feedID, std::string&& body);
+            void queueRefreshFeedIcon(uint64_t sourceID, uint64_t feedID);
             void queueAddFeed(uint64_t sourceID, const std::string& url, uint64_t folder, std::function<void(uint64_t, Feed*)> finishedCallback);
             void queueImportOPML(uint64_t sourceID, const std::string& opml, uint64_t parentFolderID, std::function<void()> opmlParsedCallback,
                                  std::function<void(uint64_t, Feed*)> feedRefreshedCallback);
@@ -171,20 +182,31 @@ namespace ZapFR
             void queueMonitorFeedRefreshCompletion(std::function<void()> finishedCallback);
             void queueMonitorSourceReloadCompletion(std::function<void()> finishedCallback);
             uint64_t totalCountOfType(AgentRunnable::Type t) const;
+            uint64_t queueDepth() const;
+            uint64_t peakQueueDepth() const noexcept { return mPeakQueueDepth; }
+
+            static constexpr uint64_t MaxRunningBackgroundAgents{2};
 
           private:
             explicit Agent();
             static std::mutex msMutex;
 
             std::deque<std::unique_ptr<AgentRunnable>> mQueue{};
+            std::deque<std::unique_ptr<AgentRunnable>> mNetworkQueue{};
+            std::deque<std::unique_ptr<AgentRunnable>> mBackgroundQueue{}; // low priority network agents, e.g. icon fetching
+            std::multimap<std::chrono::steady_clock::time_point, std::unique_ptr<AgentRunnable>> mDeferredQueue{}; // agents that can't start yet, by when they can
             std::unique_ptr<Poco::Timer> mQueueTimer{nullptr};
             std::unique_ptr<Poco::ThreadPool> mThreadPool{nullptr};
+            std::unique_ptr<Poco::ThreadPool> mNetworkThreadPool{nullptr}; // for agents that mostly wait on the network, e.g. feed fetching
             std::vector<std::unique_ptr<AgentRunnable>> mRunningAgents{};
+            std::atomic<uint64_t> mPeakQueueDepth{0};
 
             std::optional<std::function<void(uint64_t, const std::string&)>> mErrorCallback{};
 
             void onQueueTimer(Poco::Timer& timer);
             void enqueue(std::unique_ptr<AgentRunnable> agent);
+            std::deque<std::unique_ptr<AgentRunnable>>& queueFor(const AgentRunnable& agent);
+            uint64_t queuedAgentCount() const;
         };
     } // namespace Engine
 } // namespace ZapFR
@@ -19,6 +19,7 @@
 #ifndef ZAPFR_ENGINE_AGENTRUNNABLE_H
 #define ZAPFR_ENGINE_AGENTRUNNABLE_H
 
+#include <chrono>
 #include <functional>
 
 #include <Poco/Runnable.h>
@@ -43,10 +44,13 @@ namespace ZapFR
                 FeedGetCategories,
                 FeedGetLogs,
                 FeedGetPosts,
+                FeedGetTelemetry,
                 FeedGetUnreadCount,
+                FeedIngest,
                 FeedMarkRead,
                 FeedMove,
                 FeedRefresh,
+                FeedRefreshIcon,
                 FeedRemove,
                 FeedSetProperties,
                 FolderAdd,
@@ -98,14 +102,20 @@ namespace ZapFR
             virtual Type type() const noexcept = 0;
             virtual void payload(Source* source) = 0;
             virtual void onPayloadException([[maybe_unused]] Source* source){};
+            virtual bool isNetworkBound() const noexcept { return false; }
+            virtual bool isLowPriority() const noexcept { return false; } // only runs on a network thread that nothing else needs
 
             void run() override;
             bool isDone() const noexcept { return mIsDone; }
             void setShouldAbort(bool b) { mShouldAbort = b; }
+            void setNotBefore(std::chrono::steady_clock::time_point t) noexcept { mNotBefore = t; }
+            std::chrono::steady_clock::time_point notBefore() const noexcept { return mNotBefore; }
+            bool isReadyToStart() const noexcept { return std::chrono::steady_clock::now() >= mNotBefore; }
 
           protected:
             bool mIsDone{false};
             bool mShouldAbort{false};
+            std::chrono::steady_clock::time_point mNotBefore{};
 
             uint64_t mSourceID{0};
         };
@@ -19,9 +19,14 @@
 #ifndef ZAPFR_ENGINE_AUTOREFRESH_H
 #define ZAPFR_ENGINE_AUTOREFRESH_H
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <optional>
-
-#include <Poco/Timer.h>
+#include <queue>
+#include <thread>
+#include <unordered_map>
 
 #include "ZapFR/Global.h"
 
@@ -31,33 +36,82 @@ namespace ZapFR
     {
         class Feed;
 
+        // keeps the local feeds in a min-heap ordered by their next due time, and sleeps until the first one is due
         class AutoRefresh
         {
           public:
             AutoRefresh(const AutoRefresh&) = delete;
             AutoRefresh& operator=(const AutoRefresh&) = delete;
-            virtual ~AutoRefresh() = default;
+            virtual ~AutoRefresh();
 
             static AutoRefresh* getInstance();
 
-            void setEnabled(bool b) noexcept { mEnabled = b; }
+            void setEnabled(bool b);
             bool isEnabled() const noexcept { return mEnabled; }
 
-            void setFeedRefreshInterval(uint64_t seconds) noexcept { mFeedRefreshIntervalInSeconds = seconds; }
+            void setFeedRefreshInterval(uint64_t seconds);
             uint64_t feedRefreshInterval() const noexcept { return mFeedRefreshIntervalInSeconds; }
 
-            void setFeedRefreshedCallback(const std::function<void(uint64_t, Feed*)>& callback) noexcept { mFeedRefreshedCallback = callback; }
+            // when adaptive, feeds without a fixed refresh interval are refreshed according to their learned interval instead of the global one
+            void setAdaptive(bool b);
+            bool isAdaptive() const noexcept { return mAdaptive; }
+
+            void setFeedRefreshedCallback(const std::function<void(uint64_t, Feed*)>& callback);
+
+            // feeds that are overdue when the schedule is loaded (e.g. after a restart) are spread out over this window
+            void setStartupSmoothingWindow(uint64_t seconds) noexcept { mStartupSmoothingWindowInSeconds = seconds; }
+            uint64_t startupSmoothingWindow() const noexcept { return mStartupSmoothingWindowInSeconds; }
+
+            uint64_t effectiveInterval(std::optional<uint64_t> refreshInterval, std::optional<uint64_t> adaptiveRefreshInterval) const noexcept;
+            // feeds that get their updates pushed through WebSub are only polled at the WebSub safety interval
+            uint64_t nextDue(uint64_t feedID, uint64_t lastCheckedEpoch, std::optional<uint64_t> refreshInterval, std::optional<uint64_t> adaptiveRefreshInterval,
+                             bool pushed = false) const noexcept;
+            void scheduleFeed(uint64_t sourceID, uint64_t feedID, uint64_t dueEpoch);
+            void unscheduleFeed(uint64_t feedID);
+            size_t scheduledFeedCount();
+
+            static uint64_t jitter(uint64_t feedID, uint64_t interval) noexcept;
+            static constexpr uint64_t JitterDivisor{10}; // the jitter is at most a tenth of the interval
 
           private:
             explicit AutoRefresh();
 
-            bool mEnabled{true};
-            uint64_t mFeedRefreshIntervalInSeconds{DefaultFeedAutoRefreshInterval};
-            std::unique_ptr<Poco::Timer> mTimer{nullptr};
-            void onTimer(Poco::Timer& timer);
+            struct ScheduledRefresh
+            {
+                uint64_t dueEpoch{0};
+                uint64_t feedID{0};
+                bool operator>(const ScheduledRefresh& other) const noexcept { return dueEpoch > other.dueEpoch; }
+            };
+
+            struct ScheduledFeed
+            {
+                uint64_t sourceID{0};
+                uint64_t dueEpoch{0};
+            };
+
+            void run();
+            void loadSchedule(bool recompute, uint64_t generation);
+            void invalidateSchedule();
+
+            // read without the mutex by the agents computing their feed's next due time
+            std::atomic<bool> mEnabled{true};
+            std::atomic<bool> mAdaptive{true};
+            std::atomic<uint64_t> mFeedRefreshIntervalInSeconds{DefaultFeedAutoRefreshInterval};
+            std::atomic<uint64_t> mStartupSmoothingWindowInSeconds{DefaultAutoRefreshStartupSmoothingWindow};
             std::optional<std::function<void(uint64_t, Feed*)>> mFeedRefreshedCallback{};
+
+            // heap entries aren't removed when a feed is rescheduled or unscheduled; they're skipped when they no longer match mScheduledFeeds
+            std::priority_queue<ScheduledRefresh, std::vector<ScheduledRefresh>, std::greater<ScheduledRefresh>> mSchedule{};
+            std::unordered_map<uint64_t, ScheduledFeed> mScheduledFeeds{};
+            bool mScheduleLoaded{false};
+            bool mRecomputeSchedule{false};
+            uint64_t mScheduleGeneration{0}; // bumped on every invalidation, so a load that raced with one is thrown away
+            bool mShouldStop{false};
+            std::mutex mMutex{};
+            std::condition_variable mWakeUp{};
+            std::thread mThread{};
         };
     } // namespace Engine
 } // namespace ZapFR
 
-#endif // ZAPFR_ENGINE_AUTOREFRESH_H
\ No newline at end of file
+#endif // ZAPFR_ENGINE_AUTOREFRESH_H
@@ -0,0 +1,107 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_DNSCACHE_H
+#define ZAPFR_ENGINE_DNSCACHE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <Poco/Net/IPAddress.h>
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // remembers the address of every host we connect to (and the fact that a host couldn't be resolved) for a while, so connections
+        // don't each have to go through the blocking system resolver; hosts can be resolved ahead of time on a background thread
+        class DNSCache
+        {
+          public:
+            DNSCache(const DNSCache&) = delete;
+            DNSCache& operator=(const DNSCache&) = delete;
+            virtual ~DNSCache();
+
+            using Clock = std::chrono::steady_clock;
+
+            static DNSCache* getInstance();
+
+            // throws a runtime_error when the host can't be resolved
+            Poco::Net::IPAddress resolve(const std::string& host);
+            void preResolve(const std::vector<std::string>& hosts);
+            // forgets the cached address of a host, e.g. after connecting to it failed; returns whether there was anything to forget
+            bool invalidate(const std::string& host);
+            void clear();
+
+            void setTTL(uint64_t seconds);
+            uint64_t ttl();
+            void setNegativeTTL(uint64_t seconds);
+            uint64_t negativeTTL();
+
+            uint64_t hitCount() const noexcept { return mHitCount; }
+            uint64_t missCount() const noexcept { return mMissCount; }
+            uint64_t negativeHitCount() const noexcept { return mNegativeHitCount; }
+
+            static constexpr uint64_t DefaultTTL{300};
+            static constexpr uint64_t DefaultNegativeTTL{30};
+            static constexpr size_t MaxEntries{4096};
+
+          private:
+            explicit DNSCache();
+
+            struct Entry
+            {
+                std::optional<Poco::Net::IPAddress> address{};
+                std::string error{""};
+                Clock::time_point expires{};
+                Clock::time_point refreshAfter{};
+                bool refreshQueued{false};
+            };
+
+            Entry lookup(const std::string& host);
+            void store(const std::string& host, Entry entry);
+            void run();
+
+            std::unordered_map<std::string, Entry> mEntries{};
+            std::unordered_set<std::string> mResolving{};
+            std::deque<std::string> mPreResolveQueue{};
+            uint64_t mTTLInSeconds{DefaultTTL};
+            uint64_t mNegativeTTLInSeconds{DefaultNegativeTTL};
+            bool mShouldStop{false};
+            std::mutex mMutex{};
+            std::condition_variable mResolved{};
+            std::condition_variable mWakeUp{};
+            std::thread mThread{};
+
+            std::atomic<uint64_t> mHitCount{0};
+            std::atomic<uint64_t> mMissCount{0};
+            std::atomic<uint64_t> mNegativeHitCount{0};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_DNSCACHE_H
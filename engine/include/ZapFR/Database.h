@@ -55,6 +55,14 @@ namespace ZapFR
             void upgradeToDBSchemaV5();
             void upgradeToDBSchemaV6();
             void upgradeToDBSchemaV7();
+            void upgradeToDBSchemaV8();
+            void upgradeToDBSchemaV9();
+            void upgradeToDBSchemaV10();
+            void upgradeToDBSchemaV11();
+            void upgradeToDBSchemaV12();
+            void upgradeToDBSchemaV13();
+            void upgradeToDBSchemaV14();
+            void upgradeToDBSchemaV15();
         };
     } // namespace Engine
 } // namespace ZapFR
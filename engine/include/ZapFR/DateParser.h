@@ -0,0 +1,48 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_DATEPARSER_H
+#define ZAPFR_ENGINE_DATEPARSER_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // Turns the dates found in feeds into seconds since the epoch, without allocating. Understands ISO 8601/RFC 3339 (Atom, JSON Feed,
+        // dc:date and what we store ourselves) and RFC 822/1123 (RSS), including the usual deviations: missing weekdays or seconds,
+        // two-digit years, full month names, dashes instead of spaces, fractional seconds and named time zones.
+        class DateParser
+        {
+          public:
+            static std::optional<int64_t> parse(std::string_view date);
+
+            // a UTC date the way Poco's ISO8601_FORMAT writes it, e.g. 2023-10-05T23:57:09Z
+            static std::string formatISO8601(int64_t epoch);
+
+            // parse() followed by formatISO8601(), which is how dates get stored
+            static std::optional<std::string> normalize(std::string_view date);
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_DATEPARSER_H
@@ -0,0 +1,88 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_FAVICONCACHE_H
+#define ZAPFR_ENGINE_FAVICONCACHE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // remembers which icon a site uses and the icon itself (along with its ETag/Last-Modified), so feeds that share a site share a
+        // single page scrape and download; stale entries are revalidated with a conditional GET
+        class FavIconCache
+        {
+          public:
+            FavIconCache(const FavIconCache&) = delete;
+            FavIconCache& operator=(const FavIconCache&) = delete;
+            virtual ~FavIconCache() = default;
+
+            struct Icon
+            {
+                std::string hash{""};
+                std::string data{""};
+            };
+
+            static FavIconCache* getInstance();
+
+            // returns the icon URL mentioned on the page (or rather, its site), or an empty string if there isn't one
+            std::string iconURLForPage(const std::string& pageURL, uint64_t associatedFeedID);
+            std::optional<Icon> icon(const std::string& iconURL, uint64_t associatedFeedID);
+
+            uint64_t hitCount() const noexcept { return mHitCount; }
+            uint64_t fetchCount() const noexcept { return mFetchCount; }
+            uint64_t notModifiedCount() const noexcept { return mNotModifiedCount; }
+
+            static constexpr uint64_t RefreshInterval{7 * 24 * 60 * 60};
+
+          private:
+            explicit FavIconCache() = default;
+
+            // makes concurrent lookups for the same key wait for the first one, instead of all of them going out to the network
+            class KeyLock
+            {
+              public:
+                KeyLock(FavIconCache* cache, const std::string& key);
+                ~KeyLock();
+                KeyLock(const KeyLock&) = delete;
+                KeyLock& operator=(const KeyLock&) = delete;
+
+              private:
+                FavIconCache* mCache{nullptr};
+                std::string mKey{""};
+            };
+
+            std::unordered_set<std::string> mBusyKeys{};
+            std::mutex mMutex{};
+            std::condition_variable mKeyReleased{};
+
+            std::atomic<uint64_t> mHitCount{0};
+            std::atomic<uint64_t> mFetchCount{0};
+            std::atomic<uint64_t> mNotModifiedCount{0};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_FAVICONCACHE_H
@@ -59,10 +59,20 @@ namespace ZapFR
             uint64_t totalPostCount{0};
         };
 
-        constexpr uint64_t DBVersion{7};
+        constexpr uint64_t DBVersion{15};
         constexpr uint64_t APIVersion{1};
         constexpr uint64_t DefaultFeedAutoRefreshInterval{15 * 60};
+        constexpr uint64_t DefaultAutoRefreshStartupSmoothingWindow{5 * 60};
+        constexpr uint64_t MaxFeedBackoffDelay{24 * 60 * 60};
+        constexpr uint64_t FeedCircuitBreakerThreshold{8};
         constexpr uint16_t DefaultServerPort{16016};
+        constexpr uint64_t DefaultIconCacheCapacity{512};
+        constexpr uint64_t DefaultNetworkAgentConcurrency{64};
+        constexpr uint64_t DefaultHTTPMaxBodySize{32 * 1024 * 1024};
+        constexpr uint64_t DefaultHTTPDeadline{60};
+        constexpr uint64_t DefaultHTTPMinTransferRate{1024};
+        constexpr uint64_t DefaultHTTPMaxRedirects{10};
+        constexpr uint64_t PermanentRedirectConfirmations{3}; // consecutive refreshes that have to see the same permanent redirect before the feed URL is updated
 
         namespace ServerIdentifier
         {
@@ -213,8 +223,43 @@ namespace ZapFR
                 constexpr const char FeedError[]{"error"};
                 constexpr const char FeedErrors[]{"feedErrors"};
                 constexpr const char HighestPostID[]{"highestPostID"};
+                constexpr const char ConsecutiveFailures[]{"consecutiveFailures"};
+                constexpr const char Suspended[]{"suspended"};
+                constexpr const char NextAttempt[]{"nextAttempt"};
+                constexpr const char QueueDepth[]{"queueDepth"};
+                constexpr const char PeakQueueDepth[]{"peakQueueDepth"};
+                constexpr const char DNSCacheHits[]{"dnsCacheHits"};
+                constexpr const char DNSCacheMisses[]{"dnsCacheMisses"};
+                constexpr const char DNSCacheNegativeHits[]{"dnsCacheNegativeHits"};
+                constexpr const char TLSHandshakes[]{"tlsHandshakes"};
+                constexpr const char TLSResumedHandshakes[]{"tlsResumedHandshakes"};
+                constexpr const char UnchangedFeedBodies[]{"unchangedFeedBodies"};
+                constexpr const char UnchangedFeedBodyBytes[]{"unchangedFeedBodyBytes"};
+                constexpr const char WebSubSubscriptions[]{"webSubSubscriptions"};
+                constexpr const char WebSubPushedUpdates[]{"webSubPushedUpdates"};
             }; // namespace SourceStatus
 
+            namespace FeedTelemetry
+            {
+                constexpr const char Timestamp[]{"timestamp"};
+                constexpr const char Result[]{"result"};
+                constexpr const char ResultParsed[]{"parsed"};
+                constexpr const char ResultNotModified[]{"notModified"};
+                constexpr const char ResultUnchanged[]{"unchanged"};
+                constexpr const char ResultPushed[]{"pushed"};
+                constexpr const char ResultFailed[]{"failed"};
+                constexpr const char DNSTime[]{"dnsTime"};
+                constexpr const char ConnectTime[]{"connectTime"};
+                constexpr const char TLSTime[]{"tlsTime"};
+                constexpr const char FirstByteTime[]{"firstByteTime"};
+                constexpr const char TransferredBytes[]{"transferredBytes"};
+                constexpr const char BodyBytes[]{"bodyBytes"};
+                constexpr const char ParseTime[]{"parseTime"};
+                constexpr const char IngestTime[]{"ingestTime"};
+                constexpr const char NewItems[]{"newItems"};
+                constexpr const char UpdatedItems[]{"updatedItems"};
+            }; // namespace FeedTelemetry
+
             namespace About
             {
                 constexpr const char Name[]{"name"};
@@ -237,8 +282,7 @@ namespace ZapFR
                 constexpr const char SortOrder[]{"sortOrder"};
                 constexpr const char ParentFolderID[]{"parentFolderID"};
                 constexpr const char RefreshInterval[]{"refreshInterval"};
-                constexpr const char GetIcons[]{"getIcons"};
-
+                constexpr const char IconHashes[]{"iconHashes"};
             }; // namespace Feed
 
             namespace Folder
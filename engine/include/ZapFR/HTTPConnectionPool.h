@@ -0,0 +1,125 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_HTTPCONNECTIONPOOL_H
+#define ZAPFR_ENGINE_HTTPCONNECTIONPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include <Poco/Net/Context.h>
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Net/Session.h>
+#include <Poco/Timestamp.h>
+#include <Poco/URI.h>
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // keeps idle keep-alive HTTP(S) sessions around per scheme/host/port, so consecutive requests to the same host skip the TCP and TLS handshakes;
+        // new HTTPS connections resume the host's previous TLS session, which skips the certificate exchange and key agreement
+        class HTTPConnectionPool
+        {
+          public:
+            HTTPConnectionPool(const HTTPConnectionPool&) = delete;
+            HTTPConnectionPool& operator=(const HTTPConnectionPool&) = delete;
+            virtual ~HTTPConnectionPool() = default;
+
+            // a checked out session; it's returned to the pool upon destruction, but only kept if marked as reusable
+            class Connection
+            {
+              public:
+                Connection(HTTPConnectionPool* pool, const std::string& key, std::unique_ptr<Poco::Net::HTTPClientSession> session, bool reused, uint64_t dnsTime = 0);
+                ~Connection();
+                Connection(const Connection&) = delete;
+                Connection& operator=(const Connection&) = delete;
+
+                Poco::Net::HTTPClientSession* session() const noexcept { return mSession.get(); }
+                bool isReused() const noexcept { return mReused; }
+                void setReusable(bool b) noexcept { mReusable = b; }
+
+                // how long setting up the connection took, in microseconds; the connection is only made once the first request is sent,
+                // and a reused connection didn't have to be set up at all
+                uint64_t dnsTime() const noexcept { return mDNSTime; }
+                uint64_t connectTime() const;
+                uint64_t tlsTime() const;
+                // whether setting up the connection failed before a single byte went out, e.g. because the host's address is outdated
+                bool connectFailed() const;
+
+              private:
+                HTTPConnectionPool* mPool{nullptr};
+                std::string mKey{""};
+                std::unique_ptr<Poco::Net::HTTPClientSession> mSession{nullptr};
+                bool mReused{false};
+                bool mReusable{false};
+                uint64_t mDNSTime{0};
+            };
+
+            static HTTPConnectionPool* getInstance();
+
+            std::unique_ptr<Connection> checkout(const Poco::URI& url, Poco::Net::Context::Ptr sslContext);
+            void clear();
+
+            void setMaxConnectionsPerHost(size_t max);
+            size_t maxConnectionsPerHost() const noexcept { return mMaxConnectionsPerHost; }
+            void setIdleTimeout(uint64_t seconds);
+            uint64_t idleTimeout() const noexcept { return mIdleTimeoutInSeconds; }
+
+            uint64_t createdConnectionCount() const noexcept { return mCreatedConnectionCount; }
+            uint64_t reusedConnectionCount() const noexcept { return mReusedConnectionCount; }
+            uint64_t tlsHandshakeCount() const noexcept { return mTLSHandshakeCount; }
+            uint64_t tlsResumedHandshakeCount() const noexcept { return mTLSResumedHandshakeCount; }
+
+            static constexpr size_t DefaultMaxConnectionsPerHost{6};
+            static constexpr uint64_t DefaultIdleTimeout{30};
+            static constexpr uint64_t CheckoutTimeout{10};
+            static constexpr size_t MaxTLSSessions{1024};
+
+          private:
+            explicit HTTPConnectionPool() = default;
+
+            struct IdleSession
+            {
+                std::unique_ptr<Poco::Net::HTTPClientSession> session{nullptr};
+                Poco::Timestamp lastUsed{};
+            };
+
+            void checkin(const std::string& key, std::unique_ptr<Poco::Net::HTTPClientSession> session, bool reusable, bool reused);
+            void evictIdleSessions();
+
+            std::unordered_map<std::string, std::deque<IdleSession>> mIdleSessions{};
+            std::unordered_map<std::string, size_t> mActiveConnectionCount{};
+            std::unordered_map<std::string, Poco::Net::Session::Ptr> mTLSSessions{}; // the last TLS session per host, to resume on new connections
+            std::mutex mMutex{};
+            std::condition_variable mSlotAvailable{};
+
+            size_t mMaxConnectionsPerHost{DefaultMaxConnectionsPerHost};
+            uint64_t mIdleTimeoutInSeconds{DefaultIdleTimeout};
+            std::atomic<uint64_t> mCreatedConnectionCount{0};
+            std::atomic<uint64_t> mReusedConnectionCount{0};
+            std::atomic<uint64_t> mTLSHandshakeCount{0};
+            std::atomic<uint64_t> mTLSResumedHandshakeCount{0};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_HTTPCONNECTIONPOOL_H
@@ -0,0 +1,98 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_HTTPCORPUSTRANSPORT_H
+#define ZAPFR_ENGINE_HTTPCORPUSTRANSPORT_H
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "ZapFR/HTTPTransport.h"
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // a corpus is a directory holding one recorded exchange per method/URL/range/validators/request body: <key>.json has the status, headers and the time
+        // the exchange took, <key>.body the response body exactly as the server sent it
+        class HTTPCorpus
+        {
+          public:
+            struct Entry
+            {
+                std::string method{""};
+                std::string url{""};
+                Poco::Net::HTTPResponse::HTTPStatus status{Poco::Net::HTTPResponse::HTTP_OK};
+                std::string reason{""};
+                std::vector<std::pair<std::string, std::string>> headers{};
+                uint64_t elapsedMilliseconds{0};
+                std::string body{""};
+            };
+
+            // the conditional GET headers are part of the key, so a 304 to a revalidation doesn't replace the full response recorded before it;
+            // without withValidators the key is that of the same request sent unconditionally
+            static std::string key(const Poco::Net::HTTPRequest& request, const Poco::URI& url, const std::string& requestBody, bool withValidators = true);
+            static void write(const std::string& directory, const std::string& key, const Entry& entry);
+            static std::optional<Entry> read(const std::string& directory, const std::string& key);
+        };
+
+        // passes exchanges on to another transport (the network, usually), and records them into a corpus
+        class HTTPRecordingTransport : public HTTPTransport
+        {
+          public:
+            HTTPRecordingTransport(const std::string& corpusDirectory, std::shared_ptr<HTTPTransport> transport);
+            ~HTTPRecordingTransport() = default;
+
+            void exchange(const Poco::URI& url, Poco::Net::HTTPRequest& request, const std::string& requestBody, const ResponseHandler& responseHandler,
+                          Timings& timings) override;
+
+            uint64_t recordedCount() const noexcept { return mRecordedCount; }
+
+          private:
+            std::string mCorpusDirectory{""};
+            std::shared_ptr<HTTPTransport> mTransport{nullptr};
+            std::mutex mWriteMutex{};
+            std::atomic<uint64_t> mRecordedCount{0};
+        };
+
+        // answers exchanges from a corpus without touching the network, taking as long as the recorded exchange did (times latencyScale);
+        // exchanges missing from the corpus fail like an unreachable host would
+        class HTTPReplayTransport : public HTTPTransport
+        {
+          public:
+            explicit HTTPReplayTransport(const std::string& corpusDirectory, double latencyScale = 1.0);
+            ~HTTPReplayTransport() = default;
+
+            void exchange(const Poco::URI& url, Poco::Net::HTTPRequest& request, const std::string& requestBody, const ResponseHandler& responseHandler,
+                          Timings& timings) override;
+
+            uint64_t replayedCount() const noexcept { return mReplayedCount; }
+            uint64_t missedCount() const noexcept { return mMissedCount; }
+
+          private:
+            std::string mCorpusDirectory{""};
+            double mLatencyScale{1.0};
+            std::atomic<uint64_t> mReplayedCount{0};
+            std::atomic<uint64_t> mMissedCount{0};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_HTTPCORPUSTRANSPORT_H
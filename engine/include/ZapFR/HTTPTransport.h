@@ -0,0 +1,79 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_HTTPTRANSPORT_H
+#define ZAPFR_ENGINE_HTTPTRANSPORT_H
+
+#include <functional>
+#include <mutex>
+
+#include <Poco/Net/Context.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/HTTPResponse.h>
+#include <Poco/URI.h>
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // performs a single HTTP request/response exchange; everything around it (redirects, conditional GETs, decompression, transfer limits, ...)
+        // is handled by Helpers::performStreamingHTTPRequest, so a transport only has to get the bytes across
+        class HTTPTransport
+        {
+          public:
+            HTTPTransport() = default;
+            virtual ~HTTPTransport() = default;
+            HTTPTransport(const HTTPTransport&) = delete;
+            HTTPTransport& operator=(const HTTPTransport&) = delete;
+
+            // responseHandler receives the response along with its body as sent by the server (i.e. still compressed if it was)
+            using ResponseHandler = std::function<void(Poco::Net::HTTPResponse&, std::istream&)>;
+
+            // how long the parts of an exchange took, in microseconds; filled in by the time the response handler is called
+            struct Timings
+            {
+                uint64_t dns{0};
+                uint64_t connect{0};
+                uint64_t tls{0};
+                uint64_t firstByte{0}; // from sending the request until the response headers came in
+            };
+
+            virtual void exchange(const Poco::URI& url, Poco::Net::HTTPRequest& request, const std::string& requestBody, const ResponseHandler& responseHandler,
+                                  Timings& timings) = 0;
+        };
+
+        // the real thing: sends the request over a pooled connection
+        class HTTPNetworkTransport : public HTTPTransport
+        {
+          public:
+            HTTPNetworkTransport() = default;
+            ~HTTPNetworkTransport() = default;
+
+            void exchange(const Poco::URI& url, Poco::Net::HTTPRequest& request, const std::string& requestBody, const ResponseHandler& responseHandler,
+                          Timings& timings) override;
+
+          private:
+            Poco::Net::Context::Ptr sslContext();
+
+            Poco::Net::Context::Ptr mSSLContext{nullptr};
+            std::mutex mSSLContextMutex{};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_HTTPTRANSPORT_H
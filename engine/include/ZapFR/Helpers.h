@@ -19,23 +19,71 @@
 #ifndef ZAPFR_ENGINE_HELPERS_H
 #define ZAPFR_ENGINE_HELPERS_H
 
+#include <functional>
+#include <memory>
 #include <optional>
 
 #include <Poco/Net/HTTPCredentials.h>
+#include <Poco/URI.h>
+
+#include "ZapFR/Global.h"
 
 namespace ZapFR
 {
     namespace Engine
     {
+        class HTTPTransport;
+
         class Helpers
         {
           public:
             static void splitString(const std::string& sourceString, char delimiter, std::vector<std::string>& outSubstrings);
             static std::string joinString(const std::vector<std::string>& sourceVector, const char* delimiter);
             static std::string joinIDNumbers(const std::vector<uint64_t>& sourceVector, const char* delimiter);
+
+            // whether an Accept-Encoding header value allows the given content coding, i.e. lists it (or *) without q=0
+            static bool acceptsContentCoding(const std::string& acceptEncoding, const std::string& coding);
+
+            struct HTTPTransferLimits
+            {
+                uint64_t maxBodySize{DefaultHTTPMaxBodySize};         // bytes, 0 = unlimited
+                uint64_t deadline{DefaultHTTPDeadline};               // seconds, 0 = unlimited
+                uint64_t minTransferRate{DefaultHTTPMinTransferRate}; // bytes per second, 0 = unlimited
+                uint64_t maxRedirects{DefaultHTTPMaxRedirects};
+            };
+
+            // what a request cost, summed over the redirects it went through; times are in microseconds
+            struct HTTPTransferStats
+            {
+                uint64_t dnsTime{0};
+                uint64_t connectTime{0};
+                uint64_t tlsTime{0};
+                uint64_t firstByteTime{0};
+                uint64_t transferredBytes{0}; // body bytes as they came over the wire, i.e. still compressed
+                uint64_t bodyBytes{0};        // body bytes after decompression
+            };
+
+            static void setHTTPTransferLimits(const HTTPTransferLimits& limits);
+            static HTTPTransferLimits httpTransferLimits();
+
+            // what the requests below go over; the network unless swapped out, e.g. to record exchanges to or replay them from a corpus on disk
+            static void setHTTPTransport(std::shared_ptr<HTTPTransport> transport);
+            static std::shared_ptr<HTTPTransport> httpTransport();
+
+            // redirects are followed and url is updated to the final location; permanentRedirectURL (if given) receives that location
+            // when every redirect along the way was permanent, and is left empty otherwise; transferStats (if given) is filled in even when the request fails
             static std::tuple<std::string, std::string> performHTTPRequest(Poco::URI& url, const std::string& method, Poco::Net::HTTPCredentials& credentials,
                                                                            const std::map<std::string, std::string>& parameters, std::optional<uint64_t> associatedFeedID = {},
-                                                                           std::optional<std::string> conditionalGetInfo = {});
+                                                                           std::optional<std::string> conditionalGetInfo = {}, std::string* permanentRedirectURL = nullptr,
+                                                                           HTTPTransferStats* transferStats = nullptr);
+            static std::string performStreamingHTTPRequest(Poco::URI& url, const std::string& method, Poco::Net::HTTPCredentials& credentials,
+                                                           const std::map<std::string, std::string>& parameters, const std::function<void(std::istream&)>& bodyHandler,
+                                                           std::optional<uint64_t> associatedFeedID = {}, std::optional<std::string> conditionalGetInfo = {},
+                                                           std::string* permanentRedirectURL = nullptr, const std::map<std::string, std::string>& additionalHeaders = {},
+                                                           HTTPTransferStats* transferStats = nullptr);
+
+            // fetches no more than the first maxBytes of the body at url (e.g. to sniff the type of a document), abandoning the transfer after that
+            static std::string performHTTPProbe(Poco::URI& url, Poco::Net::HTTPCredentials& credentials, size_t maxBytes, std::optional<uint64_t> associatedFeedID = {});
         };
     } // namespace Engine
 } // namespace ZapFR
@@ -0,0 +1,109 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_HOSTTHROTTLE_H
+#define ZAPFR_ENGINE_HOSTTHROTTLE_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // keeps feed refreshes polite towards a single host: caps the amount of concurrent requests, enforces a minimum spacing between
+        // them, rate limits them through a token bucket and honors Retry-After responses
+        class HostThrottle
+        {
+          public:
+            HostThrottle(const HostThrottle&) = delete;
+            HostThrottle& operator=(const HostThrottle&) = delete;
+            virtual ~HostThrottle() = default;
+
+            using Clock = std::chrono::steady_clock;
+
+            struct Limits
+            {
+                uint64_t maxConcurrentRequests{2};
+                uint64_t minSpacingInMilliseconds{500};
+                uint64_t requestsPerMinute{30};
+                uint64_t burstSize{5};
+            };
+
+            // a granted request slot for a host; it's released upon destruction
+            class Permit
+            {
+              public:
+                Permit(HostThrottle* throttle, const std::string& host);
+                ~Permit();
+                Permit(const Permit&) = delete;
+                Permit& operator=(const Permit&) = delete;
+
+              private:
+                HostThrottle* mThrottle{nullptr};
+                std::string mHost{""};
+            };
+
+            static HostThrottle* getInstance();
+
+            // returns a permit if a request to the host may start right now, otherwise nullptr and retryAt is set to the earliest moment to try again
+            std::unique_ptr<Permit> tryAcquire(const std::string& host, Clock::time_point& retryAt);
+            void deferUntil(const std::string& host, Clock::time_point until);
+            void clear();
+
+            // forgets the hosts that are back to the state of a host that was never contacted; this also happens on its own every PruneInterval
+            void pruneIdleHosts();
+            size_t hostCount();
+
+            void setLimits(const Limits& limits);
+            Limits limits();
+
+            static constexpr uint64_t DefaultTooManyRequestsDelay{60};
+            static constexpr uint64_t MaxRetryAfterDelay{24 * 60 * 60};
+            static constexpr std::chrono::seconds PruneInterval{60};
+
+          private:
+            explicit HostThrottle() = default;
+
+            struct HostState
+            {
+                uint64_t activeRequests{0};
+                double tokens{0.0};
+                Clock::time_point lastRefill{};
+                Clock::time_point lastRequest{};
+                Clock::time_point blockedUntil{};
+            };
+
+            void release(const std::string& host);
+            HostState& stateForHost(const std::string& host, Clock::time_point now);
+            bool isIdle(const HostState& state, Clock::time_point now) const;
+            void removeIdleHosts(Clock::time_point now);
+
+            std::unordered_map<std::string, HostState> mHosts{};
+            Clock::time_point mNextPrune{};
+            Limits mLimits{};
+            std::mutex mMutex{};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_HOSTTHROTTLE_H
@@ -0,0 +1,66 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_ICONCACHE_H
+#define ZAPFR_ENGINE_ICONCACHE_H
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "ZapFR/Global.h"
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // in-memory LRU cache of feed icon data, keyed by the md5 hash of the icon data
+        class IconCache
+        {
+          public:
+            IconCache(const IconCache&) = delete;
+            IconCache& operator=(const IconCache&) = delete;
+            virtual ~IconCache() = default;
+
+            static IconCache* getInstance();
+
+            std::optional<std::string> get(const std::string& hash);
+            void put(const std::string& hash, const std::string& data);
+            bool contains(const std::string& hash);
+            void clear();
+
+            void setCapacity(size_t capacity);
+            size_t capacity() const noexcept { return mCapacity; }
+            size_t size();
+
+          private:
+            explicit IconCache() = default;
+
+            void evict();
+
+            size_t mCapacity{DefaultIconCacheCapacity};
+            std::list<std::pair<std::string, std::string>> mEntries{}; // most recently used at the front
+            std::unordered_map<std::string, std::list<std::pair<std::string, std::string>>::iterator> mIndex{};
+            std::mutex mMutex{};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_ICONCACHE_H
@@ -0,0 +1,123 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_WEBSUB_H
+#define ZAPFR_ENGINE_WEBSUB_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // subscribes to the WebSub (PubSubHubbub) hubs that feeds advertise, so their updates get pushed to us instead of having to be polled for;
+        // hubs reach us through the server's callback endpoint, so nothing happens until the public URL of that endpoint is known
+        class WebSub
+        {
+          public:
+            WebSub(const WebSub&) = delete;
+            WebSub& operator=(const WebSub&) = delete;
+            virtual ~WebSub();
+
+            static WebSub* getInstance();
+
+            void setCallbackURL(const std::string& url);
+            std::string callbackURL();
+            bool isEnabled();
+
+            void setLeaseDuration(uint64_t seconds) noexcept { mLeaseDurationInSeconds = seconds; }
+            uint64_t leaseDuration() const noexcept { return mLeaseDurationInSeconds; }
+
+            // feeds with an active subscription are still polled, but no more often than this, in case the hub drops the ball
+            void setSafetyInterval(uint64_t seconds) noexcept { mSafetyIntervalInSeconds = seconds; }
+            uint64_t safetyInterval() const noexcept { return mSafetyIntervalInSeconds; }
+
+            // called after every poll of a feed; (re)subscribes when the advertised hub or topic changed, and unsubscribes when the hub went away
+            void updateFeed(uint64_t feedID, const std::string& hubURL, const std::string& topicURL);
+            void removeFeed(uint64_t feedID);
+            bool hasActiveSubscription(uint64_t feedID);
+            std::unordered_set<uint64_t> activelySubscribedFeeds();
+            uint64_t activeSubscriptionCount();
+
+            // sends out the (re)subscribe and unsubscribe requests that are due; the background thread calls this periodically
+            void processDueSubscriptions();
+
+            // the hub checking that we asked for the (un)subscription; returns the challenge to echo back, or nothing when the request should be refused
+            std::optional<std::string> verifyIntent(const std::string& token, const std::string& mode, const std::string& topic, const std::string& challenge,
+                                                    uint64_t leaseSeconds);
+
+            enum class Delivery
+            {
+                Accepted,
+                InvalidSignature,
+                UnknownSubscription,
+            };
+
+            // the hub pushing new content; accepted content is queued for ingestion into the subscribed feed
+            Delivery deliver(const std::string& token, const std::string& signature, std::string&& body);
+
+            uint64_t pushedUpdateCount() const noexcept { return mPushedUpdateCount; }
+
+            static constexpr uint64_t DefaultLeaseDuration{10 * 24 * 60 * 60};
+            static constexpr uint64_t DefaultSafetyInterval{12 * 60 * 60};
+            static constexpr uint64_t RenewalMargin{60 * 60};            // leases are renewed this long before they expire
+            static constexpr uint64_t RetryInterval{60 * 60};            // for failed requests, and hubs that never verify them
+            static constexpr uint64_t DeniedRetryInterval{24 * 60 * 60}; // for hubs that refused the subscription
+            static constexpr uint64_t CheckInterval{5 * 60};
+
+          private:
+            explicit WebSub() = default;
+
+            struct Subscription
+            {
+                uint64_t id{0};
+                uint64_t feedID{0};
+                std::string hub{""};
+                std::string topic{""};
+                std::string token{""};
+                std::string secret{""};
+                std::string state{""};
+                uint64_t leaseExpires{0};
+                uint64_t nextAttempt{0};
+            };
+
+            void run();
+            bool sendRequest(const Subscription& subscription, const std::string& mode);
+            std::optional<Subscription> subscriptionForToken(const std::string& token);
+            static bool isSignatureValid(const std::string& secret, const std::string& signature, const std::string& body);
+
+            std::string mCallbackURL{""};
+            std::atomic<uint64_t> mLeaseDurationInSeconds{DefaultLeaseDuration};
+            std::atomic<uint64_t> mSafetyIntervalInSeconds{DefaultSafetyInterval};
+            std::atomic<uint64_t> mPushedUpdateCount{0};
+
+            bool mShouldStop{false};
+            std::mutex mMutex{};
+            std::condition_variable mWakeUp{};
+            std::thread mThread{};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_WEBSUB_H
@@ -35,6 +35,7 @@ namespace ZapFR
 
             void payload(Source* source) override;
             Type type() const noexcept override { return Type::FeedRefresh; }
+            bool isNetworkBound() const noexcept override { return true; }
 
           private:
             uint64_t mFeedID{0};
@@ -61,6 +61,35 @@ namespace ZapFR
                 Unknown
             };
 
+            // what a single refresh of the feed cost; times are in microseconds
+            struct Telemetry
+            {
+                enum class Result : uint64_t
+                {
+                    Parsed,
+                    NotModified, // 304, or an empty body
+                    Unchanged,   // same body as last time, so parsing and ingesting it were skipped
+                    Pushed,      // delivered by a WebSub hub
+                    Failed,
+                };
+
+                std::string timestamp{""};
+                Result result{Result::Parsed};
+                uint64_t dnsTime{0};
+                uint64_t connectTime{0};
+                uint64_t tlsTime{0};
+                uint64_t firstByteTime{0};
+                uint64_t transferredBytes{0};
+                uint64_t bodyBytes{0};
+                uint64_t parseTime{0};
+                uint64_t ingestTime{0};
+                uint64_t newItems{0};
+                uint64_t updatedItems{0};
+
+                Poco::JSON::Object toJSON() const;
+                static Telemetry fromJSON(const Poco::JSON::Object::Ptr o);
+            };
+
             const uint64_t& id() const noexcept { return mID; }
             const std::string& url() const noexcept { return mURL; }
             const uint64_t& folder() const noexcept { return mFolderID; }
@@ -80,6 +109,7 @@ namespace ZapFR
             const uint64_t& unreadCount() const noexcept { return mUnreadCount; }
             const std::optional<std::string>& lastRefreshError() { return mLastRefreshError; }
             const std::optional<uint64_t>& refreshInterval() { return mRefreshInterval; }
+            const std::optional<uint64_t>& adaptiveRefreshInterval() { return mAdaptiveRefreshInterval; }
             const std::unordered_map<Statistic, std::string>& statistics() { return mStatistics; }
             const std::vector<ThumbnailData>& thumbnailData() { return mThumbnailData; }
             const std::optional<std::string>& conditionalGETInfo() const noexcept { return mConditionalGETInfo; }
@@ -102,6 +132,7 @@ namespace ZapFR
             void setUnreadCount(uint64_t unreadCount) noexcept { mUnreadCount = unreadCount; }
             void setLastRefreshError(const std::optional<std::string>& e) { mLastRefreshError = e; }
             void setRefreshInterval(std::optional<uint64_t> ri) { mRefreshInterval = ri; }
+            void setAdaptiveRefreshInterval(std::optional<uint64_t> ri) { mAdaptiveRefreshInterval = ri; }
             void setStatistics(const std::unordered_map<Statistic, std::string>& stats) { mStatistics = stats; }
             void setConditionalGETInfo(const std::string& cgi) { mConditionalGETInfo = cgi; }
 
@@ -111,6 +142,9 @@ namespace ZapFR
 
             virtual std::tuple<uint64_t, std::vector<std::unique_ptr<Log>>> getLogs(uint64_t perPage, uint64_t page) = 0;
 
+            // the most recent refreshes, newest first
+            virtual std::vector<Telemetry> getTelemetry() = 0;
+
             virtual std::vector<std::unique_ptr<ZapFR::Engine::Category>> getCategories() = 0;
 
             virtual void updateProperties(const std::string& feedURL, std::optional<uint64_t> refreshIntervalInSeconds) = 0;
@@ -143,6 +177,7 @@ namespace ZapFR
             std::string mLastChecked{""};
             std::optional<std::string> mLastRefreshError{};
             std::optional<uint64_t> mRefreshInterval{};
+            std::optional<uint64_t> mAdaptiveRefreshInterval{};
             uint64_t mSortOrder{0};
             uint64_t mUnreadCount{0};
             std::unordered_map<Statistic, std::string> mStatistics{};
@@ -77,14 +77,14 @@ namespace ZapFR
             void setFeedID(uint64_t feedID) { mFeedID = feedID; }
             void setFeedTitle(const std::string& title) { mFeedTitle = title; }
             void setFeedLink(const std::string& link) { mFeedLink = link; }
-            void setTitle(const std::string& title) { mTitle = title; }
-            void setLink(const std::string& link) { mLink = link; }
-            void setContent(const std::string& content) { mContent = content; }
-            void setAuthor(const std::string& author) { mAuthor = author; }
-            void setCommentsURL(const std::string& commentsURL) { mCommentsURL = commentsURL; }
-            void setGuid(const std::string& guid) { mGuid = guid; }
-            void setDatePublished(const std::string& datePublished) { mDatePublished = datePublished; }
-            void setThumbnail(const std::string& thumbnail) { mThumbnail = thumbnail; }
+            void setTitle(std::string title) { mTitle = std::move(title); }
+            void setLink(std::string link) { mLink = std::move(link); }
+            void setContent(std::string content) { mContent = std::move(content); }
+            void setAuthor(std::string author) { mAuthor = std::move(author); }
+            void setCommentsURL(std::string commentsURL) { mCommentsURL = std::move(commentsURL); }
+            void setGuid(std::string guid) { mGuid = std::move(guid); }
+            void setDatePublished(std::string datePublished) { mDatePublished = std::move(datePublished); }
+            void setThumbnail(std::string thumbnail) { mThumbnail = std::move(thumbnail); }
             void setFlagColors(const std::unordered_set<FlagColor>& flagColors) { mFlagColors = flagColors; }
             void addEnclosure(const Enclosure& enclosure) { mEnclosures.emplace_back(enclosure); }
             void addEnclosure(const std::string& url, const std::string& mimeType, uint64_t size) { mEnclosures.emplace_back(url, mimeType, size); }
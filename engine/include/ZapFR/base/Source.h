@@ -90,6 +90,7 @@ namespace ZapFR
             virtual std::optional<std::unique_ptr<Feed>> addFeed(const std::string& url, uint64_t folder) = 0;
             virtual std::unordered_map<uint64_t, uint64_t> moveFeed(uint64_t feedID, uint64_t newFolder, uint64_t newSortOrder) = 0;
             virtual void removeFeed(uint64_t feedID) = 0;
+            virtual std::unordered_map<std::string, std::string> getIcons(const std::unordered_set<std::string>& iconHashes) = 0;
 
             virtual std::vector<std::unique_ptr<Folder>> getFolders(uint64_t parent, uint32_t fetchInfo) = 0;
             virtual std::optional<std::unique_ptr<Folder>> getFolder(uint64_t folderID, uint32_t fetchInfo) = 0;
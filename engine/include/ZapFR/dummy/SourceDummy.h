@@ -48,6 +48,7 @@ namespace ZapFR
             std::optional<std::unique_ptr<Feed>> addFeed(const std::string& url, uint64_t folder) override;
             std::unordered_map<uint64_t, uint64_t> moveFeed(uint64_t feedID, uint64_t newFolder, uint64_t newSortOrder) override;
             void removeFeed(uint64_t feedID) override;
+            std::unordered_map<std::string, std::string> getIcons(const std::unordered_set<std::string>& iconHashes) override;
 
             // folder stuff
             std::vector<std::unique_ptr<Folder>> getFolders(uint64_t parent, uint32_t fetchInfo) override;
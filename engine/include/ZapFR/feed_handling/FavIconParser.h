@@ -24,6 +24,7 @@
 #include <Poco/SAX/ContentHandler.h>
 #include <Poco/SAX/ErrorHandler.h>
 #include <Poco/SAX/SAXException.h>
+#include <Poco/URI.h>
 
 namespace ZapFR
 {
@@ -39,6 +40,9 @@ namespace ZapFR
             void parseString(const std::string& html, const std::optional<std::string>& originalURL);
             std::string favIcon() const noexcept;
 
+            // sites where every page has its own icon (e.g. YouTube channels), as opposed to one icon for the entire domain
+            static bool hasPageSpecificIcons(const Poco::URI& uri);
+
           private:
             std::string mURL{""};
             std::string mFavIcon{""};
@@ -19,6 +19,9 @@
 #ifndef ZAPFR_ENGINE_FEEDDISCOVERY_H
 #define ZAPFR_ENGINE_FEEDDISCOVERY_H
 
+#include <functional>
+#include <optional>
+
 #include <Poco/SAX/ContentHandler.h>
 #include <Poco/SAX/ErrorHandler.h>
 #include <Poco/SAX/SAXException.h>
@@ -33,10 +36,14 @@ namespace ZapFR
         struct DiscoveredFeed
         {
             DiscoveredFeed() = default;
-            DiscoveredFeed(const std::string& feedTitle, const std::string& feedURL, Feed::Type feedType) : title(feedTitle), url(feedURL), type(feedType) {}
+            DiscoveredFeed(const std::string& feedTitle, const std::string& feedURL, Feed::Type feedType, bool isVerified = false)
+                : title(feedTitle), url(feedURL), type(feedType), verified(isVerified)
+            {
+            }
             std::string title{""};
             std::string url{""};
             Feed::Type type{Feed::Type::RSS};
+            bool verified{false}; // whether the url is known to serve a feed, rather than just being advertised as one
         };
 
         class FeedDiscovery
@@ -47,8 +54,27 @@ namespace ZapFR
             virtual ~FeedDiscovery() = default;
 
             void discover();
+            // probes the unverified candidates concurrently, dropping the ones that turn out not to be feeds; feedVerified is called (from a worker thread,
+            // one call at a time) for every confirmed feed as soon as it's known, and candidates that are still being probed at the deadline, or when
+            // shouldAbort returns true, are kept unverified
+            void verify(const std::function<void(const DiscoveredFeed&)>& feedVerified = {}, const std::function<bool()>& shouldAbort = {});
             const std::vector<DiscoveredFeed>& discoveredFeeds() const noexcept { return mDiscoveredFeeds; }
 
+            // fetches, discovers and verifies the feeds at url on a background thread, so a UI doesn't have to wait for it; finished gets the candidates
+            // that couldn't be verified in time. Neither callback is called anymore once shouldAbort returns true, the thread then winds down on its own
+            static void discoverInBackground(const std::string& url, std::function<void(const DiscoveredFeed&)> feedVerified,
+                                             std::function<void(const std::vector<DiscoveredFeed>&)> finished, std::function<bool()> shouldAbort);
+            // waits for the background and probing threads to finish, e.g. before shutting down; they stop picking up new candidates in the meantime
+            static void joinAll();
+
+            // determines the feed type from the start of a document, which doesn't have to be complete
+            static std::optional<Feed::Type> sniffFeedType(const std::string& data);
+
+            static constexpr size_t MaxConcurrentProbes{4};
+            static constexpr uint64_t ProbeDeadline{8};       // seconds
+            static constexpr size_t ProbeSize{4096};          // bytes
+            static constexpr uint64_t AbortPollInterval{100}; // milliseconds
+
           private:
             Poco::URI mURI{""};
             std::string mData{""};
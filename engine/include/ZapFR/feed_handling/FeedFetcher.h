@@ -22,6 +22,8 @@
 #include <memory>
 #include <optional>
 
+#include "ZapFR/Helpers.h"
+
 namespace ZapFR
 {
     namespace Engine
@@ -34,14 +36,29 @@ namespace ZapFR
             FeedFetcher() = default;
             virtual ~FeedFetcher() = default;
 
-            std::optional<std::unique_ptr<FeedParser>> parseURL(const std::string& url, uint64_t associatedFeedID, std::optional<std::string> conditionalGETInfo);
+            // when knownBodyHash is given and the body turns out to match it, the body isn't parsed at all (see bodyUnchanged)
+            std::optional<std::unique_ptr<FeedParser>> parseURL(const std::string& url, uint64_t associatedFeedID, std::optional<std::string> conditionalGETInfo,
+                                                                std::optional<std::string> knownBodyHash = {});
             std::unique_ptr<FeedParser> parseString(const std::string& xml, const std::string& originalURL);
+            std::unique_ptr<FeedParser> parseStream(std::istream& stream, const std::string& originalURL);
 
             const std::string& conditionalGETInfo() const noexcept { return mConditionalGETInfo; }
+            const std::string& permanentRedirectURL() const noexcept { return mPermanentRedirectURL; }
+            const std::string& bodyHash() const noexcept { return mBodyHash; } // MD5 of the body the last parseURL received, empty if there was none
+            bool bodyUnchanged() const noexcept { return mBodyUnchanged; }     // whether that body matched knownBodyHash, and parsing it was skipped
+
+            // what the last parseURL cost; without a knownBodyHash parseURL parses the body straight off the connection, so its parse time (in
+            // microseconds) then includes receiving the body. parseString and parseStream aren't measured, their callers time them if they need to
+            const Helpers::HTTPTransferStats& transferStats() const noexcept { return mTransferStats; }
+            uint64_t parseTime() const noexcept { return mParseTime; }
 
           private:
-            std::string mData{""};
             std::string mConditionalGETInfo{""};
+            std::string mPermanentRedirectURL{""};
+            std::string mBodyHash{""};
+            bool mBodyUnchanged{false};
+            Helpers::HTTPTransferStats mTransferStats{};
+            uint64_t mParseTime{0};
         };
     } // namespace Engine
 } // namespace ZapFR
@@ -19,6 +19,9 @@
 #ifndef ZAPFR_ENGINE_FEEDPARSER_H
 #define ZAPFR_ENGINE_FEEDPARSER_H
 
+#include <bitset>
+#include <optional>
+
 #include <Poco/DOM/Document.h>
 #include <Poco/URI.h>
 
@@ -66,6 +69,29 @@ namespace ZapFR
 
             virtual std::vector<Item> items() const = 0;
 
+            // hands the items over to the storage layer; parsers that already hold their parsed items move them out rather than copying them
+            virtual std::vector<Item> takeItems() { return items(); }
+
+            // what the feed itself says about how often it should be polled
+            struct RefreshHints
+            {
+                std::optional<uint64_t> ttl{};          // <ttl>, in seconds
+                std::optional<uint64_t> updatePeriod{}; // sy:updatePeriod divided by sy:updateFrequency, in seconds
+                std::bitset<24> skipHours{};            // <skipHours>, in UTC
+                std::bitset<7> skipDays{};              // <skipDays>, 0 = Sunday
+            };
+
+            virtual RefreshHints refreshHints() const { return {}; }
+
+            // the WebSub hub the feed can be subscribed to for push updates, and the canonical (topic) URL to subscribe with
+            struct WebSubLinks
+            {
+                std::string hub{""};
+                std::string self{""};
+            };
+
+            virtual WebSubLinks webSubLinks() const { return {}; }
+
           protected:
             Poco::URI mURI{};
         };
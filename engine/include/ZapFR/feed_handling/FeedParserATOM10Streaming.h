@@ -0,0 +1,92 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_FEEDPARSERATOM10STREAMING_H
+#define ZAPFR_ENGINE_FEEDPARSERATOM10STREAMING_H
+
+#include "FeedParserXMLStreaming.h"
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        class FeedParserATOM10Streaming : public FeedParserXMLStreaming
+        {
+          public:
+            FeedParserATOM10Streaming(const std::string& url);
+            virtual ~FeedParserATOM10Streaming() = default;
+
+            Feed::Type type() const noexcept override { return Feed::Type::Atom; }
+
+          protected:
+            void elementStarted(size_t depth, const Element& element, const Poco::XML::Attributes& attributes) override;
+            void elementEnded(size_t depth, const Element& element) override;
+
+          private:
+            enum FeedField : size_t
+            {
+                FeedID,
+                FeedTitle,
+                FeedSubtitle,
+                FeedRights,
+                FeedLink,
+                FeedFieldCount,
+            };
+
+            enum EntryField : size_t
+            {
+                EntryTitle,
+                EntrySummary,
+                EntryContent,
+                EntryMediaGroup,
+                EntryMediaThumbnail,
+                EntryMediaDescription,
+                EntryAuthor,
+                EntryAuthorName,
+                EntryID,
+                EntryUpdated,
+                EntryPublished,
+                EntryFieldCount,
+            };
+
+            void entryElementStarted(size_t depth, const Element& element, const Poco::XML::Attributes& attributes);
+            void entryElementEnded(size_t depth);
+            void finishEntry();
+
+            std::bitset<FeedFieldCount> mFeedSeen{};
+
+            std::optional<size_t> mEntryDepth{};
+            std::bitset<EntryFieldCount> mEntrySeen{};
+            Item mItem{};
+            std::vector<Post::Enclosure> mEnclosureElements{};
+            std::string mSummary{""};
+            bool mContentHasSource{false};
+            std::string mContentType{""};
+            std::string mContent{""};
+            bool mInMediaGroup{false};
+            std::optional<std::string> mMediaThumbnailURL{};
+            std::string mMediaDescriptionType{""};
+            std::string mMediaDescription{""};
+            bool mInAuthor{false};
+            std::string mUpdated{""};
+            std::string mPublished{""};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_FEEDPARSERATOM10STREAMING_H
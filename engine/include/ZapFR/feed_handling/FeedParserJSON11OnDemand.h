@@ -0,0 +1,72 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_FEEDPARSERJSON11ONDEMAND_H
+#define ZAPFR_ENGINE_FEEDPARSERJSON11ONDEMAND_H
+
+#include <memory>
+#include <string_view>
+
+#include "FeedParser.h"
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // parses a JSON Feed (1.0 or 1.1) in a single pass with a cursor over the raw text, extracting the fields it knows about straight
+        // into the items instead of building a Poco::JSON object tree first; everything else is skipped without being decoded
+        class FeedParserJSON11OnDemand : public FeedParser
+        {
+          public:
+            FeedParserJSON11OnDemand(const std::string& url);
+            virtual ~FeedParserJSON11OnDemand() = default;
+            FeedParserJSON11OnDemand(const FeedParserJSON11OnDemand& e) = delete;
+            FeedParserJSON11OnDemand& operator=(const FeedParserJSON11OnDemand&) = delete;
+            FeedParserJSON11OnDemand(FeedParserJSON11OnDemand&&) = delete;
+            FeedParserJSON11OnDemand& operator=(FeedParserJSON11OnDemand&&) = delete;
+
+            Feed::Type type() const noexcept override { return Feed::Type::JSON; }
+
+            std::string guid() const override { return mGuid; }
+            std::string title() const override { return mTitle; }
+            std::string subtitle() const override { return ""; }
+            std::string link() const override { return mLink; }
+            std::string description() const override { return mDescription; }
+            std::string language() const override { return mLanguage; }
+            std::string copyright() const override { return ""; }
+            std::string iconURL() const override { return mIconURL; }
+
+            std::vector<Item> items() const override { return mItems; }
+            std::vector<Item> takeItems() override { return std::move(mItems); }
+
+            // returns nullptr when the version isn't one of the JSON Feed versions, throws when the JSON is malformed
+            static std::unique_ptr<FeedParser> parse(std::string_view json, const std::string& url);
+
+          private:
+            std::string mGuid{""};
+            std::string mTitle{""};
+            std::string mLink{""};
+            std::string mDescription{""};
+            std::string mLanguage{""};
+            std::string mIconURL{""};
+            std::vector<Item> mItems{};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_FEEDPARSERJSON11ONDEMAND_H
@@ -0,0 +1,80 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_FEEDPARSERRSS10STREAMING_H
+#define ZAPFR_ENGINE_FEEDPARSERRSS10STREAMING_H
+
+#include "FeedParserXMLStreaming.h"
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        class FeedParserRSS10Streaming : public FeedParserXMLStreaming
+        {
+          public:
+            FeedParserRSS10Streaming(const std::string& url);
+            virtual ~FeedParserRSS10Streaming() = default;
+
+            Feed::Type type() const noexcept override { return Feed::Type::RSS; }
+
+          protected:
+            void elementStarted(size_t depth, const Element& element, const Poco::XML::Attributes& attributes) override;
+            void elementEnded(size_t depth, const Element& element) override;
+            void documentEnded() override;
+
+          private:
+            enum ChannelField : size_t
+            {
+                Channel,
+                ChannelTitle,
+                ChannelLink,
+                ChannelDescription,
+                ChannelUpdatePeriod,
+                ChannelUpdateFrequency,
+                Image,
+                ChannelFieldCount,
+            };
+
+            enum ItemField : size_t
+            {
+                ItemTitle,
+                ItemLink,
+                ItemDescription,
+                ItemContentEncoded,
+                ItemCreator,
+                ItemDate,
+                ItemFieldCount,
+            };
+
+            void finishItem();
+
+            std::bitset<ChannelFieldCount> mChannelSeen{};
+            bool mInChannel{false};
+            std::string mUpdatePeriod{""};
+            std::string mUpdateFrequency{""};
+
+            std::optional<size_t> mItemDepth{};
+            std::bitset<ItemFieldCount> mItemSeen{};
+            Item mItem{};
+            std::string mContentEncoded{""};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_FEEDPARSERRSS10STREAMING_H
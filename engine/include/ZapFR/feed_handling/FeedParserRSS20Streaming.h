@@ -0,0 +1,100 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_FEEDPARSERRSS20STREAMING_H
+#define ZAPFR_ENGINE_FEEDPARSERRSS20STREAMING_H
+
+#include "FeedParserXMLStreaming.h"
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        class FeedParserRSS20Streaming : public FeedParserXMLStreaming
+        {
+          public:
+            FeedParserRSS20Streaming(const std::string& url);
+            virtual ~FeedParserRSS20Streaming() = default;
+
+            Feed::Type type() const noexcept override { return Feed::Type::RSS; }
+
+          protected:
+            void elementStarted(size_t depth, const Element& element, const Poco::XML::Attributes& attributes) override;
+            void elementEnded(size_t depth, const Element& element) override;
+            void documentEnded() override;
+
+          private:
+            enum ChannelField : size_t
+            {
+                Channel,
+                ChannelTitle,
+                ChannelLink,
+                ChannelDescription,
+                ChannelLanguage,
+                ChannelCopyright,
+                ChannelImage,
+                ChannelImageURL,
+                ChannelTTL,
+                ChannelUpdatePeriod,
+                ChannelUpdateFrequency,
+                ChannelSkipHours,
+                ChannelSkipDays,
+                ChannelFieldCount,
+            };
+
+            enum ItemField : size_t
+            {
+                ItemTitle,
+                ItemLink,
+                ItemAuthor,
+                ItemDescription,
+                ItemContentEncoded,
+                ItemMagnetURI,
+                ItemContentLength,
+                ItemComments,
+                ItemGUID,
+                ItemPubDate,
+                ItemFieldCount,
+            };
+
+            void itemElementStarted(size_t depth, const Element& element, const Poco::XML::Attributes& attributes);
+            void itemElementEnded(const Element& element);
+            void finishItem();
+
+            std::bitset<ChannelFieldCount> mChannelSeen{};
+            bool mInChannel{false};
+            bool mInImage{false};
+            bool mInSkipHours{false};
+            bool mInSkipDays{false};
+            std::string mTTL{""};
+            std::string mUpdatePeriod{""};
+            std::string mUpdateFrequency{""};
+
+            std::optional<size_t> mItemDepth{};
+            std::bitset<ItemFieldCount> mItemSeen{};
+            Item mItem{};
+            std::string mContentEncoded{""};
+            std::string mMagnetURI{""};
+            std::string mContentLength{""};
+
+            std::string mText{""}; // for the repeated elements (hour, day, category)
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_FEEDPARSERRSS20STREAMING_H
@@ -0,0 +1,147 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_FEEDPARSERXMLSTREAMING_H
+#define ZAPFR_ENGINE_FEEDPARSERXMLSTREAMING_H
+
+#include <bitset>
+#include <memory>
+#include <sstream>
+#include <string_view>
+
+#include <Poco/SAX/Attributes.h>
+#include <Poco/XML/XMLWriter.h>
+
+#include "FeedParser.h"
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // parses an XML feed in a single pass straight off the SAX events, without building a DOM; items are extracted as their element closes,
+        // so besides the result only the item currently being parsed is kept in memory
+        class FeedParserXMLStreaming : public FeedParser
+        {
+          public:
+            FeedParserXMLStreaming(const std::string& url);
+            virtual ~FeedParserXMLStreaming() = default;
+            FeedParserXMLStreaming(const FeedParserXMLStreaming& e) = delete;
+            FeedParserXMLStreaming& operator=(const FeedParserXMLStreaming&) = delete;
+            FeedParserXMLStreaming(FeedParserXMLStreaming&&) = delete;
+            FeedParserXMLStreaming& operator=(FeedParserXMLStreaming&&) = delete;
+
+            std::string guid() const override { return mGuid; }
+            std::string title() const override { return mTitle; }
+            std::string subtitle() const override { return mSubtitle; }
+            std::string link() const override { return mLink; }
+            std::string description() const override { return mDescription; }
+            std::string language() const override { return mLanguage; }
+            std::string copyright() const override { return mCopyright; }
+            std::string iconURL() const override { return mIconURL; }
+
+            std::vector<Item> items() const override { return mItems; }
+            std::vector<Item> takeItems() override { return std::move(mItems); }
+            RefreshHints refreshHints() const override { return mRefreshHints; }
+            WebSubLinks webSubLinks() const override { return mWebSubLinks; }
+
+            // the root element determines the feed format; returns nullptr for an rss document that isn't version 2.0, throws for other documents
+            static std::unique_ptr<FeedParser> parse(std::istream& stream, const std::string& url);
+            static std::unique_ptr<FeedParser> parse(const std::string& data, const std::string& url);
+
+          protected:
+            // the names point into the SAX parser's buffers, so they're only valid during the call
+            struct Element
+            {
+                std::string_view namespaceURI{};
+                std::string_view localName{};
+                std::string_view qname{};
+
+                bool is(std::string_view ns, std::string_view name) const { return localName == name && namespaceURI == ns; }
+            };
+
+            // depth is 0 for the root element
+            virtual void elementStarted(size_t depth, const Element& element, const Poco::XML::Attributes& attributes) = 0;
+            virtual void elementEnded(size_t depth, const Element& element) = 0;
+            virtual void documentEnded() {}
+
+            // collects the text of the element that was just started (including that of its descendants) into target, until the element closes;
+            // the inner XML variant serializes child elements instead of flattening them, mirroring FeedParserXML::fetchNodeValueInnerXML
+            void captureText(std::string& target);
+            void captureInnerXML(std::string& target);
+
+            // the DOM parsers only look at the first matching child, so the streaming ones keep track of which fields they've already seen
+            template <size_t N> static bool firstOccurrence(std::bitset<N>& seen, size_t field)
+            {
+                if (seen.test(field))
+                {
+                    return false;
+                }
+                seen.set(field);
+                return true;
+            }
+
+            static std::optional<std::string> attribute(const Poco::XML::Attributes& attributes, const std::string& qname);
+            static std::optional<std::string> attribute(const Poco::XML::Attributes& attributes, const std::string& namespaceURI, const std::string& localName);
+            static std::string hashedGUID(const Item& item);
+            static std::optional<uint64_t> syndicationUpdatePeriod(const std::string& updatePeriod, const std::string& updateFrequency);
+            static void addWebSubLink(WebSubLinks& links, const Poco::XML::Attributes& attributes);
+
+            std::string mGuid{""};
+            std::string mTitle{""};
+            std::string mSubtitle{""};
+            std::string mLink{""};
+            std::string mDescription{""};
+            std::string mLanguage{""};
+            std::string mCopyright{""};
+            std::string mIconURL{""};
+            std::vector<Item> mItems{};
+            RefreshHints mRefreshHints{};
+            WebSubLinks mWebSubLinks{};
+
+            static constexpr std::string_view NamespaceAtom{"http://www.w3.org/2005/Atom"};
+            static constexpr std::string_view NamespaceContent{"http://purl.org/rss/1.0/modules/content/"};
+            static constexpr std::string_view NamespaceSyndication{"http://purl.org/rss/1.0/modules/syndication/"};
+
+          private:
+            class SAXHandler;
+
+            struct Capture
+            {
+                size_t depth{0};
+                std::string* target{nullptr};
+                bool innerXML{false};
+                std::unique_ptr<std::stringstream> childStream{nullptr};
+                std::unique_ptr<Poco::XML::XMLWriter> childWriter{nullptr}; // only while inside a child element of an inner XML capture
+            };
+
+            void startElement(const std::string& namespaceURI, const std::string& localName, const std::string& qname, const Poco::XML::Attributes& attributes);
+            void endElement(const std::string& namespaceURI, const std::string& localName, const std::string& qname);
+            void characters(const Poco::XML::XMLChar ch[], int start, int length);
+            void processingInstruction(const std::string& target, const std::string& data);
+            void startCDATA();
+            void endCDATA();
+            void comment(const Poco::XML::XMLChar ch[], int start, int length);
+            void capture(std::string& target, bool innerXML);
+
+            size_t mDepth{0};
+            std::vector<Capture> mCaptures{};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_FEEDPARSERXMLSTREAMING_H
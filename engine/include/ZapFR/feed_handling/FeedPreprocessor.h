@@ -0,0 +1,106 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_ENGINE_FEEDPREPROCESSOR_H
+#define ZAPFR_ENGINE_FEEDPREPROCESSOR_H
+
+#include <cstdint>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // Cleans up a feed body before it reaches a parser: skips byte order marks and leading whitespace when sniffing the format,
+        // repairs documents that claim to be UTF-8 but aren't (invalid bytes are read as Windows-1252, the usual culprit) and rewrites
+        // HTML named entities, which XML doesn't define, into numeric character references.
+        // The byte scanning runs on AVX2, SSE2 or NEON when available (picked at runtime), with a word-at-a-time scalar fallback.
+        class FeedPreprocessor
+        {
+          public:
+            enum class Format
+            {
+                Unknown,
+                XML,
+                JSON,
+            };
+
+            // the offset of the first byte that isn't part of a UTF-8 byte order mark or leading whitespace
+            static size_t significantOffset(std::string_view data);
+            static Format sniff(std::string_view data);
+            // consumes a UTF-8 byte order mark and leading whitespace from the stream, then peeks at the next byte
+            static Format sniff(std::istream& stream);
+
+            // the whole pipeline for an in-memory XML body; the result starts at the significant offset
+            static std::string prepare(std::string_view xml);
+
+            static bool isValidUTF8(std::string_view data);
+            // byte-by-byte reference implementation, kept for the tests and benchmarks
+            static bool isValidUTF8Scalar(std::string_view data);
+            // the name of the instruction set the scanning routines were dispatched to
+            static std::string_view instructionSet();
+
+            // Incremental form of prepare(): process() handles as much of the input as it can without knowing what comes next, appends
+            // the result to `out` and returns the number of bytes consumed. The caller keeps the rest and hands it back together with
+            // the next chunk. When `final` is set, everything gets consumed.
+            class Filter
+            {
+              public:
+                size_t process(std::string_view in, bool final, std::string& out);
+
+              private:
+                enum class Mode
+                {
+                    Prolog,
+                    Text,
+                    CDATA,
+                    Comment,
+                    Verbatim,
+                };
+
+                Mode mMode{Mode::Prolog};
+                bool mRepairUTF8{true};
+
+                void emit(std::string_view span, std::string& out) const;
+            };
+
+            // runs a stream through a Filter, so a body can be cleaned up while it's being parsed straight off the connection
+            class StreamBuffer : public std::streambuf
+            {
+              public:
+                explicit StreamBuffer(std::istream& source, size_t chunkSize = 16384);
+
+              protected:
+                int_type underflow() override;
+
+              private:
+                std::istream& mSource;
+                size_t mChunkSize{0};
+                Filter mFilter{};
+                std::string mPending{};
+                std::string mOutput{};
+                bool mSourceExhausted{false};
+            };
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_ENGINE_FEEDPREPROCESSOR_H
@@ -19,29 +19,43 @@
 #ifndef ZAPFR_ENGINE_FEEDLOCAL_H
 #define ZAPFR_ENGINE_FEEDLOCAL_H
 
+#include <atomic>
+
 #include <Poco/Data/AbstractBinding.h>
 #include <Poco/File.h>
 
+#include "ZapFR/Helpers.h"
 #include "ZapFR/base/Feed.h"
+#include "ZapFR/feed_handling/FeedParser.h"
 
 namespace ZapFR
 {
     namespace Engine
     {
-        class FeedParser;
-
         class FeedLocal : public Feed
         {
           public:
             FeedLocal(uint64_t id, Source* parentSource);
             virtual ~FeedLocal() = default;
 
+            // the result of the network stage of a refresh, to be handed to the ingest stage; the body is parsed in the network stage, so only the parsed feed is passed on
+            struct FetchedData
+            {
+                std::unique_ptr<FeedParser> parsedFeed{nullptr};
+                std::string conditionalGETInfo{""};
+                std::string bodyHash{""};
+                std::string body{""}; // only for content pushed by a WebSub hub, which arrives in full and is parsed by the ingest stage
+                bool pushed{false};   // delivered by a WebSub hub rather than fetched, so it may only hold the latest items
+                Telemetry telemetry{};
+            };
+
             std::tuple<uint64_t, std::vector<std::unique_ptr<Post>>> getPosts(uint64_t perPage, uint64_t page, bool showOnlyUnread, bool showUnreadPostsAtTop,
                                                                               const std::string& searchFilter, uint64_t categoryFilterID, FlagColor flagColor) override;
             std::optional<std::unique_ptr<Post>> getPost(uint64_t postID) override;
 
             std::tuple<uint64_t, std::vector<std::unique_ptr<Log>>> getLogs(uint64_t perPage, uint64_t page) override;
             void clearLogs() override;
+            std::vector<Telemetry> getTelemetry() override;
 
             std::vector<std::unique_ptr<ZapFR::Engine::Category>> getCategories() override;
 
@@ -49,14 +63,40 @@ namespace ZapFR
             void fetchStatistics();
             void fetchThumbnailData();
             void refresh() override;
+            std::optional<FetchedData> fetch();
+            void ingest(FetchedData data);
             void markAsRead(uint64_t maxPostID) override;
             void refreshIcon();
             void removeIcon();
 
-            void processItems(FeedParser* parsedFeed);
+            // returns the number of new and actually changed items
+            std::tuple<uint64_t, uint64_t> processItems(FeedParser* parsedFeed);
             void fetchUnreadCount();
 
             static void setIconDir(const std::string& iconDir);
+            static std::optional<std::string> readIconData(uint64_t feedID, const std::string& iconHash);
+            static std::unordered_map<std::string, std::string> iconDataForHashes(const std::unordered_set<std::string>& iconHashes);
+
+            // what the auto refresh scheduler needs to know about a feed, without the overhead of loading the entire feed
+            struct ScheduleInfo
+            {
+                uint64_t sourceID{0};
+                uint64_t feedID{0};
+                std::string url{""};
+                std::string lastChecked{""};
+                std::optional<uint64_t> refreshInterval{};
+                std::optional<uint64_t> adaptiveRefreshInterval{};
+                std::optional<uint64_t> nextRefresh{};
+            };
+            static std::vector<ScheduleInfo> querySchedule(Source* parentSource);
+
+            // refreshes that received the exact same body as last time, and skipped parsing and ingesting it
+            static uint64_t unchangedBodyCount() noexcept { return msUnchangedBodyCount; }
+            static uint64_t unchangedBodyBytes() noexcept { return msUnchangedBodyBytes; }
+            static void persistNextRefresh(uint64_t feedID, uint64_t nextRefreshEpoch);
+
+            // how many refreshes worth of telemetry are kept per feed
+            static constexpr uint64_t TelemetryHistorySize{50};
 
             static std::vector<std::unique_ptr<Feed>> queryMultiple(Source* parentSource, const std::vector<std::string>& whereClause, const std::string& orderClause,
                                                                     const std::string& limitClause, const std::vector<Poco::Data::AbstractBinding::Ptr>& bindings,
@@ -77,10 +117,28 @@ namespace ZapFR
           private:
             static std::string msIconDir;
             static std::mutex msCreateFeedMutex;
+            static std::atomic<uint64_t> msUnchangedBodyCount;
+            static std::atomic<uint64_t> msUnchangedBodyBytes;
             static Poco::File iconFile(uint64_t feedID);
 
             std::optional<std::unique_ptr<Post>> getPostByGuid(const std::string& guid);
+            void prepareRefresh();
+            void ingestParsedFeed(FeedParser* parsedFeed, const std::string& conditionalGETInfo);
+            void updateAdaptiveRefreshInterval(FeedParser* parsedFeed, const std::string& conditionalGETInfo);
+            void updateNextRefresh();
             void updateAndLogLastRefreshError(const std::string& error);
+            void recordRefreshSuccess();
+            void recordTelemetry(Telemetry::Result result);
+            void setTransferTelemetry(const Helpers::HTTPTransferStats& stats);
+            void confirmPermanentRedirect(const std::string& location);
+            void updateWebSubSubscription(FeedParser* parsedFeed);
+            bool isIconStale() const;
+
+            uint64_t mConsecutiveFailures{0};
+            std::string mPendingRedirectURL{""};
+            uint64_t mPendingRedirectCount{0};
+            std::string mBodyHash{""};
+            Telemetry mTelemetry{};
         };
     } // namespace Engine
 } // namespace ZapFR
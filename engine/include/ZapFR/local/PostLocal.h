@@ -58,9 +58,10 @@ namespace ZapFR
 
             static uint64_t highestID();
 
-            static std::unique_ptr<Post> create(uint64_t feedID, const std::string& feedTitle, const std::string& title, const std::string& link, const std::string& content,
-                                                const std::string& author, const std::string& commentsURL, const std::string& guid, const std::string& datePublished,
-                                                const std::string& thumbnail, const std::vector<Enclosure>& enclosures, const std::vector<std::string>& categories);
+            // the post fields are taken by value, so a freshly parsed item can be moved into the post instead of being copied
+            static std::unique_ptr<Post> create(uint64_t feedID, const std::string& feedTitle, std::string title, std::string link, std::string content, std::string author,
+                                                std::string commentsURL, std::string guid, std::string datePublished, std::string thumbnail,
+                                                const std::vector<Enclosure>& enclosures, const std::vector<std::string>& categories);
 
           private:
             static std::mutex msCreatePostMutex;
@@ -43,6 +43,7 @@ namespace ZapFR
             std::optional<std::unique_ptr<Feed>> addFeed(const std::string& url, uint64_t folder) override;
             std::unordered_map<uint64_t, uint64_t> moveFeed(uint64_t feedID, uint64_t newFolder, uint64_t newSortOrder) override;
             void removeFeed(uint64_t feedID) override;
+            std::unordered_map<std::string, std::string> getIcons(const std::unordered_set<std::string>& iconHashes) override;
 
             // folder stuff
             std::vector<std::unique_ptr<Folder>> getFolders(uint64_t parent, uint32_t fetchInfo) override;
@@ -61,7 +62,15 @@ namespace ZapFR
                                     const std::vector<std::tuple<uint64_t, uint64_t>>& feedsAndPostIDs) override;
             void assignPostsToScriptFolder(uint64_t scriptFolderID, bool assign, const std::vector<std::tuple<uint64_t, uint64_t>>& feedsAndPostIDs) override;
             std::unordered_map<uint64_t, uint64_t> getUnreadCounts();
-            std::unordered_map<uint64_t, std::string> getFeedErrors();
+
+            struct FeedError
+            {
+                std::string error{""};
+                uint64_t consecutiveFailures{0};
+                bool suspended{false};  // the circuit breaker tripped, the feed is only probed occasionally until it recovers
+                uint64_t nextAttempt{0}; // epoch
+            };
+            std::unordered_map<uint64_t, FeedError> getFeedErrors();
             Poco::JSON::Object getStatus() override;
 
             // log stuff
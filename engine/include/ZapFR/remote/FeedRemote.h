@@ -37,6 +37,7 @@ namespace ZapFR
 
             std::tuple<uint64_t, std::vector<std::unique_ptr<Log>>> getLogs(uint64_t perPage, uint64_t page) override;
             void clearLogs() override;
+            std::vector<Telemetry> getTelemetry() override;
 
             std::vector<std::unique_ptr<ZapFR::Engine::Category>> getCategories() override;
 
@@ -0,0 +1,85 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "ZapFR/AdaptiveRefresh.h"
+
+uint64_t ZapFR::Engine::AdaptiveRefresh::calculateInterval(const Input& input, const Poco::DateTime& now)
+{
+    auto interval = input.defaultInterval;
+
+    // learn the posting frequency from the gaps between the most recent posts, and poll about twice per gap
+    auto postDates = input.postDates;
+    std::sort(postDates.begin(), postDates.end(), std::greater<Poco::Timestamp>());
+    if (postDates.size() > PostHistorySize)
+    {
+        postDates.resize(PostHistorySize);
+    }
+    if (postDates.size() >= MinPostsForEstimate)
+    {
+        std::vector<int64_t> gaps;
+        for (size_t i = 1; i < postDates.size(); ++i)
+        {
+            gaps.emplace_back((postDates.at(i - 1) - postDates.at(i)) / Poco::Timestamp::resolution());
+        }
+        std::nth_element(gaps.begin(), gaps.begin() + static_cast<int64_t>(gaps.size() / 2), gaps.end());
+        auto medianGap = static_cast<uint64_t>(std::max(gaps.at(gaps.size() / 2), static_cast<int64_t>(0)));
+        interval = medianGap / 2;
+
+        // back off when the feed has gone quiet for much longer than it usually does
+        auto sinceLastPost = (now.timestamp() - postDates.front()) / Poco::Timestamp::resolution();
+        if (sinceLastPost > 0 && static_cast<uint64_t>(sinceLastPost) > medianGap * 4)
+        {
+            interval = std::max(interval, static_cast<uint64_t>(sinceLastPost) / 4);
+        }
+    }
+
+    // polling before the server, the feed's ttl or its advertised update period say there's something new is pointless
+    if (input.freshnessLifetime.has_value())
+    {
+        interval = std::max(interval, input.freshnessLifetime.value());
+    }
+    if (input.hints.ttl.has_value())
+    {
+        interval = std::max(interval, input.hints.ttl.value());
+    }
+    if (input.hints.updatePeriod.has_value())
+    {
+        interval = std::max(interval, input.hints.updatePeriod.value());
+    }
+    interval = std::clamp(interval, MinInterval, MaxInterval);
+
+    // push the next check out of the hours and days the feed asks to be skipped
+    if (input.hints.skipHours.any() || input.hints.skipDays.any())
+    {
+        auto nextCheck = now + Poco::Timespan(static_cast<int64_t>(interval), 0);
+        for (auto i = 0; i < 7 * 24; ++i)
+        {
+            auto skipped = input.hints.skipHours.test(static_cast<size_t>(nextCheck.hour())) || input.hints.skipDays.test(static_cast<size_t>(nextCheck.dayOfWeek()));
+            if (!skipped)
+            {
+                break;
+            }
+            nextCheck = Poco::DateTime(nextCheck.year(), nextCheck.month(), nextCheck.day(), nextCheck.hour()) + Poco::Timespan(0, 1, 0, 0, 0);
+        }
+        interval = static_cast<uint64_t>((nextCheck - now).totalSeconds());
+    }
+
+    return interval;
+}
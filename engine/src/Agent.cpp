@@ -16,6 +16,8 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+
 #include "ZapFR/Agent.h"
 #include "ZapFR/agents/AgentMonitorFeedRefreshCompletion.h"
 #include "ZapFR/agents/AgentMonitorSourceReloadCompletion.h"
@@ -25,10 +27,13 @@
 #include "ZapFR/agents/feed/AgentFeedGetCategories.h"
 #include "ZapFR/agents/feed/AgentFeedGetLogs.h"
 #include "ZapFR/agents/feed/AgentFeedGetPosts.h"
+#include "ZapFR/agents/feed/AgentFeedGetTelemetry.h"
 #include "ZapFR/agents/feed/AgentFeedGetUnreadCount.h"
+#include "ZapFR/agents/feed/AgentFeedIngest.h"
 #include "ZapFR/agents/feed/AgentFeedMarkRead.h"
 #include "ZapFR/agents/feed/AgentFeedMove.h"
 #include "ZapFR/agents/feed/AgentFeedRefresh.h"
+#include "ZapFR/agents/feed/AgentFeedRefreshIcon.h"
 #include "ZapFR/agents/feed/AgentFeedRemove.h"
 #include "ZapFR/agents/feed/AgentFeedUpdate.h"
 #include "ZapFR/agents/folder/AgentFolderAdd.h"
@@ -82,6 +87,7 @@ std::mutex ZapFR::Engine::Agent::msMutex{};
 ZapFR::Engine::Agent::Agent()
 {
     mThreadPool = std::make_unique<Poco::ThreadPool>();
+    mNetworkThreadPool = std::make_unique<Poco::ThreadPool>(2, static_cast<int>(DefaultNetworkAgentConcurrency));
     mQueueTimer = std::make_unique<Poco::Timer>(0, 50);
     auto callback = Poco::TimerCallback<Agent>(*this, &Agent::onQueueTimer);
     mQueueTimer->start(callback);
@@ -104,22 +110,54 @@ void ZapFR::Engine::Agent::joinAll() const
     }
 
     mThreadPool->joinAll();
+    mNetworkThreadPool->joinAll();
 }
 
 void ZapFR::Engine::Agent::onQueueTimer(Poco::Timer& /*timer*/)
 {
-    if (mQueue.size() == 0)
+    std::lock_guard<std::mutex> lock(msMutex);
+    if (mQueue.empty() && mNetworkQueue.empty() && mBackgroundQueue.empty() && mDeferredQueue.empty())
     {
         return;
     }
 
-    std::lock_guard<std::mutex> lock(msMutex);
-    if (mThreadPool->available() > 0 && mQueue.size() > 0)
+    // deferred agents (e.g. refreshes of a host that's being throttled) join the back of their queue once their time has come
+    auto now = std::chrono::steady_clock::now();
+    while (!mDeferredQueue.empty() && mDeferredQueue.begin()->first <= now)
     {
-        auto task = std::move(mQueue.front());
-        mQueue.pop_front();
-        mThreadPool->start(*task);
-        mRunningAgents.push_back(std::move(task));
+        auto task = std::move(mDeferredQueue.begin()->second);
+        mDeferredQueue.erase(mDeferredQueue.begin());
+        queueFor(*task).push_back(std::move(task));
+    }
+
+    // start as many queued agents as there are free threads
+    const auto startQueued = [&](std::deque<std::unique_ptr<AgentRunnable>>& queue, Poco::ThreadPool* pool)
+    {
+        while (!queue.empty() && pool->available() > 0)
+        {
+            auto task = std::move(queue.front());
+            queue.pop_front();
+            pool->start(*task);
+            mRunningAgents.push_back(std::move(task));
+        }
+    };
+    startQueued(mQueue, mThreadPool.get());
+    startQueued(mNetworkQueue, mNetworkThreadPool.get());
+
+    // background agents get whatever network threads are left over once no refresh that's ready to go is waiting for one (deferred refreshes don't hold
+    // them up), but only a few at a time so they don't crowd out the refreshes
+    if (!mBackgroundQueue.empty() && mNetworkQueue.empty())
+    {
+        auto runningBackgroundAgents = static_cast<uint64_t>(
+            std::count_if(mRunningAgents.begin(), mRunningAgents.end(), [](const auto& agent) { return agent->isLowPriority() && !agent->isDone(); }));
+        while (!mBackgroundQueue.empty() && runningBackgroundAgents < MaxRunningBackgroundAgents && mNetworkThreadPool->available() > 0)
+        {
+            auto task = std::move(mBackgroundQueue.front());
+            mBackgroundQueue.pop_front();
+            mNetworkThreadPool->start(*task);
+            mRunningAgents.push_back(std::move(task));
+            runningBackgroundAgents++;
+        }
     }
 
     // clear out the finished agents from the running agents vector
@@ -129,17 +167,47 @@ void ZapFR::Engine::Agent::onQueueTimer(Poco::Timer& /*timer*/)
 void ZapFR::Engine::Agent::enqueue(std::unique_ptr<AgentRunnable> agent)
 {
     std::lock_guard<std::mutex> lock(msMutex);
-    if (mThreadPool->available() > 0)
+    if (!agent->isReadyToStart())
     {
-        mThreadPool->start(*agent);
-        mRunningAgents.push_back(std::move(agent));
+        auto notBefore = agent->notBefore();
+        mDeferredQueue.emplace(notBefore, std::move(agent));
     }
     else
     {
-        mQueue.push_back(std::move(agent));
+        auto pool = (agent->isNetworkBound() ? mNetworkThreadPool.get() : mThreadPool.get());
+        auto& queue = queueFor(*agent);
+        if (pool->available() > 0 && queue.empty() && !agent->isLowPriority())
+        {
+            pool->start(*agent);
+            mRunningAgents.push_back(std::move(agent));
+            return;
+        }
+        queue.push_back(std::move(agent));
+    }
+
+    auto depth = queuedAgentCount();
+    if (depth > mPeakQueueDepth)
+    {
+        mPeakQueueDepth = depth;
     }
 }
 
+std::deque<std::unique_ptr<ZapFR::Engine::AgentRunnable>>& ZapFR::Engine::Agent::queueFor(const AgentRunnable& agent)
+{
+    return (agent.isLowPriority() ? mBackgroundQueue : (agent.isNetworkBound() ? mNetworkQueue : mQueue));
+}
+
+uint64_t ZapFR::Engine::Agent::queuedAgentCount() const
+{
+    return static_cast<uint64_t>(mQueue.size() + mNetworkQueue.size() + mBackgroundQueue.size() + mDeferredQueue.size());
+}
+
+uint64_t ZapFR::Engine::Agent::queueDepth() const
+{
+    std::lock_guard<std::mutex> lock(msMutex);
+    return queuedAgentCount();
+}
+
 uint64_t ZapFR::Engine::Agent::totalCountOfType(AgentRunnable::Type t) const
 {
     uint64_t amount{0};
@@ -153,9 +221,20 @@ uint64_t ZapFR::Engine::Agent::totalCountOfType(AgentRunnable::Type t) const
         }
     }
 
-    for (const auto& queuedAgent : mQueue)
+    for (const auto& queue : {&mQueue, &mNetworkQueue, &mBackgroundQueue})
     {
-        if (queuedAgent->type() == t && !queuedAgent->isDone())
+        for (const auto& queuedAgent : *queue)
+        {
+            if (queuedAgent->type() == t && !queuedAgent->isDone())
+            {
+                amount++;
+            }
+        }
+    }
+
+    for (const auto& [notBefore, deferredAgent] : mDeferredQueue)
+    {
+        if (deferredAgent->type() == t && !deferredAgent->isDone())
         {
             amount++;
         }
@@ -172,9 +251,47 @@ void ZapFR::Engine::Agent::broadcastError(uint64_t sourceID, const std::string&
     }
 }
 
-void ZapFR::Engine::Agent::queueRefreshFeed(uint64_t sourceID, uint64_t feedID, std::function<void(uint64_t, Feed*)> finishedCallback)
+void ZapFR::Engine::Agent::queueRefreshFeed(uint64_t sourceID, uint64_t feedID, std::function<void(uint64_t, Feed*)> finishedCallback,
+                                            std::optional<std::chrono::steady_clock::time_point> notBefore)
+{
+    auto agent = std::make_unique<AgentFeedRefresh>(sourceID, feedID, finishedCallback);
+    if (notBefore.has_value())
+    {
+        agent->setNotBefore(notBefore.value());
+    }
+    enqueue(std::move(agent));
+}
+
+void ZapFR::Engine::Agent::queueIngestFeed(uint64_t sourceID, uint64_t feedID, FeedLocal::FetchedData&& fetchedData,
+                                           std::function<void(uint64_t, Feed*)> finishedCallback)
+{
+    enqueue(std::make_unique<AgentFeedIngest>(sourceID, feedID, std::move(fetchedData), finishedCallback));
+}
+
+void ZapFR::Engine::Agent::queueIngestPushedFeed(uint64_t sourceID, uint64_t feedID, std::string&& body)
 {
-    enqueue(std::make_unique<AgentFeedRefresh>(sourceID, feedID, finishedCallback));
+    FeedLocal::FetchedData fetchedData;
+    fetchedData.body = std::move(body);
+    fetchedData.pushed = true;
+    enqueue(std::make_unique<AgentFeedIngest>(sourceID, feedID, std::move(fetchedData), [](uint64_t, Feed*) {}));
+}
+
+void ZapFR::Engine::Agent::queueRefreshFeedIcon(uint64_t sourceID, uint64_t feedID)
+{
+    {
+        // there's no point in fetching the same icon twice, whether the other fetch is still queued or already running
+        std::lock_guard<std::mutex> lock(msMutex);
+        const auto isSameIcon = [&](const std::unique_ptr<AgentRunnable>& agent)
+        {
+            auto iconAgent = dynamic_cast<AgentFeedRefreshIcon*>(agent.get());
+            return (iconAgent != nullptr && iconAgent->feedID() == feedID && !iconAgent->isDone());
+        };
+        if (std::any_of(mBackgroundQueue.begin(), mBackgroundQueue.end(), isSameIcon) || std::any_of(mRunningAgents.begin(), mRunningAgents.end(), isSameIcon))
+        {
+            return;
+        }
+    }
+    enqueue(std::make_unique<AgentFeedRefreshIcon>(sourceID, feedID));
 }
 
 void ZapFR::Engine::Agent::queueRefreshFolder(uint64_t sourceID, uint64_t folderID, std::function<void(uint64_t, Feed*)> finishedCallback)
@@ -370,6 +487,12 @@ void ZapFR::Engine::Agent::queueGetFeedLogs(uint64_t sourceID, uint64_t feedID,
     enqueue(std::make_unique<AgentFeedGetLogs>(sourceID, feedID, perPage, page, finishedCallback));
 }
 
+void ZapFR::Engine::Agent::queueGetFeedTelemetry(uint64_t sourceID, uint64_t feedID,
+                                                 std::function<void(uint64_t, uint64_t, const std::vector<Feed::Telemetry>&)> finishedCallback)
+{
+    enqueue(std::make_unique<AgentFeedGetTelemetry>(sourceID, feedID, finishedCallback));
+}
+
 void ZapFR::Engine::Agent::queueMarkPostsFlagged(
     uint64_t sourceID, const std::vector<std::tuple<uint64_t, uint64_t>>& feedAndPostIDs, const std::unordered_set<FlagColor>& flagColors,
     std::function<void(uint64_t, const std::vector<std::tuple<uint64_t, uint64_t>>&, const std::unordered_set<FlagColor>&)> finishedCallback)
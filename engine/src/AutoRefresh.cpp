@@ -16,18 +16,49 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
-#include <Poco/DateTimeParser.h>
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <Poco/Timestamp.h>
+#include <Poco/URI.h>
 
 #include "ZapFR/Agent.h"
 #include "ZapFR/AutoRefresh.h"
+#include "ZapFR/DNSCache.h"
+#include "ZapFR/DateParser.h"
+#include "ZapFR/Log.h"
+#include "ZapFR/WebSub.h"
 #include "ZapFR/base/Feed.h"
 #include "ZapFR/base/Source.h"
+#include "ZapFR/local/FeedLocal.h"
+
+namespace
+{
+    uint64_t nowEpoch()
+    {
+        return static_cast<uint64_t>(Poco::Timestamp().epochTime());
+    }
+} // namespace
 
 ZapFR::Engine::AutoRefresh::AutoRefresh()
 {
-    mTimer = std::make_unique<Poco::Timer>(5000, 60000);
-    auto callback = Poco::TimerCallback<AutoRefresh>(*this, &AutoRefresh::onTimer);
-    mTimer->start(callback);
+    mThread = std::thread(&AutoRefresh::run, this);
+}
+
+ZapFR::Engine::AutoRefresh::~AutoRefresh()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShouldStop = true;
+    }
+    mWakeUp.notify_all();
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
 }
 
 ZapFR::Engine::AutoRefresh* ZapFR::Engine::AutoRefresh::getInstance()
@@ -36,56 +67,270 @@ ZapFR::Engine::AutoRefresh* ZapFR::Engine::AutoRefresh::getInstance()
     return &instance;
 }
 
-void ZapFR::Engine::AutoRefresh::onTimer([[maybe_unused]] Poco::Timer& timer)
+void ZapFR::Engine::AutoRefresh::setEnabled(bool b)
 {
-    if (mEnabled)
     {
-        std::vector<uint64_t> feedIDsToRefresh;
-        Poco::DateTime now;
+        std::lock_guard<std::mutex> lock(mMutex);
+        mEnabled = b;
+    }
+    mWakeUp.notify_all();
+}
 
-        auto sources = Source::getSources(ServerIdentifier::Local);
-        for (const auto& source : sources)
+void ZapFR::Engine::AutoRefresh::setFeedRefreshInterval(uint64_t seconds)
+{
+    if (mFeedRefreshIntervalInSeconds.exchange(seconds) != seconds)
+    {
+        invalidateSchedule();
+    }
+}
+
+void ZapFR::Engine::AutoRefresh::setAdaptive(bool b)
+{
+    if (mAdaptive.exchange(b) != b)
+    {
+        invalidateSchedule();
+    }
+}
+
+void ZapFR::Engine::AutoRefresh::setFeedRefreshedCallback(const std::function<void(uint64_t, Feed*)>& callback)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFeedRefreshedCallback = callback;
+}
+
+uint64_t ZapFR::Engine::AutoRefresh::effectiveInterval(std::optional<uint64_t> refreshInterval, std::optional<uint64_t> adaptiveRefreshInterval) const noexcept
+{
+    if (refreshInterval.has_value())
+    {
+        return refreshInterval.value();
+    }
+    else if (mAdaptive && adaptiveRefreshInterval.has_value())
+    {
+        return adaptiveRefreshInterval.value();
+    }
+    return mFeedRefreshIntervalInSeconds;
+}
+
+uint64_t ZapFR::Engine::AutoRefresh::nextDue(uint64_t feedID, uint64_t lastCheckedEpoch, std::optional<uint64_t> refreshInterval,
+                                             std::optional<uint64_t> adaptiveRefreshInterval, bool pushed) const noexcept
+{
+    auto interval = effectiveInterval(refreshInterval, adaptiveRefreshInterval);
+    if (pushed)
+    {
+        interval = std::max(interval, WebSub::getInstance()->safetyInterval());
+    }
+    return lastCheckedEpoch + interval + jitter(feedID, interval);
+}
+
+// a deterministic offset per feed, so feeds sharing the same interval don't all become due in the same second
+uint64_t ZapFR::Engine::AutoRefresh::jitter(uint64_t feedID, uint64_t interval) noexcept
+{
+    auto spread = interval / JitterDivisor;
+    if (spread == 0)
+    {
+        return 0;
+    }
+    auto hash = (feedID * 0x9E3779B97F4A7C15ull) >> 32; // Fibonacci hashing, so consecutive IDs end up far apart
+    return hash % spread;
+}
+
+void ZapFR::Engine::AutoRefresh::scheduleFeed(uint64_t sourceID, uint64_t feedID, uint64_t dueEpoch)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mScheduledFeeds[feedID] = {sourceID, dueEpoch};
+        mSchedule.push({dueEpoch, feedID});
+
+        // get rid of the stale entries once they outnumber the live ones
+        if (mSchedule.size() > 2 * mScheduledFeeds.size() + 1024)
         {
-            auto feeds = source->getFeeds(Source::FetchInfo::Data);
-            for (const auto& feed : feeds)
+            decltype(mSchedule) compacted;
+            for (const auto& [id, scheduledFeed] : mScheduledFeeds)
             {
-                Poco::DateTime feedLastChecked;
+                compacted.push({scheduledFeed.dueEpoch, id});
+            }
+            mSchedule = std::move(compacted);
+        }
+    }
+    mWakeUp.notify_all();
+}
 
-                try
-                {
-                    int tzDiff;
-                    feedLastChecked = Poco::DateTimeParser::parse(Poco::DateTimeFormat::ISO8601_FORMAT, feed->lastChecked(), tzDiff);
-                    feedLastChecked.makeUTC(tzDiff);
-                }
-                catch (...)
-                {
-                    continue;
-                }
+void ZapFR::Engine::AutoRefresh::unscheduleFeed(uint64_t feedID)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mScheduledFeeds.erase(feedID);
+}
 
-                Poco::Timespan interval;
-                if (feed->refreshInterval().has_value())
-                {
-                    interval.assign(static_cast<int64_t>(feed->refreshInterval().value()), 0);
-                }
-                else
-                {
-                    interval.assign(static_cast<int64_t>(mFeedRefreshIntervalInSeconds), 0);
-                }
+size_t ZapFR::Engine::AutoRefresh::scheduledFeedCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mScheduledFeeds.size();
+}
 
-                Poco::DateTime nextCheck = feedLastChecked + interval;
+void ZapFR::Engine::AutoRefresh::invalidateSchedule()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mScheduleGeneration++;
+        mScheduleLoaded = false;
+        mRecomputeSchedule = true;
+    }
+    mWakeUp.notify_all();
+}
+
+void ZapFR::Engine::AutoRefresh::run()
+{
+    // give the application some time to initialize (e.g. the database) before the schedule is loaded
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWakeUp.wait_for(lock, std::chrono::seconds(5), [&]() { return mShouldStop; });
+    }
+
+    static auto dummyCallback = [](uint64_t, Feed*) {};
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        if (mShouldStop)
+        {
+            break;
+        }
+
+        if (!mScheduleLoaded)
+        {
+            auto recompute = mRecomputeSchedule;
+            auto generation = mScheduleGeneration;
+            lock.unlock();
+            try
+            {
+                loadSchedule(recompute, generation);
+            }
+            catch (const std::exception& e)
+            {
+                Log::log(LogLevel::Error, fmt::format("Failed to load the auto refresh schedule: {}", e.what()));
+                lock.lock();
+                mWakeUp.wait_for(lock, std::chrono::seconds(60), [&]() { return mShouldStop; });
+            }
+            continue;
+        }
+
+        if (!mEnabled || mSchedule.empty())
+        {
+            mWakeUp.wait(lock);
+            continue;
+        }
+
+        auto now = nowEpoch();
+        std::vector<std::pair<uint64_t, uint64_t>> dueFeeds;
+        while (!mSchedule.empty() && mSchedule.top().dueEpoch <= now)
+        {
+            auto entry = mSchedule.top();
+            mSchedule.pop();
+
+            auto it = mScheduledFeeds.find(entry.feedID);
+            if (it == mScheduledFeeds.end() || it->second.dueEpoch != entry.dueEpoch)
+            {
+                continue; // rescheduled or removed in the meantime
+            }
+            dueFeeds.emplace_back(it->second.sourceID, entry.feedID);
+
+            // the refresh reschedules the feed once it's done, this keeps it in the schedule in case that never happens
+            it->second.dueEpoch = now + mFeedRefreshIntervalInSeconds;
+            mSchedule.push({it->second.dueEpoch, entry.feedID});
+        }
+
+        if (!dueFeeds.empty())
+        {
+            auto callback = mFeedRefreshedCallback.has_value() ? mFeedRefreshedCallback.value() : dummyCallback;
+            lock.unlock();
+            auto agent = ZapFR::Engine::Agent::getInstance();
+            for (const auto& [sourceID, feedID] : dueFeeds)
+            {
+                agent->queueRefreshFeed(sourceID, feedID, callback);
+            }
+            Log::log(LogLevel::Debug, fmt::format("Auto refresh queued {} feed(s), agent queue depth is now {}", dueFeeds.size(), agent->queueDepth()));
+            continue;
+        }
+
+        auto nextDue = std::chrono::system_clock::from_time_t(static_cast<time_t>(mSchedule.top().dueEpoch));
+        mWakeUp.wait_until(lock, nextDue);
+    }
+}
 
-                if (nextCheck < now)
+void ZapFR::Engine::AutoRefresh::loadSchedule(bool recompute, uint64_t generation)
+{
+    decltype(mSchedule) schedule;
+    decltype(mScheduledFeeds) scheduledFeeds;
+    std::unordered_set<std::string> hosts;
+    auto now = nowEpoch();
+    auto pushedFeeds = WebSub::getInstance()->activelySubscribedFeeds();
+    for (const auto& source : Source::getSources(ServerIdentifier::Local))
+    {
+        for (const auto& entry : FeedLocal::querySchedule(source.get()))
+        {
+            uint64_t dueEpoch{0};
+            if (entry.nextRefresh.has_value() && !recompute)
+            {
+                dueEpoch = entry.nextRefresh.value();
+            }
+            else
+            {
+                // feeds whose last check can't be made sense of aren't auto refreshed, until a manual refresh sets it straight
+                auto lastChecked = DateParser::parse(entry.lastChecked);
+                if (!lastChecked.has_value())
                 {
-                    feedIDsToRefresh.emplace_back(feed->id());
+                    continue;
                 }
+                dueEpoch = nextDue(entry.feedID, static_cast<uint64_t>(lastChecked.value()), entry.refreshInterval, entry.adaptiveRefreshInterval,
+                                   pushedFeeds.contains(entry.feedID));
+                FeedLocal::persistNextRefresh(entry.feedID, dueEpoch);
             }
+            scheduledFeeds[entry.feedID] = {entry.sourceID, dueEpoch};
 
-            static auto dummyCallback = [](uint64_t, Feed*) {};
-            auto agent = ZapFR::Engine::Agent::getInstance();
-            for (const auto& feedID : feedIDsToRefresh)
+            try
+            {
+                hosts.insert(Poco::URI(entry.url).getHost());
+            }
+            catch (...)
             {
-                agent->queueRefreshFeed(source->id(), feedID, mFeedRefreshedCallback.has_value() ? mFeedRefreshedCallback.value() : dummyCallback);
+                // an unparseable URL will fail on refresh anyway
             }
         }
     }
+
+    // rather than refreshing every overdue feed at once, spread them evenly over the smoothing window, the most overdue ones first
+    std::vector<std::pair<uint64_t, uint64_t>> overdueFeeds;
+    for (const auto& [feedID, scheduledFeed] : scheduledFeeds)
+    {
+        if (scheduledFeed.dueEpoch <= now)
+        {
+            overdueFeeds.emplace_back(scheduledFeed.dueEpoch, feedID);
+        }
+    }
+    auto smoothingWindow = mStartupSmoothingWindowInSeconds.load();
+    if (!overdueFeeds.empty() && smoothingWindow > 0)
+    {
+        std::sort(overdueFeeds.begin(), overdueFeeds.end());
+        for (size_t i = 0; i < overdueFeeds.size(); ++i)
+        {
+            scheduledFeeds[overdueFeeds.at(i).second].dueEpoch = now + (i * smoothingWindow) / overdueFeeds.size();
+        }
+    }
+
+    for (const auto& [feedID, scheduledFeed] : scheduledFeeds)
+    {
+        schedule.push({scheduledFeed.dueEpoch, feedID});
+    }
+
+    // warm up the DNS cache, so the first round of refreshes doesn't have to wait for the resolver
+    DNSCache::getInstance()->preResolve(std::vector<std::string>(hosts.begin(), hosts.end()));
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (generation != mScheduleGeneration)
+    {
+        return; // invalidated while loading, so the run loop loads it again with the new settings
+    }
+    mSchedule = std::move(schedule);
+    mScheduledFeeds = std::move(scheduledFeeds);
+    mScheduleLoaded = true;
+    mRecomputeSchedule = false;
 }
@@ -0,0 +1,276 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <Poco/Net/DNS.h>
+#include <Poco/Net/HostEntry.h>
+#include <Poco/String.h>
+
+#include "ZapFR/DNSCache.h"
+
+ZapFR::Engine::DNSCache::DNSCache()
+{
+    mThread = std::thread(&DNSCache::run, this);
+}
+
+ZapFR::Engine::DNSCache::~DNSCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShouldStop = true;
+    }
+    mWakeUp.notify_all();
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+ZapFR::Engine::DNSCache* ZapFR::Engine::DNSCache::getInstance()
+{
+    static DNSCache instance{};
+    return &instance;
+}
+
+Poco::Net::IPAddress ZapFR::Engine::DNSCache::resolve(const std::string& host)
+{
+    Poco::Net::IPAddress literalAddress;
+    if (Poco::Net::IPAddress::tryParse(host, literalAddress))
+    {
+        return literalAddress;
+    }
+
+    auto key = Poco::toLower(host);
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        auto now = Clock::now();
+        auto it = mEntries.find(key);
+        if (it != mEntries.end() && it->second.expires > now)
+        {
+            auto& entry = it->second;
+            if (!entry.address.has_value())
+            {
+                mNegativeHitCount++;
+                throw std::runtime_error(fmt::format("Unable to resolve host {}: {}", host, entry.error));
+            }
+
+            // a host that's still in use gets resolved again in the background before its entry expires
+            mHitCount++;
+            if (now >= entry.refreshAfter && !entry.refreshQueued)
+            {
+                entry.refreshQueued = true;
+                mPreResolveQueue.push_back(key);
+                mWakeUp.notify_all();
+            }
+            return entry.address.value();
+        }
+
+        // don't send the same query twice when another thread is already waiting for it
+        if (mResolving.contains(key))
+        {
+            mResolved.wait(lock);
+            continue;
+        }
+        break;
+    }
+
+    mMissCount++;
+    mResolving.insert(key);
+    lock.unlock();
+    auto entry = lookup(key);
+    lock.lock();
+    store(key, entry);
+    mResolving.erase(key);
+    lock.unlock();
+    mResolved.notify_all();
+
+    if (!entry.address.has_value())
+    {
+        throw std::runtime_error(fmt::format("Unable to resolve host {}: {}", host, entry.error));
+    }
+    return entry.address.value();
+}
+
+void ZapFR::Engine::DNSCache::preResolve(const std::vector<std::string>& hosts)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto now = Clock::now();
+        for (const auto& host : hosts)
+        {
+            Poco::Net::IPAddress literalAddress;
+            if (host.empty() || Poco::Net::IPAddress::tryParse(host, literalAddress))
+            {
+                continue;
+            }
+
+            auto key = Poco::toLower(host);
+            auto it = mEntries.find(key);
+            if (it != mEntries.end() && it->second.refreshAfter > now)
+            {
+                continue;
+            }
+            mPreResolveQueue.push_back(key);
+        }
+    }
+    mWakeUp.notify_all();
+}
+
+bool ZapFR::Engine::DNSCache::invalidate(const std::string& host)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.erase(Poco::toLower(host)) > 0;
+}
+
+void ZapFR::Engine::DNSCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mPreResolveQueue.clear();
+}
+
+void ZapFR::Engine::DNSCache::setTTL(uint64_t seconds)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTTLInSeconds = seconds;
+    mEntries.clear();
+}
+
+uint64_t ZapFR::Engine::DNSCache::ttl()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mTTLInSeconds;
+}
+
+void ZapFR::Engine::DNSCache::setNegativeTTL(uint64_t seconds)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mNegativeTTLInSeconds = seconds;
+    mEntries.clear();
+}
+
+uint64_t ZapFR::Engine::DNSCache::negativeTTL()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mNegativeTTLInSeconds;
+}
+
+// goes through the system resolver without holding the mutex; a failure is returned as an entry without an address
+ZapFR::Engine::DNSCache::Entry ZapFR::Engine::DNSCache::lookup(const std::string& host)
+{
+    Entry entry;
+    try
+    {
+        auto hostEntry = Poco::Net::DNS::hostByName(host);
+        const auto& addresses = hostEntry.addresses();
+
+        // prefer IPv4, just like Poco does when it resolves a host by itself
+        for (const auto& address : addresses)
+        {
+            if (address.family() == Poco::Net::IPAddress::IPv4)
+            {
+                entry.address = address;
+                break;
+            }
+        }
+        if (!entry.address.has_value() && !addresses.empty())
+        {
+            entry.address = addresses.front();
+        }
+        if (!entry.address.has_value())
+        {
+            entry.error = "no addresses found";
+        }
+    }
+    catch (const Poco::Exception& e)
+    {
+        entry.error = e.displayText();
+    }
+    return entry;
+}
+
+// assumes mMutex is held by the caller
+void ZapFR::Engine::DNSCache::store(const std::string& host, Entry entry)
+{
+    auto now = Clock::now();
+
+    // a failed background refresh doesn't throw away an address that is still valid
+    auto it = mEntries.find(host);
+    if (!entry.address.has_value() && it != mEntries.end() && it->second.address.has_value() && it->second.expires > now)
+    {
+        return;
+    }
+
+    if (entry.address.has_value())
+    {
+        entry.expires = now + std::chrono::seconds(mTTLInSeconds);
+        entry.refreshAfter = now + std::chrono::seconds(mTTLInSeconds - mTTLInSeconds / 10);
+    }
+    else
+    {
+        entry.expires = now + std::chrono::seconds(mNegativeTTLInSeconds);
+        entry.refreshAfter = entry.expires;
+    }
+
+    if (it == mEntries.end() && mEntries.size() >= MaxEntries)
+    {
+        std::erase_if(mEntries, [&](const auto& item) { return item.second.expires <= now; });
+        if (mEntries.size() >= MaxEntries)
+        {
+            mEntries.clear();
+        }
+    }
+    mEntries[host] = std::move(entry);
+}
+
+void ZapFR::Engine::DNSCache::run()
+{
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWakeUp.wait(lock, [&]() { return mShouldStop || !mPreResolveQueue.empty(); });
+        if (mShouldStop)
+        {
+            break;
+        }
+
+        auto host = mPreResolveQueue.front();
+        mPreResolveQueue.pop_front();
+        if (mResolving.contains(host))
+        {
+            continue;
+        }
+        auto it = mEntries.find(host);
+        if (it != mEntries.end() && it->second.refreshAfter > Clock::now())
+        {
+            continue;
+        }
+
+        mResolving.insert(host);
+        lock.unlock();
+        auto entry = lookup(host);
+        lock.lock();
+        store(host, entry);
+        mResolving.erase(host);
+        lock.unlock();
+        mResolved.notify_all();
+    }
+}
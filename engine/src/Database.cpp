@@ -69,7 +69,11 @@ void ZapFR::Engine::Database::upgrade()
                 []() { /* nop, there is no db version 0 */ },    []() { /* nop, version 1 should have been installed with installDBSchemaV1 */ },
                 std::bind(&Database::upgradeToDBSchemaV2, this), std::bind(&Database::upgradeToDBSchemaV3, this),
                 std::bind(&Database::upgradeToDBSchemaV4, this), std::bind(&Database::upgradeToDBSchemaV5, this),
-                std::bind(&Database::upgradeToDBSchemaV6, this), std::bind(&Database::upgradeToDBSchemaV7, this)};
+                std::bind(&Database::upgradeToDBSchemaV6, this), std::bind(&Database::upgradeToDBSchemaV7, this),
+                std::bind(&Database::upgradeToDBSchemaV8, this), std::bind(&Database::upgradeToDBSchemaV9, this),
+                std::bind(&Database::upgradeToDBSchemaV10, this), std::bind(&Database::upgradeToDBSchemaV11, this),
+                std::bind(&Database::upgradeToDBSchemaV12, this), std::bind(&Database::upgradeToDBSchemaV13, this),
+                std::bind(&Database::upgradeToDBSchemaV14, this), std::bind(&Database::upgradeToDBSchemaV15, this)};
 
             for (auto i = currentDBVersion + 1; i <= ZapFR::Engine::DBVersion; ++i)
             {
@@ -311,4 +315,95 @@ void ZapFR::Engine::Database::upgradeToDBSchemaV7()
     (*mSession) << R"(CREATE INDEX posts_IX_datepublished ON posts (datePublished))", now;
     (*mSession) << R"(CREATE INDEX post_categories_IX_postID ON post_categories (postID))", now;
     (*mSession) << "UPDATE config SET VALUE='7' WHERE key='db_schema_version'", now;
-}
\ No newline at end of file
+}
+
+void ZapFR::Engine::Database::upgradeToDBSchemaV8()
+{
+    (*mSession) << "ALTER TABLE feeds ADD adaptiveRefreshInterval INTEGER", now;
+    (*mSession) << "UPDATE config SET VALUE='8' WHERE key='db_schema_version'", now;
+}
+
+void ZapFR::Engine::Database::upgradeToDBSchemaV9()
+{
+    (*mSession) << "ALTER TABLE feeds ADD nextRefresh INTEGER", now;
+    (*mSession) << "UPDATE config SET VALUE='9' WHERE key='db_schema_version'", now;
+}
+
+void ZapFR::Engine::Database::upgradeToDBSchemaV10()
+{
+    (*mSession) << "ALTER TABLE feeds ADD consecutiveFailures INTEGER NOT NULL DEFAULT 0", now;
+    (*mSession) << "UPDATE config SET VALUE='10' WHERE key='db_schema_version'", now;
+}
+
+void ZapFR::Engine::Database::upgradeToDBSchemaV11()
+{
+    (*mSession) << "ALTER TABLE feeds ADD pendingRedirectURL TEXT", now;
+    (*mSession) << "ALTER TABLE feeds ADD pendingRedirectCount INTEGER NOT NULL DEFAULT 0", now;
+    (*mSession) << "UPDATE config SET VALUE='11' WHERE key='db_schema_version'", now;
+}
+
+void ZapFR::Engine::Database::upgradeToDBSchemaV12()
+{
+    (*mSession) << "ALTER TABLE feeds ADD bodyHash TEXT", now;
+    (*mSession) << "UPDATE config SET VALUE='12' WHERE key='db_schema_version'", now;
+}
+
+void ZapFR::Engine::Database::upgradeToDBSchemaV13()
+{
+    (*mSession) << "CREATE TABLE IF NOT EXISTS favicon_sites ("
+                   " site TEXT PRIMARY KEY NOT NULL"
+                   ",iconURL TEXT NOT NULL"
+                   ",lastChecked INTEGER NOT NULL DEFAULT 0"
+                   ")",
+        now;
+    (*mSession) << "CREATE TABLE IF NOT EXISTS favicons ("
+                   " url TEXT PRIMARY KEY NOT NULL"
+                   ",hash TEXT NOT NULL"
+                   ",data BLOB"
+                   ",conditionalGETInfo TEXT NOT NULL"
+                   ",lastChecked INTEGER NOT NULL DEFAULT 0"
+                   ")",
+        now;
+    (*mSession) << "UPDATE config SET VALUE='13' WHERE key='db_schema_version'", now;
+}
+
+void ZapFR::Engine::Database::upgradeToDBSchemaV14()
+{
+    (*mSession) << "CREATE TABLE IF NOT EXISTS websub_subscriptions ("
+                   " id INTEGER PRIMARY KEY"
+                   ",feedID INTEGER NOT NULL"
+                   ",hub TEXT NOT NULL"
+                   ",topic TEXT NOT NULL"
+                   ",token TEXT NOT NULL UNIQUE"
+                   ",secret TEXT NOT NULL"
+                   ",state TEXT NOT NULL"
+                   ",leaseExpires INTEGER NOT NULL DEFAULT 0"
+                   ",nextAttempt INTEGER NOT NULL DEFAULT 0"
+                   ")",
+        now;
+    (*mSession) << R"(CREATE INDEX websub_subscriptions_IX_feedID ON websub_subscriptions (feedID))", now;
+    (*mSession) << "UPDATE config SET VALUE='14' WHERE key='db_schema_version'", now;
+}
+
+void ZapFR::Engine::Database::upgradeToDBSchemaV15()
+{
+    (*mSession) << "CREATE TABLE IF NOT EXISTS feed_telemetry ("
+                   " id INTEGER PRIMARY KEY"
+                   ",feedID INTEGER NOT NULL"
+                   ",timestamp TEXT NOT NULL"
+                   ",result INTEGER NOT NULL"
+                   ",dnsTime INTEGER NOT NULL DEFAULT 0"
+                   ",connectTime INTEGER NOT NULL DEFAULT 0"
+                   ",tlsTime INTEGER NOT NULL DEFAULT 0"
+                   ",firstByteTime INTEGER NOT NULL DEFAULT 0"
+                   ",transferredBytes INTEGER NOT NULL DEFAULT 0"
+                   ",bodyBytes INTEGER NOT NULL DEFAULT 0"
+                   ",parseTime INTEGER NOT NULL DEFAULT 0"
+                   ",ingestTime INTEGER NOT NULL DEFAULT 0"
+                   ",newItems INTEGER NOT NULL DEFAULT 0"
+                   ",updatedItems INTEGER NOT NULL DEFAULT 0"
+                   ")",
+        now;
+    (*mSession) << R"(CREATE INDEX feed_telemetry_IX_feedID ON feed_telemetry (feedID))", now;
+    (*mSession) << "UPDATE config SET VALUE='15' WHERE key='db_schema_version'", now;
+}
@@ -0,0 +1,416 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <array>
+
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include "ZapFR/DateParser.h"
+
+namespace
+{
+    struct NamedZone
+    {
+        std::string_view name;
+        int32_t offset; // in minutes
+    };
+
+    // the zones RFC 822 defines, plus the ones that show up in feeds anyway
+    constexpr std::array<NamedZone, 36> gsNamedZones{{
+        {"UT", 0},           {"UTC", 0},          {"GMT", 0},          {"Z", 0},           {"EST", -5 * 60},   {"EDT", -4 * 60},   {"CST", -6 * 60},
+        {"CDT", -5 * 60},    {"MST", -7 * 60},    {"MDT", -6 * 60},    {"PST", -8 * 60},   {"PDT", -7 * 60},   {"AKST", -9 * 60},  {"AKDT", -8 * 60},
+        {"HST", -10 * 60},   {"AST", -4 * 60},    {"ADT", -3 * 60},    {"NST", -210},      {"NDT", -150},      {"WET", 0},         {"WEST", 60},
+        {"BST", 60},         {"IST", 330},        {"CET", 60},         {"CEST", 2 * 60},   {"MET", 60},        {"MEST", 2 * 60},   {"EET", 2 * 60},
+        {"EEST", 3 * 60},    {"MSK", 3 * 60},     {"JST", 9 * 60},     {"KST", 9 * 60},    {"AEST", 10 * 60},  {"AEDT", 11 * 60},  {"NZST", 12 * 60},
+        {"NZDT", 13 * 60},
+    }};
+
+    constexpr std::array<std::string_view, 12> gsMonthNames{"jan", "feb", "mar", "apr", "may", "jun", "jul", "aug", "sep", "oct", "nov", "dec"};
+
+    bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    bool isAlpha(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    char toLower(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    bool iequals(std::string_view a, std::string_view b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (toLower(a[i]) != toLower(b[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void skipSpaces(std::string_view s, size_t& pos)
+    {
+        while (pos < s.size() && (s[pos] == ' ' || s[pos] == '\t'))
+        {
+            ++pos;
+        }
+    }
+
+    // reads between minCount and maxCount digits; returns how many were read (0 if fewer than minCount)
+    size_t readNumber(std::string_view s, size_t& pos, size_t minCount, size_t maxCount, int32_t& value)
+    {
+        size_t count = 0;
+        int32_t result = 0;
+        while (pos + count < s.size() && count < maxCount && isDigit(s[pos + count]))
+        {
+            result = result * 10 + (s[pos + count] - '0');
+            ++count;
+        }
+        if (count < minCount)
+        {
+            return 0;
+        }
+        pos += count;
+        value = result;
+        return count;
+    }
+
+    std::string_view readWord(std::string_view s, size_t& pos)
+    {
+        auto start = pos;
+        while (pos < s.size() && isAlpha(s[pos]))
+        {
+            ++pos;
+        }
+        return s.substr(start, pos - start);
+    }
+
+    bool consume(std::string_view s, size_t& pos, char c)
+    {
+        if (pos < s.size() && s[pos] == c)
+        {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    std::optional<int32_t> month(std::string_view word)
+    {
+        if (word.size() < 3)
+        {
+            return {};
+        }
+        for (size_t i = 0; i < gsMonthNames.size(); ++i)
+        {
+            if (iequals(word.substr(0, 3), gsMonthNames.at(i)))
+            {
+                return static_cast<int32_t>(i + 1);
+            }
+        }
+        return {};
+    }
+
+    // +hh:mm, +hhmm or +hh (at the sign), in minutes
+    std::optional<int32_t> numericOffset(std::string_view s, size_t& pos)
+    {
+        auto sign = s[pos] == '-' ? -1 : 1;
+        ++pos;
+        int32_t hours{0};
+        int32_t minutes{0};
+        auto count = readNumber(s, pos, 1, 4, hours);
+        if (count == 0)
+        {
+            return {};
+        }
+        if (count > 2)
+        {
+            minutes = hours % 100;
+            hours /= 100;
+        }
+        else if (consume(s, pos, ':') && readNumber(s, pos, 2, 2, minutes) == 0)
+        {
+            return {};
+        }
+        if (hours > 23 || minutes > 59)
+        {
+            return {};
+        }
+        return sign * (hours * 60 + minutes);
+    }
+
+    // the offset from UTC in minutes; no zone at all means UTC, unknown zone names are taken as UTC too, like Poco does
+    std::optional<int32_t> zone(std::string_view s, size_t& pos)
+    {
+        skipSpaces(s, pos);
+        if (pos == s.size())
+        {
+            return 0;
+        }
+        if (s[pos] == '+' || s[pos] == '-')
+        {
+            return numericOffset(s, pos);
+        }
+
+        auto name = readWord(s, pos);
+        int32_t offset{0};
+        for (const auto& namedZone : gsNamedZones)
+        {
+            if (iequals(name, namedZone.name))
+            {
+                offset = namedZone.offset;
+                break;
+            }
+        }
+
+        // GMT+2, UTC-05:00
+        if (!name.empty() && pos < s.size() && (s[pos] == '+' || s[pos] == '-'))
+        {
+            auto extra = numericOffset(s, pos);
+            if (!extra.has_value())
+            {
+                return {};
+            }
+            offset += extra.value();
+        }
+        return offset;
+    }
+
+    // hh:mm[:ss[.fraction]]
+    bool time(std::string_view s, size_t& pos, int32_t& hour, int32_t& minute, int32_t& second)
+    {
+        if (readNumber(s, pos, 1, 2, hour) == 0 || !consume(s, pos, ':') || readNumber(s, pos, 2, 2, minute) == 0)
+        {
+            return false;
+        }
+        if (consume(s, pos, ':'))
+        {
+            if (readNumber(s, pos, 2, 2, second) == 0)
+            {
+                return false;
+            }
+            if (pos < s.size() && (s[pos] == '.' || s[pos] == ','))
+            {
+                ++pos;
+                while (pos < s.size() && isDigit(s[pos]))
+                {
+                    ++pos;
+                }
+            }
+        }
+        return true;
+    }
+
+    // days since 1970-01-01 in the proleptic Gregorian calendar (Howard Hinnant's days_from_civil)
+    int64_t daysFromCivil(int64_t year, int64_t month, int64_t day)
+    {
+        year -= month <= 2 ? 1 : 0;
+        auto era = (year >= 0 ? year : year - 399) / 400;
+        auto yearOfEra = year - era * 400;
+        auto dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        auto dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    int32_t daysInMonth(int32_t year, int32_t month)
+    {
+        static constexpr std::array<int32_t, 12> days{31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        auto leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        return (month == 2 && leap) ? 29 : days.at(static_cast<size_t>(month - 1));
+    }
+
+    std::optional<int64_t> epoch(int32_t year, int32_t month, int32_t day, int32_t hour, int32_t minute, int32_t second, int32_t offset)
+    {
+        if (year < 1 || year > 9999 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) || minute > 59 || second > 60)
+        {
+            return {};
+        }
+        if (hour > 23 && !(hour == 24 && minute == 0 && second == 0)) // 24:00:00 is midnight at the end of the day
+        {
+            return {};
+        }
+        second = std::min(second, 59); // leap seconds
+        return daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second - static_cast<int64_t>(offset) * 60;
+    }
+
+    // YYYY-MM-DD[(T| )hh:mm[:ss[.fraction]]][zone]
+    std::optional<int64_t> parseISO8601(std::string_view s)
+    {
+        size_t pos = 0;
+        int32_t year{0}, month{0}, day{0}, hour{0}, minute{0}, second{0};
+        if (readNumber(s, pos, 4, 4, year) == 0 || !consume(s, pos, '-') || readNumber(s, pos, 1, 2, month) == 0 || !consume(s, pos, '-') ||
+            readNumber(s, pos, 1, 2, day) == 0)
+        {
+            return {};
+        }
+
+        if (pos < s.size() && (s[pos] == 'T' || s[pos] == 't' || s[pos] == ' ') && pos + 1 < s.size() && isDigit(s[pos + 1]))
+        {
+            ++pos;
+            if (!time(s, pos, hour, minute, second))
+            {
+                return {};
+            }
+        }
+
+        auto offset = zone(s, pos);
+        if (!offset.has_value())
+        {
+            return {};
+        }
+        return epoch(year, month, day, hour, minute, second, offset.value());
+    }
+
+    // [Weekday[,]] DD Mon YYYY [hh:mm[:ss]] [zone], also with dashes between the date parts, or with the month first (Oct 5, 2023)
+    std::optional<int64_t> parseRFC822(std::string_view s)
+    {
+        size_t pos = 0;
+        int32_t year{0}, day{0}, hour{0}, minute{0}, second{0};
+        std::optional<int32_t> monthNumber;
+
+        const auto skipSeparators = [&]()
+        {
+            while (pos < s.size() && (s[pos] == ' ' || s[pos] == '\t' || s[pos] == ',' || s[pos] == '-' || s[pos] == '.'))
+            {
+                ++pos;
+            }
+        };
+
+        auto word = readWord(s, pos);
+        if (!word.empty())
+        {
+            monthNumber = month(word);
+            if (!monthNumber.has_value()) // a weekday; whatever comes next has to be the date
+            {
+                skipSeparators();
+                word = readWord(s, pos);
+                monthNumber = word.empty() ? std::nullopt : month(word);
+                if (!word.empty() && !monthNumber.has_value())
+                {
+                    return {};
+                }
+            }
+            skipSeparators();
+        }
+
+        if (readNumber(s, pos, 1, 2, day) == 0)
+        {
+            return {};
+        }
+        skipSeparators();
+        if (!monthNumber.has_value())
+        {
+            monthNumber = month(readWord(s, pos));
+            if (!monthNumber.has_value())
+            {
+                return {};
+            }
+            skipSeparators();
+        }
+
+        auto yearDigits = readNumber(s, pos, 2, 4, year);
+        if (yearDigits == 0)
+        {
+            return {};
+        }
+        else if (yearDigits == 2) // the same pivot Poco uses
+        {
+            year += year < 70 ? 2000 : 1900;
+        }
+        else if (yearDigits == 3)
+        {
+            year += 1900;
+        }
+
+        skipSpaces(s, pos);
+        if (pos < s.size() && isDigit(s[pos]) && !time(s, pos, hour, minute, second))
+        {
+            return {};
+        }
+
+        auto offset = zone(s, pos);
+        if (!offset.has_value())
+        {
+            return {};
+        }
+        return epoch(year, monthNumber.value(), day, hour, minute, second, offset.value());
+    }
+} // namespace
+
+std::optional<int64_t> ZapFR::Engine::DateParser::parse(std::string_view date)
+{
+    auto start = date.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos)
+    {
+        return {};
+    }
+    auto end = date.find_last_not_of(" \t\r\n");
+    date = date.substr(start, end - start + 1);
+
+    if (date.size() >= 5 && isDigit(date[0]) && isDigit(date[1]) && isDigit(date[2]) && isDigit(date[3]) && date[4] == '-')
+    {
+        return parseISO8601(date);
+    }
+    return parseRFC822(date);
+}
+
+std::string ZapFR::Engine::DateParser::formatISO8601(int64_t epoch)
+{
+    // civil_from_days, the inverse of daysFromCivil
+    auto days = epoch / 86400;
+    auto secondsOfDay = epoch % 86400;
+    if (secondsOfDay < 0)
+    {
+        secondsOfDay += 86400;
+        days -= 1;
+    }
+
+    days += 719468;
+    auto era = (days >= 0 ? days : days - 146096) / 146097;
+    auto dayOfEra = days - era * 146097;
+    auto yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    auto dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    auto shiftedMonth = (5 * dayOfYear + 2) / 153;
+    auto day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    auto month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    auto year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+    return fmt::format("{:04}-{:02}-{:02}T{:02}:{:02}:{:02}Z", year, month, day, secondsOfDay / 3600, (secondsOfDay / 60) % 60, secondsOfDay % 60);
+}
+
+std::optional<std::string> ZapFR::Engine::DateParser::normalize(std::string_view date)
+{
+    auto parsed = parse(date);
+    if (!parsed.has_value())
+    {
+        return {};
+    }
+    return formatISO8601(parsed.value());
+}
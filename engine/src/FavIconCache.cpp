@@ -0,0 +1,181 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <Poco/Data/LOB.h>
+#include <Poco/Data/Statement.h>
+#include <Poco/MD5Engine.h>
+#include <Poco/Net/HTTPCredentials.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Timestamp.h>
+#include <Poco/URI.h>
+
+#include "ZapFR/Database.h"
+#include "ZapFR/FavIconCache.h"
+#include "ZapFR/Helpers.h"
+#include "ZapFR/Log.h"
+#include "ZapFR/feed_handling/FavIconParser.h"
+
+using namespace Poco::Data::Keywords;
+
+namespace
+{
+    uint64_t nowEpoch()
+    {
+        return static_cast<uint64_t>(Poco::Timestamp().epochTime());
+    }
+} // namespace
+
+ZapFR::Engine::FavIconCache* ZapFR::Engine::FavIconCache::getInstance()
+{
+    static FavIconCache instance{};
+    return &instance;
+}
+
+std::string ZapFR::Engine::FavIconCache::iconURLForPage(const std::string& pageURL, uint64_t associatedFeedID)
+{
+    // every page of a site normally shares the same icon, so the site is scraped once for all of its feeds
+    Poco::URI uri(pageURL);
+    std::string site{pageURL};
+    if (!FavIconParser::hasPageSpecificIcons(uri))
+    {
+        uri.setPathEtc("/");
+        site = uri.toString();
+    }
+
+    KeyLock keyLock(this, "page:" + site);
+
+    std::string iconURL;
+    uint64_t lastChecked{0};
+    Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+    selectStmt << "SELECT iconURL,lastChecked FROM favicon_sites WHERE site=?", useRef(site), into(iconURL), into(lastChecked), range(0, 1);
+    auto found = (selectStmt.execute() > 0);
+    if (found && nowEpoch() < lastChecked + RefreshInterval)
+    {
+        mHitCount++;
+        return iconURL;
+    }
+
+    try
+    {
+        mFetchCount++;
+        auto p = FavIconParser();
+        p.parseURL(pageURL, associatedFeedID);
+        iconURL = p.favIcon();
+    }
+    catch (const std::exception& e)
+    {
+        // keep using what we had; the failure is remembered as well, so the site isn't scraped again by the next feed
+        Log::log(LogLevel::Debug, fmt::format("Failed to find the icon of {}: {}", site, e.what()), associatedFeedID);
+    }
+    catch (const Poco::Exception& e)
+    {
+        Log::log(LogLevel::Debug, fmt::format("Failed to find the icon of {}: {}", site, e.displayText()), associatedFeedID);
+    }
+
+    auto checked = nowEpoch();
+    Poco::Data::Statement upsertStmt(*(Database::getInstance()->session()));
+    upsertStmt << "INSERT OR REPLACE INTO favicon_sites (site,iconURL,lastChecked) VALUES (?,?,?)", useRef(site), useRef(iconURL), use(checked), now;
+    return iconURL;
+}
+
+std::optional<ZapFR::Engine::FavIconCache::Icon> ZapFR::Engine::FavIconCache::icon(const std::string& iconURL, uint64_t associatedFeedID)
+{
+    KeyLock keyLock(this, "icon:" + iconURL);
+
+    Icon cachedIcon;
+    Poco::Data::BLOB cachedData;
+    std::string conditionalGETInfo;
+    uint64_t lastChecked{0};
+    Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+    selectStmt << "SELECT hash,data,conditionalGETInfo,lastChecked FROM favicons WHERE url=?", useRef(iconURL), into(cachedIcon.hash), into(cachedData),
+        into(conditionalGETInfo), into(lastChecked), range(0, 1);
+    auto found = (selectStmt.execute() > 0);
+    if (found)
+    {
+        cachedIcon.data.assign(reinterpret_cast<const char*>(cachedData.rawContent()), cachedData.size());
+        if (nowEpoch() < lastChecked + RefreshInterval)
+        {
+            mHitCount++;
+            return cachedIcon.data.empty() ? std::nullopt : std::optional<Icon>(cachedIcon);
+        }
+    }
+
+    // revalidate what we have, or download it from scratch
+    std::optional<std::string> cgi;
+    if (found && !cachedIcon.data.empty() && !conditionalGETInfo.empty())
+    {
+        cgi = conditionalGETInfo;
+    }
+
+    Icon icon{cachedIcon};
+    try
+    {
+        mFetchCount++;
+        Poco::Net::HTTPCredentials creds;
+        auto uri = Poco::URI(iconURL);
+        const auto& [body, receivedConditionalGETInfo] = Helpers::performHTTPRequest(uri, Poco::Net::HTTPRequest::HTTP_GET, creds, {}, associatedFeedID, cgi);
+        if (body.empty() && cgi.has_value())
+        {
+            // not modified; a 304 doesn't have to repeat the validators, in which case we hold on to the ones we have
+            mNotModifiedCount++;
+            if (!receivedConditionalGETInfo.empty())
+            {
+                conditionalGETInfo = receivedConditionalGETInfo;
+            }
+        }
+        else
+        {
+            conditionalGETInfo = receivedConditionalGETInfo;
+            Poco::MD5Engine md5;
+            md5.update(body);
+            icon.hash = body.empty() ? "" : Poco::DigestEngine::digestToHex(md5.digest());
+            icon.data = body;
+        }
+    }
+    catch (...) // a missing favicon isn't worth an error; we keep whatever we had and check again later
+    {
+        Log::log(LogLevel::Debug, fmt::format("Failed to download feed icon: {}", iconURL), associatedFeedID);
+    }
+
+    auto checked = nowEpoch();
+    Poco::Data::BLOB data(reinterpret_cast<const unsigned char*>(icon.data.data()), icon.data.size());
+    Poco::Data::Statement upsertStmt(*(Database::getInstance()->session()));
+    upsertStmt << "INSERT OR REPLACE INTO favicons (url,hash,data,conditionalGETInfo,lastChecked) VALUES (?,?,?,?,?)", useRef(iconURL), useRef(icon.hash),
+        useRef(data), useRef(conditionalGETInfo), use(checked), now;
+
+    return icon.data.empty() ? std::nullopt : std::optional<Icon>(icon);
+}
+
+ZapFR::Engine::FavIconCache::KeyLock::KeyLock(FavIconCache* cache, const std::string& key) : mCache(cache), mKey(key)
+{
+    std::unique_lock<std::mutex> lock(mCache->mMutex);
+    mCache->mKeyReleased.wait(lock, [&]() { return !mCache->mBusyKeys.contains(mKey); });
+    mCache->mBusyKeys.insert(mKey);
+}
+
+ZapFR::Engine::FavIconCache::KeyLock::~KeyLock()
+{
+    {
+        std::lock_guard<std::mutex> lock(mCache->mMutex);
+        mCache->mBusyKeys.erase(mKey);
+    }
+    mCache->mKeyReleased.notify_all();
+}
@@ -0,0 +1,296 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <algorithm>
+
+#include <Poco/Net/HTTPSClientSession.h>
+#include <Poco/Net/SecureStreamSocket.h>
+#include <Poco/Net/Session.h>
+
+#include "ZapFR/DNSCache.h"
+#include "ZapFR/HTTPConnectionPool.h"
+
+namespace
+{
+    // the sessions connect lazily, upon sending their first request, so they keep track of how long that took (or whether it failed) themselves
+    struct ConnectTimes
+    {
+        uint64_t connectTime{0};
+        uint64_t tlsTime{0};
+        bool connectFailed{false};
+    };
+
+    class PooledHTTPClientSession : public Poco::Net::HTTPClientSession, public ConnectTimes
+    {
+      public:
+        explicit PooledHTTPClientSession(const Poco::Net::SocketAddress& address) : Poco::Net::HTTPClientSession(address) {}
+
+      protected:
+        void connect(const Poco::Net::SocketAddress& address) override
+        {
+            Poco::Timestamp start;
+            try
+            {
+                Poco::Net::HTTPClientSession::connect(address);
+            }
+            catch (...)
+            {
+                connectFailed = true;
+                throw;
+            }
+            connectTime = static_cast<uint64_t>(start.elapsed());
+        }
+    };
+
+    // exposes the TLS state of the underlying socket, which HTTPSClientSession keeps to itself
+    class PooledHTTPSClientSession : public Poco::Net::HTTPSClientSession, public ConnectTimes
+    {
+      public:
+        PooledHTTPSClientSession(const Poco::Net::SecureStreamSocket& socket, Poco::Net::Session::Ptr tlsSession)
+            : Poco::Net::HTTPSClientSession(socket, tlsSession)
+        {
+        }
+
+        Poco::Net::Session::Ptr currentTLSSession() { return Poco::Net::SecureStreamSocket(socket()).currentSession(); }
+        bool tlsSessionWasReused() { return Poco::Net::SecureStreamSocket(socket()).sessionWasReused(); }
+
+      protected:
+        // the socket does its handshake lazily, so the TCP connect and the TLS handshake can be timed separately
+        void connect(const Poco::Net::SocketAddress& address) override
+        {
+            Poco::Timestamp start;
+            try
+            {
+                Poco::Net::HTTPSClientSession::connect(address);
+            }
+            catch (...)
+            {
+                connectFailed = true;
+                throw;
+            }
+            connectTime = static_cast<uint64_t>(start.elapsed());
+
+            Poco::Timestamp handshakeStart;
+            Poco::Net::SecureStreamSocket(socket()).completeHandshake();
+            tlsTime = static_cast<uint64_t>(handshakeStart.elapsed());
+        }
+    };
+} // namespace
+
+ZapFR::Engine::HTTPConnectionPool* ZapFR::Engine::HTTPConnectionPool::getInstance()
+{
+    static HTTPConnectionPool instance{};
+    return &instance;
+}
+
+std::unique_ptr<ZapFR::Engine::HTTPConnectionPool::Connection> ZapFR::Engine::HTTPConnectionPool::checkout(const Poco::URI& url, Poco::Net::Context::Ptr sslContext)
+{
+    auto scheme = url.getScheme();
+    if (scheme != "https" && scheme != "http")
+    {
+        throw std::runtime_error(fmt::format("Unknown scheme in URL: {}", url.toString()));
+    }
+    auto key = fmt::format("{}://{}:{}", scheme, url.getHost(), url.getPort());
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    evictIdleSessions();
+
+    // wait until the host has a free connection slot
+    auto hasFreeSlot = [&]() { return mActiveConnectionCount[key] < mMaxConnectionsPerHost; };
+    if (!mSlotAvailable.wait_for(lock, std::chrono::seconds(CheckoutTimeout), hasFreeSlot))
+    {
+        throw std::runtime_error(fmt::format("Timeout waiting for a free connection to {}", url.getHost()));
+    }
+    mActiveConnectionCount[key]++;
+
+    // reuse the most recently returned idle session, if any
+    auto& idle = mIdleSessions[key];
+    if (!idle.empty())
+    {
+        auto session = std::move(idle.back().session);
+        idle.pop_back();
+        mReusedConnectionCount++;
+        return std::make_unique<Connection>(this, key, std::move(session), true);
+    }
+    lock.unlock();
+
+    // connect to the cached address rather than the host name, so neither the session nor its reconnects hit the system resolver
+    // (the Host header is set on the request itself)
+    Poco::Net::IPAddress address;
+    Poco::Timestamp resolveStart;
+    try
+    {
+        address = DNSCache::getInstance()->resolve(url.getHost());
+    }
+    catch (...)
+    {
+        checkin(key, nullptr, false, false);
+        throw;
+    }
+
+    auto dnsTime = static_cast<uint64_t>(resolveStart.elapsed());
+
+    std::unique_ptr<Poco::Net::HTTPClientSession> session;
+    if (scheme == "https")
+    {
+        // the socket keeps the actual host name for SNI
+        Poco::Net::SecureStreamSocket socket(sslContext);
+        socket.setPeerHostName(url.getHost());
+        socket.setLazyHandshake(true);
+        Poco::Net::Session::Ptr tlsSession{nullptr};
+        {
+            std::lock_guard<std::mutex> tlsLock(mMutex);
+            auto it = mTLSSessions.find(key);
+            if (it != mTLSSessions.end())
+            {
+                tlsSession = it->second;
+            }
+        }
+        session = std::make_unique<PooledHTTPSClientSession>(socket, tlsSession);
+        session->setHost(address.toString());
+        session->setPort(url.getPort());
+    }
+    else
+    {
+        session = std::make_unique<PooledHTTPClientSession>(Poco::Net::SocketAddress(address, url.getPort()));
+    }
+    session->setKeepAlive(true);
+    session->setKeepAliveTimeout(Poco::Timespan(static_cast<long>(mIdleTimeoutInSeconds), 0));
+    mCreatedConnectionCount++;
+    return std::make_unique<Connection>(this, key, std::move(session), false, dnsTime);
+}
+
+void ZapFR::Engine::HTTPConnectionPool::checkin(const std::string& key, std::unique_ptr<Poco::Net::HTTPClientSession> session, bool reusable, bool reused)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // remember the TLS session once a request went through, as TLS 1.3 servers only hand out their tickets after the handshake
+        auto httpsSession = dynamic_cast<PooledHTTPSClientSession*>(session.get());
+        if (httpsSession != nullptr && httpsSession->connected())
+        {
+            if (!reused)
+            {
+                mTLSHandshakeCount++;
+                if (httpsSession->tlsSessionWasReused())
+                {
+                    mTLSResumedHandshakeCount++;
+                }
+            }
+
+            auto tlsSession = httpsSession->currentTLSSession();
+            if (!tlsSession.isNull())
+            {
+                if (mTLSSessions.size() >= MaxTLSSessions && !mTLSSessions.contains(key))
+                {
+                    mTLSSessions.clear();
+                }
+                mTLSSessions[key] = tlsSession;
+            }
+        }
+
+        if (mActiveConnectionCount[key] > 0)
+        {
+            mActiveConnectionCount[key]--;
+        }
+        if (reusable && session != nullptr && session->connected())
+        {
+            mIdleSessions[key].push_back({std::move(session), Poco::Timestamp()});
+        }
+    }
+    mSlotAvailable.notify_all();
+}
+
+void ZapFR::Engine::HTTPConnectionPool::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIdleSessions.clear();
+    mTLSSessions.clear();
+}
+
+void ZapFR::Engine::HTTPConnectionPool::setMaxConnectionsPerHost(size_t max)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mMaxConnectionsPerHost = std::max(max, static_cast<size_t>(1));
+    }
+    mSlotAvailable.notify_all();
+}
+
+void ZapFR::Engine::HTTPConnectionPool::setIdleTimeout(uint64_t seconds)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mIdleTimeoutInSeconds = seconds;
+    evictIdleSessions();
+}
+
+// assumes mMutex is held by the caller
+void ZapFR::Engine::HTTPConnectionPool::evictIdleSessions()
+{
+    auto maxIdleTime = static_cast<Poco::Timestamp::TimeDiff>(mIdleTimeoutInSeconds) * Poco::Timestamp::resolution();
+    for (auto it = mIdleSessions.begin(); it != mIdleSessions.end();)
+    {
+        auto& idle = it->second;
+        while (!idle.empty() && idle.front().lastUsed.isElapsed(maxIdleTime))
+        {
+            idle.pop_front();
+        }
+
+        if (idle.empty() && mActiveConnectionCount[it->first] == 0)
+        {
+            mActiveConnectionCount.erase(it->first);
+            it = mIdleSessions.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+ZapFR::Engine::HTTPConnectionPool::Connection::Connection(HTTPConnectionPool* pool, const std::string& key, std::unique_ptr<Poco::Net::HTTPClientSession> session,
+                                                          bool reused, uint64_t dnsTime)
+    : mPool(pool), mKey(key), mSession(std::move(session)), mReused(reused), mDNSTime(dnsTime)
+{
+}
+
+uint64_t ZapFR::Engine::HTTPConnectionPool::Connection::connectTime() const
+{
+    auto times = dynamic_cast<ConnectTimes*>(mSession.get());
+    return (times != nullptr && !mReused) ? times->connectTime : 0;
+}
+
+uint64_t ZapFR::Engine::HTTPConnectionPool::Connection::tlsTime() const
+{
+    auto times = dynamic_cast<ConnectTimes*>(mSession.get());
+    return (times != nullptr && !mReused) ? times->tlsTime : 0;
+}
+
+bool ZapFR::Engine::HTTPConnectionPool::Connection::connectFailed() const
+{
+    auto times = dynamic_cast<ConnectTimes*>(mSession.get());
+    return (times != nullptr && !mReused) ? times->connectFailed : false;
+}
+
+ZapFR::Engine::HTTPConnectionPool::Connection::~Connection()
+{
+    mPool->checkin(mKey, std::move(mSession), mReusable, mReused);
+}
@@ -0,0 +1,208 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <array>
+#include <thread>
+
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <Poco/DigestEngine.h>
+#include <Poco/File.h>
+#include <Poco/FileStream.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Parser.h>
+#include <Poco/Net/NetException.h>
+#include <Poco/Path.h>
+#include <Poco/SHA1Engine.h>
+#include <Poco/StreamCopier.h>
+#include <Poco/Timestamp.h>
+
+#include "ZapFR/HTTPCorpusTransport.h"
+#include "ZapFR/Helpers.h"
+
+std::string ZapFR::Engine::HTTPCorpus::key(const Poco::Net::HTTPRequest& request, const Poco::URI& url, const std::string& requestBody, bool withValidators)
+{
+    Poco::SHA1Engine sha1;
+    sha1.update(request.getMethod());
+    sha1.update('\n');
+    sha1.update(url.toString());
+    sha1.update('\n');
+    sha1.update(request.get("Range", ""));
+    sha1.update('\n');
+    if (withValidators)
+    {
+        sha1.update(request.get("If-None-Match", ""));
+        sha1.update('\n');
+        sha1.update(request.get("If-Modified-Since", ""));
+        sha1.update('\n');
+    }
+    sha1.update(requestBody);
+    return Poco::DigestEngine::digestToHex(sha1.digest());
+}
+
+void ZapFR::Engine::HTTPCorpus::write(const std::string& directory, const std::string& key, const Entry& entry)
+{
+    Poco::File(directory).createDirectories();
+    auto basePath = Poco::Path(directory, key).toString();
+
+    // the body goes first, so an entry only becomes visible once it's complete
+    {
+        Poco::FileOutputStream bodyStream(basePath + ".body");
+        bodyStream << entry.body;
+    }
+
+    Poco::JSON::Object o;
+    o.set("method", entry.method);
+    o.set("url", entry.url);
+    o.set("status", static_cast<uint32_t>(entry.status));
+    o.set("reason", entry.reason);
+    Poco::JSON::Array headers;
+    for (const auto& [name, value] : entry.headers)
+    {
+        Poco::JSON::Array header;
+        header.add(name);
+        header.add(value);
+        headers.add(header);
+    }
+    o.set("headers", headers);
+    o.set("elapsed", entry.elapsedMilliseconds);
+
+    Poco::FileOutputStream metaStream(basePath + ".json");
+    Poco::JSON::Stringifier::stringify(o, metaStream);
+}
+
+std::optional<ZapFR::Engine::HTTPCorpus::Entry> ZapFR::Engine::HTTPCorpus::read(const std::string& directory, const std::string& key)
+{
+    auto basePath = Poco::Path(directory, key).toString();
+    if (!Poco::File(basePath + ".json").exists())
+    {
+        return {};
+    }
+
+    Entry entry;
+    {
+        Poco::FileInputStream metaStream(basePath + ".json");
+        Poco::JSON::Parser parser;
+        auto root = parser.parse(metaStream);
+        auto o = root.extract<Poco::JSON::Object::Ptr>();
+        entry.method = o->getValue<std::string>("method");
+        entry.url = o->getValue<std::string>("url");
+        entry.status = static_cast<Poco::Net::HTTPResponse::HTTPStatus>(o->getValue<uint32_t>("status"));
+        entry.reason = o->getValue<std::string>("reason");
+        entry.elapsedMilliseconds = o->getValue<uint64_t>("elapsed");
+        auto headers = o->getArray("headers");
+        for (size_t i = 0; i < headers->size(); ++i)
+        {
+            auto header = headers->getArray(static_cast<unsigned int>(i));
+            entry.headers.emplace_back(header->getElement<std::string>(0), header->getElement<std::string>(1));
+        }
+    }
+
+    Poco::FileInputStream bodyStream(basePath + ".body");
+    Poco::StreamCopier::copyToString(bodyStream, entry.body);
+    return entry;
+}
+
+ZapFR::Engine::HTTPRecordingTransport::HTTPRecordingTransport(const std::string& corpusDirectory, std::shared_ptr<HTTPTransport> transport)
+    : mCorpusDirectory(corpusDirectory), mTransport(transport)
+{
+}
+
+void ZapFR::Engine::HTTPRecordingTransport::exchange(const Poco::URI& url, Poco::Net::HTTPRequest& request, const std::string& requestBody,
+                                                     const ResponseHandler& responseHandler, Timings& timings)
+{
+    auto key = HTTPCorpus::key(request, url, requestBody);
+    Poco::Timestamp start;
+    mTransport->exchange(url, request, requestBody,
+                         [&](Poco::Net::HTTPResponse& response, std::istream& responseStream)
+                         {
+                             HTTPCorpus::Entry entry;
+                             entry.method = request.getMethod();
+                             entry.url = url.toString();
+                             entry.status = response.getStatus();
+                             entry.reason = response.getReason();
+                             for (const auto& [name, value] : response)
+                             {
+                                 entry.headers.emplace_back(name, value);
+                             }
+
+                             // the body has to be in before it can be recorded, so the size limit is enforced here rather than by the caller
+                             auto maxBodySize = Helpers::httpTransferLimits().maxBodySize;
+                             std::array<char, 16384> buffer{};
+                             while (responseStream.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || responseStream.gcount() > 0)
+                             {
+                                 entry.body.append(buffer.data(), static_cast<size_t>(responseStream.gcount()));
+                                 if (maxBodySize > 0 && entry.body.size() > maxBodySize)
+                                 {
+                                     throw std::runtime_error(fmt::format("Response body exceeds the maximum size of {} bytes", maxBodySize));
+                                 }
+                             }
+                             entry.elapsedMilliseconds = static_cast<uint64_t>(start.elapsed() / 1000);
+
+                             {
+                                 std::lock_guard<std::mutex> lock(mWriteMutex);
+                                 HTTPCorpus::write(mCorpusDirectory, key, entry);
+                             }
+                             mRecordedCount++;
+
+                             std::istringstream bodyStream(entry.body);
+                             responseHandler(response, bodyStream);
+                         },
+                         timings);
+}
+
+ZapFR::Engine::HTTPReplayTransport::HTTPReplayTransport(const std::string& corpusDirectory, double latencyScale)
+    : mCorpusDirectory(corpusDirectory), mLatencyScale(latencyScale)
+{
+}
+
+void ZapFR::Engine::HTTPReplayTransport::exchange(const Poco::URI& url, Poco::Net::HTTPRequest& request, const std::string& requestBody,
+                                                  const ResponseHandler& responseHandler, Timings& timings)
+{
+    auto entry = HTTPCorpus::read(mCorpusDirectory, HTTPCorpus::key(request, url, requestBody));
+    if (!entry.has_value() && (request.has("If-None-Match") || request.has("If-Modified-Since")))
+    {
+        // validators that weren't recorded get the full response, like from a server that ignores them
+        entry = HTTPCorpus::read(mCorpusDirectory, HTTPCorpus::key(request, url, requestBody, false));
+    }
+    if (!entry.has_value())
+    {
+        mMissedCount++;
+        throw Poco::Net::HostNotFoundException(fmt::format("No recorded response for {} {}", request.getMethod(), url.toString()));
+    }
+
+    auto delay = static_cast<uint64_t>(static_cast<double>(entry->elapsedMilliseconds) * mLatencyScale);
+    if (delay > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    }
+    timings = {};
+    timings.firstByte = delay * 1000;
+
+    Poco::Net::HTTPResponse response(entry->status, entry->reason);
+    for (const auto& [name, value] : entry->headers)
+    {
+        response.add(name, value);
+    }
+    mReplayedCount++;
+
+    std::istringstream bodyStream(entry->body);
+    responseHandler(response, bodyStream);
+}
@@ -0,0 +1,99 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include <Poco/Timestamp.h>
+
+#include "ZapFR/DNSCache.h"
+#include "ZapFR/HTTPConnectionPool.h"
+#include "ZapFR/HTTPTransport.h"
+
+void ZapFR::Engine::HTTPNetworkTransport::exchange(const Poco::URI& url, Poco::Net::HTTPRequest& request, const std::string& requestBody,
+                                                   const ResponseHandler& responseHandler, Timings& timings)
+{
+    auto context = sslContext();
+
+    // a pooled connection may have been closed by the server while it was idle, and the cached address of a host may be outdated; in both
+    // cases we retry once on a fresh connection
+    for (auto attempt = 0; attempt < 2; ++attempt)
+    {
+        auto connection = HTTPConnectionPool::getInstance()->checkout(url, context);
+        auto session = connection->session();
+        session->setTimeout(Poco::Timespan(10, 0));
+
+        Poco::Net::HTTPResponse response;
+        auto responseReceived{false};
+        try
+        {
+            Poco::Timestamp start;
+            auto& requestStream = session->sendRequest(request);
+            if (!requestBody.empty())
+            {
+                requestStream << requestBody;
+            }
+
+            std::istream& responseStream = session->receiveResponse(response);
+            responseReceived = true;
+
+            // sending the first request is what sets up the connection, so that's not part of the time to the first byte
+            timings.dns = connection->dnsTime();
+            timings.connect = connection->connectTime();
+            timings.tls = connection->tlsTime();
+            auto elapsed = static_cast<uint64_t>(start.elapsed());
+            timings.firstByte = elapsed - std::min(elapsed, timings.connect + timings.tls);
+            responseHandler(response, responseStream);
+        }
+        catch (const Poco::Exception& e)
+        {
+            if (!responseReceived && attempt == 0)
+            {
+                if (connection->isReused() && dynamic_cast<const Poco::IOException*>(&e) != nullptr)
+                {
+                    continue;
+                }
+                if (connection->connectFailed() && DNSCache::getInstance()->invalidate(url.getHost()))
+                {
+                    continue; // resolves the host again
+                }
+            }
+            throw;
+        }
+
+        // the body has been read completely, so the connection can serve the next request, unless the server wants it closed
+        connection->setReusable(response.getKeepAlive());
+        break;
+    }
+}
+
+Poco::Net::Context::Ptr ZapFR::Engine::HTTPNetworkTransport::sslContext()
+{
+    std::lock_guard<std::mutex> lock(mSSLContextMutex);
+    if (mSSLContext.isNull())
+    {
+#if POCO_VERSION < 0x010A0000
+        mSSLContext = new Poco::Net::Context(Poco::Net::Context::TLSV1_2_CLIENT_USE, "", Poco::Net::Context::VERIFY_NONE);
+#else
+        mSSLContext = new Poco::Net::Context(Poco::Net::Context::TLS_CLIENT_USE, "", Poco::Net::Context::VERIFY_NONE);
+        mSSLContext->requireMinimumProtocol(Poco::Net::Context::PROTO_TLSV1_2);
+#endif
+        // lets the connection pool resume earlier TLS sessions (both session IDs and tickets) instead of doing a full handshake
+        mSSLContext->enableSessionCache(true);
+    }
+    return mSSLContext;
+}
@@ -16,27 +16,320 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+
 #define FMT_HEADER_ONLY
 #include <fmt/core.h>
 
 #include <Poco/Base64Decoder.h>
 #include <Poco/Base64Encoder.h>
+#include <Poco/DateTimeParser.h>
+#include <Poco/InflatingStream.h>
 #include <Poco/JSON/Parser.h>
 #include <Poco/Net/Context.h>
 #include <Poco/Net/HTMLForm.h>
 #include <Poco/Net/HTTPRequest.h>
 #include <Poco/Net/HTTPResponse.h>
 #include <Poco/Net/HTTPSClientSession.h>
+#include <Poco/NumberParser.h>
+#include <Poco/String.h>
+#include <Poco/Timestamp.h>
 #include <Poco/URI.h>
 
 #include "ZapFR/Global.h"
+#include "ZapFR/HTTPTransport.h"
+#include "ZapFR/HostThrottle.h"
 #include "ZapFR/Helpers.h"
 #include "ZapFR/Log.h"
 
 namespace
 {
-    static Poco::Net::Context::Ptr gsSSLContext{nullptr};
-    static std::mutex gsSSLContextMutex{};
+    static std::shared_ptr<ZapFR::Engine::HTTPTransport> gsHTTPTransport{std::make_shared<ZapFR::Engine::HTTPNetworkTransport>()};
+    static std::mutex gsHTTPTransportMutex{};
+    static ZapFR::Engine::Helpers::HTTPTransferLimits gsHTTPTransferLimits{};
+    static std::mutex gsHTTPTransferLimitsMutex{};
+    static constexpr uint64_t gsMinTransferRateGracePeriod{5};
+
+    // thrown from a probe's body handler to abandon the rest of the transfer
+    struct ProbeComplete
+    {
+    };
+
+    // stream buffer on top of a response stream that aborts the transfer when the body grows too big, the deadline passes, or the data trickles in too slowly
+    class LimitedStreamBuf : public std::streambuf
+    {
+      public:
+        LimitedStreamBuf(std::istream& source, const ZapFR::Engine::Helpers::HTTPTransferLimits& limits, const Poco::Timestamp& start)
+            : mSource(source), mLimits(limits), mStart(start)
+        {
+        }
+
+        uint64_t totalRead() const noexcept { return mTotalRead; }
+
+      protected:
+        int_type underflow() override
+        {
+            if (gptr() < egptr())
+            {
+                return traits_type::to_int_type(*gptr());
+            }
+
+            // only take what a single read of the underlying stream delivers, so the limits are checked as soon as data arrives
+            auto sourceBuf = mSource.rdbuf();
+            if (traits_type::eq_int_type(sourceBuf->sgetc(), traits_type::eof()))
+            {
+                return traits_type::eof();
+            }
+            auto available = std::clamp(sourceBuf->in_avail(), static_cast<std::streamsize>(1), static_cast<std::streamsize>(mBuffer.size()));
+            auto count = sourceBuf->sgetn(mBuffer.data(), available);
+            if (count <= 0)
+            {
+                return traits_type::eof();
+            }
+
+            mTotalRead += static_cast<uint64_t>(count);
+            checkLimits();
+
+            setg(mBuffer.data(), mBuffer.data(), mBuffer.data() + count);
+            return traits_type::to_int_type(*gptr());
+        }
+
+      private:
+        void checkLimits() const
+        {
+            if (mLimits.maxBodySize > 0 && mTotalRead > mLimits.maxBodySize)
+            {
+                throw std::runtime_error(fmt::format("Response body exceeds the maximum size of {} bytes", mLimits.maxBodySize));
+            }
+
+            auto elapsedSeconds = static_cast<uint64_t>(mStart.elapsed() / Poco::Timestamp::resolution());
+            if (mLimits.deadline > 0 && elapsedSeconds >= mLimits.deadline)
+            {
+                throw std::runtime_error(fmt::format("Transfer did not complete within {} seconds", mLimits.deadline));
+            }
+            if (mLimits.minTransferRate > 0 && elapsedSeconds >= gsMinTransferRateGracePeriod && (mTotalRead / elapsedSeconds) < mLimits.minTransferRate)
+            {
+                throw std::runtime_error(fmt::format("Transfer rate dropped below {} bytes per second", mLimits.minTransferRate));
+            }
+        }
+
+        std::istream& mSource;
+        ZapFR::Engine::Helpers::HTTPTransferLimits mLimits;
+        Poco::Timestamp mStart;
+        std::array<char, 16384> mBuffer{};
+        uint64_t mTotalRead{0};
+    };
+
+    // stream buffer that passes a stream through as is, counting the bytes along the way (to know how much compressed data went into the inflater)
+    class CountingStreamBuf : public std::streambuf
+    {
+      public:
+        explicit CountingStreamBuf(std::istream& source) : mSource(source) {}
+
+        uint64_t totalRead() const noexcept { return mTotalRead; }
+
+      protected:
+        int_type underflow() override
+        {
+            if (gptr() < egptr())
+            {
+                return traits_type::to_int_type(*gptr());
+            }
+
+            auto sourceBuf = mSource.rdbuf();
+            if (traits_type::eq_int_type(sourceBuf->sgetc(), traits_type::eof()))
+            {
+                return traits_type::eof();
+            }
+            auto available = std::clamp(sourceBuf->in_avail(), static_cast<std::streamsize>(1), static_cast<std::streamsize>(mBuffer.size()));
+            auto count = sourceBuf->sgetn(mBuffer.data(), available);
+            if (count <= 0)
+            {
+                return traits_type::eof();
+            }
+
+            mTotalRead += static_cast<uint64_t>(count);
+            setg(mBuffer.data(), mBuffer.data(), mBuffer.data() + count);
+            return traits_type::to_int_type(*gptr());
+        }
+
+      private:
+        std::istream& mSource;
+        std::array<char, 16384> mBuffer{};
+        uint64_t mTotalRead{0};
+    };
+
+    // inflates (if needed) and limits the response body, and hands it to the body handler; whatever the handler leaves unread is drained,
+    // so the connection can be reused; the body sizes are added to stats (if given), also when the transfer is aborted
+    void consumeResponseBody(const Poco::Net::HTTPResponse& response, std::istream& responseStream, const Poco::Timestamp& start,
+                             const std::function<void(std::istream&)>* bodyHandler, ZapFR::Engine::Helpers::HTTPTransferStats* stats)
+    {
+        // a 304 (or any other bodyless response) may still carry the Content-Encoding of the cached representation, so only inflate when there's an actual body
+        auto contentEncoding = Poco::toLower(response.get("Content-Encoding", ""));
+        auto hasBody = (response.getStatus() != Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED && response.getStatus() != Poco::Net::HTTPResponse::HTTP_NO_CONTENT &&
+                        response.getContentLength64() != 0);
+        if (!hasBody)
+        {
+            responseStream.ignore(std::numeric_limits<std::streamsize>::max());
+            return;
+        }
+
+        // the compressed bytes are only counted separately when there's something to inflate, otherwise both counts are the same
+        std::unique_ptr<CountingStreamBuf> countingBuf{nullptr};
+        std::unique_ptr<std::istream> countingStream{nullptr};
+        std::unique_ptr<Poco::InflatingInputStream> inflater{nullptr};
+        std::istream* source = &responseStream;
+        if (contentEncoding == "gzip" || contentEncoding == "x-gzip" || contentEncoding == "deflate")
+        {
+            auto type = (contentEncoding == "deflate" ? Poco::InflatingStreamBuf::STREAM_ZLIB : Poco::InflatingStreamBuf::STREAM_GZIP);
+            if (stats != nullptr)
+            {
+                countingBuf = std::make_unique<CountingStreamBuf>(responseStream);
+                countingStream = std::make_unique<std::istream>(countingBuf.get());
+                inflater = std::make_unique<Poco::InflatingInputStream>(*countingStream, type);
+            }
+            else
+            {
+                inflater = std::make_unique<Poco::InflatingInputStream>(responseStream, type);
+            }
+            source = inflater.get();
+        }
+
+        LimitedStreamBuf limitedBuf(*source, ZapFR::Engine::Helpers::httpTransferLimits(), start);
+        std::istream limitedStream(&limitedBuf);
+        limitedStream.exceptions(std::ios::badbit); // rethrows the limit violations raised inside the stream buffer
+
+        const auto recordStats = [&]()
+        {
+            if (stats != nullptr)
+            {
+                stats->bodyBytes += limitedBuf.totalRead();
+                stats->transferredBytes += (countingBuf != nullptr ? countingBuf->totalRead() : limitedBuf.totalRead());
+            }
+        };
+
+        try
+        {
+            if (bodyHandler != nullptr)
+            {
+                (*bodyHandler)(limitedStream);
+            }
+            limitedStream.ignore(std::numeric_limits<std::streamsize>::max());
+        }
+        catch (...)
+        {
+            recordStats();
+            throw;
+        }
+        recordStats();
+        responseStream.ignore(std::numeric_limits<std::streamsize>::max());
+    }
+
+    // the Retry-After header holds either a delay in seconds or an HTTP date
+    uint64_t parseRetryAfter(const Poco::Net::HTTPResponse& response)
+    {
+        auto retryAfter = Poco::trim(response.get("Retry-After", ""));
+        if (retryAfter.empty())
+        {
+            return ZapFR::Engine::HostThrottle::DefaultTooManyRequestsDelay;
+        }
+
+        uint64_t seconds{0};
+        if (Poco::NumberParser::tryParseUnsigned64(retryAfter, seconds))
+        {
+            return seconds;
+        }
+
+        Poco::DateTime retryDate;
+        int tzd{0};
+        if (Poco::DateTimeParser::tryParse(retryAfter, retryDate, tzd))
+        {
+            retryDate.makeUTC(tzd);
+            auto diff = retryDate - Poco::DateTime();
+            return (diff.totalSeconds() > 0 ? static_cast<uint64_t>(diff.totalSeconds()) : 0);
+        }
+        return ZapFR::Engine::HostThrottle::DefaultTooManyRequestsDelay;
+    }
+
+    // how long the response may be considered fresh according to Cache-Control: max-age or Expires, in seconds (0 if it isn't cacheable)
+    uint64_t parseFreshnessLifetime(const Poco::Net::HTTPResponse& response)
+    {
+        auto cacheControl = Poco::toLower(response.get("Cache-Control", ""));
+        if (cacheControl.find("no-cache") != std::string::npos || cacheControl.find("no-store") != std::string::npos)
+        {
+            return 0;
+        }
+
+        auto maxAgePos = cacheControl.find("max-age=");
+        if (maxAgePos != std::string::npos)
+        {
+            auto maxAgeStr = cacheControl.substr(maxAgePos + 8);
+            auto endPos = maxAgeStr.find_first_not_of("0123456789");
+            uint64_t maxAge{0};
+            if (Poco::NumberParser::tryParseUnsigned64(maxAgeStr.substr(0, endPos), maxAge))
+            {
+                return maxAge;
+            }
+        }
+
+        if (response.has("Expires"))
+        {
+            Poco::DateTime expires;
+            int tzd{0};
+            if (Poco::DateTimeParser::tryParse(Poco::trim(response.get("Expires")), expires, tzd))
+            {
+                expires.makeUTC(tzd);
+                auto diff = expires - Poco::DateTime();
+                return (diff.totalSeconds() > 0 ? static_cast<uint64_t>(diff.totalSeconds()) : 0);
+            }
+        }
+        return 0;
+    }
+
+    // temporary redirects that came with an explicit freshness lifetime, so they can be followed without asking the server again
+    struct CachedRedirect
+    {
+        std::string location{""};
+        Poco::Timestamp expires{};
+    };
+    static std::unordered_map<std::string, CachedRedirect> gsCachedRedirects{};
+    static std::mutex gsCachedRedirectsMutex{};
+    static constexpr size_t gsMaxCachedRedirects{1024};
+
+    std::optional<std::string> cachedRedirect(const std::string& url)
+    {
+        std::lock_guard<std::mutex> lock(gsCachedRedirectsMutex);
+        auto it = gsCachedRedirects.find(url);
+        if (it == gsCachedRedirects.end())
+        {
+            return {};
+        }
+        if (it->second.expires < Poco::Timestamp())
+        {
+            gsCachedRedirects.erase(it);
+            return {};
+        }
+        return it->second.location;
+    }
+
+    void cacheRedirect(const std::string& url, const std::string& location, uint64_t lifetime)
+    {
+        std::lock_guard<std::mutex> lock(gsCachedRedirectsMutex);
+        if (gsCachedRedirects.size() >= gsMaxCachedRedirects)
+        {
+            Poco::Timestamp now;
+            std::erase_if(gsCachedRedirects, [&](const auto& entry) { return entry.second.expires < now; });
+            if (gsCachedRedirects.size() >= gsMaxCachedRedirects)
+            {
+                gsCachedRedirects.clear();
+            }
+        }
+        auto expires = Poco::Timestamp() + static_cast<Poco::Timestamp::TimeDiff>(lifetime) * Poco::Timestamp::resolution();
+        gsCachedRedirects[url] = {location, expires};
+    }
 } // namespace
 
 void ZapFR::Engine::Helpers::splitString(const std::string& sourceString, char delimiter, std::vector<std::string>& outSubstrings)
@@ -84,23 +377,98 @@ std::string ZapFR::Engine::Helpers::joinIDNumbers(const std::vector<uint64_t>& s
     }
 }
 
-std::tuple<std::string, std::string> ZapFR::Engine::Helpers::performHTTPRequest(Poco::URI& url, const std::string& method, Poco::Net::HTTPCredentials& credentials,
-                                                                                const std::map<std::string, std::string>& parameters, std::optional<uint64_t> associatedFeedID,
-                                                                                std::optional<std::string> conditionalGetInfo)
+bool ZapFR::Engine::Helpers::acceptsContentCoding(const std::string& acceptEncoding, const std::string& coding)
 {
+    std::optional<double> codingQuality{};
+    std::optional<double> wildcardQuality{};
+
+    std::vector<std::string> entries;
+    splitString(acceptEncoding, ',', entries);
+    for (const auto& entry : entries)
     {
-        std::lock_guard<std::mutex> lock(gsSSLContextMutex);
-        if (gsSSLContext.isNull())
+        std::vector<std::string> parts;
+        splitString(entry, ';', parts);
+        if (parts.empty())
+        {
+            continue;
+        }
+
+        auto name = Poco::trim(parts.at(0));
+        double quality{1.0};
+        for (size_t i = 1; i < parts.size(); ++i)
+        {
+            auto param = Poco::trim(parts.at(i));
+            if (param.size() > 2 && Poco::icompare(param.substr(0, 2), "q=") == 0)
+            {
+                if (!Poco::NumberParser::tryParseFloat(param.substr(2), quality))
+                {
+                    quality = 0.0;
+                }
+            }
+        }
+
+        if (Poco::icompare(name, coding) == 0)
+        {
+            codingQuality = quality;
+        }
+        else if (name == "*")
         {
-#if POCO_VERSION < 0x010A0000
-            gsSSLContext = new Poco::Net::Context(Poco::Net::Context::TLSV1_2_CLIENT_USE, "", Poco::Net::Context::VERIFY_NONE);
-#else
-            gsSSLContext = new Poco::Net::Context(Poco::Net::Context::TLS_CLIENT_USE, "", Poco::Net::Context::VERIFY_NONE);
-            gsSSLContext->requireMinimumProtocol(Poco::Net::Context::PROTO_TLSV1_2);
-#endif
+            wildcardQuality = quality;
         }
     }
 
+    // an explicit mention of the coding takes precedence over the wildcard
+    if (codingQuality.has_value())
+    {
+        return codingQuality.value() > 0.0;
+    }
+    return wildcardQuality.has_value() && wildcardQuality.value() > 0.0;
+}
+
+void ZapFR::Engine::Helpers::setHTTPTransferLimits(const HTTPTransferLimits& limits)
+{
+    std::lock_guard<std::mutex> lock(gsHTTPTransferLimitsMutex);
+    gsHTTPTransferLimits = limits;
+}
+
+ZapFR::Engine::Helpers::HTTPTransferLimits ZapFR::Engine::Helpers::httpTransferLimits()
+{
+    std::lock_guard<std::mutex> lock(gsHTTPTransferLimitsMutex);
+    return gsHTTPTransferLimits;
+}
+
+void ZapFR::Engine::Helpers::setHTTPTransport(std::shared_ptr<HTTPTransport> transport)
+{
+    std::lock_guard<std::mutex> lock(gsHTTPTransportMutex);
+    gsHTTPTransport = (transport != nullptr ? transport : std::make_shared<HTTPNetworkTransport>());
+}
+
+std::shared_ptr<ZapFR::Engine::HTTPTransport> ZapFR::Engine::Helpers::httpTransport()
+{
+    std::lock_guard<std::mutex> lock(gsHTTPTransportMutex);
+    return gsHTTPTransport;
+}
+
+std::tuple<std::string, std::string> ZapFR::Engine::Helpers::performHTTPRequest(Poco::URI& url, const std::string& method, Poco::Net::HTTPCredentials& credentials,
+                                                                                const std::map<std::string, std::string>& parameters, std::optional<uint64_t> associatedFeedID,
+                                                                                std::optional<std::string> conditionalGetInfo, std::string* permanentRedirectURL,
+                                                                                HTTPTransferStats* transferStats)
+{
+    std::string body;
+    auto receivedConditionalGETInfo = performStreamingHTTPRequest(
+        url, method, credentials, parameters, [&](std::istream& bodyStream) { Poco::StreamCopier::copyToString(bodyStream, body); }, associatedFeedID,
+        conditionalGetInfo, permanentRedirectURL, {}, transferStats);
+    return std::make_tuple(std::move(body), std::move(receivedConditionalGETInfo));
+}
+
+std::string ZapFR::Engine::Helpers::performStreamingHTTPRequest(Poco::URI& url, const std::string& method, Poco::Net::HTTPCredentials& credentials,
+                                                                const std::map<std::string, std::string>& parameters,
+                                                                const std::function<void(std::istream&)>& bodyHandler, std::optional<uint64_t> associatedFeedID,
+                                                                std::optional<std::string> conditionalGetInfo, std::string* permanentRedirectURL,
+                                                                const std::map<std::string, std::string>& additionalHeaders, HTTPTransferStats* transferStats)
+{
+    auto transport = httpTransport();
+
     // stupid exception for YouTube's consent form bullshit
     auto host = url.getHost();
     if (Poco::endsWith(host, std::string("youtube.com")) || Poco::endsWith(host, std::string("youtu.be")) || Poco::endsWith(host, std::string("ytimg.com")))
@@ -122,7 +490,7 @@ std::tuple<std::string, std::string> ZapFR::Engine::Helpers::performHTTPRequest(
         }
     }
 
-    // lambda to convert relative url to absolute url, in case a 301/302 redirect is received
+    // lambda to convert relative url to absolute url, in case a redirect is received
     const auto ensureRedirectLocationIsAbsolute = [](const Poco::URI& originalURL, const std::string& newLocation) -> Poco::URI
     {
         Poco::URI newURI(originalURL);
@@ -137,22 +505,6 @@ std::tuple<std::string, std::string> ZapFR::Engine::Helpers::performHTTPRequest(
         return newURI;
     };
 
-    std::unique_ptr<Poco::Net::HTTPClientSession> session;
-
-    auto scheme = url.getScheme();
-    if (scheme == "https")
-    {
-        session = std::make_unique<Poco::Net::HTTPSClientSession>(url.getHost(), url.getPort(), gsSSLContext);
-    }
-    else if (scheme == "http")
-    {
-        session = std::make_unique<Poco::Net::HTTPClientSession>(url.getHost(), url.getPort());
-    }
-    else
-    {
-        throw std::runtime_error(fmt::format("Unknown scheme in URL: {}", url.toString()));
-    }
-
     if (method == Poco::Net::HTTPRequest::HTTP_GET)
     {
         for (const auto& [k, v] : parameters)
@@ -161,105 +513,225 @@ std::tuple<std::string, std::string> ZapFR::Engine::Helpers::performHTTPRequest(
         }
     }
 
-    auto path = url.getPathAndQuery();
-    if (path.empty())
+    // redirects are followed in place, so url ends up as the location the response was actually received from
+    const auto maxRedirects = httpTransferLimits().maxRedirects;
+    const auto originalURL = url.toString();
+    std::unordered_set<std::string> visitedURLs{originalURL};
+    uint64_t redirectCount{0};
+    auto allRedirectsPermanent{true};
+    const auto followRedirect = [&](const Poco::URI& newURL)
     {
-        path = "/";
-    }
-
-    session->setTimeout(Poco::Timespan(10, 0));
-    Poco::Net::HTTPRequest request(method, path, Poco::Net::HTTPMessage::HTTP_1_1);
-    request.setKeepAlive(false);
+        auto newURLStr = newURL.toString();
+        if (visitedURLs.contains(newURLStr))
+        {
+            throw std::runtime_error(fmt::format("Redirect loop detected for {} at {}", originalURL, newURLStr));
+        }
+        if (++redirectCount > maxRedirects)
+        {
+            throw std::runtime_error(fmt::format("Too many redirects (more than {}) for {}", maxRedirects, originalURL));
+        }
+        visitedURLs.insert(newURLStr);
+        url = newURL;
+    };
 
-    static const auto userAgent = fmt::format("ZapFeedReader/{}", ZapFR::Engine::APIVersion);
-    request.set("User-Agent", userAgent);
-    if (!credentials.empty())
+    auto currentMethod = method;
+    std::unique_ptr<Poco::Net::HTTPResponse> receivedResponse{nullptr};
+    while (true)
     {
-        std::stringstream b64Stream;
-        Poco::Base64Encoder encoder(b64Stream);
-        encoder << credentials.getUsername() << ":" << credentials.getPassword();
-        encoder.close();
-        request.set("Authorization", fmt::format("Basic {}", b64Stream.str()));
-    }
+        auto cachedLocation = cachedRedirect(url.toString());
+        if (cachedLocation.has_value())
+        {
+            Log::log(LogLevel::Debug, fmt::format("Following cached redirect from {} to {}", url.toString(), cachedLocation.value()), associatedFeedID);
+            allRedirectsPermanent = false;
+            followRedirect(Poco::URI(cachedLocation.value()));
+            continue;
+        }
 
-    if (conditionalGetInfo.has_value())
-    {
-        Poco::JSON::Parser parser;
-        auto root = parser.parse(conditionalGetInfo.value());
-        auto rootObj = root.extract<Poco::JSON::Object::Ptr>();
-        auto lastModified = rootObj->getValue<std::string>("l");
-        auto eTag = rootObj->getValue<std::string>("e");
-        if (!lastModified.empty())
+        auto path = url.getPathAndQuery();
+        if (path.empty())
         {
-            request.set("If-Modified-Since", lastModified);
+            path = "/";
         }
-        if (!eTag.empty())
+
+        Poco::Net::HTTPRequest request(currentMethod, path, Poco::Net::HTTPMessage::HTTP_1_1);
+        request.setHost(url.getHost(), url.getPort()); // the pooled session is connected to the resolved address, not the host name
+        request.setKeepAlive(true);
+
+        static const auto userAgent = fmt::format("ZapFeedReader/{}", ZapFR::Engine::APIVersion);
+        request.set("User-Agent", userAgent);
+        request.set("Accept-Encoding", "gzip, deflate");
+        if (!credentials.empty())
         {
-            request.set("If-None-Match", eTag);
+            std::stringstream b64Stream;
+            Poco::Base64Encoder encoder(b64Stream);
+            encoder << credentials.getUsername() << ":" << credentials.getPassword();
+            encoder.close();
+            request.set("Authorization", fmt::format("Basic {}", b64Stream.str()));
         }
-    }
 
-    if (method == Poco::Net::HTTPRequest::HTTP_POST || method == Poco::Net::HTTPRequest::HTTP_PATCH)
-    {
-        Poco::Net::HTMLForm form;
-        for (const auto& [k, v] : parameters)
+        if (conditionalGetInfo.has_value())
         {
-            form.add(k, v);
+            Poco::JSON::Parser parser;
+            auto root = parser.parse(conditionalGetInfo.value());
+            auto rootObj = root.extract<Poco::JSON::Object::Ptr>();
+            auto lastModified = rootObj->getValue<std::string>("l");
+            auto eTag = rootObj->getValue<std::string>("e");
+            if (!lastModified.empty())
+            {
+                request.set("If-Modified-Since", lastModified);
+            }
+            if (!eTag.empty())
+            {
+                request.set("If-None-Match", eTag);
+            }
         }
-        form.prepareSubmit(request);
-        form.write(session->sendRequest(request));
-    }
-    else
-    {
-        session->sendRequest(request);
-    }
 
-    Poco::Net::HTTPResponse response;
-    std::istream& responseStream = session->receiveResponse(response);
+        for (const auto& [k, v] : additionalHeaders)
+        {
+            request.set(k, v);
+        }
 
-    auto status = response.getStatus();
-    std::string resultStr;
-    Poco::StreamCopier::copyToString(responseStream, resultStr);
+        std::string requestBody;
+        if (currentMethod == Poco::Net::HTTPRequest::HTTP_POST || currentMethod == Poco::Net::HTTPRequest::HTTP_PATCH)
+        {
+            Poco::Net::HTMLForm form;
+            for (const auto& [k, v] : parameters)
+            {
+                form.add(k, v);
+            }
+            form.prepareSubmit(request);
+            std::stringstream formStream;
+            form.write(formStream);
+            requestBody = formStream.str();
+        }
 
-    if (status == Poco::Net::HTTPResponse::HTTP_MOVED_PERMANENTLY)
-    {
-        auto newURL = ensureRedirectLocationIsAbsolute(url, response.get("Location"));
-        Log::log(LogLevel::Info, fmt::format("Moved permanently to {}", newURL.toString()), associatedFeedID);
-        // TODO: limit amount of redirects
-        return performHTTPRequest(newURL, method, credentials, parameters, associatedFeedID);
+        Poco::Timestamp start;
+        HTTPTransport::Timings timings;
+        transport->exchange(
+            url, request, requestBody,
+            [&](Poco::Net::HTTPResponse& response, std::istream& responseStream)
+            {
+                if (transferStats != nullptr)
+                {
+                    transferStats->dnsTime += timings.dns;
+                    transferStats->connectTime += timings.connect;
+                    transferStats->tlsTime += timings.tls;
+                    transferStats->firstByteTime += timings.firstByte;
+                }
+
+                // only successful responses are handed to the body handler, the body of anything else is discarded
+                auto status = response.getStatus();
+                auto isSuccess = (status >= Poco::Net::HTTPResponse::HTTP_OK && status < Poco::Net::HTTPResponse::HTTP_MULTIPLE_CHOICES);
+                consumeResponseBody(response, responseStream, start, isSuccess ? &bodyHandler : nullptr, transferStats);
+                receivedResponse = std::make_unique<Poco::Net::HTTPResponse>(status, response.getReason());
+                for (const auto& [name, value] : response)
+                {
+                    receivedResponse->add(name, value);
+                }
+            },
+            timings);
+
+        const auto& redirectResponse = *receivedResponse;
+        auto redirectStatus = redirectResponse.getStatus();
+        auto isPermanentRedirect = (redirectStatus == Poco::Net::HTTPResponse::HTTP_MOVED_PERMANENTLY || redirectStatus == Poco::Net::HTTPResponse::HTTP_PERMANENT_REDIRECT);
+        auto isTemporaryRedirect = (redirectStatus == Poco::Net::HTTPResponse::HTTP_FOUND || redirectStatus == Poco::Net::HTTPResponse::HTTP_SEE_OTHER ||
+                                    redirectStatus == Poco::Net::HTTPResponse::HTTP_TEMPORARY_REDIRECT);
+        if ((!isPermanentRedirect && !isTemporaryRedirect) || !redirectResponse.has("Location"))
+        {
+            break;
+        }
+
+        auto newURL = ensureRedirectLocationIsAbsolute(url, redirectResponse.get("Location"));
+        if (isPermanentRedirect)
+        {
+            Log::log(LogLevel::Info, fmt::format("Moved permanently to {}", newURL.toString()), associatedFeedID);
+        }
+        else
+        {
+            Log::log(LogLevel::Info, fmt::format("Moved temporarily to {}", newURL.toString()), associatedFeedID);
+            allRedirectsPermanent = false;
+            auto lifetime = parseFreshnessLifetime(redirectResponse);
+            if (lifetime > 0)
+            {
+                cacheRedirect(url.toString(), newURL.toString(), lifetime);
+            }
+        }
+        if (redirectStatus == Poco::Net::HTTPResponse::HTTP_SEE_OTHER)
+        {
+            currentMethod = Poco::Net::HTTPRequest::HTTP_GET;
+        }
+        followRedirect(newURL);
     }
-    else if (status == Poco::Net::HTTPResponse::HTTP_FOUND)
+
+    if (permanentRedirectURL != nullptr)
     {
-        auto newURL = ensureRedirectLocationIsAbsolute(url, response.get("Location"));
-        Log::log(LogLevel::Info, fmt::format("Moved temporarily to {}", newURL.toString()), associatedFeedID);
-        // TODO: limit amount of redirects
-        return performHTTPRequest(newURL, method, credentials, parameters, associatedFeedID);
+        *permanentRedirectURL = (redirectCount > 0 && allRedirectsPermanent) ? url.toString() : "";
     }
-    else if (status == Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED)
+
+    const auto& response = *receivedResponse;
+    auto status = response.getStatus();
+
+    if (status == 401)
     {
-        resultStr = "";
+        throw std::runtime_error("HTTP status 401 Unauthorized; invalid or no credentials provided");
     }
-    else if (status == 401)
+    else if (status == 429 || (status == Poco::Net::HTTPResponse::HTTP_SERVICE_UNAVAILABLE && response.has("Retry-After")))
     {
-        throw std::runtime_error("HTTP status 401 Unauthorized; invalid or no credentials provided");
+        auto delay = parseRetryAfter(response);
+        HostThrottle::getInstance()->deferUntil(url.getHost(), HostThrottle::Clock::now() + std::chrono::seconds(delay));
+        Log::log(LogLevel::Warning, fmt::format("Host {} asked to back off; holding off requests for {} seconds", url.getHost(), delay), associatedFeedID);
     }
 
     if ((status < Poco::Net::HTTPResponse::HTTP_OK || status >= Poco::Net::HTTPResponse::HTTP_MULTIPLE_CHOICES) && status != Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED)
     {
-        auto msg = fmt::format("HTTP status {} received for {} {}", static_cast<uint32_t>(response.getStatus()), method, url.toString());
+        auto msg = fmt::format("HTTP status {} received for {} {}", static_cast<uint32_t>(response.getStatus()), currentMethod, url.toString());
         throw std::runtime_error(msg);
     }
 
     std::string receivedConditionalGETInfo;
-    if (response.has("Last-Modified") || response.has("ETag"))
+    auto freshnessLifetime = parseFreshnessLifetime(response);
+    if (response.has("Last-Modified") || response.has("ETag") || freshnessLifetime > 0)
     {
         Poco::JSON::Object cgiObj;
         cgiObj.set("l", response.get("Last-Modified", ""));
         cgiObj.set("e", response.get("ETag", ""));
+        if (freshnessLifetime > 0)
+        {
+            cgiObj.set("f", freshnessLifetime);
+        }
         std::stringstream ss;
         Poco::JSON::Stringifier::stringify(cgiObj, ss);
         receivedConditionalGETInfo = ss.str();
     }
 
-    return std::make_tuple(resultStr, receivedConditionalGETInfo);
+    return receivedConditionalGETInfo;
+}
+
+std::string ZapFR::Engine::Helpers::performHTTPProbe(Poco::URI& url, Poco::Net::HTTPCredentials& credentials, size_t maxBytes, std::optional<uint64_t> associatedFeedID)
+{
+    // ask for just the byte range we need, uncompressed because a truncated gzip stream can't be inflated; servers that ignore the range
+    // have their connection dropped (rather than drained and pooled) once enough of the body is in
+    const std::map<std::string, std::string> probeHeaders{{"Range", fmt::format("bytes=0-{}", maxBytes - 1)}, {"Accept-Encoding", "identity"}};
+
+    std::string data;
+    try
+    {
+        performStreamingHTTPRequest(
+            url, Poco::Net::HTTPRequest::HTTP_GET, credentials, {},
+            [&](std::istream& bodyStream)
+            {
+                data.resize(maxBytes);
+                bodyStream.read(data.data(), static_cast<std::streamsize>(maxBytes));
+                data.resize(static_cast<size_t>(bodyStream.gcount()));
+                if (data.size() == maxBytes && bodyStream.peek() != std::char_traits<char>::eof())
+                {
+                    throw ProbeComplete();
+                }
+            },
+            associatedFeedID, {}, nullptr, probeHeaders);
+    }
+    catch (const ProbeComplete&)
+    {
+    }
+    return data;
 }
@@ -0,0 +1,189 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include <Poco/String.h>
+
+#include "ZapFR/HostThrottle.h"
+
+ZapFR::Engine::HostThrottle* ZapFR::Engine::HostThrottle::getInstance()
+{
+    static HostThrottle instance{};
+    return &instance;
+}
+
+std::unique_ptr<ZapFR::Engine::HostThrottle::Permit> ZapFR::Engine::HostThrottle::tryAcquire(const std::string& host, Clock::time_point& retryAt)
+{
+    auto key = Poco::toLower(host);
+    auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (now >= mNextPrune)
+    {
+        removeIdleHosts(now);
+    }
+    auto& state = stateForHost(key, now);
+
+    // refill the token bucket for the time that passed since the last request
+    auto elapsed = std::chrono::duration<double>(now - state.lastRefill).count();
+    state.tokens = std::min(static_cast<double>(mLimits.burstSize), state.tokens + elapsed * static_cast<double>(mLimits.requestsPerMinute) / 60.0);
+    state.lastRefill = now;
+
+    retryAt = now;
+    if (state.blockedUntil > now)
+    {
+        retryAt = std::max(retryAt, state.blockedUntil);
+    }
+    auto nextSpacedRequest = state.lastRequest + std::chrono::milliseconds(mLimits.minSpacingInMilliseconds);
+    if (nextSpacedRequest > now)
+    {
+        retryAt = std::max(retryAt, nextSpacedRequest);
+    }
+    if (state.tokens < 1.0 && mLimits.requestsPerMinute > 0)
+    {
+        auto secondsUntilToken = (1.0 - state.tokens) * 60.0 / static_cast<double>(mLimits.requestsPerMinute);
+        retryAt = std::max(retryAt, now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(secondsUntilToken)));
+    }
+    if (state.activeRequests >= mLimits.maxConcurrentRequests)
+    {
+        // there's no telling when a running request finishes, so just check back after the minimum spacing
+        retryAt = std::max(retryAt, now + std::chrono::milliseconds(std::max(mLimits.minSpacingInMilliseconds, static_cast<uint64_t>(100))));
+    }
+
+    if (retryAt > now)
+    {
+        return nullptr;
+    }
+
+    state.activeRequests++;
+    state.lastRequest = now;
+    if (mLimits.requestsPerMinute > 0)
+    {
+        state.tokens -= 1.0;
+    }
+    return std::make_unique<Permit>(this, key);
+}
+
+void ZapFR::Engine::HostThrottle::deferUntil(const std::string& host, Clock::time_point until)
+{
+    auto key = Poco::toLower(host);
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto& state = stateForHost(key, Clock::now());
+    state.blockedUntil = std::max(state.blockedUntil, std::min(until, Clock::now() + std::chrono::seconds(MaxRetryAfterDelay)));
+}
+
+void ZapFR::Engine::HostThrottle::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::erase_if(mHosts, [](const auto& entry) { return entry.second.activeRequests == 0; });
+    for (auto& [host, state] : mHosts)
+    {
+        state.blockedUntil = {};
+        state.lastRequest = {};
+        state.tokens = static_cast<double>(mLimits.burstSize);
+    }
+}
+
+void ZapFR::Engine::HostThrottle::pruneIdleHosts()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    removeIdleHosts(Clock::now());
+}
+
+size_t ZapFR::Engine::HostThrottle::hostCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mHosts.size();
+}
+
+void ZapFR::Engine::HostThrottle::setLimits(const Limits& limits)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mLimits = limits;
+    mLimits.maxConcurrentRequests = std::max(mLimits.maxConcurrentRequests, static_cast<uint64_t>(1));
+    mLimits.burstSize = std::max(mLimits.burstSize, static_cast<uint64_t>(1));
+}
+
+ZapFR::Engine::HostThrottle::Limits ZapFR::Engine::HostThrottle::limits()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLimits;
+}
+
+void ZapFR::Engine::HostThrottle::release(const std::string& host)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mHosts.find(host);
+    if (it != mHosts.end() && it->second.activeRequests > 0)
+    {
+        it->second.activeRequests--;
+    }
+
+    auto now = Clock::now();
+    if (now >= mNextPrune)
+    {
+        removeIdleHosts(now);
+    }
+}
+
+// assumes mMutex is held by the caller
+ZapFR::Engine::HostThrottle::HostState& ZapFR::Engine::HostThrottle::stateForHost(const std::string& host, Clock::time_point now)
+{
+    auto it = mHosts.find(host);
+    if (it == mHosts.end())
+    {
+        HostState state;
+        state.tokens = static_cast<double>(mLimits.burstSize);
+        state.lastRefill = now;
+        it = mHosts.emplace(host, state).first;
+    }
+    return it->second;
+}
+
+// assumes mMutex is held by the caller; a host with nothing in flight, nothing to wait for and a full bucket behaves exactly like one that's
+// never been contacted, so its state can go
+bool ZapFR::Engine::HostThrottle::isIdle(const HostState& state, Clock::time_point now) const
+{
+    if (state.activeRequests > 0 || state.blockedUntil > now || state.lastRequest + std::chrono::milliseconds(mLimits.minSpacingInMilliseconds) > now)
+    {
+        return false;
+    }
+    if (mLimits.requestsPerMinute > 0)
+    {
+        auto elapsed = std::chrono::duration<double>(now - state.lastRefill).count();
+        return (state.tokens + elapsed * static_cast<double>(mLimits.requestsPerMinute) / 60.0 >= static_cast<double>(mLimits.burstSize));
+    }
+    return true;
+}
+
+// assumes mMutex is held by the caller
+void ZapFR::Engine::HostThrottle::removeIdleHosts(Clock::time_point now)
+{
+    std::erase_if(mHosts, [&](const auto& entry) { return isIdle(entry.second, now); });
+    mNextPrune = now + PruneInterval;
+}
+
+ZapFR::Engine::HostThrottle::Permit::Permit(HostThrottle* throttle, const std::string& host) : mThrottle(throttle), mHost(host)
+{
+}
+
+ZapFR::Engine::HostThrottle::Permit::~Permit()
+{
+    mThrottle->release(mHost);
+}
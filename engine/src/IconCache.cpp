@@ -0,0 +1,96 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZapFR/IconCache.h"
+
+ZapFR::Engine::IconCache* ZapFR::Engine::IconCache::getInstance()
+{
+    static IconCache instance{};
+    return &instance;
+}
+
+std::optional<std::string> ZapFR::Engine::IconCache::get(const std::string& hash)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mIndex.find(hash);
+    if (it == mIndex.end())
+    {
+        return {};
+    }
+
+    // move the entry to the front, marking it as most recently used
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return it->second->second;
+}
+
+void ZapFR::Engine::IconCache::put(const std::string& hash, const std::string& data)
+{
+    if (hash.empty() || data.empty())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mIndex.find(hash);
+    if (it != mIndex.end())
+    {
+        it->second->second = data;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return;
+    }
+
+    mEntries.emplace_front(hash, data);
+    mIndex[hash] = mEntries.begin();
+    evict();
+}
+
+bool ZapFR::Engine::IconCache::contains(const std::string& hash)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mIndex.contains(hash);
+}
+
+void ZapFR::Engine::IconCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mIndex.clear();
+}
+
+void ZapFR::Engine::IconCache::setCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCapacity = capacity;
+    evict();
+}
+
+size_t ZapFR::Engine::IconCache::size()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+// assumes mMutex is held by the caller
+void ZapFR::Engine::IconCache::evict()
+{
+    while (mEntries.size() > mCapacity)
+    {
+        mIndex.erase(mEntries.back().first);
+        mEntries.pop_back();
+    }
+}
@@ -0,0 +1,471 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <Poco/Data/Statement.h>
+#include <Poco/DigestEngine.h>
+#include <Poco/HMACEngine.h>
+#include <Poco/Net/HTTPCredentials.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/SHA1Engine.h>
+#include <Poco/SHA2Engine.h>
+#include <Poco/String.h>
+#include <Poco/Timestamp.h>
+#include <Poco/URI.h>
+#include <Poco/UUIDGenerator.h>
+
+#include "ZapFR/Agent.h"
+#include "ZapFR/AutoRefresh.h"
+#include "ZapFR/Database.h"
+#include "ZapFR/Helpers.h"
+#include "ZapFR/Log.h"
+#include "ZapFR/WebSub.h"
+#include "ZapFR/base/Source.h"
+
+using namespace Poco::Data::Keywords;
+
+namespace
+{
+    uint64_t nowEpoch()
+    {
+        return static_cast<uint64_t>(Poco::Timestamp().epochTime());
+    }
+
+    template <typename Engine> std::string hmacHex(const std::string& secret, const std::string& body)
+    {
+        Poco::HMACEngine<Engine> hmac(secret);
+        hmac.update(body);
+        return Poco::DigestEngine::digestToHex(hmac.digest());
+    }
+
+    std::optional<uint64_t> localSourceID()
+    {
+        auto sources = ZapFR::Engine::Source::getSources(ZapFR::Engine::ServerIdentifier::Local);
+        if (sources.empty())
+        {
+            return {};
+        }
+        return sources.at(0)->id();
+    }
+
+    // the subscription states; a subscription is requested, then pending until the hub verifies it, and active until its lease runs out
+    // (or the feed goes away, at which point it's unsubscribing until the hub verifies that too)
+    static const std::string gsStateRequested{"requested"};
+    static const std::string gsStatePending{"pending"};
+    static const std::string gsStateActive{"active"};
+    static const std::string gsStateUnsubscribing{"unsubscribing"};
+} // namespace
+
+ZapFR::Engine::WebSub::~WebSub()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShouldStop = true;
+    }
+    mWakeUp.notify_all();
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+ZapFR::Engine::WebSub* ZapFR::Engine::WebSub::getInstance()
+{
+    static WebSub instance{};
+    return &instance;
+}
+
+void ZapFR::Engine::WebSub::setCallbackURL(const std::string& url)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCallbackURL = url;
+        while (mCallbackURL.ends_with("/"))
+        {
+            mCallbackURL.pop_back();
+        }
+
+        // the thread is only started once there's something for it to do, so clients that never push don't carry it around
+        if (!mCallbackURL.empty() && !mThread.joinable())
+        {
+            mThread = std::thread(&WebSub::run, this);
+        }
+    }
+    mWakeUp.notify_all();
+}
+
+std::string ZapFR::Engine::WebSub::callbackURL()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCallbackURL;
+}
+
+bool ZapFR::Engine::WebSub::isEnabled()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return !mCallbackURL.empty();
+}
+
+void ZapFR::Engine::WebSub::updateFeed(uint64_t feedID, const std::string& hubURL, const std::string& topicURL)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    std::vector<uint64_t> ids;
+    std::vector<std::string> hubs;
+    std::vector<std::string> topics;
+    Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+    selectStmt << "SELECT id,hub,topic FROM websub_subscriptions WHERE feedID=? AND state!=?", use(feedID), useRef(gsStateUnsubscribing), into(ids), into(hubs),
+        into(topics), now;
+
+    auto alreadySubscribed{false};
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        if (!hubURL.empty() && hubs.at(i) == hubURL && topics.at(i) == topicURL)
+        {
+            alreadySubscribed = true;
+            continue;
+        }
+
+        // the feed moved to another hub or topic, or stopped advertising one
+        Log::log(LogLevel::Info, fmt::format("Feed no longer advertises WebSub hub {} for {}; unsubscribing", hubs.at(i), topics.at(i)), feedID);
+        auto id = ids.at(i);
+        Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+        updateStmt << "UPDATE websub_subscriptions SET state=?, nextAttempt=0 WHERE id=?", useRef(gsStateUnsubscribing), use(id), now;
+    }
+
+    if (!hubURL.empty() && !alreadySubscribed)
+    {
+        Log::log(LogLevel::Info, fmt::format("Feed advertises WebSub hub {}; subscribing to {}", hubURL, topicURL), feedID);
+        auto token = Poco::UUIDGenerator::defaultGenerator().createRandom().toString();
+        auto secret = Poco::UUIDGenerator::defaultGenerator().createRandom().toString();
+        Poco::Data::Statement insertStmt(*(Database::getInstance()->session()));
+        insertStmt << "INSERT INTO websub_subscriptions (feedID,hub,topic,token,secret,state) VALUES (?,?,?,?,?,?)", use(feedID), useRef(hubURL), useRef(topicURL),
+            useRef(token), useRef(secret), useRef(gsStateRequested), now;
+    }
+
+    if (!ids.empty() || !hubURL.empty())
+    {
+        mWakeUp.notify_all();
+    }
+}
+
+void ZapFR::Engine::WebSub::removeFeed(uint64_t feedID)
+{
+    // without a callback URL, the hubs can't verify the unsubscribe request anyway, and will let the lease run out
+    Poco::Data::Statement stmt(*(Database::getInstance()->session()));
+    if (isEnabled())
+    {
+        stmt << "UPDATE websub_subscriptions SET state=?, nextAttempt=0 WHERE feedID=? AND state!=?", useRef(gsStateUnsubscribing), use(feedID),
+            useRef(gsStateUnsubscribing), now;
+        mWakeUp.notify_all();
+    }
+    else
+    {
+        stmt << "DELETE FROM websub_subscriptions WHERE feedID=?", use(feedID), now;
+    }
+}
+
+bool ZapFR::Engine::WebSub::hasActiveSubscription(uint64_t feedID)
+{
+    uint64_t count{0};
+    auto currentTime = nowEpoch();
+    Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+    selectStmt << "SELECT COUNT(*) FROM websub_subscriptions WHERE feedID=? AND state=? AND leaseExpires>?", use(feedID), useRef(gsStateActive), use(currentTime), into(count),
+        now;
+    return count > 0;
+}
+
+std::unordered_set<uint64_t> ZapFR::Engine::WebSub::activelySubscribedFeeds()
+{
+    std::vector<uint64_t> feedIDs;
+    auto currentTime = nowEpoch();
+    Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+    selectStmt << "SELECT DISTINCT feedID FROM websub_subscriptions WHERE state=? AND leaseExpires>?", useRef(gsStateActive), use(currentTime), into(feedIDs), now;
+    return std::unordered_set<uint64_t>(feedIDs.begin(), feedIDs.end());
+}
+
+uint64_t ZapFR::Engine::WebSub::activeSubscriptionCount()
+{
+    uint64_t count{0};
+    auto currentTime = nowEpoch();
+    Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+    selectStmt << "SELECT COUNT(*) FROM websub_subscriptions WHERE state=? AND leaseExpires>?", useRef(gsStateActive), use(currentTime), into(count), now;
+    return count;
+}
+
+void ZapFR::Engine::WebSub::processDueSubscriptions()
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    auto currentTime = nowEpoch();
+    auto renewalThreshold = currentTime + RenewalMargin;
+    std::vector<Subscription> dueSubscriptions;
+    {
+        Subscription s;
+        Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+        selectStmt << "SELECT id,feedID,hub,topic,token,secret,state,leaseExpires,nextAttempt FROM websub_subscriptions"
+                      " WHERE nextAttempt<=? AND (state!=? OR leaseExpires<=?)",
+            use(currentTime), useRef(gsStateActive), use(renewalThreshold), into(s.id), into(s.feedID), into(s.hub), into(s.topic), into(s.token), into(s.secret),
+            into(s.state), into(s.leaseExpires), into(s.nextAttempt), range(0, 1);
+        while (!selectStmt.done())
+        {
+            if (selectStmt.execute() > 0)
+            {
+                dueSubscriptions.emplace_back(s);
+            }
+        }
+    }
+
+    for (auto& subscription : dueSubscriptions)
+    {
+        if (subscription.state == gsStateUnsubscribing)
+        {
+            // an unsubscribe request is sent once; if it fails, or the hub never verifies it, the subscription is simply forgotten
+            if (subscription.nextAttempt == 0 && sendRequest(subscription, "unsubscribe"))
+            {
+                auto nextAttempt = currentTime + RetryInterval;
+                Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+                updateStmt << "UPDATE websub_subscriptions SET nextAttempt=? WHERE id=?", use(nextAttempt), use(subscription.id), now;
+            }
+            else
+            {
+                Poco::Data::Statement deleteStmt(*(Database::getInstance()->session()));
+                deleteStmt << "DELETE FROM websub_subscriptions WHERE id=?", use(subscription.id), now;
+            }
+            continue;
+        }
+
+        if (subscription.state == gsStateActive && subscription.leaseExpires <= currentTime)
+        {
+            // the lease ran out before it could be renewed, so the feed has to be polled on its regular schedule again until the hub is back
+            Log::log(LogLevel::Warning, fmt::format("WebSub subscription to {} lapsed; falling back to polling", subscription.hub), subscription.feedID);
+            subscription.state = gsStateRequested;
+            auto sourceID = localSourceID();
+            if (sourceID.has_value())
+            {
+                AutoRefresh::getInstance()->scheduleFeed(sourceID.value(), subscription.feedID, currentTime);
+            }
+        }
+
+        // a subscription that's already active stays active while it's being renewed
+        auto newState = (subscription.state == gsStateActive ? gsStateActive : gsStatePending);
+        if (!sendRequest(subscription, "subscribe"))
+        {
+            newState = subscription.state;
+        }
+        auto nextAttempt = currentTime + RetryInterval;
+        Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+        updateStmt << "UPDATE websub_subscriptions SET state=?, nextAttempt=? WHERE id=?", useRef(newState), use(nextAttempt), use(subscription.id), now;
+    }
+}
+
+bool ZapFR::Engine::WebSub::sendRequest(const Subscription& subscription, const std::string& mode)
+{
+    std::map<std::string, std::string> parameters{
+        {"hub.callback", fmt::format("{}/websub/{}", callbackURL(), subscription.token)},
+        {"hub.mode", mode},
+        {"hub.topic", subscription.topic},
+    };
+    if (mode == "subscribe")
+    {
+        parameters["hub.lease_seconds"] = std::to_string(mLeaseDurationInSeconds);
+        parameters["hub.secret"] = subscription.secret;
+    }
+
+    try
+    {
+        Poco::Net::HTTPCredentials creds;
+        auto uri = Poco::URI(subscription.hub);
+        Helpers::performHTTPRequest(uri, Poco::Net::HTTPRequest::HTTP_POST, creds, parameters, subscription.feedID);
+        Log::log(LogLevel::Debug, fmt::format("Sent WebSub {} request for {} to {}", mode, subscription.topic, subscription.hub), subscription.feedID);
+        return true;
+    }
+    catch (const Poco::Exception& e)
+    {
+        Log::log(LogLevel::Warning, fmt::format("WebSub {} request to {} failed: {}", mode, subscription.hub, e.displayText()), subscription.feedID);
+    }
+    catch (const std::exception& e)
+    {
+        Log::log(LogLevel::Warning, fmt::format("WebSub {} request to {} failed: {}", mode, subscription.hub, e.what()), subscription.feedID);
+    }
+    return false;
+}
+
+std::optional<std::string> ZapFR::Engine::WebSub::verifyIntent(const std::string& token, const std::string& mode, const std::string& topic,
+                                                               const std::string& challenge, uint64_t leaseSeconds)
+{
+    auto subscription = subscriptionForToken(token);
+    if (!subscription.has_value() || subscription->topic != topic)
+    {
+        return {};
+    }
+
+    if (mode == "subscribe" && (subscription->state == gsStatePending || subscription->state == gsStateActive) && !challenge.empty())
+    {
+        auto leaseExpires = nowEpoch() + (leaseSeconds > 0 ? leaseSeconds : mLeaseDurationInSeconds.load());
+        Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+        updateStmt << "UPDATE websub_subscriptions SET state=?, leaseExpires=?, nextAttempt=0 WHERE id=?", useRef(gsStateActive), use(leaseExpires),
+            use(subscription->id), now;
+        Log::log(LogLevel::Info, fmt::format("WebSub subscription to {} confirmed by the hub", subscription->hub), subscription->feedID);
+        return challenge;
+    }
+    else if (mode == "unsubscribe" && subscription->state == gsStateUnsubscribing && !challenge.empty())
+    {
+        Poco::Data::Statement deleteStmt(*(Database::getInstance()->session()));
+        deleteStmt << "DELETE FROM websub_subscriptions WHERE id=?", use(subscription->id), now;
+        return challenge;
+    }
+    else if (mode == "denied" && subscription->state != gsStateUnsubscribing)
+    {
+        Log::log(LogLevel::Warning, fmt::format("WebSub hub {} refused the subscription", subscription->hub), subscription->feedID);
+        auto nextAttempt = nowEpoch() + DeniedRetryInterval;
+        Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+        updateStmt << "UPDATE websub_subscriptions SET state=?, leaseExpires=0, nextAttempt=? WHERE id=?", useRef(gsStateRequested), use(nextAttempt),
+            use(subscription->id), now;
+    }
+    return {};
+}
+
+ZapFR::Engine::WebSub::Delivery ZapFR::Engine::WebSub::deliver(const std::string& token, const std::string& signature, std::string&& body)
+{
+    auto subscription = subscriptionForToken(token);
+    if (!subscription.has_value() || subscription->state == gsStateUnsubscribing)
+    {
+        return Delivery::UnknownSubscription;
+    }
+
+    if (!isSignatureValid(subscription->secret, signature, body))
+    {
+        Log::log(LogLevel::Warning, "Ignored WebSub content with a missing or invalid signature", subscription->feedID);
+        return Delivery::InvalidSignature;
+    }
+
+    auto sourceID = localSourceID();
+    if (!sourceID.has_value())
+    {
+        return Delivery::UnknownSubscription;
+    }
+
+    Log::log(LogLevel::Info, fmt::format("Received {} bytes of content pushed by WebSub hub {}", body.size(), subscription->hub), subscription->feedID);
+    mPushedUpdateCount++;
+    Agent::getInstance()->queueIngestPushedFeed(sourceID.value(), subscription->feedID, std::move(body));
+    return Delivery::Accepted;
+}
+
+std::optional<ZapFR::Engine::WebSub::Subscription> ZapFR::Engine::WebSub::subscriptionForToken(const std::string& token)
+{
+    Subscription s;
+    Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+    selectStmt << "SELECT id,feedID,hub,topic,token,secret,state,leaseExpires,nextAttempt FROM websub_subscriptions WHERE token=?", useRef(token), into(s.id),
+        into(s.feedID), into(s.hub), into(s.topic), into(s.token), into(s.secret), into(s.state), into(s.leaseExpires), into(s.nextAttempt), range(0, 1);
+    if (selectStmt.execute() > 0)
+    {
+        return s;
+    }
+    return {};
+}
+
+bool ZapFR::Engine::WebSub::isSignatureValid(const std::string& secret, const std::string& signature, const std::string& body)
+{
+    // X-Hub-Signature: <method>=<hex HMAC of the body, keyed with our secret>, where the hub picks any of the methods the spec requires us to accept
+    auto separator = signature.find('=');
+    if (separator == std::string::npos)
+    {
+        return false;
+    }
+
+    std::string expected;
+    auto method = Poco::toLower(signature.substr(0, separator));
+    if (method == "sha1")
+    {
+        expected = hmacHex<Poco::SHA1Engine>(secret, body);
+    }
+    else if (method == "sha256")
+    {
+        expected = hmacHex<Poco::SHA2Engine256>(secret, body);
+    }
+    else if (method == "sha384")
+    {
+        expected = hmacHex<Poco::SHA2Engine384>(secret, body);
+    }
+    else if (method == "sha512")
+    {
+        expected = hmacHex<Poco::SHA2Engine512>(secret, body);
+    }
+    else
+    {
+        return false;
+    }
+    auto received = Poco::toLower(signature.substr(separator + 1));
+
+    // compare in constant time, so the signature can't be guessed byte by byte
+    if (expected.size() != received.size())
+    {
+        return false;
+    }
+    unsigned char difference{0};
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        difference |= static_cast<unsigned char>(expected.at(i) ^ received.at(i));
+    }
+    return difference == 0;
+}
+
+void ZapFR::Engine::WebSub::run()
+{
+    // give the application some time to initialize (e.g. the database) before the subscriptions are looked at
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWakeUp.wait_for(lock, std::chrono::seconds(5), [&]() { return mShouldStop; });
+    }
+
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mShouldStop)
+            {
+                break;
+            }
+        }
+
+        try
+        {
+            processDueSubscriptions();
+        }
+        catch (const Poco::Exception& e)
+        {
+            Log::log(LogLevel::Error, fmt::format("Failed to process the WebSub subscriptions: {}", e.displayText()));
+        }
+        catch (const std::exception& e)
+        {
+            Log::log(LogLevel::Error, fmt::format("Failed to process the WebSub subscriptions: {}", e.what()));
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWakeUp.wait_for(lock, std::chrono::seconds(CheckInterval), [&]() { return mShouldStop; });
+    }
+}
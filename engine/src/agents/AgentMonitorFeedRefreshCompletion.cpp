@@ -33,7 +33,7 @@ void ZapFR::Engine::AgentMonitorFeedRefreshCompletion::run()
 {
     while (true && !mShouldAbort)
     {
-        auto refreshThreadCount = mAgentManager->totalCountOfType(Type::FeedRefresh);
+        auto refreshThreadCount = mAgentManager->totalCountOfType(Type::FeedRefresh) + mAgentManager->totalCountOfType(Type::FeedIngest);
         if (refreshThreadCount == 0)
         {
             break;
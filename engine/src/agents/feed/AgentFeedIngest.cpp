@@ -0,0 +1,44 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZapFR/agents/feed/AgentFeedIngest.h"
+#include "ZapFR/Agent.h"
+#include "ZapFR/base/Feed.h"
+#include "ZapFR/base/Source.h"
+
+ZapFR::Engine::AgentFeedIngest::AgentFeedIngest(uint64_t sourceID, uint64_t feedID, FeedLocal::FetchedData&& fetchedData,
+                                                std::function<void(uint64_t, ZapFR::Engine::Feed*)> finishedCallback)
+    : AgentRunnable(sourceID), mFeedID(feedID), mFetchedData(std::move(fetchedData)), mFinishedCallback(finishedCallback)
+{
+}
+
+void ZapFR::Engine::AgentFeedIngest::payload(Source* source)
+{
+    auto feed = source->getFeed(mFeedID, ZapFR::Engine::Source::FetchInfo::None);
+    if (!feed.has_value())
+    {
+        return;
+    }
+
+    auto localFeed = dynamic_cast<FeedLocal*>(feed.value().get());
+    if (localFeed != nullptr)
+    {
+        localFeed->ingest(std::move(mFetchedData)); // the parsed feed is released as soon as it's ingested
+    }
+    mFinishedCallback(mSourceID, feed.value().get());
+}
@@ -16,10 +16,14 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <Poco/URI.h>
+
 #include "ZapFR/agents/feed/AgentFeedRefresh.h"
 #include "ZapFR/Agent.h"
+#include "ZapFR/HostThrottle.h"
 #include "ZapFR/base/Feed.h"
 #include "ZapFR/base/Source.h"
+#include "ZapFR/local/FeedLocal.h"
 
 ZapFR::Engine::AgentFeedRefresh::AgentFeedRefresh(uint64_t sourceID, uint64_t feedID, std::function<void(uint64_t, ZapFR::Engine::Feed*)> finishedCallback)
     : AgentRunnable(sourceID), mFeedID(feedID), mFinishedCallback(finishedCallback)
@@ -29,7 +33,48 @@ ZapFR::Engine::AgentFeedRefresh::AgentFeedRefresh(uint64_t sourceID, uint64_t fe
 void ZapFR::Engine::AgentFeedRefresh::payload(Source* source)
 {
     auto feed = source->getFeed(mFeedID, ZapFR::Engine::Source::FetchInfo::None);
-    if (feed.has_value())
+    if (!feed.has_value())
+    {
+        return;
+    }
+
+    // local feeds only do the network part here (the body is parsed as it comes in), storing the posts is handed off to the ingest stage
+    auto localFeed = dynamic_cast<FeedLocal*>(feed.value().get());
+    if (localFeed != nullptr)
+    {
+        // don't hammer a single host; if it's being throttled, requeue the refresh for when it's allowed again so the other hosts keep going
+        localFeed->fetchData();
+        std::string host;
+        try
+        {
+            host = Poco::URI(localFeed->url()).getHost();
+        }
+        catch (const Poco::Exception&)
+        {
+            // invalid URLs are reported by the fetch itself
+        }
+
+        std::unique_ptr<HostThrottle::Permit> permit{nullptr};
+        if (!host.empty())
+        {
+            HostThrottle::Clock::time_point retryAt;
+            permit = HostThrottle::getInstance()->tryAcquire(host, retryAt);
+            if (permit == nullptr)
+            {
+                Agent::getInstance()->queueRefreshFeed(mSourceID, mFeedID, mFinishedCallback, retryAt);
+                return;
+            }
+        }
+
+        auto fetchedData = localFeed->fetch();
+        permit.reset();
+        if (fetchedData.has_value())
+        {
+            Agent::getInstance()->queueIngestFeed(mSourceID, mFeedID, std::move(fetchedData.value()), mFinishedCallback);
+            return;
+        }
+    }
+    else
     {
         feed.value()->refresh();
     }
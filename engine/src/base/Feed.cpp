@@ -34,10 +34,65 @@ const std::unordered_map<ZapFR::Engine::Feed::Statistic, std::string> ZapFR::Eng
     {Statistic::NewestPost, JSON::Statistic::NewestPost},
 };
 
+namespace
+{
+    static const std::unordered_map<ZapFR::Engine::Feed::Telemetry::Result, std::string> gsTelemetryResultJSONIdentifierMap{
+        {ZapFR::Engine::Feed::Telemetry::Result::Parsed, ZapFR::Engine::JSON::FeedTelemetry::ResultParsed},
+        {ZapFR::Engine::Feed::Telemetry::Result::NotModified, ZapFR::Engine::JSON::FeedTelemetry::ResultNotModified},
+        {ZapFR::Engine::Feed::Telemetry::Result::Unchanged, ZapFR::Engine::JSON::FeedTelemetry::ResultUnchanged},
+        {ZapFR::Engine::Feed::Telemetry::Result::Pushed, ZapFR::Engine::JSON::FeedTelemetry::ResultPushed},
+        {ZapFR::Engine::Feed::Telemetry::Result::Failed, ZapFR::Engine::JSON::FeedTelemetry::ResultFailed},
+    };
+} // namespace
+
 ZapFR::Engine::Feed::Feed(uint64_t feedID, Source* parentSource) : mID(feedID), mParentSource(parentSource)
 {
 }
 
+Poco::JSON::Object ZapFR::Engine::Feed::Telemetry::toJSON() const
+{
+    Poco::JSON::Object o;
+    o.set(JSON::FeedTelemetry::Timestamp, timestamp);
+    o.set(JSON::FeedTelemetry::Result, gsTelemetryResultJSONIdentifierMap.at(result));
+    o.set(JSON::FeedTelemetry::DNSTime, dnsTime);
+    o.set(JSON::FeedTelemetry::ConnectTime, connectTime);
+    o.set(JSON::FeedTelemetry::TLSTime, tlsTime);
+    o.set(JSON::FeedTelemetry::FirstByteTime, firstByteTime);
+    o.set(JSON::FeedTelemetry::TransferredBytes, transferredBytes);
+    o.set(JSON::FeedTelemetry::BodyBytes, bodyBytes);
+    o.set(JSON::FeedTelemetry::ParseTime, parseTime);
+    o.set(JSON::FeedTelemetry::IngestTime, ingestTime);
+    o.set(JSON::FeedTelemetry::NewItems, newItems);
+    o.set(JSON::FeedTelemetry::UpdatedItems, updatedItems);
+    return o;
+}
+
+ZapFR::Engine::Feed::Telemetry ZapFR::Engine::Feed::Telemetry::fromJSON(const Poco::JSON::Object::Ptr o)
+{
+    Telemetry t;
+    t.timestamp = o->getValue<std::string>(JSON::FeedTelemetry::Timestamp);
+    auto result = o->getValue<std::string>(JSON::FeedTelemetry::Result);
+    for (const auto& [r, identifier] : gsTelemetryResultJSONIdentifierMap)
+    {
+        if (identifier == result)
+        {
+            t.result = r;
+            break;
+        }
+    }
+    t.dnsTime = o->getValue<uint64_t>(JSON::FeedTelemetry::DNSTime);
+    t.connectTime = o->getValue<uint64_t>(JSON::FeedTelemetry::ConnectTime);
+    t.tlsTime = o->getValue<uint64_t>(JSON::FeedTelemetry::TLSTime);
+    t.firstByteTime = o->getValue<uint64_t>(JSON::FeedTelemetry::FirstByteTime);
+    t.transferredBytes = o->getValue<uint64_t>(JSON::FeedTelemetry::TransferredBytes);
+    t.bodyBytes = o->getValue<uint64_t>(JSON::FeedTelemetry::BodyBytes);
+    t.parseTime = o->getValue<uint64_t>(JSON::FeedTelemetry::ParseTime);
+    t.ingestTime = o->getValue<uint64_t>(JSON::FeedTelemetry::IngestTime);
+    t.newItems = o->getValue<uint64_t>(JSON::FeedTelemetry::NewItems);
+    t.updatedItems = o->getValue<uint64_t>(JSON::FeedTelemetry::UpdatedItems);
+    return t;
+}
+
 Poco::JSON::Object ZapFR::Engine::Feed::toJSON() const
 {
     Poco::JSON::Object o;
@@ -54,6 +54,11 @@ void ZapFR::Engine::FeedDummy::clearLogs()
     throw std::runtime_error("Not implemented");
 }
 
+std::vector<ZapFR::Engine::Feed::Telemetry> ZapFR::Engine::FeedDummy::getTelemetry()
+{
+    throw std::runtime_error("Not implemented");
+}
+
 void ZapFR::Engine::FeedDummy::updateProperties(const std::string& /*feedURL*/, std::optional<uint64_t> /*refreshIntervalInSeconds*/)
 {
     throw std::runtime_error("Not implemented");
@@ -48,6 +48,11 @@ void ZapFR::Engine::SourceDummy::removeFeed(uint64_t /*feedID*/)
     throw std::runtime_error("Not implemented");
 }
 
+std::unordered_map<std::string, std::string> ZapFR::Engine::SourceDummy::getIcons(const std::unordered_set<std::string>& /*iconHashes*/)
+{
+    throw std::runtime_error("Not implemented");
+}
+
 /* ************************** FOLDER STUFF ************************** */
 std::vector<std::unique_ptr<ZapFR::Engine::Folder>> ZapFR::Engine::SourceDummy::getFolders(uint64_t /*parent*/, uint32_t /*fetchInfo*/)
 {
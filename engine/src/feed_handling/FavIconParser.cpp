@@ -40,6 +40,11 @@ void ZapFR::Engine::FavIconParser::parseURL(const std::string& url, uint64_t ass
     parseString(html, {});
 }
 
+bool ZapFR::Engine::FavIconParser::hasPageSpecificIcons(const Poco::URI& uri)
+{
+    return Poco::endsWith(uri.getHost(), std::string("youtube.com"));
+}
+
 void ZapFR::Engine::FavIconParser::parseString(const std::string& html, const std::optional<std::string>& originalURL)
 {
     if (originalURL.has_value())
@@ -50,7 +55,7 @@ void ZapFR::Engine::FavIconParser::parseString(const std::string& html, const st
     auto uri = Poco::URI(mURL);
 
     // exception for YouTube: extract the channel image from the ytInitialData variable
-    if (Poco::endsWith(uri.getHost(), std::string("youtube.com")))
+    if (hasPageSpecificIcons(uri))
     {
         static Poco::RegularExpression ytInitialDataRegex("var ytInitialData = ({.*?});");
         Poco::RegularExpression::MatchVec matches;
@@ -16,6 +16,14 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #define FMT_HEADER_ONLY
 #include <fmt/core.h>
 
@@ -28,6 +36,107 @@
 #include "ZapFR/Helpers.h"
 #include "ZapFR/feed_handling/FeedDiscovery.h"
 
+namespace
+{
+    // every thread discovery leaves running in the background is counted, so joinAll() can wait for them before the engine is torn down
+    std::mutex gsBackgroundThreadsMutex{};
+    std::condition_variable gsBackgroundThreadFinished{};
+    size_t gsBackgroundThreadCount{0};
+    std::atomic<bool> gsJoiningBackgroundThreads{false};
+
+    void startBackgroundThread(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(gsBackgroundThreadsMutex);
+            if (gsJoiningBackgroundThreads)
+            {
+                return;
+            }
+            gsBackgroundThreadCount++;
+        }
+
+        std::thread(
+            [task = std::move(task)]() mutable
+            {
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                }
+                task = nullptr; // release whatever it captured before joinAll() can return
+
+                std::lock_guard<std::mutex> lock(gsBackgroundThreadsMutex);
+                gsBackgroundThreadCount--;
+                gsBackgroundThreadFinished.notify_all();
+            })
+            .detach();
+    }
+
+    // shared between verify() and the probing threads, which may outlive it when the deadline passes
+    struct ProbeState
+    {
+        std::mutex mutex{};
+        std::condition_variable probeFinished{};
+        std::vector<ZapFR::Engine::DiscoveredFeed> candidates{};
+        std::vector<std::optional<bool>> outcomes{}; // per candidate: confirmed, rejected or not probed yet
+        size_t nextCandidate{0};
+        size_t probeCount{0};
+        size_t finishedProbeCount{0};
+        bool abandoned{false};
+        std::function<void(const ZapFR::Engine::DiscoveredFeed&)> feedVerified{};
+    };
+
+    void probeCandidates(std::shared_ptr<ProbeState> state)
+    {
+        while (true)
+        {
+            size_t index{0};
+            Poco::URI uri;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                while (state->nextCandidate < state->candidates.size() && state->outcomes.at(state->nextCandidate).has_value())
+                {
+                    state->nextCandidate++;
+                }
+                if (state->abandoned || gsJoiningBackgroundThreads || state->nextCandidate >= state->candidates.size())
+                {
+                    return;
+                }
+                index = state->nextCandidate++;
+                uri = Poco::URI(state->candidates.at(index).url);
+            }
+
+            std::optional<ZapFR::Engine::Feed::Type> type{};
+            try
+            {
+                Poco::Net::HTTPCredentials creds;
+                auto data = ZapFR::Engine::Helpers::performHTTPProbe(uri, creds, ZapFR::Engine::FeedDiscovery::ProbeSize);
+                type = ZapFR::Engine::FeedDiscovery::sniffFeedType(data);
+            }
+            catch (...)
+            {
+            }
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            auto& candidate = state->candidates.at(index);
+            state->outcomes.at(index) = type.has_value();
+            if (type.has_value())
+            {
+                candidate.type = type.value();
+                candidate.verified = true;
+                if (!state->abandoned && state->feedVerified)
+                {
+                    state->feedVerified(candidate);
+                }
+            }
+            state->finishedProbeCount++;
+            state->probeFinished.notify_all();
+        }
+    }
+} // namespace
+
 ZapFR::Engine::FeedDiscovery::FeedDiscovery(const std::string& url)
 {
     if (url.empty())
@@ -85,6 +194,204 @@ void ZapFR::Engine::FeedDiscovery::discover()
     }
 }
 
+void ZapFR::Engine::FeedDiscovery::verify(const std::function<void(const DiscoveredFeed&)>& feedVerified, const std::function<bool()>& shouldAbort)
+{
+    auto state = std::make_shared<ProbeState>();
+    state->feedVerified = feedVerified;
+    state->candidates = mDiscoveredFeeds;
+    for (const auto& candidate : mDiscoveredFeeds)
+    {
+        if (candidate.verified)
+        {
+            state->outcomes.emplace_back(true);
+            if (feedVerified)
+            {
+                feedVerified(candidate);
+            }
+        }
+        else
+        {
+            state->outcomes.emplace_back();
+            state->probeCount++;
+        }
+    }
+    if (state->probeCount == 0)
+    {
+        return;
+    }
+
+    // the probing threads run in the background, so a slow or unresponsive candidate can't hold up the result beyond the deadline
+    auto threadCount = std::min(MaxConcurrentProbes, state->probeCount);
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        startBackgroundThread([state]() { probeCandidates(state); });
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(ProbeDeadline);
+    std::unique_lock<std::mutex> lock(state->mutex);
+    while (state->finishedProbeCount < state->probeCount && std::chrono::steady_clock::now() < deadline)
+    {
+        if (gsJoiningBackgroundThreads || (shouldAbort && shouldAbort()))
+        {
+            break;
+        }
+        auto timeout = std::min<std::chrono::steady_clock::duration>(std::chrono::milliseconds(AbortPollInterval), deadline - std::chrono::steady_clock::now());
+        state->probeFinished.wait_for(lock, timeout);
+    }
+    state->abandoned = true;
+
+    mDiscoveredFeeds.clear();
+    for (size_t i = 0; i < state->candidates.size(); ++i)
+    {
+        const auto& outcome = state->outcomes.at(i);
+        if (!outcome.has_value() || outcome.value())
+        {
+            mDiscoveredFeeds.emplace_back(state->candidates.at(i));
+        }
+    }
+}
+
+void ZapFR::Engine::FeedDiscovery::discoverInBackground(const std::string& url, std::function<void(const DiscoveredFeed&)> feedVerified,
+                                                       std::function<void(const std::vector<DiscoveredFeed>&)> finished, std::function<bool()> shouldAbort)
+{
+    startBackgroundThread(
+        [=]()
+        {
+            const auto aborted = [&]() { return gsJoiningBackgroundThreads || (shouldAbort && shouldAbort()); };
+
+            auto fd = FeedDiscovery(url);
+            if (aborted())
+            {
+                return;
+            }
+            fd.discover();
+            fd.verify([&](const DiscoveredFeed& discoveredFeed)
+                      {
+                          if (feedVerified && !aborted())
+                          {
+                              feedVerified(discoveredFeed);
+                          }
+                      },
+                      aborted);
+            if (!finished || aborted())
+            {
+                return;
+            }
+
+            std::vector<DiscoveredFeed> unverifiedFeeds;
+            for (const auto& discoveredFeed : fd.discoveredFeeds())
+            {
+                if (!discoveredFeed.verified)
+                {
+                    unverifiedFeeds.emplace_back(discoveredFeed);
+                }
+            }
+            finished(unverifiedFeeds);
+        });
+}
+
+void ZapFR::Engine::FeedDiscovery::joinAll()
+{
+    gsJoiningBackgroundThreads = true;
+    {
+        std::unique_lock<std::mutex> lock(gsBackgroundThreadsMutex);
+        gsBackgroundThreadFinished.wait(lock, []() { return gsBackgroundThreadCount == 0; });
+    }
+    gsJoiningBackgroundThreads = false;
+}
+
+std::optional<ZapFR::Engine::Feed::Type> ZapFR::Engine::FeedDiscovery::sniffFeedType(const std::string& data)
+{
+    size_t offset{0};
+    if (data.starts_with("\xEF\xBB\xBF"))
+    {
+        offset = 3;
+    }
+
+    const auto skipWhitespace = [&]()
+    {
+        while (offset < data.size() && std::isspace(static_cast<unsigned char>(data.at(offset))))
+        {
+            offset++;
+        }
+    };
+
+    skipWhitespace();
+    if (offset >= data.size())
+    {
+        return {};
+    }
+
+    if (data.at(offset) == '{')
+    {
+        // the document may be cut off, so look for the version member rather than parsing it
+        static Poco::RegularExpression versionRegex(R"#("version"\s*:\s*"https?:\\?/\\?/jsonfeed\.org\\?/version\\?/1)#", Poco::RegularExpression::RE_CASELESS);
+        Poco::RegularExpression::Match match;
+        if (versionRegex.match(data, offset, match) > 0)
+        {
+            return Feed::Type::JSON;
+        }
+        return {};
+    }
+
+    // skip the xml declaration, processing instructions, comments and the doctype to get to the document element
+    while (offset < data.size() && data.at(offset) == '<')
+    {
+        std::string terminator;
+        if (data.compare(offset, 2, "<?") == 0)
+        {
+            terminator = "?>";
+        }
+        else if (data.compare(offset, 4, "<!--") == 0)
+        {
+            terminator = "-->";
+        }
+        else if (data.compare(offset, 2, "<!") == 0)
+        {
+            terminator = ">";
+        }
+        else
+        {
+            break;
+        }
+
+        auto end = data.find(terminator, offset);
+        if (end == std::string::npos)
+        {
+            return {};
+        }
+        offset = end + terminator.size();
+        skipWhitespace();
+    }
+
+    if (offset >= data.size() || data.at(offset) != '<')
+    {
+        return {};
+    }
+
+    auto nameEnd = data.find_first_of(" \t\r\n/>", offset + 1);
+    if (nameEnd == std::string::npos)
+    {
+        return {};
+    }
+    auto elementName = data.substr(offset + 1, nameEnd - offset - 1);
+    auto colon = elementName.find(':');
+    if (colon != std::string::npos)
+    {
+        elementName = elementName.substr(colon + 1);
+    }
+
+    if (Poco::icompare(elementName, "rss") == 0 || Poco::icompare(elementName, "rdf") == 0)
+    {
+        return Feed::Type::RSS;
+    }
+    else if (Poco::icompare(elementName, "feed") == 0)
+    {
+        return Feed::Type::Atom;
+    }
+    return {};
+}
+
 bool ZapFR::Engine::FeedDiscovery::interpretAsYoutubeSource()
 {
     if (Poco::endsWith(mURI.getHost(), std::string("youtube.com")))
@@ -108,7 +415,7 @@ bool ZapFR::Engine::FeedDiscovery::interpretAsYoutubeSource()
                     channelTitle = mData.substr(titleMatches.at(1).offset, titleMatches.at(1).length);
                 }
 
-                mDiscoveredFeeds.emplace_back(channelTitle, fmt::format("https://www.youtube.com/feeds/videos.xml?channel_id={}", channelID), Feed::Type::Atom);
+                mDiscoveredFeeds.emplace_back(channelTitle, fmt::format("https://www.youtube.com/feeds/videos.xml?channel_id={}", channelID), Feed::Type::Atom, true);
                 return true;
             }
         }
@@ -132,12 +439,12 @@ bool ZapFR::Engine::FeedDiscovery::interpretAsDirectFeedLink()
             const auto& documentElementTitle = handler.documentElementTitle();
             if (Poco::icompare(documentElementTitle, "rss") == 0 || Poco::icompare(documentElementTitle, "rdf") == 0)
             {
-                mDiscoveredFeeds.emplace_back("RSS Feed", mURI.toString(), Feed::Type::RSS);
+                mDiscoveredFeeds.emplace_back("RSS Feed", mURI.toString(), Feed::Type::RSS, true);
                 return true;
             }
             else if (Poco::icompare(documentElementTitle, "feed") == 0)
             {
-                mDiscoveredFeeds.emplace_back("Atom Feed", mURI.toString(), Feed::Type::Atom);
+                mDiscoveredFeeds.emplace_back("Atom Feed", mURI.toString(), Feed::Type::Atom, true);
                 return true;
             }
         }
@@ -160,7 +467,7 @@ bool ZapFR::Engine::FeedDiscovery::interpretAsDirectFeedLink()
                 {
                     feedTitle = rootObj->getValue<std::string>("title");
                 }
-                mDiscoveredFeeds.emplace_back(feedTitle, mURI.toString(), Feed::Type::JSON);
+                mDiscoveredFeeds.emplace_back(feedTitle, mURI.toString(), Feed::Type::JSON, true);
                 return true;
             }
         }
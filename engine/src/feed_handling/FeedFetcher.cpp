@@ -16,87 +16,103 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
-#include <Poco/DOM/DOMParser.h>
-#include <Poco/JSON/Parser.h>
+#include <iterator>
+#include <limits>
+
+#include <Poco/DigestStream.h>
+#include <Poco/MD5Engine.h>
 #include <Poco/Net/HTTPRequest.h>
+#include <Poco/StreamCopier.h>
+#include <Poco/Timestamp.h>
 
 #include "ZapFR/Helpers.h"
 #include "ZapFR/feed_handling/FeedFetcher.h"
-#include "ZapFR/feed_handling/FeedParserATOM10.h"
-#include "ZapFR/feed_handling/FeedParserJSON11.h"
-#include "ZapFR/feed_handling/FeedParserRSS10.h"
-#include "ZapFR/feed_handling/FeedParserRSS20.h"
+#include "ZapFR/feed_handling/FeedParserJSON11OnDemand.h"
+#include "ZapFR/feed_handling/FeedParserXMLStreaming.h"
+#include "ZapFR/feed_handling/FeedPreprocessor.h"
 
 std::optional<std::unique_ptr<ZapFR::Engine::FeedParser>> ZapFR::Engine::FeedFetcher::parseURL(const std::string& url, uint64_t associatedFeedID,
-                                                                                               std::optional<std::string> conditionalGETInfo)
+                                                                                               std::optional<std::string> conditionalGETInfo,
+                                                                                               std::optional<std::string> knownBodyHash)
 {
     Poco::Net::HTTPCredentials creds;
     auto uri = Poco::URI(url);
-    const auto& [data, newConditionalGETInfo] = Helpers::performHTTPRequest(uri, Poco::Net::HTTPRequest::HTTP_GET, creds, {}, associatedFeedID, conditionalGETInfo);
-    mConditionalGETInfo = newConditionalGETInfo;
-    if (data.empty())
-    {
-        return {};
-    }
-    return parseString(data, url);
+
+    // a 304 or an empty body never reaches the parser. The body is hashed as it comes in, so callers can recognize a body they've seen before
+    // without holding on to it
+    std::optional<std::unique_ptr<FeedParser>> parsedFeed;
+    mTransferStats = {};
+    mParseTime = 0;
+    mBodyHash = "";
+    mBodyUnchanged = false;
+    mConditionalGETInfo = Helpers::performStreamingHTTPRequest(
+        uri, Poco::Net::HTTPRequest::HTTP_GET, creds, {},
+        [&](std::istream& body)
+        {
+            Poco::MD5Engine md5;
+            Poco::DigestInputStream hashedBody(md5, body);
+            if (hashedBody.peek() == std::char_traits<char>::eof())
+            {
+                return;
+            }
+
+            if (!knownBodyHash.has_value())
+            {
+                // nothing to compare against, so parse straight off the connection
+                Poco::Timestamp parseStart;
+                parsedFeed = parseStream(hashedBody, url);
+                hashedBody.ignore(std::numeric_limits<std::streamsize>::max()); // whatever the parser left unread
+                mBodyHash = Poco::DigestEngine::digestToHex(md5.digest());
+                mParseTime = static_cast<uint64_t>(parseStart.elapsed());
+                return;
+            }
+
+            // the body has to be in before its hash is known, so hold on to it (the transfer limits bound its size) and only parse it when it changed
+            std::string spooledBody;
+            Poco::StreamCopier::copyToString(hashedBody, spooledBody);
+            mBodyHash = Poco::DigestEngine::digestToHex(md5.digest());
+            if (mBodyHash == knownBodyHash.value())
+            {
+                mBodyUnchanged = true;
+                return;
+            }
+            Poco::Timestamp parseStart;
+            parsedFeed = parseString(spooledBody, url);
+            mParseTime = static_cast<uint64_t>(parseStart.elapsed());
+        },
+        associatedFeedID, conditionalGETInfo, &mPermanentRedirectURL, {}, &mTransferStats);
+    return parsedFeed;
 }
 
 std::unique_ptr<ZapFR::Engine::FeedParser> ZapFR::Engine::FeedFetcher::parseString(const std::string& data, const std::string& originalURL)
 {
-    mData = data;
-
-    if (data.empty())
+    auto format = FeedPreprocessor::sniff(data);
+    if (format == FeedPreprocessor::Format::XML)
     {
-        return nullptr;
+        return FeedParserXMLStreaming::parse(FeedPreprocessor::prepare(data), originalURL);
     }
-    if (data.at(0) == '<')
+    else if (format == FeedPreprocessor::Format::JSON)
     {
-        Poco::XML::DOMParser parser;
-        Poco::AutoPtr<Poco::XML::Document> xmlDoc = parser.parseString(data);
+        return FeedParserJSON11OnDemand::parse(std::string_view(data).substr(FeedPreprocessor::significantOffset(data)), originalURL);
+    }
 
-        auto docEl = xmlDoc->documentElement();
-        if (docEl->nodeName() == "rss")
-        {
-            if (docEl->hasAttribute("version") && docEl->getAttribute("version") == "2.0")
-            {
-                auto feed = std::make_unique<FeedParserRSS20>(originalURL);
-                feed->setXMLDoc(xmlDoc);
-                return feed;
-            }
-        }
-        else if (docEl->nodeName() == "feed")
-        {
-            auto feed = std::make_unique<FeedParserATOM10>(originalURL);
-            feed->setXMLDoc(xmlDoc);
-            return feed;
-        }
-        else if (docEl->nodeName() == "rdf:RDF")
-        {
-            auto feed = std::make_unique<FeedParserRSS10>(originalURL);
-            feed->setXMLDoc(xmlDoc);
-            return feed;
-        }
-        else
-        {
-            throw std::runtime_error("Unkown feed type");
-        }
+    return nullptr;
+}
+
+std::unique_ptr<ZapFR::Engine::FeedParser> ZapFR::Engine::FeedFetcher::parseStream(std::istream& stream, const std::string& originalURL)
+{
+    auto format = FeedPreprocessor::sniff(stream);
+    if (format == FeedPreprocessor::Format::XML)
+    {
+        FeedPreprocessor::StreamBuffer buffer(stream);
+        std::istream preparedStream(&buffer);
+        return FeedParserXMLStreaming::parse(preparedStream, originalURL);
     }
-    else if (data.at(0) == '{')
+    else if (format == FeedPreprocessor::Format::JSON)
     {
-        Poco::JSON::Parser parser;
-        auto root = parser.parse(data);
-        auto rootObj = root.extract<Poco::JSON::Object::Ptr>();
-        if (!rootObj.isNull())
-        {
-            auto version = rootObj->getValue<std::string>("version");
-            // both v1 and v1.1 can be parsed by the 1.1 parser, as it checks for both 'authors' and 'author' entries
-            if (Poco::icompare(version, "https://jsonfeed.org/version/1.1") == 0 || Poco::icompare(version, "https://jsonfeed.org/version/1") == 0)
-            {
-                auto feed = std::make_unique<FeedParserJSON11>(originalURL);
-                feed->setRootObj(rootObj);
-                return feed;
-            }
-        }
+        // the cursor works on the raw text, so JSON bodies are read in full first
+        std::string json(std::istreambuf_iterator<char>(stream), {});
+        return FeedParserJSON11OnDemand::parse(json, originalURL);
     }
 
     return nullptr;
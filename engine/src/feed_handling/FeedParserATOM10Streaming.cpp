@@ -0,0 +1,318 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <Poco/NumberParser.h>
+#include <Poco/String.h>
+
+#include "ZapFR/DateParser.h"
+#include "ZapFR/feed_handling/FeedParserATOM10Streaming.h"
+
+namespace
+{
+    constexpr std::string_view gsMediaNamespace{"http://search.yahoo.com/mrss/"};
+    const std::string gsXMLNamespace{"http://www.w3.org/XML/1998/namespace"};
+} // namespace
+
+ZapFR::Engine::FeedParserATOM10Streaming::FeedParserATOM10Streaming(const std::string& url) : FeedParserXMLStreaming(url)
+{
+}
+
+void ZapFR::Engine::FeedParserATOM10Streaming::elementStarted(size_t depth, const Element& element, const Poco::XML::Attributes& attributes)
+{
+    if (depth == 0)
+    {
+        mLanguage = attribute(attributes, gsXMLNamespace, "lang").value_or("");
+        return;
+    }
+
+    // the feed link is the first alternate link in the document, which may well be one of an entry
+    if (element.qname == "link" && !mFeedSeen.test(FeedLink))
+    {
+        auto rel = attribute(attributes, "rel");
+        auto href = attribute(attributes, "href");
+        if (rel.has_value() && rel.value() == "alternate" && href.has_value())
+        {
+            mFeedSeen.set(FeedLink);
+            mLink = href.value();
+        }
+    }
+
+    if (mEntryDepth.has_value())
+    {
+        entryElementStarted(depth, element, attributes);
+        return;
+    }
+
+    if (element.qname == "entry")
+    {
+        mEntryDepth = depth;
+        mEntrySeen.reset();
+        mItem = {};
+        mEnclosureElements.clear();
+        mSummary.clear();
+        mContentHasSource = false;
+        mContentType.clear();
+        mContent.clear();
+        mInMediaGroup = false;
+        mMediaThumbnailURL.reset();
+        mMediaDescriptionType.clear();
+        mMediaDescription.clear();
+        mInAuthor = false;
+        mUpdated.clear();
+        mPublished.clear();
+        return;
+    }
+
+    if (depth == 1)
+    {
+        if (element.qname == "id" && firstOccurrence(mFeedSeen, FeedID))
+        {
+            captureText(mGuid);
+        }
+        else if (element.qname == "title" && firstOccurrence(mFeedSeen, FeedTitle))
+        {
+            captureText(mTitle);
+        }
+        else if (element.qname == "subtitle" && firstOccurrence(mFeedSeen, FeedSubtitle))
+        {
+            captureText(mSubtitle);
+        }
+        else if (element.qname == "rights" && firstOccurrence(mFeedSeen, FeedRights))
+        {
+            captureText(mCopyright);
+        }
+        else if (element.is(NamespaceAtom, "link"))
+        {
+            addWebSubLink(mWebSubLinks, attributes);
+        }
+    }
+}
+
+void ZapFR::Engine::FeedParserATOM10Streaming::elementEnded(size_t depth, const Element& /*element*/)
+{
+    if (mEntryDepth.has_value())
+    {
+        if (depth == mEntryDepth.value())
+        {
+            finishEntry();
+            mEntryDepth.reset();
+        }
+        else
+        {
+            entryElementEnded(depth);
+        }
+    }
+}
+
+void ZapFR::Engine::FeedParserATOM10Streaming::entryElementStarted(size_t depth, const Element& element, const Poco::XML::Attributes& attributes)
+{
+    auto childDepth = mEntryDepth.value() + 1;
+    if (depth == childDepth)
+    {
+        if (element.qname == "title" && firstOccurrence(mEntrySeen, EntryTitle))
+        {
+            captureText(mItem.title);
+        }
+        else if (element.qname == "summary" && firstOccurrence(mEntrySeen, EntrySummary))
+        {
+            captureInnerXML(mSummary);
+        }
+        else if (element.qname == "content" && firstOccurrence(mEntrySeen, EntryContent))
+        {
+            mContentHasSource = attribute(attributes, "src").has_value();
+            mContentType = attribute(attributes, "type").value_or("text");
+            if (!mContentHasSource)
+            {
+                if (mContentType == "text")
+                {
+                    captureText(mContent);
+                }
+                else
+                {
+                    captureInnerXML(mContent);
+                }
+            }
+        }
+        else if (element.is(gsMediaNamespace, "group") && firstOccurrence(mEntrySeen, EntryMediaGroup))
+        {
+            mInMediaGroup = true;
+        }
+        else if (element.qname == "author" && firstOccurrence(mEntrySeen, EntryAuthor))
+        {
+            mInAuthor = true;
+        }
+        else if (element.qname == "id" && firstOccurrence(mEntrySeen, EntryID))
+        {
+            captureText(mItem.guid);
+        }
+        else if (element.qname == "updated" && firstOccurrence(mEntrySeen, EntryUpdated))
+        {
+            captureText(mUpdated);
+        }
+        else if (element.qname == "published" && firstOccurrence(mEntrySeen, EntryPublished))
+        {
+            captureText(mPublished);
+        }
+    }
+    else if (depth == childDepth + 1 && mInMediaGroup)
+    {
+        if (element.is(gsMediaNamespace, "thumbnail") && firstOccurrence(mEntrySeen, EntryMediaThumbnail))
+        {
+            mMediaThumbnailURL = attribute(attributes, "url");
+        }
+        else if (element.is(gsMediaNamespace, "description") && firstOccurrence(mEntrySeen, EntryMediaDescription))
+        {
+            mMediaDescriptionType = attribute(attributes, "type").value_or("");
+            captureText(mMediaDescription);
+        }
+    }
+    else if (depth == childDepth + 1 && mInAuthor && element.qname == "name" && firstOccurrence(mEntrySeen, EntryAuthorName))
+    {
+        captureText(mItem.author);
+    }
+
+    if (element.qname == "link")
+    {
+        auto href = attribute(attributes, "href");
+        if (href.has_value())
+        {
+            auto rel = attribute(attributes, "rel");
+            if (rel.has_value() && rel.value() == "enclosure")
+            {
+                Post::Enclosure e;
+                e.url = href.value();
+                e.mimeType = attribute(attributes, "type").value_or("");
+                auto length = attribute(attributes, "length");
+                if (length.has_value())
+                {
+                    Poco::NumberParser::tryParseUnsigned64(length.value(), e.size);
+                }
+                if (!e.url.empty())
+                {
+                    mItem.enclosures.emplace_back(e);
+                }
+            }
+            else if (!rel.has_value() || rel.value() == "alternate")
+            {
+                mItem.link = href.value();
+            }
+        }
+    }
+    else if (element.qname == "enclosure")
+    {
+        // some feeds also put <enclosure> elements within items (diverges from spec, but allow anyway)
+        Post::Enclosure e;
+        e.url = attribute(attributes, "href").value_or("");
+        if (e.url.empty())
+        {
+            e.url = attribute(attributes, "url").value_or("");
+        }
+        e.mimeType = attribute(attributes, "type").value_or("");
+        auto length = attribute(attributes, "length");
+        if (length.has_value())
+        {
+            Poco::NumberParser::tryParseUnsigned64(length.value(), e.size);
+        }
+        if (!e.url.empty())
+        {
+            mEnclosureElements.emplace_back(e);
+        }
+    }
+    else if (element.qname == "category")
+    {
+        auto term = attribute(attributes, "term");
+        if (term.has_value())
+        {
+            mItem.categories.emplace_back(term.value());
+        }
+    }
+}
+
+void ZapFR::Engine::FeedParserATOM10Streaming::entryElementEnded(size_t depth)
+{
+    if (depth == mEntryDepth.value() + 1)
+    {
+        mInMediaGroup = false;
+        mInAuthor = false;
+    }
+}
+
+void ZapFR::Engine::FeedParserATOM10Streaming::finishEntry()
+{
+    // the enclosure elements are listed after the enclosure links, as the DOM parser does
+    mItem.enclosures.insert(mItem.enclosures.end(), mEnclosureElements.begin(), mEnclosureElements.end());
+
+    mItem.content = std::move(mSummary);
+    if (mEntrySeen.test(EntryContent) && !mContentHasSource)
+    {
+        if (mContentType == "text")
+        {
+            mItem.content = fmt::format(R"(<pre style="white-space:pre-wrap;">{}</pre>)", mContent);
+        }
+        else
+        {
+            mItem.content = std::move(mContent);
+        }
+    }
+
+    if (mItem.content.empty() && mEntrySeen.test(EntryMediaGroup)) // see if there's a media:thumbnail/media:description present (for YouTube)
+    {
+        std::stringstream mediaContentStream;
+        if (mMediaThumbnailURL.has_value())
+        {
+            mItem.thumbnail = mMediaThumbnailURL.value();
+            mediaContentStream << R"(<a href=")" << mItem.link << R"("><img src=")" << mItem.thumbnail << R"(" alt="" /></a>)";
+        }
+
+        if (mEntrySeen.test(EntryMediaDescription))
+        {
+            if (mMediaDescriptionType == "html")
+            {
+                mediaContentStream << "<p>" << mMediaDescription << "</p>";
+            }
+            else
+            {
+                Poco::replaceInPlace(mMediaDescription, "\n", "<br />");
+                mediaContentStream << "<p>" << mMediaDescription << "</p>";
+            }
+        }
+
+        mItem.content = mediaContentStream.str();
+    }
+
+    // 'updated' is a required node according to the atom spec, but seen missing in the wild, in favor of the optional 'published' node
+    if (mEntrySeen.test(EntryUpdated))
+    {
+        mItem.datePublished = mUpdated;
+    }
+    else if (mEntrySeen.test(EntryPublished))
+    {
+        mItem.datePublished = mPublished;
+    }
+
+    auto normalizedDate = DateParser::normalize(mItem.datePublished);
+    if (normalizedDate.has_value())
+    {
+        mItem.datePublished = std::move(normalizedDate.value());
+    }
+
+    mItems.emplace_back(std::move(mItem));
+}
@@ -0,0 +1,615 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <optional>
+
+#include <Poco/String.h>
+#include <Poco/UTF8Encoding.h>
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include "ZapFR/DateParser.h"
+#include "ZapFR/Helpers.h"
+#include "ZapFR/feed_handling/FeedParserJSON11OnDemand.h"
+
+namespace
+{
+    // A forward-only cursor over a JSON document. Values are only decoded when asked for; whatever gets skipped is stepped over
+    // by matching brackets and quotes, without validating what's inside.
+    class JSONCursor
+    {
+      public:
+        explicit JSONCursor(std::string_view json) : mJSON(json) {}
+
+        char peek()
+        {
+            skipWhitespace();
+            if (mPos >= mJSON.size())
+            {
+                fail("Unexpected end of JSON");
+            }
+            return mJSON[mPos];
+        }
+
+        bool consumeIf(char c)
+        {
+            if (peek() == c)
+            {
+                ++mPos;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char c)
+        {
+            if (!consumeIf(c))
+            {
+                fail(fmt::format("Expected '{}'", c));
+            }
+        }
+
+        // calls f for every key of the object at the cursor, which has to read or skip the value; the key is only valid until the next key is read
+        template <typename F> void forEachMember(F&& f)
+        {
+            expect('{');
+            if (consumeIf('}'))
+            {
+                return;
+            }
+            do
+            {
+                auto key = rawString(mKeyScratch);
+                expect(':');
+                f(key);
+            } while (consumeIf(','));
+            expect('}');
+        }
+
+        // calls f for every element of the array at the cursor, which has to read or skip it
+        template <typename F> void forEachElement(F&& f)
+        {
+            expect('[');
+            if (consumeIf(']'))
+            {
+                return;
+            }
+            do
+            {
+                f();
+            } while (consumeIf(','));
+            expect(']');
+        }
+
+        // the value as Poco::Dynamic::Var would convert it to a string: strings decoded, numbers and booleans as written, nothing for
+        // null, objects and arrays (which get skipped)
+        std::optional<std::string> scalar()
+        {
+            auto c = peek();
+            if (c == '"')
+            {
+                return std::string(rawString(mValueScratch));
+            }
+            else if (c == '{' || c == '[')
+            {
+                skip();
+                return {};
+            }
+
+            auto literal = rawLiteral();
+            if (literal == "null")
+            {
+                return {};
+            }
+            return std::string(literal);
+        }
+
+        void skip()
+        {
+            auto c = peek();
+            if (c == '"')
+            {
+                skipString();
+            }
+            else if (c == '{' || c == '[')
+            {
+                size_t depth = 0;
+                do
+                {
+                    auto next = mJSON.find_first_of("\"{}[]", mPos);
+                    if (next == std::string_view::npos)
+                    {
+                        fail("Unterminated object or array");
+                    }
+                    mPos = next;
+                    auto bracket = mJSON[next];
+                    if (bracket == '"')
+                    {
+                        skipString();
+                        continue;
+                    }
+                    if (bracket == '{' || bracket == '[')
+                    {
+                        ++depth;
+                    }
+                    else
+                    {
+                        --depth;
+                    }
+                    ++mPos;
+                } while (depth > 0);
+            }
+            else
+            {
+                rawLiteral();
+            }
+        }
+
+        [[noreturn]] void fail(const std::string& message) const { throw std::runtime_error(fmt::format("{} at offset {}", message, mPos)); }
+
+      private:
+        std::string_view mJSON{};
+        size_t mPos{0};
+        std::string mKeyScratch{};
+        std::string mValueScratch{};
+
+        void skipWhitespace()
+        {
+            while (mPos < mJSON.size() && (mJSON[mPos] == ' ' || mJSON[mPos] == '\n' || mJSON[mPos] == '\r' || mJSON[mPos] == '\t'))
+            {
+                ++mPos;
+            }
+        }
+
+        // a view into the document when the string has no escapes, otherwise into scratch
+        std::string_view rawString(std::string& scratch)
+        {
+            expect('"');
+            auto start = mPos;
+            auto end = findStringSpecial(start);
+            mPos = end + 1;
+            if (mJSON[end] == '"')
+            {
+                return mJSON.substr(start, end - start);
+            }
+
+            scratch.assign(mJSON.substr(start, end - start));
+            mPos = end;
+            while (mJSON[mPos] == '\\')
+            {
+                if (mPos + 1 >= mJSON.size())
+                {
+                    fail("Unterminated string");
+                }
+                auto escaped = mJSON[mPos + 1];
+                mPos += 2;
+                if (escaped == '"' || escaped == '\\' || escaped == '/')
+                {
+                    scratch += escaped;
+                }
+                else if (escaped == 'b')
+                {
+                    scratch += '\b';
+                }
+                else if (escaped == 'f')
+                {
+                    scratch += '\f';
+                }
+                else if (escaped == 'n')
+                {
+                    scratch += '\n';
+                }
+                else if (escaped == 'r')
+                {
+                    scratch += '\r';
+                }
+                else if (escaped == 't')
+                {
+                    scratch += '\t';
+                }
+                else if (escaped == 'u')
+                {
+                    appendCodepoint(unicodeEscape(), scratch);
+                }
+                else
+                {
+                    fail("Invalid escape sequence");
+                }
+
+                end = findStringSpecial(mPos);
+                scratch.append(mJSON.substr(mPos, end - mPos));
+                mPos = end;
+            }
+            ++mPos;
+            return scratch;
+        }
+
+        size_t findStringSpecial(size_t from) const
+        {
+            auto pos = mJSON.find_first_of("\"\\", from);
+            if (pos == std::string_view::npos)
+            {
+                fail("Unterminated string");
+            }
+            return pos;
+        }
+
+        void skipString()
+        {
+            ++mPos;
+            auto end = findStringSpecial(mPos);
+            while (mJSON[end] == '\\')
+            {
+                end = findStringSpecial(end + 2);
+            }
+            mPos = end + 1;
+        }
+
+        std::string_view rawLiteral()
+        {
+            auto start = mPos;
+            auto end = mJSON.find_first_of(",}] \t\r\n", start);
+            if (end == std::string_view::npos)
+            {
+                end = mJSON.size();
+            }
+            auto literal = mJSON.substr(start, end - start);
+            auto first = literal.empty() ? '\0' : literal.front();
+            if (literal != "true" && literal != "false" && literal != "null" && first != '-' && (first < '0' || first > '9'))
+            {
+                fail("Unexpected character");
+            }
+            mPos = end;
+            return literal;
+        }
+
+        // the \uXXXX escape (after the \u), combining surrogate pairs; a lone surrogate becomes U+FFFD
+        int unicodeEscape()
+        {
+            auto hex = [&]()
+            {
+                if (mPos + 4 > mJSON.size())
+                {
+                    fail("Invalid unicode escape");
+                }
+                int value = 0;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    auto c = mJSON[mPos++];
+                    value <<= 4;
+                    if (c >= '0' && c <= '9')
+                    {
+                        value |= c - '0';
+                    }
+                    else if (c >= 'a' && c <= 'f')
+                    {
+                        value |= c - 'a' + 10;
+                    }
+                    else if (c >= 'A' && c <= 'F')
+                    {
+                        value |= c - 'A' + 10;
+                    }
+                    else
+                    {
+                        fail("Invalid unicode escape");
+                    }
+                }
+                return value;
+            };
+
+            auto codepoint = hex();
+            if (codepoint >= 0xD800 && codepoint <= 0xDBFF)
+            {
+                if (mJSON.substr(mPos, 2) == "\\u")
+                {
+                    auto nextEscape = mPos;
+                    mPos += 2;
+                    auto low = hex();
+                    if (low >= 0xDC00 && low <= 0xDFFF)
+                    {
+                        return 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+
+                    // not the low half of a pair, so it's an escape of its own that still needs decoding
+                    mPos = nextEscape;
+                }
+                return 0xFFFD;
+            }
+            else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF)
+            {
+                return 0xFFFD;
+            }
+            return codepoint;
+        }
+
+        static void appendCodepoint(int codepoint, std::string& target)
+        {
+            static Poco::UTF8Encoding utf8;
+            unsigned char bytes[4];
+            auto length = utf8.convert(codepoint, bytes, sizeof(bytes));
+            target.append(reinterpret_cast<const char*>(bytes), static_cast<size_t>(length));
+        }
+    };
+
+    // the names in an authors array, joined the same way FeedParserJSON11::getAuthors does it
+    std::string readAuthors(JSONCursor& cursor)
+    {
+        std::vector<std::string> authors;
+        cursor.forEachElement(
+            [&]()
+            {
+                if (cursor.peek() != '{')
+                {
+                    cursor.skip();
+                    return;
+                }
+                cursor.forEachMember(
+                    [&](std::string_view key)
+                    {
+                        if (key == "name")
+                        {
+                            auto name = cursor.scalar();
+                            if (name.has_value())
+                            {
+                                authors.emplace_back(std::move(name.value()));
+                            }
+                        }
+                        else
+                        {
+                            cursor.skip();
+                        }
+                    });
+            });
+        return ZapFR::Engine::Helpers::joinString(authors, ", ");
+    }
+
+    // the name of an author object; an empty string when it doesn't have one
+    std::string readAuthorName(JSONCursor& cursor)
+    {
+        std::string name;
+        cursor.forEachMember(
+            [&](std::string_view key)
+            {
+                if (key == "name")
+                {
+                    name = cursor.scalar().value_or("");
+                }
+                else
+                {
+                    cursor.skip();
+                }
+            });
+        return name;
+    }
+} // namespace
+
+ZapFR::Engine::FeedParserJSON11OnDemand::FeedParserJSON11OnDemand(const std::string& url) : FeedParser(url)
+{
+}
+
+std::unique_ptr<ZapFR::Engine::FeedParser> ZapFR::Engine::FeedParserJSON11OnDemand::parse(std::string_view json, const std::string& url)
+{
+    auto feed = std::make_unique<FeedParserJSON11OnDemand>(url);
+    JSONCursor cursor(json);
+
+    std::string version;
+    std::optional<std::string> icon;
+    std::optional<std::string> favicon;
+    std::optional<std::string> topLevelAuthors;
+    std::optional<std::string> topLevelAuthorName;
+    std::vector<size_t> itemsWithoutAuthor; // the feed's authors may come after the items, so these get filled in at the end
+
+    const auto readItem = [&]()
+    {
+        if (cursor.peek() != '{')
+        {
+            cursor.skip();
+            return;
+        }
+
+        Item item;
+        bool hasID{false};
+        std::optional<std::string> contentHTML;
+        std::optional<std::string> contentText;
+        std::optional<std::string> dateModified;
+        std::optional<std::string> datePublished;
+        std::optional<std::string> authors;
+        std::optional<std::string> authorName;
+        cursor.forEachMember(
+            [&](std::string_view key)
+            {
+                if (key == "id")
+                {
+                    hasID = true;
+                    item.guid = cursor.scalar().value_or("");
+                }
+                else if (key == "url")
+                {
+                    item.link = cursor.scalar().value_or("");
+                }
+                else if (key == "title")
+                {
+                    item.title = cursor.scalar().value_or("");
+                }
+                else if (key == "content_html")
+                {
+                    contentHTML = cursor.scalar().value_or("");
+                }
+                else if (key == "content_text")
+                {
+                    contentText = cursor.scalar().value_or("");
+                }
+                else if (key == "image")
+                {
+                    item.thumbnail = cursor.scalar().value_or("");
+                }
+                else if (key == "date_modified")
+                {
+                    dateModified = cursor.scalar().value_or("");
+                }
+                else if (key == "date_published")
+                {
+                    datePublished = cursor.scalar().value_or("");
+                }
+                else if (key == "authors" && cursor.peek() == '[')
+                {
+                    authors = readAuthors(cursor);
+                }
+                else if (key == "author" && cursor.peek() == '{')
+                {
+                    authorName = readAuthorName(cursor);
+                }
+                else if (key == "tags" && cursor.peek() == '[')
+                {
+                    cursor.forEachElement(
+                        [&]()
+                        {
+                            auto tag = cursor.scalar();
+                            if (tag.has_value())
+                            {
+                                item.categories.emplace_back(std::move(tag.value()));
+                            }
+                        });
+                }
+                else
+                {
+                    cursor.skip();
+                }
+            });
+
+        if (!hasID)
+        {
+            return;
+        }
+
+        if (contentHTML.has_value())
+        {
+            item.content = std::move(contentHTML.value());
+        }
+        else if (contentText.has_value())
+        {
+            auto& text = contentText.value();
+
+            // the spec is very clear about only allowing html in the content_html field, yet some people put html in there
+            // seeing as this screws up the layout, force it to show the html as plain text by replacing < and >
+            Poco::replaceInPlace(text, "<", "&lt;");
+            Poco::replaceInPlace(text, ">", "&gt;");
+
+            Poco::replaceInPlace(text, "\n", "<br />");
+            item.content = fmt::format(R"(<pre style="white-space:pre-wrap;">{}</pre>)", text);
+        }
+
+        auto providedDate = dateModified.has_value() ? dateModified.value() : datePublished.value_or("");
+        if (!providedDate.empty())
+        {
+            auto normalizedDate = DateParser::normalize(providedDate);
+            if (normalizedDate.has_value())
+            {
+                item.datePublished = std::move(normalizedDate.value());
+            }
+        }
+
+        if (authors.has_value())
+        {
+            item.author = std::move(authors.value());
+        }
+        else if (authorName.has_value())
+        {
+            item.author = std::move(authorName.value());
+        }
+        else
+        {
+            itemsWithoutAuthor.emplace_back(feed->mItems.size());
+        }
+
+        feed->mItems.emplace_back(std::move(item));
+    };
+
+    cursor.forEachMember(
+        [&](std::string_view key)
+        {
+            if (key == "version")
+            {
+                version = cursor.scalar().value_or("");
+            }
+            else if (key == "title")
+            {
+                feed->mTitle = cursor.scalar().value_or("");
+            }
+            else if (key == "feed_url")
+            {
+                feed->mGuid = cursor.scalar().value_or("");
+            }
+            else if (key == "home_page_url")
+            {
+                feed->mLink = cursor.scalar().value_or("");
+            }
+            else if (key == "description")
+            {
+                feed->mDescription = cursor.scalar().value_or("");
+            }
+            else if (key == "language")
+            {
+                feed->mLanguage = cursor.scalar().value_or("");
+            }
+            else if (key == "icon")
+            {
+                icon = cursor.scalar().value_or("");
+            }
+            else if (key == "favicon")
+            {
+                favicon = cursor.scalar().value_or("");
+            }
+            else if (key == "authors" && cursor.peek() == '[')
+            {
+                topLevelAuthors = readAuthors(cursor);
+            }
+            else if (key == "author" && cursor.peek() == '{')
+            {
+                topLevelAuthorName = readAuthorName(cursor);
+            }
+            else if (key == "items" && cursor.peek() == '[')
+            {
+                cursor.forEachElement(readItem);
+            }
+            else
+            {
+                cursor.skip();
+            }
+        });
+
+    // both v1 and v1.1 are handled, as the authors are looked up under 'authors' and 'author'
+    if (Poco::icompare(version, "https://jsonfeed.org/version/1.1") != 0 && Poco::icompare(version, "https://jsonfeed.org/version/1") != 0)
+    {
+        return nullptr;
+    }
+
+    feed->mIconURL = icon.has_value() ? icon.value() : favicon.value_or("");
+
+    auto feedAuthors = topLevelAuthors.value_or("");
+    if (feedAuthors.empty())
+    {
+        feedAuthors = topLevelAuthorName.value_or("");
+    }
+    for (auto index : itemsWithoutAuthor)
+    {
+        feed->mItems.at(index).author = feedAuthors;
+    }
+
+    return feed;
+}
@@ -0,0 +1,154 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZapFR/DateParser.h"
+#include "ZapFR/feed_handling/FeedParserRSS10Streaming.h"
+
+namespace
+{
+    const std::string gsRDFNamespace{"http://www.w3.org/1999/02/22-rdf-syntax-ns#"};
+    constexpr std::string_view gsDublinCoreNamespace{"http://purl.org/dc/elements/1.1/"};
+} // namespace
+
+ZapFR::Engine::FeedParserRSS10Streaming::FeedParserRSS10Streaming(const std::string& url) : FeedParserXMLStreaming(url)
+{
+}
+
+void ZapFR::Engine::FeedParserRSS10Streaming::elementStarted(size_t depth, const Element& element, const Poco::XML::Attributes& attributes)
+{
+    if (mItemDepth.has_value())
+    {
+        if (depth != mItemDepth.value() + 1)
+        {
+            return;
+        }
+
+        if (element.qname == "title" && firstOccurrence(mItemSeen, ItemTitle))
+        {
+            captureText(mItem.title);
+        }
+        else if (element.qname == "link" && firstOccurrence(mItemSeen, ItemLink))
+        {
+            captureText(mItem.link);
+        }
+        else if (element.qname == "description" && firstOccurrence(mItemSeen, ItemDescription))
+        {
+            captureInnerXML(mItem.content);
+        }
+        else if (element.is(NamespaceContent, "encoded") && firstOccurrence(mItemSeen, ItemContentEncoded))
+        {
+            captureText(mContentEncoded);
+        }
+        else if (element.is(gsDublinCoreNamespace, "creator") && firstOccurrence(mItemSeen, ItemCreator))
+        {
+            captureText(mItem.author);
+        }
+        else if (element.is(gsDublinCoreNamespace, "date") && firstOccurrence(mItemSeen, ItemDate))
+        {
+            captureText(mItem.datePublished);
+        }
+        return;
+    }
+
+    if (element.qname == "item")
+    {
+        mItemDepth = depth;
+        mItemSeen.reset();
+        mItem = {};
+        mContentEncoded.clear();
+        return;
+    }
+
+    if (depth == 1)
+    {
+        if (element.qname == "channel" && firstOccurrence(mChannelSeen, Channel))
+        {
+            mInChannel = true;
+        }
+        else if (element.qname == "image" && firstOccurrence(mChannelSeen, Image))
+        {
+            mIconURL = attribute(attributes, gsRDFNamespace, "about").value_or("");
+        }
+    }
+    else if (depth == 2 && mInChannel)
+    {
+        if (element.qname == "title" && firstOccurrence(mChannelSeen, ChannelTitle))
+        {
+            captureText(mTitle);
+        }
+        else if (element.qname == "link" && firstOccurrence(mChannelSeen, ChannelLink))
+        {
+            captureText(mLink);
+        }
+        else if (element.qname == "description" && firstOccurrence(mChannelSeen, ChannelDescription))
+        {
+            captureText(mDescription);
+        }
+        else if (element.is(NamespaceSyndication, "updatePeriod") && firstOccurrence(mChannelSeen, ChannelUpdatePeriod))
+        {
+            captureText(mUpdatePeriod);
+        }
+        else if (element.is(NamespaceSyndication, "updateFrequency") && firstOccurrence(mChannelSeen, ChannelUpdateFrequency))
+        {
+            captureText(mUpdateFrequency);
+        }
+    }
+}
+
+void ZapFR::Engine::FeedParserRSS10Streaming::elementEnded(size_t depth, const Element& /*element*/)
+{
+    if (mItemDepth.has_value())
+    {
+        if (depth == mItemDepth.value())
+        {
+            finishItem();
+            mItemDepth.reset();
+        }
+    }
+    else if (depth == 1)
+    {
+        mInChannel = false;
+    }
+}
+
+void ZapFR::Engine::FeedParserRSS10Streaming::documentEnded()
+{
+    mRefreshHints.updatePeriod = syndicationUpdatePeriod(mUpdatePeriod, mUpdateFrequency);
+}
+
+void ZapFR::Engine::FeedParserRSS10Streaming::finishItem()
+{
+    // see if there's a content:encoded with more information present, if so, replace the body of the text with that
+    if (mItemSeen.test(ItemContentEncoded))
+    {
+        mItem.content = std::move(mContentEncoded);
+    }
+
+    mItem.guid = hashedGUID(mItem);
+
+    if (mItemSeen.test(ItemDate))
+    {
+        auto normalizedDate = DateParser::normalize(mItem.datePublished);
+        if (normalizedDate.has_value())
+        {
+            mItem.datePublished = std::move(normalizedDate.value());
+        }
+    }
+
+    mItems.emplace_back(std::move(mItem));
+}
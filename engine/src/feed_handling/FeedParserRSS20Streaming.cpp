@@ -0,0 +1,281 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include <Poco/NumberParser.h>
+#include <Poco/String.h>
+
+#include "ZapFR/DateParser.h"
+#include "ZapFR/feed_handling/FeedParserRSS20Streaming.h"
+
+namespace
+{
+    constexpr std::string_view gsTorrentNamespace{"http://xmlns.ezrss.it/0.1/"};
+}
+
+ZapFR::Engine::FeedParserRSS20Streaming::FeedParserRSS20Streaming(const std::string& url) : FeedParserXMLStreaming(url)
+{
+}
+
+void ZapFR::Engine::FeedParserRSS20Streaming::elementStarted(size_t depth, const Element& element, const Poco::XML::Attributes& attributes)
+{
+    if (mItemDepth.has_value())
+    {
+        itemElementStarted(depth, element, attributes);
+        return;
+    }
+
+    if (element.qname == "item")
+    {
+        mItemDepth = depth;
+        mItemSeen.reset();
+        mItem = {};
+        mContentEncoded.clear();
+        mMagnetURI.clear();
+        mContentLength.clear();
+        return;
+    }
+
+    if (depth == 1 && element.qname == "channel" && firstOccurrence(mChannelSeen, Channel))
+    {
+        mInChannel = true;
+    }
+    else if (mInChannel && depth == 2)
+    {
+        if (element.qname == "title" && firstOccurrence(mChannelSeen, ChannelTitle))
+        {
+            captureText(mTitle);
+        }
+        else if (element.qname == "link" && firstOccurrence(mChannelSeen, ChannelLink))
+        {
+            captureText(mLink);
+        }
+        else if (element.qname == "description" && firstOccurrence(mChannelSeen, ChannelDescription))
+        {
+            captureText(mDescription);
+        }
+        else if (element.qname == "language" && firstOccurrence(mChannelSeen, ChannelLanguage))
+        {
+            captureText(mLanguage);
+        }
+        else if (element.qname == "copyright" && firstOccurrence(mChannelSeen, ChannelCopyright))
+        {
+            captureText(mCopyright);
+        }
+        else if (element.qname == "image" && firstOccurrence(mChannelSeen, ChannelImage))
+        {
+            mInImage = true;
+        }
+        else if (element.qname == "ttl" && firstOccurrence(mChannelSeen, ChannelTTL))
+        {
+            captureText(mTTL);
+        }
+        else if (element.qname == "skipHours" && firstOccurrence(mChannelSeen, ChannelSkipHours))
+        {
+            mInSkipHours = true;
+        }
+        else if (element.qname == "skipDays" && firstOccurrence(mChannelSeen, ChannelSkipDays))
+        {
+            mInSkipDays = true;
+        }
+        else if (element.is(NamespaceSyndication, "updatePeriod") && firstOccurrence(mChannelSeen, ChannelUpdatePeriod))
+        {
+            captureText(mUpdatePeriod);
+        }
+        else if (element.is(NamespaceSyndication, "updateFrequency") && firstOccurrence(mChannelSeen, ChannelUpdateFrequency))
+        {
+            captureText(mUpdateFrequency);
+        }
+        else if (element.is(NamespaceAtom, "link"))
+        {
+            addWebSubLink(mWebSubLinks, attributes);
+        }
+    }
+    else if (mInImage && depth == 3 && element.qname == "url" && firstOccurrence(mChannelSeen, ChannelImageURL))
+    {
+        captureText(mIconURL);
+    }
+
+    if ((mInSkipHours && element.qname == "hour") || (mInSkipDays && element.qname == "day"))
+    {
+        mText.clear();
+        captureText(mText);
+    }
+}
+
+void ZapFR::Engine::FeedParserRSS20Streaming::elementEnded(size_t depth, const Element& element)
+{
+    if (mItemDepth.has_value())
+    {
+        if (depth == mItemDepth.value())
+        {
+            finishItem();
+            mItemDepth.reset();
+        }
+        else
+        {
+            itemElementEnded(element);
+        }
+        return;
+    }
+
+    if (depth == 1)
+    {
+        mInChannel = false;
+    }
+    else if (depth == 2)
+    {
+        mInImage = false;
+        mInSkipHours = false;
+        mInSkipDays = false;
+    }
+    else if (mInSkipHours && element.qname == "hour")
+    {
+        uint64_t hour{0};
+        if (Poco::NumberParser::tryParseUnsigned64(Poco::trim(mText), hour))
+        {
+            mRefreshHints.skipHours.set(hour % 24); // some feeds use 1-24 instead of 0-23
+        }
+    }
+    else if (mInSkipDays && element.qname == "day")
+    {
+        static const std::vector<std::string> dayNames{"sunday", "monday", "tuesday", "wednesday", "thursday", "friday", "saturday"};
+        auto it = std::find(dayNames.begin(), dayNames.end(), Poco::toLower(Poco::trim(mText)));
+        if (it != dayNames.end())
+        {
+            mRefreshHints.skipDays.set(static_cast<size_t>(std::distance(dayNames.begin(), it)));
+        }
+    }
+}
+
+void ZapFR::Engine::FeedParserRSS20Streaming::documentEnded()
+{
+    uint64_t ttlInMinutes{0};
+    if (Poco::NumberParser::tryParseUnsigned64(Poco::trim(mTTL), ttlInMinutes) && ttlInMinutes > 0)
+    {
+        mRefreshHints.ttl = ttlInMinutes * 60;
+    }
+    mRefreshHints.updatePeriod = syndicationUpdatePeriod(mUpdatePeriod, mUpdateFrequency);
+}
+
+void ZapFR::Engine::FeedParserRSS20Streaming::itemElementStarted(size_t depth, const Element& element, const Poco::XML::Attributes& attributes)
+{
+    if (depth == mItemDepth.value() + 1)
+    {
+        if (element.qname == "title" && firstOccurrence(mItemSeen, ItemTitle))
+        {
+            captureText(mItem.title);
+        }
+        else if (element.qname == "link" && firstOccurrence(mItemSeen, ItemLink))
+        {
+            captureText(mItem.link);
+        }
+        else if (element.qname == "author" && firstOccurrence(mItemSeen, ItemAuthor))
+        {
+            captureText(mItem.author);
+        }
+        else if (element.qname == "description" && firstOccurrence(mItemSeen, ItemDescription))
+        {
+            captureInnerXML(mItem.content);
+        }
+        else if (element.qname == "comments" && firstOccurrence(mItemSeen, ItemComments))
+        {
+            captureText(mItem.commentsURL);
+        }
+        else if (element.qname == "guid" && firstOccurrence(mItemSeen, ItemGUID))
+        {
+            captureText(mItem.guid);
+        }
+        else if (element.qname == "pubDate" && firstOccurrence(mItemSeen, ItemPubDate))
+        {
+            captureText(mItem.datePublished);
+        }
+        else if (element.is(NamespaceContent, "encoded") && firstOccurrence(mItemSeen, ItemContentEncoded))
+        {
+            captureText(mContentEncoded);
+        }
+        else if (element.is(gsTorrentNamespace, "magnetURI") && firstOccurrence(mItemSeen, ItemMagnetURI))
+        {
+            captureText(mMagnetURI);
+        }
+        else if (element.is(gsTorrentNamespace, "contentLength") && firstOccurrence(mItemSeen, ItemContentLength))
+        {
+            captureText(mContentLength);
+        }
+    }
+
+    if (element.qname == "enclosure")
+    {
+        Post::Enclosure e;
+        e.url = attribute(attributes, "url").value_or("");
+        e.mimeType = attribute(attributes, "type").value_or("");
+        auto length = attribute(attributes, "length");
+        if (length.has_value())
+        {
+            Poco::NumberParser::tryParseUnsigned64(length.value(), e.size);
+        }
+        mItem.enclosures.emplace_back(e);
+    }
+    else if (element.qname == "category")
+    {
+        mText.clear();
+        captureText(mText);
+    }
+}
+
+void ZapFR::Engine::FeedParserRSS20Streaming::itemElementEnded(const Element& element)
+{
+    if (element.qname == "category")
+    {
+        mItem.categories.emplace_back(mText);
+    }
+}
+
+void ZapFR::Engine::FeedParserRSS20Streaming::finishItem()
+{
+    // see if there's a content:encoded with more information present, if so, replace the body of the text with that
+    if (mItemSeen.test(ItemContentEncoded))
+    {
+        mItem.content = std::move(mContentEncoded);
+    }
+
+    // see if there's a torrent:magnetURI and torrent:contentLength present, if so, add that as an enclosure
+    if (!mMagnetURI.empty())
+    {
+        Post::Enclosure e;
+        e.url = mMagnetURI;
+        e.mimeType = "application/x-bittorrent";
+        Poco::NumberParser::tryParseUnsigned64(mContentLength, e.size);
+        mItem.enclosures.emplace_back(e);
+    }
+
+    if (!mItemSeen.test(ItemGUID))
+    {
+        mItem.guid = hashedGUID(mItem);
+    }
+
+    if (mItem.link.empty() && mItem.guid.starts_with("http"))
+    {
+        mItem.link = mItem.guid;
+    }
+
+    mItem.datePublished = DateParser::normalize(mItem.datePublished).value_or("");
+
+    mItems.emplace_back(std::move(mItem));
+}
@@ -0,0 +1,393 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <Poco/DigestStream.h>
+#include <Poco/MD5Engine.h>
+#include <Poco/NumberParser.h>
+#include <Poco/SAX/DefaultHandler.h>
+#include <Poco/SAX/InputSource.h>
+#include <Poco/SAX/LexicalHandler.h>
+#include <Poco/SAX/SAXParser.h>
+#include <Poco/String.h>
+#include <Poco/UUIDGenerator.h>
+
+#include "ZapFR/Helpers.h"
+#include "ZapFR/feed_handling/FeedParserATOM10Streaming.h"
+#include "ZapFR/feed_handling/FeedParserRSS10Streaming.h"
+#include "ZapFR/feed_handling/FeedParserRSS20Streaming.h"
+#include "ZapFR/feed_handling/FeedParserXMLStreaming.h"
+
+// picks the parser for the feed format on the root element, then forwards all the events to it
+class ZapFR::Engine::FeedParserXMLStreaming::SAXHandler : public Poco::XML::DefaultHandler, public Poco::XML::LexicalHandler
+{
+  public:
+    explicit SAXHandler(const std::string& url) : mURL(url) {}
+
+    void attach(Poco::XML::SAXParser& parser)
+    {
+        // same features as Poco::XML::DOMParser, so qualified names and attributes come out the way the DOM parsers see them
+        parser.setFeature(Poco::XML::XMLReader::FEATURE_NAMESPACES, true);
+        parser.setFeature(Poco::XML::XMLReader::FEATURE_NAMESPACE_PREFIXES, true);
+        parser.setContentHandler(this);
+        parser.setProperty(Poco::XML::XMLReader::PROPERTY_LEXICAL_HANDLER, static_cast<Poco::XML::LexicalHandler*>(this));
+    }
+
+    std::unique_ptr<FeedParser> result() { return std::move(mFeed); }
+
+    void startElement(const Poco::XML::XMLString& uri, const Poco::XML::XMLString& localName, const Poco::XML::XMLString& qname,
+                      const Poco::XML::Attributes& attributes) override
+    {
+        if (!mRootSeen)
+        {
+            mRootSeen = true;
+            if (qname == "rss")
+            {
+                auto version = FeedParserXMLStreaming::attribute(attributes, "version");
+                if (version.has_value() && version.value() == "2.0")
+                {
+                    mFeed = std::make_unique<FeedParserRSS20Streaming>(mURL);
+                }
+            }
+            else if (qname == "feed")
+            {
+                mFeed = std::make_unique<FeedParserATOM10Streaming>(mURL);
+            }
+            else if (qname == "rdf:RDF")
+            {
+                mFeed = std::make_unique<FeedParserRSS10Streaming>(mURL);
+            }
+            else
+            {
+                throw std::runtime_error("Unkown feed type");
+            }
+        }
+
+        if (mFeed != nullptr)
+        {
+            mFeed->startElement(uri, localName, qname, attributes);
+        }
+    }
+
+    void endElement(const Poco::XML::XMLString& uri, const Poco::XML::XMLString& localName, const Poco::XML::XMLString& qname) override
+    {
+        if (mFeed != nullptr)
+        {
+            mFeed->endElement(uri, localName, qname);
+        }
+    }
+
+    void characters(const Poco::XML::XMLChar ch[], int start, int length) override
+    {
+        if (mFeed != nullptr)
+        {
+            mFeed->characters(ch, start, length);
+        }
+    }
+
+    void ignorableWhitespace(const Poco::XML::XMLChar ch[], int start, int length) override { characters(ch, start, length); }
+
+    void processingInstruction(const Poco::XML::XMLString& target, const Poco::XML::XMLString& data) override
+    {
+        if (mFeed != nullptr)
+        {
+            mFeed->processingInstruction(target, data);
+        }
+    }
+
+    void endDocument() override
+    {
+        if (mFeed != nullptr)
+        {
+            mFeed->documentEnded();
+        }
+    }
+
+    void startCDATA() override
+    {
+        if (mFeed != nullptr)
+        {
+            mFeed->startCDATA();
+        }
+    }
+
+    void endCDATA() override
+    {
+        if (mFeed != nullptr)
+        {
+            mFeed->endCDATA();
+        }
+    }
+
+    void comment(const Poco::XML::XMLChar ch[], int start, int length) override
+    {
+        if (mFeed != nullptr)
+        {
+            mFeed->comment(ch, start, length);
+        }
+    }
+
+    void startDTD(const Poco::XML::XMLString&, const Poco::XML::XMLString&, const Poco::XML::XMLString&) override {}
+    void endDTD() override {}
+    void startEntity(const Poco::XML::XMLString&) override {}
+    void endEntity(const Poco::XML::XMLString&) override {}
+
+  private:
+    std::string mURL{""};
+    bool mRootSeen{false};
+    std::unique_ptr<FeedParserXMLStreaming> mFeed{nullptr};
+};
+
+ZapFR::Engine::FeedParserXMLStreaming::FeedParserXMLStreaming(const std::string& url) : FeedParser(url)
+{
+}
+
+std::unique_ptr<ZapFR::Engine::FeedParser> ZapFR::Engine::FeedParserXMLStreaming::parse(std::istream& stream, const std::string& url)
+{
+    SAXHandler handler(url);
+    Poco::XML::SAXParser parser;
+    handler.attach(parser);
+    Poco::XML::InputSource source(stream);
+    parser.parse(&source);
+    return handler.result();
+}
+
+std::unique_ptr<ZapFR::Engine::FeedParser> ZapFR::Engine::FeedParserXMLStreaming::parse(const std::string& data, const std::string& url)
+{
+    SAXHandler handler(url);
+    Poco::XML::SAXParser parser;
+    handler.attach(parser);
+    parser.parseMemoryNP(data.data(), data.size());
+    return handler.result();
+}
+
+void ZapFR::Engine::FeedParserXMLStreaming::startElement(const std::string& namespaceURI, const std::string& localName, const std::string& qname,
+                                                         const Poco::XML::Attributes& attributes)
+{
+    auto depth = mDepth++;
+    for (auto& capture : mCaptures)
+    {
+        if (!capture.innerXML)
+        {
+            continue;
+        }
+
+        // every child element gets serialized on its own, the same way DOMWriter::writeNode does it
+        if (depth == capture.depth + 1)
+        {
+            capture.childStream = std::make_unique<std::stringstream>();
+            capture.childWriter = std::make_unique<Poco::XML::XMLWriter>(*capture.childStream, Poco::XML::XMLWriter::CANONICAL_XML);
+            capture.childWriter->startFragment();
+        }
+        capture.childWriter->startElement(namespaceURI, localName, qname, attributes);
+    }
+
+    elementStarted(depth, Element{namespaceURI, localName, qname}, attributes);
+}
+
+void ZapFR::Engine::FeedParserXMLStreaming::endElement(const std::string& namespaceURI, const std::string& localName, const std::string& qname)
+{
+    auto depth = --mDepth;
+    while (!mCaptures.empty() && mCaptures.back().depth == depth)
+    {
+        mCaptures.pop_back();
+    }
+
+    for (auto& capture : mCaptures)
+    {
+        if (capture.childWriter == nullptr)
+        {
+            continue;
+        }
+
+        capture.childWriter->endElement(namespaceURI, localName, qname);
+        if (depth == capture.depth + 1)
+        {
+            capture.childWriter->endFragment();
+            capture.childWriter.reset();
+            capture.target->append(capture.childStream->str());
+            capture.childStream.reset();
+        }
+    }
+
+    elementEnded(depth, Element{namespaceURI, localName, qname});
+}
+
+void ZapFR::Engine::FeedParserXMLStreaming::characters(const Poco::XML::XMLChar ch[], int start, int length)
+{
+    for (auto& capture : mCaptures)
+    {
+        if (capture.childWriter != nullptr)
+        {
+            capture.childWriter->characters(ch, start, length);
+        }
+        else
+        {
+            capture.target->append(ch + start, static_cast<size_t>(length));
+        }
+    }
+}
+
+void ZapFR::Engine::FeedParserXMLStreaming::processingInstruction(const std::string& target, const std::string& data)
+{
+    for (auto& capture : mCaptures)
+    {
+        if (capture.childWriter != nullptr)
+        {
+            capture.childWriter->processingInstruction(target, data);
+        }
+    }
+}
+
+void ZapFR::Engine::FeedParserXMLStreaming::startCDATA()
+{
+    for (auto& capture : mCaptures)
+    {
+        if (capture.childWriter != nullptr)
+        {
+            capture.childWriter->startCDATA();
+        }
+    }
+}
+
+void ZapFR::Engine::FeedParserXMLStreaming::endCDATA()
+{
+    for (auto& capture : mCaptures)
+    {
+        if (capture.childWriter != nullptr)
+        {
+            capture.childWriter->endCDATA();
+        }
+    }
+}
+
+void ZapFR::Engine::FeedParserXMLStreaming::comment(const Poco::XML::XMLChar ch[], int start, int length)
+{
+    for (auto& capture : mCaptures)
+    {
+        if (capture.childWriter != nullptr)
+        {
+            capture.childWriter->comment(ch, start, length);
+        }
+    }
+}
+
+void ZapFR::Engine::FeedParserXMLStreaming::captureText(std::string& target)
+{
+    capture(target, false);
+}
+
+void ZapFR::Engine::FeedParserXMLStreaming::captureInnerXML(std::string& target)
+{
+    capture(target, true);
+}
+
+void ZapFR::Engine::FeedParserXMLStreaming::capture(std::string& target, bool innerXML)
+{
+    Capture c;
+    c.depth = mDepth - 1;
+    c.target = &target;
+    c.innerXML = innerXML;
+    mCaptures.emplace_back(std::move(c));
+}
+
+std::optional<std::string> ZapFR::Engine::FeedParserXMLStreaming::attribute(const Poco::XML::Attributes& attributes, const std::string& qname)
+{
+    auto index = attributes.getIndex(qname);
+    if (index < 0)
+    {
+        return {};
+    }
+    return attributes.getValue(index);
+}
+
+std::optional<std::string> ZapFR::Engine::FeedParserXMLStreaming::attribute(const Poco::XML::Attributes& attributes, const std::string& namespaceURI,
+                                                                            const std::string& localName)
+{
+    auto index = attributes.getIndex(namespaceURI, localName);
+    if (index < 0)
+    {
+        return {};
+    }
+    return attributes.getValue(index);
+}
+
+std::string ZapFR::Engine::FeedParserXMLStreaming::hashedGUID(const Item& item)
+{
+    // create a guid out of the link if present, or either title or description (all are optional, but either title or description must be present)
+    auto guidSrc = item.link;
+    if (guidSrc.empty())
+    {
+        guidSrc = item.title;
+    }
+    if (guidSrc.empty())
+    {
+        guidSrc = item.content;
+    }
+    if (guidSrc.empty()) // shouldn't happen, but just in case, use a random uuid
+    {
+        guidSrc = Poco::UUIDGenerator::defaultGenerator().createRandom().toString();
+    }
+
+    Poco::MD5Engine md5;
+    Poco::DigestOutputStream ds(md5);
+    ds << guidSrc;
+    ds.close();
+    return Poco::DigestEngine::digestToHex(md5.digest());
+}
+
+std::optional<uint64_t> ZapFR::Engine::FeedParserXMLStreaming::syndicationUpdatePeriod(const std::string& updatePeriod, const std::string& updateFrequency)
+{
+    static const std::unordered_map<std::string, uint64_t> periods{
+        {"hourly", 60 * 60}, {"daily", 24 * 60 * 60}, {"weekly", 7 * 24 * 60 * 60}, {"monthly", 30 * 24 * 60 * 60}, {"yearly", 365 * 24 * 60 * 60}};
+
+    auto it = periods.find(Poco::toLower(Poco::trim(updatePeriod)));
+    if (it == periods.end())
+    {
+        return {};
+    }
+
+    uint64_t frequency{1};
+    Poco::NumberParser::tryParseUnsigned64(Poco::trim(updateFrequency), frequency);
+    return it->second / std::max(frequency, static_cast<uint64_t>(1));
+}
+
+void ZapFR::Engine::FeedParserXMLStreaming::addWebSubLink(WebSubLinks& links, const Poco::XML::Attributes& attributes)
+{
+    auto href = Poco::trim(attribute(attributes, "href").value_or(""));
+    if (href.empty())
+    {
+        return;
+    }
+
+    std::vector<std::string> rels;
+    Helpers::splitString(Poco::toLower(attribute(attributes, "rel").value_or("")), ' ', rels);
+    for (const auto& rel : rels)
+    {
+        if (rel == "hub" && links.hub.empty())
+        {
+            links.hub = href;
+        }
+        else if (rel == "self" && links.self.empty())
+        {
+            links.self = href;
+        }
+    }
+}
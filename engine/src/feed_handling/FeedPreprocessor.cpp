@@ -0,0 +1,757 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cstring>
+#include <optional>
+
+#include <Poco/String.h>
+
+#include "ZapFR/feed_handling/FeedPreprocessor.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define ZAPFR_PREPROCESSOR_SSE2
+#if defined(__GNUC__)
+#define ZAPFR_PREPROCESSOR_AVX2
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define ZAPFR_PREPROCESSOR_NEON
+#endif
+
+namespace
+{
+    // HTML 4 named entities, minus the five XML predefines; sorted, so they can be binary searched
+    constexpr std::array<std::pair<std::string_view, uint32_t>, 248> gsHTMLEntities{{
+            {"AElig", 198}, {"Aacute", 193}, {"Acirc", 194}, {"Agrave", 192}, {"Alpha", 913}, {"Aring", 197}, {"Atilde", 195}, {"Auml", 196}, {"Beta", 914}, {"Ccedil", 199},
+            {"Chi", 935}, {"Dagger", 8225}, {"Delta", 916}, {"ETH", 208}, {"Eacute", 201}, {"Ecirc", 202}, {"Egrave", 200}, {"Epsilon", 917}, {"Eta", 919}, {"Euml", 203},
+            {"Gamma", 915}, {"Iacute", 205}, {"Icirc", 206}, {"Igrave", 204}, {"Iota", 921}, {"Iuml", 207}, {"Kappa", 922}, {"Lambda", 923}, {"Mu", 924}, {"Ntilde", 209},
+            {"Nu", 925}, {"OElig", 338}, {"Oacute", 211}, {"Ocirc", 212}, {"Ograve", 210}, {"Omega", 937}, {"Omicron", 927}, {"Oslash", 216}, {"Otilde", 213}, {"Ouml", 214},
+            {"Phi", 934}, {"Pi", 928}, {"Prime", 8243}, {"Psi", 936}, {"Rho", 929}, {"Scaron", 352}, {"Sigma", 931}, {"THORN", 222}, {"Tau", 932}, {"Theta", 920},
+            {"Uacute", 218}, {"Ucirc", 219}, {"Ugrave", 217}, {"Upsilon", 933}, {"Uuml", 220}, {"Xi", 926}, {"Yacute", 221}, {"Yuml", 376}, {"Zeta", 918}, {"aacute", 225},
+            {"acirc", 226}, {"acute", 180}, {"aelig", 230}, {"agrave", 224}, {"alefsym", 8501}, {"alpha", 945}, {"and", 8743}, {"ang", 8736}, {"aring", 229}, {"asymp", 8776},
+            {"atilde", 227}, {"auml", 228}, {"bdquo", 8222}, {"beta", 946}, {"brvbar", 166}, {"bull", 8226}, {"cap", 8745}, {"ccedil", 231}, {"cedil", 184}, {"cent", 162},
+            {"chi", 967}, {"circ", 710}, {"clubs", 9827}, {"cong", 8773}, {"copy", 169}, {"crarr", 8629}, {"cup", 8746}, {"curren", 164}, {"dArr", 8659}, {"dagger", 8224},
+            {"darr", 8595}, {"deg", 176}, {"delta", 948}, {"diams", 9830}, {"divide", 247}, {"eacute", 233}, {"ecirc", 234}, {"egrave", 232}, {"empty", 8709}, {"emsp", 8195},
+            {"ensp", 8194}, {"epsilon", 949}, {"equiv", 8801}, {"eta", 951}, {"eth", 240}, {"euml", 235}, {"euro", 8364}, {"exist", 8707}, {"fnof", 402}, {"forall", 8704},
+            {"frac12", 189}, {"frac14", 188}, {"frac34", 190}, {"frasl", 8260}, {"gamma", 947}, {"ge", 8805}, {"hArr", 8660}, {"harr", 8596}, {"hearts", 9829},
+            {"hellip", 8230}, {"iacute", 237}, {"icirc", 238}, {"iexcl", 161}, {"igrave", 236}, {"image", 8465}, {"infin", 8734}, {"int", 8747}, {"iota", 953},
+            {"iquest", 191}, {"isin", 8712}, {"iuml", 239}, {"kappa", 954}, {"lArr", 8656}, {"lambda", 955}, {"lang", 9001}, {"laquo", 171}, {"larr", 8592}, {"lceil", 8968},
+            {"ldquo", 8220}, {"le", 8804}, {"lfloor", 8970}, {"lowast", 8727}, {"loz", 9674}, {"lrm", 8206}, {"lsaquo", 8249}, {"lsquo", 8216}, {"macr", 175},
+            {"mdash", 8212}, {"micro", 181}, {"middot", 183}, {"minus", 8722}, {"mu", 956}, {"nabla", 8711}, {"nbsp", 160}, {"ndash", 8211}, {"ne", 8800}, {"ni", 8715},
+            {"not", 172}, {"notin", 8713}, {"nsub", 8836}, {"ntilde", 241}, {"nu", 957}, {"oacute", 243}, {"ocirc", 244}, {"oelig", 339}, {"ograve", 242}, {"oline", 8254},
+            {"omega", 969}, {"omicron", 959}, {"oplus", 8853}, {"or", 8744}, {"ordf", 170}, {"ordm", 186}, {"oslash", 248}, {"otilde", 245}, {"otimes", 8855}, {"ouml", 246},
+            {"para", 182}, {"part", 8706}, {"permil", 8240}, {"perp", 8869}, {"phi", 966}, {"pi", 960}, {"piv", 982}, {"plusmn", 177}, {"pound", 163}, {"prime", 8242},
+            {"prod", 8719}, {"prop", 8733}, {"psi", 968}, {"rArr", 8658}, {"radic", 8730}, {"rang", 9002}, {"raquo", 187}, {"rarr", 8594}, {"rceil", 8969}, {"rdquo", 8221},
+            {"real", 8476}, {"reg", 174}, {"rfloor", 8971}, {"rho", 961}, {"rlm", 8207}, {"rsaquo", 8250}, {"rsquo", 8217}, {"sbquo", 8218}, {"scaron", 353}, {"sdot", 8901},
+            {"sect", 167}, {"shy", 173}, {"sigma", 963}, {"sigmaf", 962}, {"sim", 8764}, {"spades", 9824}, {"sub", 8834}, {"sube", 8838}, {"sum", 8721}, {"sup", 8835},
+            {"sup1", 185}, {"sup2", 178}, {"sup3", 179}, {"supe", 8839}, {"szlig", 223}, {"tau", 964}, {"there4", 8756}, {"theta", 952}, {"thetasym", 977}, {"thinsp", 8201},
+            {"thorn", 254}, {"tilde", 732}, {"times", 215}, {"trade", 8482}, {"uArr", 8657}, {"uacute", 250}, {"uarr", 8593}, {"ucirc", 251}, {"ugrave", 249}, {"uml", 168},
+            {"upsih", 978}, {"upsilon", 965}, {"uuml", 252}, {"weierp", 8472}, {"xi", 958}, {"yacute", 253}, {"yen", 165}, {"yuml", 255}, {"zeta", 950}, {"zwj", 8205},
+            {"zwnj", 8204},
+    }};
+    static_assert(std::is_sorted(gsHTMLEntities.begin(), gsHTMLEntities.end()));
+
+    // what the bytes 0x80-0x9F mean in Windows-1252 (0xA0-0xFF match their code points); the unassigned ones become U+FFFD
+    constexpr std::array<uint32_t, 32> gsWindows1252{0x20AC, 0xFFFD, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021, 0x02C6, 0x2030, 0x0160,
+                                                     0x2039, 0x0152, 0xFFFD, 0x017D, 0xFFFD, 0xFFFD, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022,
+                                                     0x2013, 0x2014, 0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0xFFFD, 0x017E, 0x0178};
+
+    constexpr uint64_t gsHighBits{0x8080808080808080ULL};
+    constexpr uint64_t gsLowBits{0x0101010101010101ULL};
+
+    // number of leading bytes below 0x80
+    size_t asciiPrefixScalar(const char* data, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            if ((word & gsHighBits) != 0)
+            {
+                break;
+            }
+        }
+        while (i < size && static_cast<unsigned char>(data[i]) < 0x80)
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    // index of the first `a` or `b`, or `size` when there is none
+    size_t findEitherScalar(const char* data, size_t size, char a, char b)
+    {
+        const auto hasZeroByte = [](uint64_t word) { return (word - gsLowBits) & ~word & gsHighBits; };
+        const auto patternA = gsLowBits * static_cast<unsigned char>(a);
+        const auto patternB = gsLowBits * static_cast<unsigned char>(b);
+
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            if ((hasZeroByte(word ^ patternA) | hasZeroByte(word ^ patternB)) != 0)
+            {
+                break;
+            }
+        }
+        while (i < size && data[i] != a && data[i] != b)
+        {
+            ++i;
+        }
+        return i;
+    }
+
+#ifdef ZAPFR_PREPROCESSOR_SSE2
+    size_t asciiPrefixSSE2(const char* data, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            if (_mm_movemask_epi8(chunk) != 0)
+            {
+                break;
+            }
+        }
+        return i + asciiPrefixScalar(data + i, size - i);
+    }
+
+    size_t findEitherSSE2(const char* data, size_t size, char a, char b)
+    {
+        auto patternA = _mm_set1_epi8(a);
+        auto patternB = _mm_set1_epi8(b);
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, patternA), _mm_cmpeq_epi8(chunk, patternB))));
+            if (mask != 0)
+            {
+                return i + static_cast<size_t>(std::countr_zero(mask));
+            }
+        }
+        return i + findEitherScalar(data + i, size - i, a, b);
+    }
+#endif
+
+#ifdef ZAPFR_PREPROCESSOR_AVX2
+    __attribute__((target("avx2"))) size_t asciiPrefixAVX2(const char* data, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            if (_mm256_movemask_epi8(chunk) != 0)
+            {
+                break;
+            }
+        }
+        return i + asciiPrefixScalar(data + i, size - i);
+    }
+
+    __attribute__((target("avx2"))) size_t findEitherAVX2(const char* data, size_t size, char a, char b)
+    {
+        auto patternA = _mm256_set1_epi8(a);
+        auto patternB = _mm256_set1_epi8(b);
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, patternA), _mm256_cmpeq_epi8(chunk, patternB))));
+            if (mask != 0)
+            {
+                return i + static_cast<size_t>(std::countr_zero(mask));
+            }
+        }
+        return i + findEitherScalar(data + i, size - i, a, b);
+    }
+#endif
+
+#ifdef ZAPFR_PREPROCESSOR_NEON
+    size_t asciiPrefixNEON(const char* data, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            auto chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+            if (vmaxvq_u8(chunk) >= 0x80)
+            {
+                break;
+            }
+        }
+        return i + asciiPrefixScalar(data + i, size - i);
+    }
+
+    size_t findEitherNEON(const char* data, size_t size, char a, char b)
+    {
+        auto patternA = vdupq_n_u8(static_cast<uint8_t>(a));
+        auto patternB = vdupq_n_u8(static_cast<uint8_t>(b));
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            auto chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+            if (vmaxvq_u8(vorrq_u8(vceqq_u8(chunk, patternA), vceqq_u8(chunk, patternB))) != 0)
+            {
+                break;
+            }
+        }
+        return i + findEitherScalar(data + i, size - i, a, b);
+    }
+#endif
+
+    struct Kernels
+    {
+        size_t (*asciiPrefix)(const char*, size_t);
+        size_t (*findEither)(const char*, size_t, char, char);
+        std::string_view name;
+    };
+
+    const Kernels& kernels()
+    {
+        static const Kernels selected = []() -> Kernels
+        {
+#ifdef ZAPFR_PREPROCESSOR_AVX2
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return {asciiPrefixAVX2, findEitherAVX2, "AVX2"};
+            }
+#endif
+#if defined(ZAPFR_PREPROCESSOR_SSE2)
+            return {asciiPrefixSSE2, findEitherSSE2, "SSE2"};
+#elif defined(ZAPFR_PREPROCESSOR_NEON)
+            return {asciiPrefixNEON, findEitherNEON, "NEON"};
+#else
+            return {asciiPrefixScalar, findEitherScalar, "scalar"};
+#endif
+        }();
+        return selected;
+    }
+
+    // the length of the well-formed UTF-8 sequence at the start of `s` (which isn't empty), or 0 if it's malformed or cut off
+    size_t sequenceLength(std::string_view s)
+    {
+        const auto byte = [&](size_t i) { return static_cast<unsigned char>(s[i]); };
+        const auto continuation = [&](size_t i, unsigned char low = 0x80, unsigned char high = 0xBF) { return i < s.size() && byte(i) >= low && byte(i) <= high; };
+
+        auto lead = byte(0);
+        if (lead < 0x80)
+        {
+            return 1;
+        }
+        else if (lead < 0xC2)
+        {
+            return 0;
+        }
+        else if (lead < 0xE0)
+        {
+            return continuation(1) ? 2 : 0;
+        }
+        else if (lead < 0xF0)
+        {
+            auto low = lead == 0xE0 ? 0xA0 : 0x80;  // overlong
+            auto high = lead == 0xED ? 0x9F : 0xBF; // surrogates
+            return (continuation(1, low, high) && continuation(2)) ? 3 : 0;
+        }
+        else if (lead < 0xF5)
+        {
+            auto low = lead == 0xF0 ? 0x90 : 0x80;  // overlong
+            auto high = lead == 0xF4 ? 0x8F : 0xBF; // beyond U+10FFFF
+            return (continuation(1, low, high) && continuation(2) && continuation(3)) ? 4 : 0;
+        }
+        return 0;
+    }
+
+    // how many bytes at the end of `s` are the start of a sequence that continues in the next chunk
+    size_t incompleteTail(std::string_view s)
+    {
+        for (size_t k = 1; k <= std::min<size_t>(3, s.size()); ++k)
+        {
+            auto c = static_cast<unsigned char>(s[s.size() - k]);
+            if ((c & 0xC0) == 0x80)
+            {
+                continue;
+            }
+            if (c >= 0xC0)
+            {
+                size_t expected = c >= 0xF0 ? 4 : (c >= 0xE0 ? 3 : 2);
+                return expected > k ? k : 0;
+            }
+            return 0;
+        }
+        return 0;
+    }
+
+    void appendCodepoint(uint32_t cp, std::string& out)
+    {
+        if (cp < 0x80)
+        {
+            out += static_cast<char>(cp);
+        }
+        else if (cp < 0x800)
+        {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else if (cp < 0x10000)
+        {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else
+        {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    void appendRepairedUTF8(std::string_view s, std::string& out)
+    {
+        const auto& k = kernels();
+        size_t i = 0;
+        while (i < s.size())
+        {
+            auto ascii = k.asciiPrefix(s.data() + i, s.size() - i);
+            out.append(s.data() + i, ascii);
+            i += ascii;
+            if (i == s.size())
+            {
+                break;
+            }
+
+            auto length = sequenceLength(s.substr(i));
+            if (length > 0)
+            {
+                out.append(s.data() + i, length);
+                i += length;
+            }
+            else
+            {
+                auto c = static_cast<unsigned char>(s[i]);
+                appendCodepoint(c < 0xA0 ? gsWindows1252.at(c - 0x80) : c, out);
+                ++i;
+            }
+        }
+    }
+
+    std::optional<uint32_t> htmlEntity(std::string_view name)
+    {
+        auto it = std::lower_bound(gsHTMLEntities.begin(), gsHTMLEntities.end(), name, [](const auto& entry, std::string_view n) { return entry.first < n; });
+        if (it != gsHTMLEntities.end() && it->first == name)
+        {
+            return it->second;
+        }
+        return {};
+    }
+
+    bool isXMLWhitespace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    constexpr std::string_view gsUTF8BOM{"\xEF\xBB\xBF"};
+} // namespace
+
+size_t ZapFR::Engine::FeedPreprocessor::significantOffset(std::string_view data)
+{
+    size_t offset = data.starts_with(gsUTF8BOM) ? gsUTF8BOM.size() : 0;
+    while (offset < data.size() && isXMLWhitespace(data[offset]))
+    {
+        ++offset;
+    }
+    return offset;
+}
+
+ZapFR::Engine::FeedPreprocessor::Format ZapFR::Engine::FeedPreprocessor::sniff(std::string_view data)
+{
+    auto offset = significantOffset(data);
+    if (offset == data.size())
+    {
+        return Format::Unknown;
+    }
+
+    auto first = static_cast<unsigned char>(data[offset]);
+    if (first == '<' || first == 0xFE || first == 0xFF) // UTF-16 byte order marks; JSON has to be UTF-8, so these can only be XML
+    {
+        return Format::XML;
+    }
+    else if (first == '{')
+    {
+        return Format::JSON;
+    }
+    return Format::Unknown;
+}
+
+ZapFR::Engine::FeedPreprocessor::Format ZapFR::Engine::FeedPreprocessor::sniff(std::istream& stream)
+{
+    constexpr auto eof = std::char_traits<char>::eof();
+    if (stream.peek() == static_cast<unsigned char>(gsUTF8BOM[0]))
+    {
+        char bom[3];
+        stream.read(bom, 3);
+        if (stream.gcount() != 3 || std::string_view(bom, 3) != gsUTF8BOM)
+        {
+            return Format::Unknown;
+        }
+    }
+    while (stream.peek() != eof && isXMLWhitespace(static_cast<char>(stream.peek())))
+    {
+        stream.get();
+    }
+
+    auto next = stream.peek();
+    if (next == '<' || next == 0xFE || next == 0xFF)
+    {
+        return Format::XML;
+    }
+    else if (next == '{')
+    {
+        return Format::JSON;
+    }
+    return Format::Unknown;
+}
+
+std::string ZapFR::Engine::FeedPreprocessor::prepare(std::string_view xml)
+{
+    auto body = xml.substr(significantOffset(xml));
+    std::string out;
+    out.reserve(body.size());
+    Filter().process(body, true, out);
+    return out;
+}
+
+bool ZapFR::Engine::FeedPreprocessor::isValidUTF8(std::string_view data)
+{
+    const auto& k = kernels();
+    size_t i = 0;
+    while (i < data.size())
+    {
+        i += k.asciiPrefix(data.data() + i, data.size() - i);
+        if (i == data.size())
+        {
+            break;
+        }
+        auto length = sequenceLength(data.substr(i));
+        if (length == 0)
+        {
+            return false;
+        }
+        i += length;
+    }
+    return true;
+}
+
+bool ZapFR::Engine::FeedPreprocessor::isValidUTF8Scalar(std::string_view data)
+{
+    size_t i = 0;
+    while (i < data.size())
+    {
+        auto c = static_cast<unsigned char>(data[i]);
+        size_t length = 0;
+        uint32_t cp = 0;
+        uint32_t minimum = 0;
+        if (c < 0x80)
+        {
+            ++i;
+            continue;
+        }
+        else if ((c & 0xE0) == 0xC0)
+        {
+            length = 2;
+            cp = c & 0x1F;
+            minimum = 0x80;
+        }
+        else if ((c & 0xF0) == 0xE0)
+        {
+            length = 3;
+            cp = c & 0x0F;
+            minimum = 0x800;
+        }
+        else if ((c & 0xF8) == 0xF0)
+        {
+            length = 4;
+            cp = c & 0x07;
+            minimum = 0x10000;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (i + length > data.size())
+        {
+            return false;
+        }
+        for (size_t j = 1; j < length; ++j)
+        {
+            auto cc = static_cast<unsigned char>(data[i + j]);
+            if ((cc & 0xC0) != 0x80)
+            {
+                return false;
+            }
+            cp = (cp << 6) | (cc & 0x3F);
+        }
+        if (cp < minimum || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+        {
+            return false;
+        }
+        i += length;
+    }
+    return true;
+}
+
+std::string_view ZapFR::Engine::FeedPreprocessor::instructionSet()
+{
+    return kernels().name;
+}
+
+size_t ZapFR::Engine::FeedPreprocessor::Filter::process(std::string_view in, bool final, std::string& out)
+{
+    const auto& k = kernels();
+    size_t pos = 0;
+
+    // a terminator (or a multibyte sequence) may straddle the end of the chunk, so hold back its possible start
+    const auto emitUntil = [&](std::string_view terminator, Mode nextMode)
+    {
+        auto end = in.find(terminator, pos);
+        if (end == std::string_view::npos)
+        {
+            auto keep = final ? 0 : std::min(in.size() - pos, std::max(terminator.size() - 1, incompleteTail(in.substr(pos))));
+            emit(in.substr(pos, in.size() - pos - keep), out);
+            pos = in.size() - keep;
+            return false;
+        }
+        end += terminator.size();
+        emit(in.substr(pos, end - pos), out);
+        pos = end;
+        mMode = nextMode;
+        return true;
+    };
+
+    if (mMode == Mode::Prolog)
+    {
+        if (in.size() < 5 && !final)
+        {
+            return 0;
+        }
+        if (in.starts_with("\xFE\xFF") || in.starts_with("\xFF\xFE"))
+        {
+            // UTF-16; left to the XML parser as is
+            mMode = Mode::Verbatim;
+            mRepairUTF8 = false;
+        }
+        else
+        {
+            auto declaration = in.substr(in.starts_with(gsUTF8BOM) ? gsUTF8BOM.size() : 0);
+            if (declaration.starts_with("<?xml"))
+            {
+                auto end = declaration.find("?>");
+                if (end == std::string_view::npos && !final)
+                {
+                    return 0;
+                }
+                declaration = declaration.substr(0, end);
+
+                // only a document that says it's UTF-8 (or says nothing, which means the same) gets repaired, any other
+                // declared charset gets transcoded by the XML parser itself
+                auto attribute = declaration.find("encoding");
+                if (attribute != std::string_view::npos)
+                {
+                    auto quote = declaration.find_first_of("\"'", attribute);
+                    if (quote != std::string_view::npos)
+                    {
+                        auto closingQuote = declaration.find(declaration[quote], quote + 1);
+                        auto encoding = std::string(declaration.substr(quote + 1, closingQuote == std::string_view::npos ? std::string_view::npos : closingQuote - quote - 1));
+                        mRepairUTF8 = (Poco::icompare(encoding, "utf-8") == 0 || Poco::icompare(encoding, "utf8") == 0);
+                    }
+                }
+            }
+            mMode = Mode::Text;
+        }
+    }
+
+    while (pos < in.size())
+    {
+        if (mMode == Mode::Verbatim)
+        {
+            auto keep = final ? 0 : incompleteTail(in.substr(pos));
+            emit(in.substr(pos, in.size() - pos - keep), out);
+            return in.size() - keep;
+        }
+        else if (mMode == Mode::CDATA)
+        {
+            if (!emitUntil("]]>", Mode::Text))
+            {
+                return pos;
+            }
+        }
+        else if (mMode == Mode::Comment)
+        {
+            if (!emitUntil("-->", Mode::Text))
+            {
+                return pos;
+            }
+        }
+        else
+        {
+            auto special = pos + k.findEither(in.data() + pos, in.size() - pos, '&', '<');
+            if (special == in.size())
+            {
+                auto keep = final ? 0 : incompleteTail(in.substr(pos));
+                emit(in.substr(pos, in.size() - pos - keep), out);
+                return in.size() - keep;
+            }
+            emit(in.substr(pos, special - pos), out);
+            pos = special;
+
+            auto rest = in.substr(pos);
+            if (rest[0] == '<')
+            {
+                constexpr std::string_view cdata{"<![CDATA["};
+                constexpr std::string_view comment{"<!--"};
+                constexpr std::string_view doctype{"<!DOCTYPE"};
+                if (rest.size() < cdata.size() && !final)
+                {
+                    return pos;
+                }
+
+                if (rest.starts_with(cdata))
+                {
+                    out.append(cdata);
+                    pos += cdata.size();
+                    mMode = Mode::CDATA;
+                }
+                else if (rest.starts_with(comment))
+                {
+                    out.append(comment);
+                    pos += comment.size();
+                    mMode = Mode::Comment;
+                }
+                else if (rest.starts_with(doctype))
+                {
+                    // an internal subset may declare entities of its own, so from here on nothing gets rewritten
+                    auto subset = rest.find_first_of("[>");
+                    if (subset == std::string_view::npos && !final)
+                    {
+                        return pos;
+                    }
+                    if (subset != std::string_view::npos && rest[subset] == '[')
+                    {
+                        mMode = Mode::Verbatim;
+                    }
+                    out.append(doctype);
+                    pos += doctype.size();
+                }
+                else
+                {
+                    out += '<';
+                    ++pos;
+                }
+            }
+            else
+            {
+                constexpr size_t maxNameLength{32};
+                size_t end = 1;
+                while (end < rest.size() && end <= maxNameLength && std::isalnum(static_cast<unsigned char>(rest[end])))
+                {
+                    ++end;
+                }
+                if (end == rest.size() && end <= maxNameLength && !final)
+                {
+                    return pos;
+                }
+
+                std::optional<uint32_t> codepoint;
+                if (end > 1 && end < rest.size() && rest[end] == ';')
+                {
+                    codepoint = htmlEntity(rest.substr(1, end - 1));
+                }
+                if (codepoint.has_value())
+                {
+                    out.append("&#");
+                    out.append(std::to_string(codepoint.value()));
+                    out += ';';
+                    pos += end + 1;
+                }
+                else
+                {
+                    out += '&';
+                    ++pos;
+                }
+            }
+        }
+    }
+    return pos;
+}
+
+void ZapFR::Engine::FeedPreprocessor::Filter::emit(std::string_view span, std::string& out) const
+{
+    if (mRepairUTF8)
+    {
+        appendRepairedUTF8(span, out);
+    }
+    else
+    {
+        out.append(span);
+    }
+}
+
+ZapFR::Engine::FeedPreprocessor::StreamBuffer::StreamBuffer(std::istream& source, size_t chunkSize) : mSource(source), mChunkSize(std::max<size_t>(chunkSize, 1))
+{
+}
+
+ZapFR::Engine::FeedPreprocessor::StreamBuffer::int_type ZapFR::Engine::FeedPreprocessor::StreamBuffer::underflow()
+{
+    if (gptr() < egptr())
+    {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    mOutput.clear();
+    while (mOutput.empty())
+    {
+        if (mSourceExhausted && mPending.empty())
+        {
+            return traits_type::eof();
+        }
+
+        if (!mSourceExhausted)
+        {
+            auto previousSize = mPending.size();
+            mPending.resize(previousSize + mChunkSize);
+            mSource.read(mPending.data() + previousSize, static_cast<std::streamsize>(mChunkSize));
+            mPending.resize(previousSize + static_cast<size_t>(mSource.gcount()));
+            mSourceExhausted = !mSource;
+        }
+
+        auto consumed = mFilter.process(mPending, mSourceExhausted, mOutput);
+        mPending.erase(0, consumed);
+    }
+
+    setg(mOutput.data(), mOutput.data(), mOutput.data() + mOutput.size());
+    return traits_type::to_int_type(*gptr());
+}
@@ -20,17 +20,24 @@
 #include <fmt/core.h>
 
 #include <Poco/Data/RecordSet.h>
-#include <Poco/DigestStream.h>
+#include <Poco/DateTimeFormatter.h>
 #include <Poco/FileStream.h>
-#include <Poco/MD5Engine.h>
+#include <Poco/JSON/Parser.h>
 #include <Poco/Path.h>
 #include <Poco/StreamCopier.h>
+#include <Poco/Timestamp.h>
 
+#include "ZapFR/AdaptiveRefresh.h"
+#include "ZapFR/Agent.h"
+#include "ZapFR/AutoRefresh.h"
 #include "ZapFR/Database.h"
+#include "ZapFR/DateParser.h"
+#include "ZapFR/FavIconCache.h"
 #include "ZapFR/Helpers.h"
+#include "ZapFR/IconCache.h"
 #include "ZapFR/Log.h"
+#include "ZapFR/WebSub.h"
 #include "ZapFR/base/Script.h"
-#include "ZapFR/feed_handling/FavIconParser.h"
 #include "ZapFR/feed_handling/FeedFetcher.h"
 #include "ZapFR/feed_handling/FeedParser.h"
 #include "ZapFR/local/FeedLocal.h"
@@ -43,6 +50,8 @@ using namespace Poco::Data::Keywords;
 
 std::string ZapFR::Engine::FeedLocal::msIconDir{""};
 std::mutex ZapFR::Engine::FeedLocal::msCreateFeedMutex{};
+std::atomic<uint64_t> ZapFR::Engine::FeedLocal::msUnchangedBodyCount{0};
+std::atomic<uint64_t> ZapFR::Engine::FeedLocal::msUnchangedBodyBytes{0};
 
 ZapFR::Engine::FeedLocal::FeedLocal(uint64_t id, Source* parentSource) : Feed(id, parentSource)
 {
@@ -134,6 +143,13 @@ void ZapFR::Engine::FeedLocal::fetchData()
     {
         Poco::Nullable<std::string> lastRefreshError;
         Poco::Nullable<std::string> cgi;
+        Poco::Nullable<uint64_t> refreshInterval;
+        Poco::Nullable<uint64_t> adaptiveRefreshInterval;
+        Poco::Nullable<std::string> pendingRedirectURL;
+        Poco::Nullable<std::string> bodyHash;
+        Poco::Nullable<std::string> iconURL;
+        Poco::Nullable<std::string> iconHash;
+        Poco::Nullable<std::string> iconLastFetched;
         Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
         selectStmt << "SELECT url"
                       ",folder"
@@ -148,11 +164,50 @@ void ZapFR::Engine::FeedLocal::fetchData()
                       ",lastRefreshError"
                       ",sortOrder"
                       ",conditionalGETInfo"
+                      ",refreshInterval"
+                      ",adaptiveRefreshInterval"
+                      ",consecutiveFailures"
+                      ",pendingRedirectURL"
+                      ",pendingRedirectCount"
+                      ",bodyHash"
+                      ",iconURL"
+                      ",iconHash"
+                      ",iconLastFetched"
                       " FROM feeds"
                       " WHERE id=?",
             use(mID), into(mURL), into(mFolderID), into(mGuid), into(mTitle), into(mSubtitle), into(mLink), into(mDescription), into(mLanguage), into(mCopyright),
-            into(mLastChecked), into(lastRefreshError), into(mSortOrder), into(cgi), now;
+            into(mLastChecked), into(lastRefreshError), into(mSortOrder), into(cgi), into(refreshInterval), into(adaptiveRefreshInterval),
+            into(mConsecutiveFailures), into(pendingRedirectURL), into(mPendingRedirectCount), into(bodyHash), into(iconURL), into(iconHash), into(iconLastFetched), now;
         mDataFetched = true;
+        // the background icon refresh relies on these to skip fresh icons and to prefer the icon the feed declares over scraping the site
+        if (!iconURL.isNull())
+        {
+            mIconURL = iconURL.value();
+        }
+        if (!iconHash.isNull())
+        {
+            mIconHash = iconHash.value();
+        }
+        if (!iconLastFetched.isNull())
+        {
+            mIconLastFetched = iconLastFetched.value();
+        }
+        if (!bodyHash.isNull())
+        {
+            mBodyHash = bodyHash.value();
+        }
+        if (!pendingRedirectURL.isNull())
+        {
+            mPendingRedirectURL = pendingRedirectURL.value();
+        }
+        if (!refreshInterval.isNull())
+        {
+            mRefreshInterval = refreshInterval.value();
+        }
+        if (!adaptiveRefreshInterval.isNull())
+        {
+            mAdaptiveRefreshInterval = adaptiveRefreshInterval.value();
+        }
         if (!lastRefreshError.isNull())
         {
             mLastRefreshError = lastRefreshError.value();
@@ -166,41 +221,98 @@ void ZapFR::Engine::FeedLocal::fetchData()
 
 void ZapFR::Engine::FeedLocal::refresh()
 {
-    Log::log(LogLevel::Info, "Refreshing feed", mID);
-    fetchData();
-
+    auto fetchedData = fetch();
+    if (fetchedData.has_value())
     {
-        auto nowISO = Poco::DateTimeFormatter::format(Poco::DateTime(), Poco::DateTimeFormat::ISO8601_FORMAT);
-        Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
-        updateStmt << "UPDATE feeds SET lastRefreshError=NULL, lastChecked=? WHERE id=?", useRef(nowISO), use(mID), now;
-        setLastRefreshError({});
+        ingest(std::move(fetchedData.value()));
     }
+}
 
+std::optional<ZapFR::Engine::FeedLocal::FetchedData> ZapFR::Engine::FeedLocal::fetch()
+{
+    prepareRefresh();
+
+    FeedFetcher ff;
+    auto result = Telemetry::Result::Failed;
     try
     {
-        FeedFetcher ff;
-        const auto& parsedFeed = ff.parseURL(mURL, mID, mConditionalGETInfo);
-        if (parsedFeed.has_value())
+        // plenty of feeds don't do conditional GETs, so hand over the hash of the last body we ingested, a body we've seen before isn't parsed again
+        auto knownBodyHash = (mBodyHash.empty() ? std::optional<std::string>() : std::optional<std::string>(mBodyHash));
+        auto parsedFeed = ff.parseURL(mURL, mID, mConditionalGETInfo, knownBodyHash);
+        confirmPermanentRedirect(ff.permanentRedirectURL());
+        result = Telemetry::Result::NotModified;
+        if (ff.bodyUnchanged())
         {
-            if (parsedFeed.value() == nullptr)
-            {
-                throw std::runtime_error("Feed type not recognized");
-            }
-
-            const auto& guid = parsedFeed.value()->guid();
-            const auto& title = parsedFeed.value()->title();
-            const auto& subtitle = parsedFeed.value()->subtitle();
-            const auto& link = parsedFeed.value()->link();
-            const auto& description = parsedFeed.value()->description();
-            const auto& language = parsedFeed.value()->language();
-            const auto& copyright = parsedFeed.value()->copyright();
-            const auto& iconURL = parsedFeed.value()->iconURL();
+            msUnchangedBodyCount++;
+            msUnchangedBodyBytes += ff.transferStats().bodyBytes;
+            result = Telemetry::Result::Unchanged;
+            Log::log(LogLevel::Debug, fmt::format("Feed body unchanged since the last refresh; skipped parsing and ingesting {} bytes", ff.transferStats().bodyBytes),
+                     mID);
+        }
+        else if (parsedFeed.has_value())
+        {
+            FetchedData data;
+            data.parsedFeed = std::move(parsedFeed.value());
+            data.conditionalGETInfo = ff.conditionalGETInfo();
+            data.bodyHash = ff.bodyHash();
+
+            // the ingest stage finishes (and records) the telemetry
+            setTransferTelemetry(ff.transferStats());
+            mTelemetry.parseTime = ff.parseTime();
+            data.telemetry = mTelemetry;
+            return data;
+        }
+        recordRefreshSuccess(); // not modified
+    }
+    catch (const Poco::Exception& e)
+    {
+        updateAndLogLastRefreshError(e.displayText());
+    }
+    catch (const std::runtime_error& e)
+    {
+        updateAndLogLastRefreshError(e.what());
+    }
+    catch (...)
+    {
+        updateAndLogLastRefreshError("Unknown exception");
+    }
+    setTransferTelemetry(ff.transferStats());
+    mTelemetry.parseTime = ff.parseTime();
+    recordTelemetry(result);
+    return {};
+}
 
-            update(iconURL, guid, title, subtitle, link, description, language, copyright, ff.conditionalGETInfo());
-            processItems(parsedFeed.value().get());
+void ZapFR::Engine::FeedLocal::ingest(FetchedData data)
+{
+    fetchData();
 
-            refreshIcon();
-            fetchUnreadCount();
+    mTelemetry = data.telemetry;
+    auto result = Telemetry::Result::Failed;
+    try
+    {
+        if (data.pushed)
+        {
+            // pushed content says nothing about what a poll returns, so the validators and body hash of the last poll are kept
+            Log::log(LogLevel::Info, "Ingesting content pushed by the WebSub hub", mID);
+            mTelemetry.transferredBytes = data.body.size();
+            mTelemetry.bodyBytes = data.body.size();
+            FeedFetcher ff;
+            Poco::Timestamp parseStart;
+            auto parsedFeed = ff.parseString(data.body, mURL);
+            mTelemetry.parseTime = static_cast<uint64_t>(parseStart.elapsed());
+            ingestParsedFeed(parsedFeed.get(), mConditionalGETInfo.value_or(""));
+            result = Telemetry::Result::Pushed;
+        }
+        else
+        {
+            ingestParsedFeed(data.parsedFeed.get(), data.conditionalGETInfo);
+            updateWebSubSubscription(data.parsedFeed.get());
+
+            // only remembered once the body made it in, so a body that failed to ingest is tried again
+            mBodyHash = data.bodyHash;
+            Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+            updateStmt << "UPDATE feeds SET bodyHash=? WHERE id=?", useRef(mBodyHash), use(mID), now;
+            result = Telemetry::Result::Parsed;
         }
     }
     catch (const Poco::Exception& e)
@@ -215,10 +327,172 @@ void ZapFR::Engine::FeedLocal::refresh()
     {
         updateAndLogLastRefreshError("Unknown exception");
     }
+    recordTelemetry(result);
+}
+
+void ZapFR::Engine::FeedLocal::prepareRefresh()
+{
+    Log::log(LogLevel::Info, "Refreshing feed", mID);
+    fetchData();
+    mTelemetry = {};
+
+    auto nowISO = Poco::DateTimeFormatter::format(Poco::DateTime(), Poco::DateTimeFormat::ISO8601_FORMAT);
+    Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+    updateStmt << "UPDATE feeds SET lastRefreshError=NULL, lastChecked=? WHERE id=?", useRef(nowISO), use(mID), now;
+    setLastRefreshError({});
+    setLastChecked(nowISO);
+    updateNextRefresh();
+}
+
+void ZapFR::Engine::FeedLocal::ingestParsedFeed(FeedParser* parsedFeed, const std::string& conditionalGETInfo)
+{
+    if (parsedFeed == nullptr)
+    {
+        throw std::runtime_error("Feed type not recognized");
+    }
+
+    const auto& guid = parsedFeed->guid();
+    const auto& title = parsedFeed->title();
+    const auto& subtitle = parsedFeed->subtitle();
+    const auto& link = parsedFeed->link();
+    const auto& description = parsedFeed->description();
+    const auto& language = parsedFeed->language();
+    const auto& copyright = parsedFeed->copyright();
+    const auto& iconURL = parsedFeed->iconURL();
+
+    Poco::Timestamp ingestStart;
+    update(iconURL, guid, title, subtitle, link, description, language, copyright, conditionalGETInfo);
+    std::tie(mTelemetry.newItems, mTelemetry.updatedItems) = processItems(parsedFeed);
+    updateAdaptiveRefreshInterval(parsedFeed, conditionalGETInfo);
+
+    // icons are fetched in the background, so they don't hold up the refresh
+    if (mParentSource != nullptr && isIconStale())
+    {
+        Agent::getInstance()->queueRefreshFeedIcon(mParentSource->id(), mID);
+    }
+    fetchUnreadCount();
+    mTelemetry.ingestTime = static_cast<uint64_t>(ingestStart.elapsed());
+    recordRefreshSuccess();
 }
 
-void ZapFR::Engine::FeedLocal::processItems(FeedParser* parsedFeed)
+void ZapFR::Engine::FeedLocal::updateAdaptiveRefreshInterval(FeedParser* parsedFeed, const std::string& conditionalGETInfo)
 {
+    AdaptiveRefresh::Input input;
+    input.hints = parsedFeed->refreshHints();
+
+    std::vector<std::string> postDates;
+    auto historySize = AdaptiveRefresh::PostHistorySize;
+    Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+    selectStmt << "SELECT datePublished FROM posts WHERE feedID=? AND datePublished IS NOT NULL AND datePublished != '' ORDER BY datePublished DESC LIMIT ?",
+        use(mID), use(historySize), into(postDates), now;
+    for (const auto& postDate : postDates)
+    {
+        auto parsedDate = DateParser::parse(postDate);
+        if (parsedDate.has_value())
+        {
+            input.postDates.emplace_back(Poco::Timestamp::fromEpochTime(static_cast<std::time_t>(parsedDate.value())));
+        }
+    }
+
+    if (!conditionalGETInfo.empty())
+    {
+        try
+        {
+            Poco::JSON::Parser parser;
+            auto cgiObj = parser.parse(conditionalGETInfo).extract<Poco::JSON::Object::Ptr>();
+            if (cgiObj->has("f"))
+            {
+                input.freshnessLifetime = cgiObj->getValue<uint64_t>("f");
+            }
+        }
+        catch (...)
+        {
+        }
+    }
+
+    auto interval = AdaptiveRefresh::calculateInterval(input);
+    Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+    updateStmt << "UPDATE feeds SET adaptiveRefreshInterval=? WHERE id=?", use(interval), use(mID), now;
+    setAdaptiveRefreshInterval(interval);
+    Log::log(LogLevel::Debug, fmt::format("Adaptive refresh interval set to {} seconds", interval), mID);
+    updateNextRefresh();
+}
+
+void ZapFR::Engine::FeedLocal::updateNextRefresh()
+{
+    auto autoRefresh = AutoRefresh::getInstance();
+
+    auto lastCheckedEpoch = static_cast<uint64_t>(Poco::Timestamp().epochTime());
+    auto lastChecked = DateParser::parse(mLastChecked);
+    if (lastChecked.has_value())
+    {
+        lastCheckedEpoch = static_cast<uint64_t>(lastChecked.value());
+    }
+
+    auto webSub = WebSub::getInstance();
+    auto pushed = webSub->isEnabled() && webSub->hasActiveSubscription(mID);
+    auto nextRefresh = autoRefresh->nextDue(mID, lastCheckedEpoch, mRefreshInterval, mAdaptiveRefreshInterval, pushed);
+    persistNextRefresh(mID, nextRefresh);
+    if (mParentSource != nullptr)
+    {
+        autoRefresh->scheduleFeed(mParentSource->id(), mID, nextRefresh);
+    }
+}
+
+std::vector<ZapFR::Engine::FeedLocal::ScheduleInfo> ZapFR::Engine::FeedLocal::querySchedule(Source* parentSource)
+{
+    std::vector<ScheduleInfo> schedule;
+
+    uint64_t id;
+    std::string url;
+    std::string lastChecked;
+    Poco::Nullable<uint64_t> refreshInterval;
+    Poco::Nullable<uint64_t> adaptiveRefreshInterval;
+    Poco::Nullable<uint64_t> nextRefresh;
+
+    Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+    selectStmt << "SELECT id,url,lastChecked,refreshInterval,adaptiveRefreshInterval,nextRefresh FROM feeds", into(id), into(url), into(lastChecked),
+        into(refreshInterval), into(adaptiveRefreshInterval), into(nextRefresh), range(0, 1);
+
+    while (!selectStmt.done())
+    {
+        if (selectStmt.execute() > 0)
+        {
+            ScheduleInfo info;
+            info.sourceID = parentSource->id();
+            info.feedID = id;
+            info.url = url;
+            info.lastChecked = lastChecked;
+            if (!refreshInterval.isNull())
+            {
+                info.refreshInterval = refreshInterval.value();
+            }
+            if (!adaptiveRefreshInterval.isNull())
+            {
+                info.adaptiveRefreshInterval = adaptiveRefreshInterval.value();
+            }
+            if (!nextRefresh.isNull())
+            {
+                info.nextRefresh = nextRefresh.value();
+            }
+            schedule.emplace_back(info);
+        }
+    }
+
+    return schedule;
+}
+
+void ZapFR::Engine::FeedLocal::persistNextRefresh(uint64_t feedID, uint64_t nextRefreshEpoch)
+{
+    Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+    updateStmt << "UPDATE feeds SET nextRefresh=? WHERE id=?", use(nextRefreshEpoch), use(feedID), now;
+}
+
+std::tuple<uint64_t, uint64_t> ZapFR::Engine::FeedLocal::processItems(FeedParser* parsedFeed)
+{
+    uint64_t newItems{0};
+    uint64_t updatedItems{0};
+
     // see if we have to execute a script for each item
     std::vector<std::string> scriptsRanOnNewPost{};
     std::vector<std::string> scriptsRanOnUpdatePost{};
@@ -249,7 +523,8 @@ void ZapFR::Engine::FeedLocal::processItems(FeedParser* parsedFeed)
         }
     }
 
-    for (const auto& item : parsedFeed->items())
+    auto items = parsedFeed->takeItems();
+    for (auto& item : items)
     {
         // see if it already exists
         auto existingPost = getPostByGuid(item.guid);
@@ -258,43 +533,46 @@ void ZapFR::Engine::FeedLocal::processItems(FeedParser* parsedFeed)
             dynamic_cast<PostLocal*>(existingPost.value().get())
                 ->update(item.title, item.link, item.content, item.author, item.commentsURL, item.guid, item.datePublished, item.thumbnail, item.enclosures, item.categories);
 
-            if (scriptsRanOnUpdatePost.size() > 0)
+            // existingPost still holds the values from before the update, so compare against those to see whether anything actually changed
+            auto isDifferent{false};
+            // clang-format off
+            if (!isDifferent && (existingPost.value()->title() != item.title)) { isDifferent = true; }
+            if (!isDifferent && (existingPost.value()->link() != item.link)) { isDifferent = true; }
+            if (!isDifferent && (existingPost.value()->content() != item.content)) { isDifferent = true; }
+            if (!isDifferent && (existingPost.value()->author() != item.author)) { isDifferent = true; }
+            if (!isDifferent && (existingPost.value()->commentsURL() != item.commentsURL)) { isDifferent = true; }
+            if (!isDifferent && (existingPost.value()->datePublished() != item.datePublished)) { isDifferent = true; }
+            if (!isDifferent && (existingPost.value()->thumbnail() != item.thumbnail)) { isDifferent = true; }
+            // clang-format on
+
+            // TODO:  enclosures!
+
+            // check if categories differ
+            if (!isDifferent)
             {
-                // Only trigger the update script(s) in case one of the fields is different
-                auto isDifferent{false};
-                // clang-format off
-                if (!isDifferent && (existingPost.value()->title() != item.title)) { isDifferent = true; }
-                if (!isDifferent && (existingPost.value()->link() != item.link)) { isDifferent = true; }
-                if (!isDifferent && (existingPost.value()->content() != item.content)) { isDifferent = true; }
-                if (!isDifferent && (existingPost.value()->author() != item.author)) { isDifferent = true; }
-                if (!isDifferent && (existingPost.value()->commentsURL() != item.commentsURL)) { isDifferent = true; }
-                if (!isDifferent && (existingPost.value()->datePublished() != item.datePublished)) { isDifferent = true; }
-                if (!isDifferent && (existingPost.value()->thumbnail() != item.thumbnail)) { isDifferent = true; }
-                // clang-format on
-
-                // TODO:  enclosures!
-
-                // check if categories differ
-                if (!isDifferent)
+                if (item.categories.size() != existingPost.value()->categories().size())
                 {
-                    if (item.categories.size() != existingPost.value()->categories().size())
-                    {
-                        isDifferent = true;
-                    }
-                    else
+                    isDifferent = true;
+                }
+                else
+                {
+                    for (const auto& newCat : item.categories)
                     {
-                        for (const auto& newCat : item.categories)
+                        if (!existingPost.value()->hasCategory(newCat))
                         {
-                            if (!existingPost.value()->hasCategory(newCat))
-                            {
-                                isDifferent = true;
-                                break;
-                            }
+                            isDifferent = true;
+                            break;
                         }
                     }
                 }
+            }
+
+            if (isDifferent)
+            {
+                updatedItems++;
 
-                if (isDifferent)
+                // Only trigger the update script(s) in case one of the fields is different
+                if (scriptsRanOnUpdatePost.size() > 0)
                 {
                     auto updatedPost = getPost(existingPost.value()->id());
                     if (updatedPost.has_value())
@@ -309,8 +587,10 @@ void ZapFR::Engine::FeedLocal::processItems(FeedParser* parsedFeed)
         }
         else // INSERT in case it doesn't
         {
-            auto post = PostLocal::create(mID, mTitle, item.title, item.link, item.content, item.author, item.commentsURL, item.guid, item.datePublished, item.thumbnail,
-                                          item.enclosures, item.categories);
+            auto post = PostLocal::create(mID, mTitle, std::move(item.title), std::move(item.link), std::move(item.content), std::move(item.author),
+                                          std::move(item.commentsURL), std::move(item.guid), std::move(item.datePublished), std::move(item.thumbnail), item.enclosures,
+                                          item.categories);
+            newItems++;
 
             if (scriptsRanOnNewPost.size() > 0)
             {
@@ -321,6 +601,7 @@ void ZapFR::Engine::FeedLocal::processItems(FeedParser* parsedFeed)
             }
         }
     }
+    return std::make_tuple(newItems, updatedItems);
 }
 
 void ZapFR::Engine::FeedLocal::markAsRead(uint64_t maxPostID)
@@ -335,24 +616,31 @@ void ZapFR::Engine::FeedLocal::markAsRead(uint64_t maxPostID)
     }
 }
 
-void ZapFR::Engine::FeedLocal::refreshIcon()
+bool ZapFR::Engine::FeedLocal::isIconStale() const
 {
-    fetchData();
-
     // only check for new icons every week
-    Poco::DateTime lastFetched;
-    int32_t tzd;
-    if (Poco::DateTimeParser::tryParse(mIconLastFetched, lastFetched, tzd))
+    auto lastFetched = DateParser::parse(mIconLastFetched);
+    if (lastFetched.has_value())
     {
-        lastFetched.makeUTC(tzd);
-        Poco::DateTime now;
-        auto difference = now - lastFetched;
-        if (difference.totalHours() < (24 * 7))
+        auto difference = Poco::Timestamp().epochTime() - lastFetched.value();
+        if (difference < (24 * 7 * 60 * 60))
         {
-            return;
+            return false;
         }
     }
+    return true;
+}
 
+void ZapFR::Engine::FeedLocal::refreshIcon()
+{
+    fetchData();
+    if (!isIconStale())
+    {
+        return;
+    }
+
+    // the icon cache is shared by all feeds, so feeds of the same site only cause a single page scrape and icon download
+    auto favIconCache = FavIconCache::getInstance();
     std::string iconURLToQuery;
     if (mIconURL.empty())
     {
@@ -364,9 +652,7 @@ void ZapFR::Engine::FeedLocal::refreshIcon()
             indexPage.setPath("/");
             link = indexPage.toString();
         }
-        auto p = FavIconParser();
-        p.parseURL(link, mID);
-        iconURLToQuery = p.favIcon();
+        iconURLToQuery = favIconCache->iconURLForPage(link, mID);
     }
     else
     {
@@ -375,31 +661,18 @@ void ZapFR::Engine::FeedLocal::refreshIcon()
 
     if (!iconURLToQuery.empty())
     {
-        try
-        {
-            Poco::Net::HTTPCredentials creds; // TODO
-            auto uri = Poco::URI(iconURLToQuery);
-            std::string cgi;
-            std::tie(mIconData, cgi) = Helpers::performHTTPRequest(uri, "GET", creds, {}, mID);
-        }
-        catch (...) // we ignore errors here because a missing favicon shouldn't put the feed in error state
-        {
-            Log::log(LogLevel::Debug, fmt::format("Failed to download feed icon: {}", iconURLToQuery), mID);
-        }
-    }
-
-    if (!mIconData.empty())
-    {
+        auto icon = favIconCache->icon(iconURLToQuery, mID);
         auto i = iconFile(mID);
-        auto fos = Poco::FileOutputStream(i.path());
-        fos << mIconData;
-        fos.close();
+        if (icon.has_value() && (icon.value().hash != mIconHash || !i.exists()))
+        {
+            mIconData = icon.value().data;
+            mIconHash = icon.value().hash;
 
-        Poco::MD5Engine md5;
-        Poco::DigestOutputStream ds(md5);
-        ds << mIconData;
-        ds.close();
-        mIconHash = Poco::DigestEngine::digestToHex(md5.digest());
+            auto fos = Poco::FileOutputStream(i.path());
+            fos << mIconData;
+            fos.close();
+            IconCache::getInstance()->put(mIconHash, mIconData);
+        }
     }
 
     // update icon last fetched time and md5 hash
@@ -429,6 +702,91 @@ void ZapFR::Engine::FeedLocal::setIconDir(const std::string& iconDir)
     }
 }
 
+std::optional<std::string> ZapFR::Engine::FeedLocal::readIconData(uint64_t feedID, const std::string& iconHash)
+{
+    auto cache = IconCache::getInstance();
+    if (!iconHash.empty())
+    {
+        auto cached = cache->get(iconHash);
+        if (cached.has_value())
+        {
+            return cached;
+        }
+    }
+
+    auto i = iconFile(feedID);
+    if (msIconDir.empty() || !i.exists())
+    {
+        return {};
+    }
+
+    auto fis = Poco::FileInputStream(i.path());
+    std::string data;
+    Poco::StreamCopier::copyToString(fis, data);
+    fis.close();
+    if (data.empty())
+    {
+        return {};
+    }
+
+    cache->put(iconHash, data);
+    return data;
+}
+
+std::unordered_map<std::string, std::string> ZapFR::Engine::FeedLocal::iconDataForHashes(const std::unordered_set<std::string>& iconHashes)
+{
+    std::unordered_map<std::string, std::string> icons;
+
+    // serve what we can from the cache, and look up a feed for the remaining hashes so the icon file can be read
+    std::unordered_set<std::string> missingHashes;
+    for (const auto& hash : iconHashes)
+    {
+        auto cached = IconCache::getInstance()->get(hash);
+        if (cached.has_value())
+        {
+            icons[hash] = cached.value();
+        }
+        else if (!hash.empty())
+        {
+            missingHashes.insert(hash);
+        }
+    }
+
+    // only look up the feeds that carry one of the missing hashes, in batches that stay well below SQLite's bound parameter limit
+    static constexpr size_t maxHashesPerQuery{500};
+    std::vector<std::string> hashesToQuery(missingHashes.begin(), missingHashes.end());
+    for (size_t offset = 0; offset < hashesToQuery.size(); offset += maxHashesPerQuery)
+    {
+        auto batchEnd = std::min(offset + maxHashesPerQuery, hashesToQuery.size());
+        std::vector<std::string> placeholders(batchEnd - offset, "?");
+
+        uint64_t feedID{0};
+        std::string iconHash{""};
+        Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+        selectStmt << Poco::format("SELECT id, iconHash FROM feeds WHERE iconHash IN (%s)", Helpers::joinString(placeholders, ",")), into(feedID), into(iconHash),
+            range(0, 1);
+        for (size_t i = offset; i < batchEnd; ++i)
+        {
+            selectStmt.addBind(useRef(hashesToQuery.at(i)));
+        }
+
+        while (!selectStmt.done())
+        {
+            if (selectStmt.execute() > 0 && missingHashes.contains(iconHash))
+            {
+                auto data = readIconData(feedID, iconHash);
+                if (data.has_value())
+                {
+                    icons[iconHash] = data.value();
+                    missingHashes.erase(iconHash);
+                }
+            }
+        }
+    }
+
+    return icons;
+}
+
 Poco::File ZapFR::Engine::FeedLocal::iconFile(uint64_t feedID)
 {
     if (msIconDir.empty())
@@ -464,6 +822,31 @@ void ZapFR::Engine::FeedLocal::clearLogs()
     deleteStmt << "DELETE FROM logs WHERE feedID=?", use(mID), now;
 }
 
+std::vector<ZapFR::Engine::Feed::Telemetry> ZapFR::Engine::FeedLocal::getTelemetry()
+{
+    std::vector<Telemetry> telemetry;
+
+    Telemetry t;
+    uint64_t result{0};
+    Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
+    selectStmt << "SELECT timestamp,result,dnsTime,connectTime,tlsTime,firstByteTime,transferredBytes,bodyBytes,parseTime,ingestTime,newItems,updatedItems"
+                  " FROM feed_telemetry"
+                  " WHERE feedID=?"
+                  " ORDER BY id DESC",
+        use(mID), into(t.timestamp), into(result), into(t.dnsTime), into(t.connectTime), into(t.tlsTime), into(t.firstByteTime), into(t.transferredBytes),
+        into(t.bodyBytes), into(t.parseTime), into(t.ingestTime), into(t.newItems), into(t.updatedItems), range(0, 1);
+
+    while (!selectStmt.done())
+    {
+        if (selectStmt.execute() > 0)
+        {
+            t.result = static_cast<Telemetry::Result>(result);
+            telemetry.emplace_back(t);
+        }
+    }
+    return telemetry;
+}
+
 std::vector<std::unique_ptr<ZapFR::Engine::Category>> ZapFR::Engine::FeedLocal::getCategories()
 {
     std::vector<std::string> whereClause;
@@ -581,6 +964,7 @@ std::unique_ptr<ZapFR::Engine::FeedLocal> ZapFR::Engine::FeedLocal::create(Sourc
     f->setSortOrder(sortOrder);
     f->setLastChecked(nowDate);
     f->setDataFetched(true);
+    f->updateNextRefresh();
 
     return f;
 }
@@ -596,9 +980,135 @@ void ZapFR::Engine::FeedLocal::fetchUnreadCount()
 void ZapFR::Engine::FeedLocal::updateAndLogLastRefreshError(const std::string& error)
 {
     Log::log(LogLevel::Error, error, mID);
+
+    // back off exponentially from the feed's refresh interval; once it keeps failing, only probe it once per MaxFeedBackoffDelay until it recovers
+    mConsecutiveFailures++;
+    auto autoRefresh = AutoRefresh::getInstance();
+    auto delay = MaxFeedBackoffDelay;
+    auto storedError = error;
+    if (mConsecutiveFailures < FeedCircuitBreakerThreshold)
+    {
+        auto interval = autoRefresh->effectiveInterval(mRefreshInterval, mAdaptiveRefreshInterval);
+        delay = std::min(interval << std::min(mConsecutiveFailures - 1, static_cast<uint64_t>(20)), MaxFeedBackoffDelay);
+    }
+    else
+    {
+        storedError = fmt::format("Suspended after {} consecutive failures: {}", mConsecutiveFailures, error);
+    }
+    auto nextRefresh = static_cast<uint64_t>(Poco::Timestamp().epochTime()) + delay + AutoRefresh::jitter(mID, delay);
+
     Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
-    updateStmt << "UPDATE feeds SET lastRefreshError=? WHERE id=?", useRef(error), use(mID), now;
-    setLastRefreshError(error);
+    updateStmt << "UPDATE feeds SET lastRefreshError=?, consecutiveFailures=?, nextRefresh=? WHERE id=?", useRef(storedError), use(mConsecutiveFailures),
+        use(nextRefresh), use(mID), now;
+    setLastRefreshError(storedError);
+    if (mParentSource != nullptr)
+    {
+        autoRefresh->scheduleFeed(mParentSource->id(), mID, nextRefresh);
+    }
+}
+
+void ZapFR::Engine::FeedLocal::recordRefreshSuccess()
+{
+    if (mConsecutiveFailures > 0)
+    {
+        Log::log(LogLevel::Info, fmt::format("Feed recovered after {} consecutive failures", mConsecutiveFailures), mID);
+        mConsecutiveFailures = 0;
+        Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+        updateStmt << "UPDATE feeds SET consecutiveFailures=0 WHERE id=?", use(mID), now;
+    }
+}
+
+void ZapFR::Engine::FeedLocal::setTransferTelemetry(const Helpers::HTTPTransferStats& stats)
+{
+    mTelemetry.dnsTime = stats.dnsTime;
+    mTelemetry.connectTime = stats.connectTime;
+    mTelemetry.tlsTime = stats.tlsTime;
+    mTelemetry.firstByteTime = stats.firstByteTime;
+    mTelemetry.transferredBytes = stats.transferredBytes;
+    mTelemetry.bodyBytes = stats.bodyBytes;
+}
+
+void ZapFR::Engine::FeedLocal::recordTelemetry(Telemetry::Result result)
+{
+    mTelemetry.timestamp = Poco::DateTimeFormatter::format(Poco::DateTime(), Poco::DateTimeFormat::ISO8601_FORMAT);
+    mTelemetry.result = result;
+    auto resultValue = static_cast<uint64_t>(result);
+
+    try
+    {
+        Poco::Data::Statement insertStmt(*(Database::getInstance()->session()));
+        insertStmt << "INSERT INTO feed_telemetry (feedID,timestamp,result,dnsTime,connectTime,tlsTime,firstByteTime,transferredBytes,bodyBytes,parseTime,ingestTime,"
+                      "newItems,updatedItems) VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)",
+            use(mID), useRef(mTelemetry.timestamp), use(resultValue), use(mTelemetry.dnsTime), use(mTelemetry.connectTime), use(mTelemetry.tlsTime),
+            use(mTelemetry.firstByteTime), use(mTelemetry.transferredBytes), use(mTelemetry.bodyBytes), use(mTelemetry.parseTime), use(mTelemetry.ingestTime),
+            use(mTelemetry.newItems), use(mTelemetry.updatedItems), now;
+
+        // it's a rolling window, so drop whatever fell off the end of it
+        auto historySize = TelemetryHistorySize;
+        Poco::Data::Statement deleteStmt(*(Database::getInstance()->session()));
+        deleteStmt << "DELETE FROM feed_telemetry WHERE feedID=? AND id <= (SELECT id FROM feed_telemetry WHERE feedID=? ORDER BY id DESC LIMIT 1 OFFSET ?)", use(mID),
+            use(mID), use(historySize), now;
+    }
+    catch (const Poco::Exception& e)
+    {
+        Log::log(LogLevel::Warning, fmt::format("Failed to record the refresh telemetry: {}", e.displayText()), mID);
+    }
+}
+
+void ZapFR::Engine::FeedLocal::updateWebSubSubscription(FeedParser* parsedFeed)
+{
+    auto webSub = WebSub::getInstance();
+    if (parsedFeed == nullptr || !webSub->isEnabled())
+    {
+        return;
+    }
+
+    // hubs know the feed by its self link, which isn't necessarily the URL we fetch it from
+    auto links = parsedFeed->webSubLinks();
+    webSub->updateFeed(mID, links.hub, links.self.empty() ? mURL : links.self);
+}
+
+// a permanent redirect is only written back to the feed URL once it has been seen on a few consecutive refreshes, so a misconfigured
+// server can't permanently hijack a feed with a single response
+void ZapFR::Engine::FeedLocal::confirmPermanentRedirect(const std::string& location)
+{
+    if (location.empty())
+    {
+        if (mPendingRedirectCount > 0)
+        {
+            mPendingRedirectURL = "";
+            mPendingRedirectCount = 0;
+            Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+            updateStmt << "UPDATE feeds SET pendingRedirectURL=NULL, pendingRedirectCount=0 WHERE id=?", use(mID), now;
+        }
+        return;
+    }
+
+    if (location == mPendingRedirectURL)
+    {
+        mPendingRedirectCount++;
+    }
+    else
+    {
+        mPendingRedirectURL = location;
+        mPendingRedirectCount = 1;
+    }
+
+    if (mPendingRedirectCount >= PermanentRedirectConfirmations)
+    {
+        Log::log(LogLevel::Info, fmt::format("Feed moved permanently; updating its URL from {} to {}", mURL, location), mID);
+        mURL = location;
+        mPendingRedirectURL = "";
+        mPendingRedirectCount = 0;
+        Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+        updateStmt << "UPDATE feeds SET url=?, pendingRedirectURL=NULL, pendingRedirectCount=0 WHERE id=?", useRef(mURL), use(mID), now;
+    }
+    else
+    {
+        Poco::Data::Statement updateStmt(*(Database::getInstance()->session()));
+        updateStmt << "UPDATE feeds SET pendingRedirectURL=?, pendingRedirectCount=? WHERE id=?", useRef(mPendingRedirectURL), use(mPendingRedirectCount), use(mID),
+            now;
+    }
 }
 
 void ZapFR::Engine::FeedLocal::update(const std::string& iconURL, const std::string& guid, const std::string& title, const std::string& subtitle, const std::string& link,
@@ -652,6 +1162,9 @@ void ZapFR::Engine::FeedLocal::updateProperties(const std::string& feedURL, std:
 
     setURL(feedURL);
     setRefreshInterval(refreshIntervalInSeconds);
+
+    fetchData();
+    updateNextRefresh();
 }
 
 std::unordered_map<uint64_t, uint64_t> ZapFR::Engine::FeedLocal::move(uint64_t feedID, uint64_t newFolder, uint64_t newSortOrder)
@@ -725,6 +1238,8 @@ void ZapFR::Engine::FeedLocal::remove(Source* parentSource, uint64_t feedID)
             Poco::Data::Statement deleteStmt(*(Database::getInstance()->session()));
             deleteStmt << "DELETE FROM feeds WHERE id=?", use(feedID), now;
         }
+        AutoRefresh::getInstance()->unscheduleFeed(feedID);
+        WebSub::getInstance()->removeFeed(feedID);
 
         {
             Poco::Data::Statement deleteStmt(*(Database::getInstance()->session()));
@@ -735,6 +1250,11 @@ void ZapFR::Engine::FeedLocal::remove(Source* parentSource, uint64_t feedID)
             Poco::Data::Statement deleteStmt(*(Database::getInstance()->session()));
             deleteStmt << "DELETE FROM posts WHERE feedID=?", use(feedID), now;
         }
+
+        {
+            Poco::Data::Statement deleteStmt(*(Database::getInstance()->session()));
+            deleteStmt << "DELETE FROM feed_telemetry WHERE feedID=?", use(feedID), now;
+        }
         // TODO: remove all scripts->runOnFeedIDs
 
         resort(folder);
@@ -763,6 +1283,7 @@ std::vector<std::unique_ptr<ZapFR::Engine::Feed>> ZapFR::Engine::FeedLocal::quer
     std::string lastChecked;
     Poco::Nullable<std::string> lastRefreshError;
     Poco::Nullable<uint64_t> refreshInterval;
+    Poco::Nullable<uint64_t> adaptiveRefreshInterval;
     uint64_t sortOrder;
     Poco::Nullable<std::string> conditionalGETInfo;
 
@@ -785,6 +1306,7 @@ std::vector<std::unique_ptr<ZapFR::Engine::Feed>> ZapFR::Engine::FeedLocal::quer
           ",feeds.lastChecked"
           ",feeds.lastRefreshError"
           ",feeds.refreshInterval"
+          ",feeds.adaptiveRefreshInterval"
           ",feeds.sortOrder"
           ",feeds.conditionalGETInfo"
           " FROM feeds";
@@ -820,6 +1342,7 @@ std::vector<std::unique_ptr<ZapFR::Engine::Feed>> ZapFR::Engine::FeedLocal::quer
     selectStmt.addExtract(into(lastChecked));
     selectStmt.addExtract(into(lastRefreshError));
     selectStmt.addExtract(into(refreshInterval));
+    selectStmt.addExtract(into(adaptiveRefreshInterval));
     selectStmt.addExtract(into(sortOrder));
     selectStmt.addExtract(into(conditionalGETInfo));
 
@@ -849,6 +1372,10 @@ std::vector<std::unique_ptr<ZapFR::Engine::Feed>> ZapFR::Engine::FeedLocal::quer
             {
                 f->setRefreshInterval(refreshInterval.value());
             }
+            if (!adaptiveRefreshInterval.isNull())
+            {
+                f->setAdaptiveRefreshInterval(adaptiveRefreshInterval.value());
+            }
             f->setSortOrder(sortOrder);
             if (!conditionalGETInfo.isNull())
             {
@@ -857,17 +1384,12 @@ std::vector<std::unique_ptr<ZapFR::Engine::Feed>> ZapFR::Engine::FeedLocal::quer
             f->fetchUnreadCount();
             f->setDataFetched(true);
 
-            if ((fetchInfo & Source::FetchInfo::Icon) == Source::FetchInfo::Icon && !msIconDir.empty())
+            if ((fetchInfo & Source::FetchInfo::Icon) == Source::FetchInfo::Icon)
             {
-                // TODO: maybe also cache the icons here locally
-                auto i = iconFile(id);
-                if (i.exists())
+                auto data = readIconData(id, iconHash);
+                if (data.has_value())
                 {
-                    auto fis = Poco::FileInputStream(i.path());
-                    std::string iconData;
-                    Poco::StreamCopier::copyToString(fis, iconData);
-                    fis.close();
-                    f->setIconData(iconData);
+                    f->setIconData(data.value());
                 }
             }
 
@@ -896,6 +1418,7 @@ std::optional<std::unique_ptr<ZapFR::Engine::Feed>> ZapFR::Engine::FeedLocal::qu
     std::string lastChecked;
     Poco::Nullable<std::string> lastRefreshError;
     Poco::Nullable<uint64_t> refreshInterval;
+    Poco::Nullable<uint64_t> adaptiveRefreshInterval;
     uint64_t sortOrder;
     Poco::Nullable<std::string> conditionalGETInfo;
 
@@ -918,6 +1441,7 @@ std::optional<std::unique_ptr<ZapFR::Engine::Feed>> ZapFR::Engine::FeedLocal::qu
           ",feeds.lastChecked"
           ",feeds.lastRefreshError"
           ",feeds.refreshInterval"
+          ",feeds.adaptiveRefreshInterval"
           ",feeds.sortOrder"
           ",feeds.conditionalGETInfo"
           " FROM feeds";
@@ -951,6 +1475,7 @@ std::optional<std::unique_ptr<ZapFR::Engine::Feed>> ZapFR::Engine::FeedLocal::qu
     selectStmt.addExtract(into(lastChecked));
     selectStmt.addExtract(into(lastRefreshError));
     selectStmt.addExtract(into(refreshInterval));
+    selectStmt.addExtract(into(adaptiveRefreshInterval));
     selectStmt.addExtract(into(sortOrder));
     selectStmt.addExtract(into(conditionalGETInfo));
 
@@ -981,6 +1506,10 @@ std::optional<std::unique_ptr<ZapFR::Engine::Feed>> ZapFR::Engine::FeedLocal::qu
         {
             f->setRefreshInterval(refreshInterval.value());
         }
+        if (!adaptiveRefreshInterval.isNull())
+        {
+            f->setAdaptiveRefreshInterval(adaptiveRefreshInterval.value());
+        }
         f->setSortOrder(sortOrder);
         if (!conditionalGETInfo.isNull())
         {
@@ -18,6 +18,7 @@
 
 #include <Poco/Data/RecordSet.h>
 
+#include "ZapFR/AutoRefresh.h"
 #include "ZapFR/Database.h"
 #include "ZapFR/Helpers.h"
 #include "ZapFR/Log.h"
@@ -381,11 +382,12 @@ void ZapFR::Engine::FolderLocal::remove(Source* parentSource, uint64_t folderID)
         auto feedIDs = f.value()->feedIDsInFoldersAndSubfolders();
         auto folderIDs = fLocal->folderAndSubfolderIDs();
 
-        // remove the icons from the cache
+        // remove the icons from the cache, and the feeds from the auto refresh schedule
         for (const auto& feedID : feedIDs)
         {
             auto feed = FeedLocal(feedID, parentSource);
             feed.removeIcon();
+            AutoRefresh::getInstance()->unscheduleFeed(feedID);
         }
 
         // remove feeds and their posts
@@ -411,10 +411,9 @@ void ZapFR::Engine::PostLocal::update(const std::string& title, const std::strin
     replaceCategories(mID, mFeedID, categories);
 }
 
-std::unique_ptr<ZapFR::Engine::Post> ZapFR::Engine::PostLocal::create(uint64_t feedID, const std::string& feedTitle, const std::string& title, const std::string& link,
-                                                                      const std::string& content, const std::string& author, const std::string& commentsURL,
-                                                                      const std::string& guid, const std::string& datePublished, const std::string& thumbnail,
-                                                                      const std::vector<Enclosure>& enclosures, const std::vector<std::string>& categories)
+std::unique_ptr<ZapFR::Engine::Post> ZapFR::Engine::PostLocal::create(uint64_t feedID, const std::string& feedTitle, std::string title, std::string link, std::string content,
+                                                                      std::string author, std::string commentsURL, std::string guid, std::string datePublished,
+                                                                      std::string thumbnail, const std::vector<Enclosure>& enclosures, const std::vector<std::string>& categories)
 {
     Poco::Nullable<std::string> thumbnailNullable;
     if (!thumbnail.empty())
@@ -451,14 +450,14 @@ std::unique_ptr<ZapFR::Engine::Post> ZapFR::Engine::PostLocal::create(uint64_t f
     p->setFeedID(feedID);
     p->setFeedTitle(feedTitle);
     p->setIsRead(false);
-    p->setTitle(title);
-    p->setLink(link);
-    p->setContent(content);
-    p->setAuthor(author);
-    p->setCommentsURL(commentsURL);
-    p->setGuid(guid);
-    p->setDatePublished(datePublished);
-    p->setThumbnail(thumbnail);
+    p->setTitle(std::move(title));
+    p->setLink(std::move(link));
+    p->setContent(std::move(content));
+    p->setAuthor(std::move(author));
+    p->setCommentsURL(std::move(commentsURL));
+    p->setGuid(std::move(guid));
+    p->setDatePublished(std::move(datePublished));
+    p->setThumbnail(std::move(thumbnail));
 
     // query flags
     std::unordered_set<FlagColor> flags;
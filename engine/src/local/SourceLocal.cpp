@@ -19,10 +19,14 @@
 #define FMT_HEADER_ONLY
 #include <fmt/core.h>
 
+#include "ZapFR/Agent.h"
+#include "ZapFR/DNSCache.h"
 #include "ZapFR/Database.h"
+#include "ZapFR/HTTPConnectionPool.h"
 #include "ZapFR/Helpers.h"
 #include "ZapFR/Log.h"
 #include "ZapFR/OPMLParser.h"
+#include "ZapFR/WebSub.h"
 #include "ZapFR/base/Category.h"
 #include "ZapFR/feed_handling/FeedFetcher.h"
 #include "ZapFR/local/FeedLocal.h"
@@ -101,6 +105,11 @@ void ZapFR::Engine::SourceLocal::removeFeed(uint64_t feedID)
     FeedLocal::remove(this, feedID);
 }
 
+std::unordered_map<std::string, std::string> ZapFR::Engine::SourceLocal::getIcons(const std::unordered_set<std::string>& iconHashes)
+{
+    return FeedLocal::iconDataForHashes(iconHashes);
+}
+
 /* ************************** FOLDER STUFF ************************** */
 std::vector<std::unique_ptr<ZapFR::Engine::Folder>> ZapFR::Engine::SourceLocal::getFolders(uint64_t parent, uint32_t fetchInfo)
 {
@@ -377,19 +386,27 @@ std::unordered_map<uint64_t, uint64_t> ZapFR::Engine::SourceLocal::getUnreadCoun
     return unreadCounts;
 }
 
-std::unordered_map<uint64_t, std::string> ZapFR::Engine::SourceLocal::getFeedErrors()
+std::unordered_map<uint64_t, ZapFR::Engine::SourceLocal::FeedError> ZapFR::Engine::SourceLocal::getFeedErrors()
 {
-    std::unordered_map<uint64_t, std::string> feedErrors;
+    std::unordered_map<uint64_t, FeedError> feedErrors;
 
     uint64_t feedID{0};
     std::string error{""};
+    uint64_t consecutiveFailures{0};
+    Poco::Nullable<uint64_t> nextRefresh;
     Poco::Data::Statement selectStmt(*(Database::getInstance()->session()));
-    selectStmt << "SELECT id, lastRefreshError FROM feeds WHERE lastRefreshError NOT NULL", into(feedID), into(error), range(0, 1);
+    selectStmt << "SELECT id, lastRefreshError, consecutiveFailures, nextRefresh FROM feeds WHERE lastRefreshError NOT NULL", into(feedID), into(error),
+        into(consecutiveFailures), into(nextRefresh), range(0, 1);
     while (!selectStmt.done())
     {
         if (selectStmt.execute() > 0)
         {
-            feedErrors[feedID] = error;
+            FeedError fe;
+            fe.error = error;
+            fe.consecutiveFailures = consecutiveFailures;
+            fe.suspended = (consecutiveFailures >= FeedCircuitBreakerThreshold);
+            fe.nextAttempt = nextRefresh.isNull() ? 0 : nextRefresh.value();
+            feedErrors[feedID] = fe;
         }
     }
     return feedErrors;
@@ -412,17 +429,40 @@ Poco::JSON::Object ZapFR::Engine::SourceLocal::getStatus()
 
     const auto& feedErrors = getFeedErrors();
     Poco::JSON::Array feedErrorsArr;
-    for (const auto& [feedID, error] : feedErrors)
+    for (const auto& [feedID, feedError] : feedErrors)
     {
         Poco::JSON::Object feObj;
         feObj.set(JSON::SourceStatus::FeedID, feedID);
-        feObj.set(JSON::SourceStatus::FeedError, error);
+        feObj.set(JSON::SourceStatus::FeedError, feedError.error);
+        feObj.set(JSON::SourceStatus::ConsecutiveFailures, feedError.consecutiveFailures);
+        feObj.set(JSON::SourceStatus::Suspended, feedError.suspended);
+        feObj.set(JSON::SourceStatus::NextAttempt, feedError.nextAttempt);
         feedErrorsArr.add(feObj);
     }
     o.set(JSON::SourceStatus::FeedErrors, feedErrorsArr);
 
     o.set(JSON::SourceStatus::HighestPostID, PostLocal::highestID());
 
+    auto agent = Agent::getInstance();
+    o.set(JSON::SourceStatus::QueueDepth, agent->queueDepth());
+    o.set(JSON::SourceStatus::PeakQueueDepth, agent->peakQueueDepth());
+
+    auto dnsCache = DNSCache::getInstance();
+    o.set(JSON::SourceStatus::DNSCacheHits, dnsCache->hitCount());
+    o.set(JSON::SourceStatus::DNSCacheMisses, dnsCache->missCount());
+    o.set(JSON::SourceStatus::DNSCacheNegativeHits, dnsCache->negativeHitCount());
+
+    auto connectionPool = HTTPConnectionPool::getInstance();
+    o.set(JSON::SourceStatus::TLSHandshakes, connectionPool->tlsHandshakeCount());
+    o.set(JSON::SourceStatus::TLSResumedHandshakes, connectionPool->tlsResumedHandshakeCount());
+
+    o.set(JSON::SourceStatus::UnchangedFeedBodies, FeedLocal::unchangedBodyCount());
+    o.set(JSON::SourceStatus::UnchangedFeedBodyBytes, FeedLocal::unchangedBodyBytes());
+
+    auto webSub = WebSub::getInstance();
+    o.set(JSON::SourceStatus::WebSubSubscriptions, webSub->activeSubscriptionCount());
+    o.set(JSON::SourceStatus::WebSubPushedUpdates, webSub->pushedUpdateCount());
+
     return o;
 }
 
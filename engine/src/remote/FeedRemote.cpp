@@ -194,6 +194,34 @@ void ZapFR::Engine::FeedRemote::clearLogs()
     }
 }
 
+std::vector<ZapFR::Engine::Feed::Telemetry> ZapFR::Engine::FeedRemote::getTelemetry()
+{
+    std::vector<Telemetry> telemetry;
+
+    auto remoteSource = dynamic_cast<SourceRemote*>(mParentSource);
+    auto uri = remoteSource->remoteURL();
+    if (remoteSource->remoteURLIsValid())
+    {
+        uri.setPath(fmt::format("/feed/{}/telemetry", mID));
+        auto creds = Poco::Net::HTTPCredentials(remoteSource->remoteLogin(), remoteSource->remotePassword());
+
+        const auto& [json, cgi] = Helpers::performHTTPRequest(uri, Poco::Net::HTTPRequest::HTTP_GET, creds, {});
+        auto parser = Poco::JSON::Parser();
+        auto root = parser.parse(json);
+        auto rootArr = root.extract<Poco::JSON::Array::Ptr>();
+        if (!rootArr.isNull())
+        {
+            for (size_t i = 0; i < rootArr->size(); ++i)
+            {
+                auto telemetryObj = rootArr->getObject(static_cast<uint32_t>(i));
+                telemetry.emplace_back(Telemetry::fromJSON(telemetryObj));
+            }
+        }
+    }
+
+    return telemetry;
+}
+
 std::vector<std::unique_ptr<ZapFR::Engine::Category>> ZapFR::Engine::FeedRemote::getCategories()
 {
     std::vector<std::unique_ptr<ZapFR::Engine::Category>> categories;
@@ -19,10 +19,12 @@
 #define FMT_HEADER_ONLY
 #include <fmt/core.h>
 
+#include <Poco/Base64Decoder.h>
 #include <Poco/JSON/Parser.h>
 #include <Poco/Net/HTTPRequest.h>
 
 #include "ZapFR/Helpers.h"
+#include "ZapFR/IconCache.h"
 #include "ZapFR/Log.h"
 #include "ZapFR/base/Category.h"
 #include "ZapFR/base/Feed.h"
@@ -79,13 +81,7 @@ std::vector<std::unique_ptr<ZapFR::Engine::Feed>> ZapFR::Engine::SourceRemote::g
         uri.setPath("/feeds");
         auto creds = Poco::Net::HTTPCredentials(mRemoteLogin, mRemotePassword);
 
-        std::map<std::string, std::string> params;
-        if ((fetchInfo & FetchInfo::Icon) == FetchInfo::Icon)
-        {
-            params[HTTPParam::Feed::GetIcons] = HTTPParam::True;
-        }
-
-        const auto& [json, cgi] = Helpers::performHTTPRequest(uri, Poco::Net::HTTPRequest::HTTP_GET, creds, params);
+        const auto& [json, cgi] = Helpers::performHTTPRequest(uri, Poco::Net::HTTPRequest::HTTP_GET, creds, {});
         auto parser = Poco::JSON::Parser();
         auto root = parser.parse(json);
         auto feedArr = root.extract<Poco::JSON::Array::Ptr>();
@@ -97,6 +93,33 @@ std::vector<std::unique_ptr<ZapFR::Engine::Feed>> ZapFR::Engine::SourceRemote::g
                 feeds.emplace_back(FeedRemote::fromJSON(this, feedObj));
             }
         }
+
+        // the feed list only contains the icon hashes, so only request the icons we don't have cached yet
+        if ((fetchInfo & FetchInfo::Icon) == FetchInfo::Icon)
+        {
+            auto cache = IconCache::getInstance();
+            std::unordered_set<std::string> missingHashes;
+            for (const auto& feed : feeds)
+            {
+                if (!feed->iconHash().empty() && !cache->contains(feed->iconHash()))
+                {
+                    missingHashes.insert(feed->iconHash());
+                }
+            }
+            if (!missingHashes.empty())
+            {
+                getIcons(missingHashes);
+            }
+
+            for (auto& feed : feeds)
+            {
+                auto iconData = cache->get(feed->iconHash());
+                if (iconData.has_value())
+                {
+                    feed->setIconData(iconData.value());
+                }
+            }
+        }
     }
     return feeds;
 }
@@ -214,6 +237,39 @@ void ZapFR::Engine::SourceRemote::removeFeed(uint64_t feedID)
     }
 }
 
+std::unordered_map<std::string, std::string> ZapFR::Engine::SourceRemote::getIcons(const std::unordered_set<std::string>& iconHashes)
+{
+    std::unordered_map<std::string, std::string> icons;
+
+    auto uri = remoteURL();
+    if (mRemoteURLIsValid && !iconHashes.empty())
+    {
+        uri.setPath("/feeds/icons");
+        auto creds = Poco::Net::HTTPCredentials(mRemoteLogin, mRemotePassword);
+
+        std::map<std::string, std::string> params;
+        params[HTTPParam::Feed::IconHashes] = Helpers::joinString(std::vector<std::string>(iconHashes.begin(), iconHashes.end()), ",");
+
+        const auto& [json, cgi] = Helpers::performHTTPRequest(uri, Poco::Net::HTTPRequest::HTTP_POST, creds, params);
+        auto parser = Poco::JSON::Parser();
+        auto root = parser.parse(json);
+        auto iconsObj = root.extract<Poco::JSON::Object::Ptr>();
+        if (!iconsObj.isNull())
+        {
+            auto cache = IconCache::getInstance();
+            for (const auto& hash : iconsObj->getNames())
+            {
+                std::istringstream base64stream(iconsObj->getValue<std::string>(hash));
+                Poco::Base64Decoder b64decoderstream(base64stream);
+                std::string decoded(std::istreambuf_iterator<char>(b64decoderstream), {});
+                cache->put(hash, decoded);
+                icons[hash] = decoded;
+            }
+        }
+    }
+    return icons;
+}
+
 /* ************************** FOLDER STUFF ************************** */
 std::vector<std::unique_ptr<ZapFR::Engine::Folder>> ZapFR::Engine::SourceRemote::getFolders(uint64_t parent, uint32_t fetchInfo)
 {
@@ -100,6 +100,10 @@ for key in api:
     if "acceptsFileUploads" in api[key]:
         acceptsFileUploads = "true" if api[key]["acceptsFileUploads"] else "false"
         entry += f"""\t\t\t\tentry->setAcceptsFileUploads({acceptsFileUploads});\n"""
+
+    if "acceptsRawBody" in api[key]:
+        acceptsRawBody = "true" if api[key]["acceptsRawBody"] else "false"
+        entry += f"""\t\t\t\tentry->setAcceptsRawBody({acceptsRawBody});\n"""
     
     entry += "\t\t\t\tmsAPIs.emplace_back(std::move(entry));\n"
 
@@ -145,7 +149,7 @@ for key in api:
 
             fp.write(f"""\n\n   Poco::JSON::Object o;\n""")
             fp.write(f"""   o.set("success", true);\n\n""")
-            fp.write(f"""   Poco::JSON::Stringifier::stringify(o, response.send());\n\n""")
+            fp.write(f"""   Poco::JSON::Stringifier::stringify(o, apiRequest->send(response));\n\n""")
             fp.write(f"""   return Poco::Net::HTTPResponse::HTTP_OK;\n""")
             fp.write(f"""\n}}""")
 
@@ -184,6 +188,9 @@ for key in api:
             if len(acceptsFileUploads) > 0:
                 replacement += acceptsFileUploads
 
+        if "acceptsRawBody" in api[key] and api[key]["acceptsRawBody"]:
+            replacement += f"""//\tAccepts a raw request body - apiRequest->body()\n"""
+
         replacement += f"""//\n// API::\n"""
 
         handler_contents = re_api_tags.sub(replacement, handler_contents)
@@ -87,6 +87,8 @@ namespace ZapFR
             void setContentType(const std::string& ct);
             std::string contentType() const noexcept;
             void setJSONOutput(const std::string& jo);
+            void setAcceptsRawBody(bool b);
+            bool acceptsRawBody() const noexcept;
             void setHandler(const std::function<Poco::Net::HTTPResponse::HTTPStatus(APIRequest* apiRequest, Poco::Net::HTTPServerResponse& response)>& handler);
             auto handler() const noexcept { return mHandler; }
 
@@ -108,6 +110,7 @@ namespace ZapFR
             bool mRequiresCredentials{false};
             std::string mContentType{""};
             std::string mJSONOutput{""};
+            bool mAcceptsRawBody{false};
 
             std::function<Poco::Net::HTTPResponse::HTTPStatus(APIRequest* apiRequest, Poco::Net::HTTPServerResponse& response)> mHandler{};
 
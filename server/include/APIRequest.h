@@ -19,7 +19,9 @@
 #ifndef ZAPFR_SERVER_APIREQUEST_H
 #define ZAPFR_SERVER_APIREQUEST_H
 
+#include <Poco/DeflatingStream.h>
 #include <Poco/Net/HTMLForm.h>
+#include <Poco/Net/HTTPServerResponse.h>
 #include <Poco/URI.h>
 
 namespace ZapFR
@@ -45,6 +47,10 @@ namespace ZapFR
             bool hasParameter(const std::string& key) const noexcept;
             const Poco::Net::HTMLForm& parameters() const noexcept { return mParameters; }
             const Poco::URI& uri() const noexcept { return mURI; }
+            std::string& body() noexcept { return mBody; }
+
+            std::ostream& send(Poco::Net::HTTPServerResponse& response);
+            void finishResponse();
 
           private:
             API* mAPI{nullptr};
@@ -52,6 +58,9 @@ namespace ZapFR
             Poco::Net::HTTPServerRequest* mRequest{nullptr};
             Poco::Net::HTMLForm mParameters{};
             Poco::URI mURI{};
+            std::string mBody{""};
+            std::ostream* mResponseStream{nullptr};
+            std::unique_ptr<Poco::DeflatingOutputStream> mCompressedResponseStream{nullptr};
         };
     } // namespace Server
 } // namespace ZapFR
@@ -110,6 +110,16 @@ void ZapFR::Server::API::setJSONOutput(const std::string& jo)
     mJSONOutput = jo;
 }
 
+void ZapFR::Server::API::setAcceptsRawBody(bool b)
+{
+    mAcceptsRawBody = b;
+}
+
+bool ZapFR::Server::API::acceptsRawBody() const noexcept
+{
+    return mAcceptsRawBody;
+}
+
 void ZapFR::Server::API::setHandler(const std::function<Poco::Net::HTTPResponse::HTTPStatus(APIRequest* apiRequest, Poco::Net::HTTPServerResponse& response)>& handler)
 {
     mHandler = handler;
@@ -16,6 +16,8 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+
 #include <Poco/Base64Decoder.h>
 #include <Poco/NullStream.h>
 #include <Poco/StreamCopier.h>
@@ -80,7 +82,23 @@ ZapFR::Server::APIRequest::APIRequest(API* api, Poco::Net::HTTPServerRequest& re
         mParameters.setEncoding("multipart/form-data");
         parseBodyAsForm = true;
     }
-    if (parseBodyAsForm)
+    if (api->acceptsRawBody() && !parseBodyAsForm)
+    {
+        static constexpr std::streamsize maxBodySize{25 * 1024 * 1024};
+        mBody.reserve(static_cast<size_t>(std::max(std::streamsize{0}, std::min(request.getContentLength64(), maxBodySize))));
+        char buffer[8192];
+        while (request.stream().read(buffer, sizeof(buffer)) || request.stream().gcount() > 0)
+        {
+            mBody.append(buffer, static_cast<size_t>(request.stream().gcount()));
+            if (static_cast<std::streamsize>(mBody.size()) > maxBodySize)
+            {
+                throw std::runtime_error("Request body too large");
+            }
+        }
+        mParameters.load(request);
+        bodyConsumed = true;
+    }
+    else if (parseBodyAsForm)
     {
         try
         {
@@ -131,3 +149,33 @@ bool ZapFR::Server::APIRequest::hasParameter(const std::string& key) const noexc
 {
     return mParameters.has(key);
 }
+
+std::ostream& ZapFR::Server::APIRequest::send(Poco::Net::HTTPServerResponse& response)
+{
+    if (mResponseStream != nullptr)
+    {
+        return *mResponseStream;
+    }
+
+    // gzip the response body if the client supports it
+    if (ZapFR::Engine::Helpers::acceptsContentCoding(mRequest->get("Accept-Encoding", ""), "gzip"))
+    {
+        response.set("Content-Encoding", "gzip");
+        response.set("Vary", "Accept-Encoding");
+        mCompressedResponseStream = std::make_unique<Poco::DeflatingOutputStream>(response.send(), Poco::DeflatingStreamBuf::STREAM_GZIP);
+        mResponseStream = mCompressedResponseStream.get();
+    }
+    else
+    {
+        mResponseStream = &response.send();
+    }
+    return *mResponseStream;
+}
+
+void ZapFR::Server::APIRequest::finishResponse()
+{
+    if (mCompressedResponseStream != nullptr)
+    {
+        mCompressedResponseStream->close();
+    }
+}
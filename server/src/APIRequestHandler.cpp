@@ -40,6 +40,7 @@ void ZapFR::Server::APIRequestHandler::handleRequest(Poco::Net::HTTPServerReques
 
         auto handler = mAPI->handler();
         httpStatus = handler(apiRequest.get(), response);
+        apiRequest->finishResponse();
     }
     catch (const UnauthorizedError& e)
     {
@@ -190,6 +190,18 @@ std::vector<std::unique_ptr<ZapFR::Server::API>> ZapFR::Server::API::msAPIs = st
 				msAPIs.emplace_back(std::move(entry));
 			}
 
+		{
+				auto entry = std::make_unique<ZapFR::Server::API>(daemon, R"(Feeds)", R"(Returns what the most recent refreshes of the feed cost (timings in microseconds, sizes in bytes), newest first)");
+				entry->setMethod("GET");
+				entry->setPath(R"(^\/feed/([0-9]+)/telemetry$)", R"(/feed/<feedID>/telemetry)");
+				entry->addURIParameter({R"(feedID)", R"(The id of the feed to retrieve the telemetry for)"});
+				entry->setRequiresCredentials(true);
+				entry->setContentType(R"(application/json)");
+				entry->setJSONOutput(R"(Array)");
+				entry->setHandler(ZapFR::Server::APIHandler_feed_telemetry);
+				msAPIs.emplace_back(std::move(entry));
+			}
+
 		{
 				auto entry = std::make_unique<ZapFR::Server::API>(daemon, R"(Feeds)", R"(Updates the properties of a feed)");
 				entry->setMethod("PATCH");
@@ -204,11 +216,22 @@ std::vector<std::unique_ptr<ZapFR::Server::API>> ZapFR::Server::API::msAPIs = st
 				msAPIs.emplace_back(std::move(entry));
 			}
 
+		{
+				auto entry = std::make_unique<ZapFR::Server::API>(daemon, R"(Feeds)", R"(Returns the base64 encoded icons matching the requested icon hashes, as an object keyed by hash)");
+				entry->setMethod("POST");
+				entry->setPath(R"(^\/feeds\/icons$)", R"(/feeds/icons)");
+				entry->addBodyParameter({R"(iconHashes)", true, R"(A comma separated list of the icon hashes to retrieve)"});
+				entry->setRequiresCredentials(true);
+				entry->setContentType(R"(application/json)");
+				entry->setJSONOutput(R"(Object)");
+				entry->setHandler(ZapFR::Server::APIHandler_feeds_icons);
+				msAPIs.emplace_back(std::move(entry));
+			}
+
 		{
 				auto entry = std::make_unique<ZapFR::Server::API>(daemon, R"(Feeds)", R"(Returns all the feeds within the source)");
 				entry->setMethod("GET");
 				entry->setPath(R"(^\/feeds$)", R"(/feeds)");
-				entry->addBodyParameter({R"(getIcons)", false, R"(Whether to include the base64 encoded icon or not ('true' or 'false') (optional; default=false))"});
 				entry->setRequiresCredentials(true);
 				entry->setContentType(R"(application/json)");
 				entry->setJSONOutput(R"(Array)");
@@ -648,6 +671,33 @@ std::vector<std::unique_ptr<ZapFR::Server::API>> ZapFR::Server::API::msAPIs = st
 				msAPIs.emplace_back(std::move(entry));
 			}
 
+		{
+				auto entry = std::make_unique<ZapFR::Server::API>(daemon, R"(WebSub)", R"(Receives the feed content a WebSub hub pushes for a subscription)");
+				entry->setMethod("POST");
+				entry->setPath(R"(^\/websub\/([0-9a-f-]+)$)", R"(/websub/<token>)");
+				entry->addURIParameter({R"(token)", R"(The token identifying the subscription)"});
+				entry->setRequiresCredentials(false);
+				entry->setContentType(R"(text/plain)");
+				entry->setHandler(ZapFR::Server::APIHandler_websub_deliver);
+				entry->setAcceptsRawBody(true);
+				msAPIs.emplace_back(std::move(entry));
+			}
+
+		{
+				auto entry = std::make_unique<ZapFR::Server::API>(daemon, R"(WebSub)", R"(Lets a WebSub hub verify a subscription or unsubscription request by echoing its challenge)");
+				entry->setMethod("GET");
+				entry->setPath(R"(^\/websub\/([0-9a-f-]+)$)", R"(/websub/<token>)");
+				entry->addURIParameter({R"(token)", R"(The token identifying the subscription)"});
+				entry->addBodyParameter({R"(hub.mode)", true, R"(Either 'subscribe' or 'unsubscribe')"});
+				entry->addBodyParameter({R"(hub.topic)", true, R"(The URL of the feed the request applies to)"});
+				entry->addBodyParameter({R"(hub.challenge)", true, R"(The string to echo back to confirm the request)"});
+				entry->addBodyParameter({R"(hub.lease_seconds)", false, R"(How long the hub keeps the subscription active)"});
+				entry->setRequiresCredentials(false);
+				entry->setContentType(R"(text/plain)");
+				entry->setHandler(ZapFR::Server::APIHandler_websub_verify);
+				msAPIs.emplace_back(std::move(entry));
+			}
+
         msAPIsLoaded = true;
         }
 }
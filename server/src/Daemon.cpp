@@ -16,12 +16,20 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
 #include <Poco/JSON/Parser.h>
 
 #include "Daemon.h"
 #include "ZapFR/AutoRefresh.h"
+#include "ZapFR/DNSCache.h"
 #include "ZapFR/Database.h"
+#include "ZapFR/HTTPCorpusTransport.h"
+#include "ZapFR/Helpers.h"
+#include "ZapFR/HostThrottle.h"
 #include "ZapFR/Log.h"
+#include "ZapFR/WebSub.h"
 #include "ZapFR/local/FeedLocal.h"
 #include "ZapFR/local/ScriptLocal.h"
 
@@ -50,6 +58,46 @@ void ZapFR::Server::Daemon::boot()
     auto ar = ZapFR::Engine::AutoRefresh::getInstance();
     ar->setEnabled(mConfiguration->getBool("zapfr.autorefresh.enabled", true));
     ar->setFeedRefreshInterval(mConfiguration->getUInt64("zapfr.autorefresh.interval", ZapFR::Engine::DefaultFeedAutoRefreshInterval));
+    ar->setAdaptive(mConfiguration->getBool("zapfr.autorefresh.adaptive", true));
+    ar->setStartupSmoothingWindow(mConfiguration->getUInt64("zapfr.autorefresh.startupwindow", ZapFR::Engine::DefaultAutoRefreshStartupSmoothingWindow));
+
+    ZapFR::Engine::Helpers::HTTPTransferLimits limits;
+    limits.maxBodySize = mConfiguration->getUInt64("zapfr.http.maxbodysize", ZapFR::Engine::DefaultHTTPMaxBodySize);
+    limits.deadline = mConfiguration->getUInt64("zapfr.http.deadline", ZapFR::Engine::DefaultHTTPDeadline);
+    limits.minTransferRate = mConfiguration->getUInt64("zapfr.http.mintransferrate", ZapFR::Engine::DefaultHTTPMinTransferRate);
+    limits.maxRedirects = mConfiguration->getUInt64("zapfr.http.maxredirects", ZapFR::Engine::DefaultHTTPMaxRedirects);
+    ZapFR::Engine::Helpers::setHTTPTransferLimits(limits);
+
+    // lets refreshes be recorded once and then replayed offline, e.g. to benchmark them
+    auto replayDir = mConfiguration->getString("zapfr.http.replaydir", "");
+    auto recordDir = mConfiguration->getString("zapfr.http.recorddir", "");
+    if (!replayDir.empty())
+    {
+        ZapFR::Engine::Log::log(ZapFR::Engine::LogLevel::Warning, fmt::format("Replaying HTTP exchanges from {}, the network won't be used", replayDir));
+        ZapFR::Engine::Helpers::setHTTPTransport(std::make_shared<ZapFR::Engine::HTTPReplayTransport>(replayDir));
+    }
+    else if (!recordDir.empty())
+    {
+        ZapFR::Engine::Log::log(ZapFR::Engine::LogLevel::Info, fmt::format("Recording HTTP exchanges to {}", recordDir));
+        ZapFR::Engine::Helpers::setHTTPTransport(
+            std::make_shared<ZapFR::Engine::HTTPRecordingTransport>(recordDir, std::make_shared<ZapFR::Engine::HTTPNetworkTransport>()));
+    }
+
+    ZapFR::Engine::HostThrottle::Limits throttleLimits;
+    throttleLimits.maxConcurrentRequests = mConfiguration->getUInt64("zapfr.throttle.maxconcurrentrequests", throttleLimits.maxConcurrentRequests);
+    throttleLimits.minSpacingInMilliseconds = mConfiguration->getUInt64("zapfr.throttle.minspacing", throttleLimits.minSpacingInMilliseconds);
+    throttleLimits.requestsPerMinute = mConfiguration->getUInt64("zapfr.throttle.requestsperminute", throttleLimits.requestsPerMinute);
+    throttleLimits.burstSize = mConfiguration->getUInt64("zapfr.throttle.burstsize", throttleLimits.burstSize);
+    ZapFR::Engine::HostThrottle::getInstance()->setLimits(throttleLimits);
+
+    auto dnsCache = ZapFR::Engine::DNSCache::getInstance();
+    dnsCache->setTTL(mConfiguration->getUInt64("zapfr.dns.ttl", ZapFR::Engine::DNSCache::DefaultTTL));
+    dnsCache->setNegativeTTL(mConfiguration->getUInt64("zapfr.dns.negativettl", ZapFR::Engine::DNSCache::DefaultNegativeTTL));
+
+    auto webSub = ZapFR::Engine::WebSub::getInstance();
+    webSub->setLeaseDuration(mConfiguration->getUInt64("zapfr.websub.leaseduration", ZapFR::Engine::WebSub::DefaultLeaseDuration));
+    webSub->setSafetyInterval(mConfiguration->getUInt64("zapfr.websub.safetyinterval", ZapFR::Engine::WebSub::DefaultSafetyInterval));
+    webSub->setCallbackURL(mConfiguration->getString("zapfr.websub.callbackurl", ""));
 
     auto logLevel = mConfiguration->getString("loglevel", "info");
     if (logLevel == "debug")
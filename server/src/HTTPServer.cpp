@@ -31,6 +31,8 @@ void ZapFR::Server::HTTPServer::start()
     auto serverParams = new Poco::Net::HTTPServerParams;
     serverParams->setMaxQueued(100);
     serverParams->setMaxThreads(16);
+    serverParams->setKeepAlive(true);
+    serverParams->setKeepAliveTimeout(Poco::Timespan(60, 0));
 
     Poco::Net::SocketAddress socketAddress(static_cast<Poco::UInt16>(mBindPort));
     if (mPrivKey.empty())
@@ -38,7 +38,7 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_about([[maybe_unus
     o.set(ZapFR::Engine::JSON::About::Name, apiRequest->api()->daemon()->configString("zapfr.servername"));
     o.set(ZapFR::Engine::JSON::About::Version, ZapFR::Engine::APIVersion);
 
-    Poco::JSON::Stringifier::stringify(o, response.send());
+    Poco::JSON::Stringifier::stringify(o, apiRequest->send(response));
 
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
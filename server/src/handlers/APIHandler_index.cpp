@@ -47,7 +47,7 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_index([[maybe_unus
        << "\"</h1>"
           "	</body>"
           "</html>";
-    response.send() << ss.str();
+    apiRequest->send(response) << ss.str();
 
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
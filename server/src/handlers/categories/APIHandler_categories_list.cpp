@@ -93,6 +93,6 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_categories_list([[
         }
     }
 
-    Poco::JSON::Stringifier::stringify(catArr, response.send());
+    Poco::JSON::Stringifier::stringify(catArr, apiRequest->send(response));
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
@@ -49,9 +49,9 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_dummyfeed_createpo
     DummyFeed::getInstance()->addEntry(fmt::format("New post on {}", nowFormatted), fmt::format("Content of new post on <b>{}</b>", nowFormatted),
                                        Poco::UUIDGenerator::defaultGenerator().createRandom().toString(), Poco::Timestamp());
 
-    response.send() << "Post created at " << nowFormatted;
+    apiRequest->send(response) << "Post created at " << nowFormatted;
 #else
-    response.send();
+    apiRequest->send(response);
 #endif
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
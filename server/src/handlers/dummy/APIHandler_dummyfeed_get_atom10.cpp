@@ -33,9 +33,9 @@
 Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_dummyfeed_get_atom10([[maybe_unused]] APIRequest* apiRequest, Poco::Net::HTTPServerResponse& response)
 {
 #ifdef DEBUG
-    response.send() << DummyFeed::getInstance()->getATOM10();
+    apiRequest->send(response) << DummyFeed::getInstance()->getATOM10();
 #else
-    response.send();
+    apiRequest->send(response);
 #endif
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
@@ -33,9 +33,9 @@
 Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_dummyfeed_get_json11([[maybe_unused]] APIRequest* apiRequest, Poco::Net::HTTPServerResponse& response)
 {
 #ifdef DEBUG
-    response.send() << DummyFeed::getInstance()->getJSON11();
+    apiRequest->send(response) << DummyFeed::getInstance()->getJSON11();
 #else
-    response.send();
+    apiRequest->send(response);
 #endif
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
@@ -33,9 +33,9 @@
 Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_dummyfeed_get_rss20([[maybe_unused]] APIRequest* apiRequest, Poco::Net::HTTPServerResponse& response)
 {
 #ifdef DEBUG
-    response.send() << DummyFeed::getInstance()->getRSS20();
+    apiRequest->send(response) << DummyFeed::getInstance()->getRSS20();
 #else
-    response.send();
+    apiRequest->send(response);
 #endif
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
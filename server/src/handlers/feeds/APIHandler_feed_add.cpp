@@ -56,7 +56,7 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_feed_add([[maybe_u
         }
     }
 
-    Poco::JSON::Stringifier::stringify(o, response.send());
+    Poco::JSON::Stringifier::stringify(o, apiRequest->send(response));
 
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
@@ -56,6 +56,6 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_feed_deletelogs([[
     }
 
     Poco::JSON::Object o;
-    Poco::JSON::Stringifier::stringify(o, response.send());
+    Poco::JSON::Stringifier::stringify(o, apiRequest->send(response));
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <Poco/Base64Encoder.h>
+
+#include "API.h"
+#include "APIHandlers.h"
+#include "APIRequest.h"
+#include "ZapFR/Helpers.h"
+#include "ZapFR/local/SourceLocal.h"
+
+// ::API
+//
+//	Returns the base64 encoded icons matching the requested icon hashes, as an object keyed by hash
+//	/feeds/icons (POST)
+//
+//	Parameters:
+//		iconHashes (REQD) - A comma separated list of the icon hashes to retrieve - apiRequest->parameter("iconHashes")
+//
+//	Content-Type: application/json
+//	JSON output: Object
+//
+// API::
+
+Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_feeds_icons(APIRequest* apiRequest, Poco::Net::HTTPServerResponse& response)
+{
+    const auto iconHashesStr = apiRequest->parameter(ZapFR::Engine::HTTPParam::Feed::IconHashes);
+
+    std::vector<std::string> iconHashesVec;
+    ZapFR::Engine::Helpers::splitString(iconHashesStr, ',', iconHashesVec);
+    std::unordered_set<std::string> iconHashes(iconHashesVec.begin(), iconHashesVec.end());
+
+    Poco::JSON::Object o;
+
+    auto source = ZapFR::Engine::Source::getSource(1);
+    if (source.has_value())
+    {
+        const auto& icons = source.value()->getIcons(iconHashes);
+        for (const auto& [hash, data] : icons)
+        {
+            std::stringstream b64Stream;
+            Poco::Base64Encoder encoder(b64Stream);
+            encoder << data;
+            encoder.close();
+            o.set(hash, b64Stream.str());
+        }
+    }
+
+    Poco::JSON::Stringifier::stringify(o, apiRequest->send(response));
+
+    return Poco::Net::HTTPResponse::HTTP_OK;
+}
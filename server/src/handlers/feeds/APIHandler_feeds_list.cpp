@@ -27,9 +27,6 @@
 //	Returns all the feeds within the source
 //	/feeds (GET)
 //
-//	Parameters:
-//		getIcons - Whether to include the base64 encoded icon or not ('true' or 'false') (optional; default=false) - apiRequest->parameter("getIcons")
-//
 //	Content-Type: application/json
 //	JSON output: Array
 //
@@ -37,21 +34,19 @@
 
 Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_feeds_list([[maybe_unused]] APIRequest* apiRequest, Poco::Net::HTTPServerResponse& response)
 {
-    auto fetchIcons = (apiRequest->parameter(ZapFR::Engine::HTTPParam::Feed::GetIcons) == ZapFR::Engine::HTTPParam::True);
-
     Poco::JSON::Array a;
 
     auto source = ZapFR::Engine::Source::getSource(1);
     if (source.has_value())
     {
-        auto feeds = source.value()->getFeeds((fetchIcons ? ZapFR::Engine::Source::FetchInfo::Icon : ZapFR::Engine::Source::FetchInfo::Data));
+        auto feeds = source.value()->getFeeds(ZapFR::Engine::Source::FetchInfo::Data);
         for (const auto& feed : feeds)
         {
             a.add(feed->toJSON());
         }
     }
 
-    Poco::JSON::Stringifier::stringify(a, response.send());
+    Poco::JSON::Stringifier::stringify(a, apiRequest->send(response));
 
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
@@ -68,7 +68,7 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_folder_markasread(
         }
     }
 
-    Poco::JSON::Stringifier::stringify(arr, response.send());
+    Poco::JSON::Stringifier::stringify(arr, apiRequest->send(response));
 
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
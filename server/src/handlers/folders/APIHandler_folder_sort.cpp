@@ -95,7 +95,7 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_folder_sort([[mayb
     o.set(ZapFR::Engine::JSON::Folder::FolderSortOrders, folderSortOrderArr);
     o.set(ZapFR::Engine::JSON::Folder::FeedSortOrders, feedSortOrderArr);
 
-    Poco::JSON::Stringifier::stringify(o, response.send());
+    Poco::JSON::Stringifier::stringify(o, apiRequest->send(response));
 
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
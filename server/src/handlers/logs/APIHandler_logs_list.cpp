@@ -101,7 +101,7 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_logs_list([[maybe_
         o.set(ZapFR::Engine::JSON::Log::Count, logCount);
     }
 
-    Poco::JSON::Stringifier::stringify(o, response.send());
+    Poco::JSON::Stringifier::stringify(o, apiRequest->send(response));
 
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
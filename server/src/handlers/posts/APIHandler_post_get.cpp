@@ -66,7 +66,7 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_post_get([[maybe_u
         }
     }
 
-    Poco::JSON::Stringifier::stringify(o, response.send());
+    Poco::JSON::Stringifier::stringify(o, apiRequest->send(response));
 
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
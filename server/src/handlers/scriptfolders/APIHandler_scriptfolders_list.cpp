@@ -46,7 +46,7 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_scriptfolders_list
         }
     }
 
-    Poco::JSON::Stringifier::stringify(a, response.send());
+    Poco::JSON::Stringifier::stringify(a, apiRequest->send(response));
 
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
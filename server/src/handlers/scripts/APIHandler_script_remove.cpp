@@ -51,6 +51,6 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_script_remove([[ma
     }
 
     Poco::JSON::Object o;
-    Poco::JSON::Stringifier::stringify(o, response.send());
+    Poco::JSON::Stringifier::stringify(o, apiRequest->send(response));
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
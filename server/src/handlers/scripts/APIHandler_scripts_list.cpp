@@ -45,6 +45,6 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_scripts_list([[may
         }
     }
 
-    Poco::JSON::Stringifier::stringify(a, response.send());
+    Poco::JSON::Stringifier::stringify(a, apiRequest->send(response));
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
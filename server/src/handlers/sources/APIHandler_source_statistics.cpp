@@ -44,7 +44,7 @@ Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_source_statistics(
             o.set(ZapFR::Engine::Source::SourceStatisticJSONIdentifierMap.at(stat), value);
         }
     }
-    Poco::JSON::Stringifier::stringify(o, response.send());
+    Poco::JSON::Stringifier::stringify(o, apiRequest->send(response));
 
     return Poco::Net::HTTPResponse::HTTP_OK;
 }
\ No newline at end of file
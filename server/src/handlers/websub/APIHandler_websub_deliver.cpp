@@ -0,0 +1,52 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "API.h"
+#include "APIHandlers.h"
+#include "APIRequest.h"
+#include "ZapFR/WebSub.h"
+
+// ::API
+//
+//	Receives the feed content a WebSub hub pushes for a subscription
+//	/websub/<token> (POST)
+//
+//	URI parameters:
+//		token - The token identifying the subscription - apiRequest->pathComponentAt(1)
+//
+//	Content-Type: text/plain
+//	Accepts a raw request body - apiRequest->body()
+//
+// API::
+
+Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_websub_deliver([[maybe_unused]] APIRequest* apiRequest, Poco::Net::HTTPServerResponse& response)
+{
+    const auto token = apiRequest->pathComponentAt(1);
+    const auto signature = apiRequest->request()->get("X-Hub-Signature", "");
+
+    // content with a bad signature is dropped, but still acknowledged, so a forger can't tell whether it got through
+    auto delivery = ZapFR::Engine::WebSub::getInstance()->deliver(token, signature, std::move(apiRequest->body()));
+    if (delivery == ZapFR::Engine::WebSub::Delivery::UnknownSubscription)
+    {
+        // tells the hub to stop delivering to this callback
+        return Poco::Net::HTTPResponse::HTTP_GONE;
+    }
+
+    apiRequest->send(response);
+    return Poco::Net::HTTPResponse::HTTP_OK;
+}
@@ -0,0 +1,63 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <Poco/NumberParser.h>
+
+#include "API.h"
+#include "APIHandlers.h"
+#include "APIRequest.h"
+#include "ZapFR/WebSub.h"
+
+// ::API
+//
+//	Lets a WebSub hub verify a subscription or unsubscription request by echoing its challenge
+//	/websub/<token> (GET)
+//
+//	URI parameters:
+//		token - The token identifying the subscription - apiRequest->pathComponentAt(1)
+//
+//	Parameters:
+//		hub.mode (REQD) - Either 'subscribe' or 'unsubscribe' - apiRequest->parameter("hub.mode")
+//		hub.topic (REQD) - The URL of the feed the request applies to - apiRequest->parameter("hub.topic")
+//		hub.challenge (REQD) - The string to echo back to confirm the request - apiRequest->parameter("hub.challenge")
+//		hub.lease_seconds - How long the hub keeps the subscription active - apiRequest->parameter("hub.lease_seconds")
+//
+//	Content-Type: text/plain
+//
+// API::
+
+Poco::Net::HTTPResponse::HTTPStatus ZapFR::Server::APIHandler_websub_verify([[maybe_unused]] APIRequest* apiRequest, Poco::Net::HTTPServerResponse& response)
+{
+    const auto token = apiRequest->pathComponentAt(1);
+    const auto mode = apiRequest->parameter("hub.mode");
+    const auto topic = apiRequest->parameter("hub.topic");
+    const auto challenge = apiRequest->parameter("hub.challenge");
+    const auto leaseSecondsStr = apiRequest->parameter("hub.lease_seconds");
+
+    uint64_t leaseSeconds{0};
+    Poco::NumberParser::tryParseUnsigned64(leaseSecondsStr, leaseSeconds);
+
+    auto echo = ZapFR::Engine::WebSub::getInstance()->verifyIntent(token, mode, topic, challenge, leaseSeconds);
+    if (!echo.has_value())
+    {
+        return Poco::Net::HTTPResponse::HTTP_NOT_FOUND;
+    }
+
+    apiRequest->send(response) << echo.value();
+    return Poco::Net::HTTPResponse::HTTP_OK;
+}
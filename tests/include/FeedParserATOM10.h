@@ -16,8 +16,8 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
-#ifndef ZAPFR_ENGINE_FEEDPARSERATOM10_H
-#define ZAPFR_ENGINE_FEEDPARSERATOM10_H
+#ifndef ZAPFR_TESTS_FEEDPARSERATOM10_H
+#define ZAPFR_TESTS_FEEDPARSERATOM10_H
 
 #include "FeedParserXML.h"
 
@@ -43,8 +43,9 @@ namespace ZapFR
             std::string iconURL() const override;
 
             std::vector<Item> items() const override;
+            WebSubLinks webSubLinks() const override;
         };
     } // namespace Engine
 } // namespace ZapFR
 
-#endif // ZAPFR_ENGINE_FEEDPARSERATOM10_H
\ No newline at end of file
+#endif // ZAPFR_TESTS_FEEDPARSERATOM10_H
\ No newline at end of file
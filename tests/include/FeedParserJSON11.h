@@ -16,15 +16,17 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
-#ifndef ZAPFR_ENGINE_FEEDPARSERJSON11_H
-#define ZAPFR_ENGINE_FEEDPARSERJSON11_H
+#ifndef ZAPFR_TESTS_FEEDPARSERJSON11_H
+#define ZAPFR_TESTS_FEEDPARSERJSON11_H
 
-#include "FeedParser.h"
+#include "ZapFR/feed_handling/FeedParser.h"
 
 namespace ZapFR
 {
     namespace Engine
     {
+        // the Poco::JSON object tree parser the engine used before it switched to FeedParserJSON11OnDemand; the tests keep it around as the
+        // reference that the on-demand parser has to produce identical output to
         class FeedParserJSON11 : public FeedParser
         {
           public:
@@ -54,4 +56,4 @@ namespace ZapFR
     } // namespace Engine
 } // namespace ZapFR
 
-#endif // ZAPFR_ENGINE_FEEDPARSERJSON11_H
\ No newline at end of file
+#endif // ZAPFR_TESTS_FEEDPARSERJSON11_H
\ No newline at end of file
@@ -16,8 +16,8 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
-#ifndef ZAPFR_ENGINE_FEEDPARSERRSS20_H
-#define ZAPFR_ENGINE_FEEDPARSERRSS20_H
+#ifndef ZAPFR_TESTS_FEEDPARSERRSS20_H
+#define ZAPFR_TESTS_FEEDPARSERRSS20_H
 
 #include "FeedParserXML.h"
 
@@ -43,8 +43,10 @@ namespace ZapFR
             std::string iconURL() const override;
 
             std::vector<Item> items() const override;
+            WebSubLinks webSubLinks() const override;
+            RefreshHints refreshHints() const override;
         };
     } // namespace Engine
 } // namespace ZapFR
 
-#endif // ZAPFR_ENGINE_FEEDPARSERRSS20_H
\ No newline at end of file
+#endif // ZAPFR_TESTS_FEEDPARSERRSS20_H
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_TESTS_FEEDPARSERXML_H
+#define ZAPFR_TESTS_FEEDPARSERXML_H
+
+#include <functional>
+#include <unordered_map>
+
+#include <Poco/DOM/Element.h>
+
+#include "ZapFR/feed_handling/FeedParser.h"
+
+namespace ZapFR
+{
+    namespace Engine
+    {
+        // the DOM based XML parsers the engine used before it switched to FeedParserXMLStreaming; the tests keep them around as the reference
+        // that the streaming parsers have to produce identical output to
+        class FeedParserXML : public FeedParser
+        {
+          public:
+            FeedParserXML(const std::string& url);
+            virtual ~FeedParserXML() = default;
+            FeedParserXML(const FeedParserXML& e) = delete;
+            FeedParserXML& operator=(const FeedParserXML&) = delete;
+            FeedParserXML(FeedParserXML&&) = delete;
+            FeedParserXML& operator=(FeedParserXML&&) = delete;
+
+            void setXMLDoc(Poco::AutoPtr<Poco::XML::Document> xmlDoc)
+            {
+                mXMLDoc = xmlDoc;
+                mFeedFieldCache.clear();
+            }
+
+          protected:
+            std::string fetchNodeValue(const std::string& nodeName) const;
+            std::string fetchNodeValue(Poco::XML::Node* parent, const std::string& nodeName) const;
+            std::string fetchNodeValueNS(Poco::XML::Node* parent, const std::string& nodeName, const Poco::XML::Node::NSMap& nsMap) const;
+            std::string innerXML(Poco::XML::Node* node) const;
+            Poco::XML::Node* fetchNode(Poco::XML::Node* parent, const std::string& nodeName) const;
+            std::optional<uint64_t> fetchSyndicationUpdatePeriod(Poco::XML::Node* channel) const;
+            WebSubLinks fetchWebSubLinks(Poco::XML::Node* parent) const;
+
+            // feed-level values are looked up in the document only once, the getters return the cached value afterwards
+            const std::string& cachedFeedField(const std::string& key, const std::function<std::string()>& lookup) const;
+
+            // walks the subtree below parent once, in document order (the order getElementsByTagName uses); depth is 1 for the direct children
+            static void forEachDescendantElement(Poco::XML::Node* parent, const std::function<void(Poco::XML::Element*, size_t)>& visitor);
+            std::vector<Poco::XML::Element*> elementsByTagName(const std::string& tagName) const;
+            static std::string innerText(Poco::XML::Node* node) { return node != nullptr ? node->innerText() : ""; }
+            static void keepFirst(Poco::XML::Element*& target, Poco::XML::Element* element)
+            {
+                if (target == nullptr)
+                {
+                    target = element;
+                }
+            }
+            static bool isElementNS(Poco::XML::Element* element, const std::string& namespaceURI, const std::string& localName)
+            {
+                return element->localName() == localName && element->namespaceURI() == namespaceURI;
+            }
+
+            Poco::AutoPtr<Poco::XML::Document> mXMLDoc{nullptr};
+            mutable std::unordered_map<std::string, std::string> mFeedFieldCache{};
+        };
+    } // namespace Engine
+} // namespace ZapFR
+
+#endif // ZAPFR_TESTS_FEEDPARSERXML_H
\ No newline at end of file
@@ -35,6 +35,8 @@ namespace ZapFR
             void testRunStarting(Catch::TestRunInfo const&) override;
             void testRunEnded(Catch::TestRunStats const&) override;
 
+            static constexpr uint16_t serverPort() noexcept { return msPort; }
+
           private:
             std::string mTemporaryDirectory{""};
             std::string mTemporaryConfigFilePath{""};
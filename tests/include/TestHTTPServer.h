@@ -0,0 +1,94 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef ZAPFR_TESTS_TESTHTTPSERVER_H
+#define ZAPFR_TESTS_TESTHTTPSERVER_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Poco/Net/HTTPResponse.h>
+#include <Poco/Net/HTTPServer.h>
+#include <Poco/Net/NameValueCollection.h>
+
+namespace ZapFR
+{
+    namespace Tests
+    {
+        // a local HTTP server for the tests to point feeds, hubs, ... at; it listens on a port picked by the OS and answers every path it
+        // has no route for with a 404
+        class TestHTTPServer
+        {
+          public:
+            struct Request
+            {
+                std::string method{""};
+                std::string path{""};
+                std::string query{""};
+                Poco::Net::NameValueCollection headers{};
+                std::string body{""};
+            };
+
+            struct Response
+            {
+                Poco::Net::HTTPResponse::HTTPStatus status{Poco::Net::HTTPResponse::HTTP_OK};
+                std::map<std::string, std::string> headers{};
+                std::string body{""};
+            };
+
+            using Handler = std::function<Response(const Request&)>;
+
+            TestHTTPServer();
+            ~TestHTTPServer();
+            TestHTTPServer(const TestHTTPServer&) = delete;
+            TestHTTPServer& operator=(const TestHTTPServer&) = delete;
+            TestHTTPServer(TestHTTPServer&&) = delete;
+            TestHTTPServer& operator=(TestHTTPServer&&) = delete;
+
+            uint16_t port() const noexcept { return mPort; }
+            std::string url(const std::string& path) const;
+
+            void route(const std::string& path, Handler handler);
+            void serve(const std::string& path, const std::string& contentType, const std::string& body);
+            void redirect(const std::string& path, const std::string& location, Poco::Net::HTTPResponse::HTTPStatus status);
+
+            std::vector<Request> requests(const std::string& path) const;
+            size_t requestCount(const std::string& path) const;
+
+            // an RSS 2.0 document with itemCount items (guids https://example.com/1 onwards), plus whatever extra the channel needs
+            static std::string rssFeed(const std::string& title, size_t itemCount = 1, const std::string& extraChannelElements = "");
+
+          private:
+            uint16_t mPort{0};
+            std::unique_ptr<Poco::Net::HTTPServer> mServer{nullptr};
+            mutable std::mutex mMutex{};
+            std::map<std::string, Handler> mRoutes{};
+            std::vector<Request> mRequests{};
+
+            Response handle(Request request);
+
+            friend class TestHTTPServerHandler;
+        };
+    } // namespace Tests
+} // namespace ZapFR
+
+#endif // ZAPFR_TESTS_TESTHTTPSERVER_H
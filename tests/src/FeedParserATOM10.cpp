@@ -0,0 +1,317 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include "ZapFR/DateParser.h"
+#include "FeedParserATOM10.h"
+
+ZapFR::Engine::FeedParserATOM10::FeedParserATOM10(const std::string& url) : FeedParserXML(url)
+{
+}
+
+std::string ZapFR::Engine::FeedParserATOM10::guid() const
+{
+    return fetchNodeValue("/id");
+}
+
+std::string ZapFR::Engine::FeedParserATOM10::title() const
+{
+    return fetchNodeValue("/title");
+}
+
+std::string ZapFR::Engine::FeedParserATOM10::subtitle() const
+{
+    return fetchNodeValue("/subtitle");
+}
+
+std::string ZapFR::Engine::FeedParserATOM10::link() const
+{
+    const auto lookup = [&]()
+    {
+        // the first alternate link in the document, which may well be one of an entry
+        std::string link;
+        bool found{false};
+        const auto visit = [&](Poco::XML::Element* el, size_t)
+        {
+            if (!found && el->nodeName() == "link" && el->hasAttribute("rel") && el->getAttribute("rel") == "alternate" && el->hasAttribute("href"))
+            {
+                link = el->getAttribute("href");
+                found = true;
+            }
+        };
+        forEachDescendantElement(mXMLDoc->documentElement(), visit);
+        return link;
+    };
+    return cachedFeedField("link", lookup);
+}
+
+ZapFR::Engine::FeedParser::WebSubLinks ZapFR::Engine::FeedParserATOM10::webSubLinks() const
+{
+    return fetchWebSubLinks(mXMLDoc->documentElement());
+}
+
+std::string ZapFR::Engine::FeedParserATOM10::description() const
+{
+    return "";
+}
+
+std::string ZapFR::Engine::FeedParserATOM10::iconURL() const
+{
+    return "";
+}
+
+#include <Poco/DOM/NamedNodeMap.h>
+std::string ZapFR::Engine::FeedParserATOM10::language() const
+{
+    auto docEl = mXMLDoc->documentElement();
+    if (docEl->hasAttributeNS("http://www.w3.org/XML/1998/namespace", "lang"))
+    {
+        return docEl->getAttributeNS("http://www.w3.org/XML/1998/namespace", "lang");
+    }
+    return "";
+}
+
+std::string ZapFR::Engine::FeedParserATOM10::copyright() const
+{
+    return fetchNodeValue("/rights");
+}
+
+std::vector<ZapFR::Engine::FeedParser::Item> ZapFR::Engine::FeedParserATOM10::items() const
+{
+    static const std::string mediaNamespace{"http://search.yahoo.com/mrss/"};
+
+    std::vector<Item> items;
+    for (auto entryEl : elementsByTagName("entry"))
+    {
+        Item item;
+
+        // walk the entry once; the fields come from the first direct child with that name, links, enclosures and categories from anywhere below
+        // the entry (the enclosure elements are listed after the enclosure links)
+        Poco::XML::Element* titleEl{nullptr};
+        Poco::XML::Element* summaryEl{nullptr};
+        Poco::XML::Element* contentEl{nullptr};
+        Poco::XML::Element* mediaGroupEl{nullptr};
+        Poco::XML::Element* authorEl{nullptr};
+        Poco::XML::Element* idEl{nullptr};
+        Poco::XML::Element* updatedEl{nullptr};
+        Poco::XML::Element* publishedEl{nullptr};
+        std::vector<Post::Enclosure> enclosureElements;
+        const auto visit = [&](Poco::XML::Element* el, size_t depth)
+        {
+            const auto& name = el->nodeName();
+            if (depth == 1)
+            {
+                if (name == "title")
+                {
+                    keepFirst(titleEl, el);
+                }
+                else if (name == "summary")
+                {
+                    keepFirst(summaryEl, el);
+                }
+                else if (name == "content")
+                {
+                    keepFirst(contentEl, el);
+                }
+                else if (name == "author")
+                {
+                    keepFirst(authorEl, el);
+                }
+                else if (name == "id")
+                {
+                    keepFirst(idEl, el);
+                }
+                else if (name == "updated")
+                {
+                    keepFirst(updatedEl, el);
+                }
+                else if (name == "published")
+                {
+                    keepFirst(publishedEl, el);
+                }
+                else if (isElementNS(el, mediaNamespace, "group"))
+                {
+                    keepFirst(mediaGroupEl, el);
+                }
+            }
+
+            if (name == "link")
+            {
+                if (el->hasAttribute("href"))
+                {
+                    if (el->hasAttribute("rel"))
+                    {
+                        auto rel = el->getAttribute("rel");
+                        if (rel == "enclosure")
+                        {
+                            Post::Enclosure e;
+                            e.url = el->getAttribute("href");
+                            if (el->hasAttribute("type"))
+                            {
+                                e.mimeType = el->getAttribute("type");
+                            }
+                            if (el->hasAttribute("length"))
+                            {
+                                auto lengthStr = el->getAttribute("length");
+                                Poco::NumberParser::tryParseUnsigned64(lengthStr, e.size);
+                            }
+                            if (!e.url.empty())
+                            {
+                                item.enclosures.emplace_back(e);
+                            }
+                            return;
+                        }
+                        else if (rel != "alternate")
+                        {
+                            return;
+                        }
+                    }
+                    item.link = el->getAttribute("href");
+                }
+            }
+            else if (name == "enclosure")
+            {
+                // some feeds also put <enclosure> elements within items (diverges from spec, but allow anyway)
+                // try url/href, length and type as attributes
+                Post::Enclosure e;
+                if (el->hasAttribute("href"))
+                {
+                    e.url = el->getAttribute("href");
+                }
+                if (e.url.empty() && el->hasAttribute("url"))
+                {
+                    e.url = el->getAttribute("url");
+                }
+                if (el->hasAttribute("type"))
+                {
+                    e.mimeType = el->getAttribute("type");
+                }
+                if (el->hasAttribute("length"))
+                {
+                    auto lengthStr = el->getAttribute("length");
+                    Poco::NumberParser::tryParseUnsigned64(lengthStr, e.size);
+                }
+                if (!e.url.empty())
+                {
+                    enclosureElements.emplace_back(e);
+                }
+            }
+            else if (name == "category")
+            {
+                if (el->hasAttribute("term"))
+                {
+                    item.categories.emplace_back(el->getAttribute("term"));
+                }
+            }
+        };
+        forEachDescendantElement(entryEl, visit);
+        item.enclosures.insert(item.enclosures.end(), enclosureElements.begin(), enclosureElements.end());
+
+        item.title = innerText(titleEl);
+        item.content = innerXML(summaryEl);
+
+        if (contentEl != nullptr && !contentEl->hasAttribute("src"))
+        {
+            std::string contentType = "text";
+            if (contentEl->hasAttribute("type"))
+            {
+                contentType = contentEl->getAttribute("type");
+            }
+
+            if (contentType == "text")
+            {
+                item.content = fmt::format(R"(<pre style="white-space:pre-wrap;">{}</pre>)", contentEl->innerText());
+            }
+            else
+            {
+                item.content = innerXML(contentEl);
+            }
+        }
+
+        if (item.content.empty() && mediaGroupEl != nullptr) // see if there's a media:thumbnail/media:description present (for YouTube)
+        {
+            Poco::XML::Element* thumbnailEl{nullptr};
+            Poco::XML::Element* descriptionEl{nullptr};
+            for (auto child = mediaGroupEl->firstChild(); child != nullptr; child = child->nextSibling())
+            {
+                if (child->nodeType() == Poco::XML::Node::ELEMENT_NODE)
+                {
+                    auto childEl = static_cast<Poco::XML::Element*>(child);
+                    if (isElementNS(childEl, mediaNamespace, "thumbnail"))
+                    {
+                        keepFirst(thumbnailEl, childEl);
+                    }
+                    else if (isElementNS(childEl, mediaNamespace, "description"))
+                    {
+                        keepFirst(descriptionEl, childEl);
+                    }
+                }
+            }
+
+            std::stringstream mediaContentStream;
+            if (thumbnailEl != nullptr && thumbnailEl->hasAttribute("url"))
+            {
+                item.thumbnail = thumbnailEl->getAttribute("url");
+                mediaContentStream << R"(<a href=")" << item.link << R"("><img src=")" << item.thumbnail << R"(" alt="" /></a>)";
+            }
+
+            if (descriptionEl != nullptr)
+            {
+                if (descriptionEl->hasAttribute("type") && descriptionEl->getAttribute("type") == "html")
+                {
+                    // TODO: using descriptionNode->innerText() strips all its tags, is this correct?
+                    mediaContentStream << "<p>" << descriptionEl->innerText() << "</p>";
+                }
+                else
+                {
+                    auto text = descriptionEl->innerText();
+                    Poco::replaceInPlace(text, "\n", "<br />");
+                    mediaContentStream << "<p>" << text << "</p>";
+                }
+            }
+
+            item.content = mediaContentStream.str();
+        }
+
+        if (authorEl != nullptr)
+        {
+            auto authorNameNode = fetchNode(authorEl, "name");
+            if (authorNameNode != nullptr)
+            {
+                item.author = authorNameNode->innerText();
+            }
+        }
+
+        item.guid = innerText(idEl);
+
+        // 'updated' is a required node according to the atom spec, but seen missing in the wild, in favor of the optional 'published' node
+        item.datePublished = innerText(updatedEl != nullptr ? updatedEl : publishedEl);
+
+        auto normalizedDate = DateParser::normalize(item.datePublished);
+        if (normalizedDate.has_value())
+        {
+            item.datePublished = std::move(normalizedDate.value());
+        }
+
+        items.emplace_back(std::move(item));
+    }
+
+    return items;
+}
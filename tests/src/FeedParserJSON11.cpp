@@ -19,8 +19,9 @@
 #define FMT_HEADER_ONLY
 #include <fmt/core.h>
 
+#include "ZapFR/DateParser.h"
 #include "ZapFR/Helpers.h"
-#include "ZapFR/feed_handling/FeedParserJSON11.h"
+#include "FeedParserJSON11.h"
 
 ZapFR::Engine::FeedParserJSON11::FeedParserJSON11(const std::string& url) : FeedParser(url)
 {
@@ -165,12 +166,10 @@ std::vector<ZapFR::Engine::FeedParser::Item> ZapFR::Engine::FeedParserJSON11::it
             }
             if (!providedDate.empty())
             {
-                Poco::DateTime parsedDate;
-                int tzDiff;
-                if (Poco::DateTimeParser::tryParse(Poco::DateTimeFormat::ISO8601_FORMAT, providedDate, parsedDate, tzDiff))
+                auto normalizedDate = DateParser::normalize(providedDate);
+                if (normalizedDate.has_value())
                 {
-                    parsedDate.makeUTC(tzDiff);
-                    item.datePublished = Poco::DateTimeFormatter::format(parsedDate, Poco::DateTimeFormat::ISO8601_FORMAT);
+                    item.datePublished = std::move(normalizedDate.value());
                 }
             }
 
@@ -16,14 +16,12 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
-#include <Poco/DOM/NodeList.h>
-#include <Poco/DateTimeFormatter.h>
-#include <Poco/DateTimeParser.h>
 #include <Poco/DigestStream.h>
 #include <Poco/MD5Engine.h>
 #include <Poco/UUIDGenerator.h>
 
-#include "ZapFR/feed_handling/FeedParserRSS10.h"
+#include "ZapFR/DateParser.h"
+#include "FeedParserRSS10.h"
 
 ZapFR::Engine::FeedParserRSS10::FeedParserRSS10(const std::string& url) : FeedParserXML(url)
 {
@@ -80,27 +78,63 @@ std::string ZapFR::Engine::FeedParserRSS10::iconURL() const
 
 std::vector<ZapFR::Engine::FeedParser::Item> ZapFR::Engine::FeedParserRSS10::items() const
 {
-    std::vector<Item> items;
+    static const std::string dublinCoreNamespace{"http://purl.org/dc/elements/1.1/"};
+    static const std::string contentNamespace{"http://purl.org/rss/1.0/modules/content/"};
 
-    auto itemList = mXMLDoc->getElementsByTagName("item");
-    for (size_t i = 0; i < itemList->length(); ++i)
+    std::vector<Item> items;
+    for (auto itemEl : elementsByTagName("item"))
     {
-        auto itemNode = itemList->item(i);
+        // the fields all come from the first direct child with that name, so only the children of the item need looking at
+        Poco::XML::Element* titleEl{nullptr};
+        Poco::XML::Element* linkEl{nullptr};
+        Poco::XML::Element* descriptionEl{nullptr};
+        Poco::XML::Element* contentEncodedEl{nullptr};
+        Poco::XML::Element* creatorEl{nullptr};
+        Poco::XML::Element* dateEl{nullptr};
+        for (auto child = itemEl->firstChild(); child != nullptr; child = child->nextSibling())
+        {
+            if (child->nodeType() != Poco::XML::Node::ELEMENT_NODE)
+            {
+                continue;
+            }
 
-        Poco::XML::Element::NSMap nsMap;
-        nsMap.declarePrefix("dc", "http://purl.org/dc/elements/1.1/");
-        nsMap.declarePrefix("content", "http://purl.org/rss/1.0/modules/content/");
+            auto el = static_cast<Poco::XML::Element*>(child);
+            const auto& name = el->nodeName();
+            if (name == "title")
+            {
+                keepFirst(titleEl, el);
+            }
+            else if (name == "link")
+            {
+                keepFirst(linkEl, el);
+            }
+            else if (name == "description")
+            {
+                keepFirst(descriptionEl, el);
+            }
+            else if (isElementNS(el, contentNamespace, "encoded"))
+            {
+                keepFirst(contentEncodedEl, el);
+            }
+            else if (isElementNS(el, dublinCoreNamespace, "creator"))
+            {
+                keepFirst(creatorEl, el);
+            }
+            else if (isElementNS(el, dublinCoreNamespace, "date"))
+            {
+                keepFirst(dateEl, el);
+            }
+        }
 
         Item item;
-        item.title = fetchNodeValue(itemNode, "title");
-        item.link = fetchNodeValue(itemNode, "link");
-        item.content = fetchNodeValueInnerXML(itemNode, "description");
+        item.title = innerText(titleEl);
+        item.link = innerText(linkEl);
+        item.content = innerXML(descriptionEl);
 
         // see if there's a content:encoded with more information present, if so, replace the body of the text with that
-        auto contentEncodedNode = itemNode->getNodeByPathNS("content:encoded", nsMap);
-        if (contentEncodedNode != nullptr)
+        if (contentEncodedEl != nullptr)
         {
-            item.content = contentEncodedNode->innerText();
+            item.content = contentEncodedEl->innerText();
         }
 
         // create a guid out of the link if present, or either title or description (all are optional, but either title or description must be present)
@@ -124,27 +158,33 @@ std::vector<ZapFR::Engine::FeedParser::Item> ZapFR::Engine::FeedParserRSS10::ite
         ds.close();
         item.guid = Poco::DigestEngine::digestToHex(md5.digest());
 
-        auto creatorNode = itemNode->getNodeByPathNS("dc:creator", nsMap);
-        if (creatorNode != nullptr)
+        if (creatorEl != nullptr)
         {
-            item.author = creatorNode->innerText();
+            item.author = creatorEl->innerText();
         }
 
-        auto dateNode = itemNode->getNodeByPathNS("dc:date", nsMap);
-        if (dateNode != nullptr)
+        if (dateEl != nullptr)
         {
-            item.datePublished = dateNode->innerText();
-            int tzDiff;
-            Poco::DateTime parsedDate;
-            if (Poco::DateTimeParser::tryParse(Poco::DateTimeFormat::ISO8601_FORMAT, item.datePublished, parsedDate, tzDiff))
+            item.datePublished = dateEl->innerText();
+            auto normalizedDate = DateParser::normalize(item.datePublished);
+            if (normalizedDate.has_value())
             {
-                parsedDate.makeUTC(tzDiff);
-                item.datePublished = Poco::DateTimeFormatter::format(parsedDate, Poco::DateTimeFormat::ISO8601_FORMAT);
+                item.datePublished = std::move(normalizedDate.value());
             }
         }
-        items.emplace_back(item);
+        items.emplace_back(std::move(item));
     }
-    itemList->release();
 
     return items;
 }
+
+ZapFR::Engine::FeedParser::RefreshHints ZapFR::Engine::FeedParserRSS10::refreshHints() const
+{
+    RefreshHints hints;
+    auto channel = mXMLDoc->documentElement()->getNodeByPath("/channel");
+    if (channel != nullptr)
+    {
+        hints.updatePeriod = fetchSyndicationUpdatePeriod(channel);
+    }
+    return hints;
+}
@@ -0,0 +1,279 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include <Poco/DOM/NodeList.h>
+#include <Poco/DigestStream.h>
+#include <Poco/MD5Engine.h>
+#include <Poco/String.h>
+#include <Poco/UUIDGenerator.h>
+
+#include "ZapFR/DateParser.h"
+#include "FeedParserRSS20.h"
+
+ZapFR::Engine::FeedParserRSS20::FeedParserRSS20(const std::string& url) : FeedParserXML(url)
+{
+}
+
+std::string ZapFR::Engine::FeedParserRSS20::guid() const
+{
+    return "";
+}
+
+std::string ZapFR::Engine::FeedParserRSS20::title() const
+{
+    return fetchNodeValue("/channel/title");
+}
+
+std::string ZapFR::Engine::FeedParserRSS20::subtitle() const
+{
+    return "";
+}
+
+std::string ZapFR::Engine::FeedParserRSS20::link() const
+{
+    return fetchNodeValue("/channel/link");
+}
+
+std::string ZapFR::Engine::FeedParserRSS20::description() const
+{
+    return fetchNodeValue("/channel/description");
+}
+
+std::string ZapFR::Engine::FeedParserRSS20::language() const
+{
+    return fetchNodeValue("/channel/language");
+}
+
+std::string ZapFR::Engine::FeedParserRSS20::copyright() const
+{
+    return fetchNodeValue("/channel/copyright");
+}
+
+std::string ZapFR::Engine::FeedParserRSS20::iconURL() const
+{
+    return fetchNodeValue("/channel/image/url");
+}
+
+std::vector<ZapFR::Engine::FeedParser::Item> ZapFR::Engine::FeedParserRSS20::items() const
+{
+    static const std::string contentNamespace{"http://purl.org/rss/1.0/modules/content/"};
+    static const std::string torrentNamespace{"http://xmlns.ezrss.it/0.1/"};
+
+    std::vector<Item> items;
+    for (auto itemEl : elementsByTagName("item"))
+    {
+        Item item;
+
+        // walk the item once; the fields come from the first direct child with that name, enclosures and categories from anywhere below the item
+        Poco::XML::Element* titleEl{nullptr};
+        Poco::XML::Element* linkEl{nullptr};
+        Poco::XML::Element* authorEl{nullptr};
+        Poco::XML::Element* descriptionEl{nullptr};
+        Poco::XML::Element* contentEncodedEl{nullptr};
+        Poco::XML::Element* magnetURIEl{nullptr};
+        Poco::XML::Element* contentLengthEl{nullptr};
+        Poco::XML::Element* commentsEl{nullptr};
+        Poco::XML::Element* guidEl{nullptr};
+        Poco::XML::Element* pubDateEl{nullptr};
+        const auto visit = [&](Poco::XML::Element* el, size_t depth)
+        {
+            const auto& name = el->nodeName();
+            if (depth == 1)
+            {
+                if (name == "title")
+                {
+                    keepFirst(titleEl, el);
+                }
+                else if (name == "link")
+                {
+                    keepFirst(linkEl, el);
+                }
+                else if (name == "author")
+                {
+                    keepFirst(authorEl, el);
+                }
+                else if (name == "description")
+                {
+                    keepFirst(descriptionEl, el);
+                }
+                else if (name == "comments")
+                {
+                    keepFirst(commentsEl, el);
+                }
+                else if (name == "guid")
+                {
+                    keepFirst(guidEl, el);
+                }
+                else if (name == "pubDate")
+                {
+                    keepFirst(pubDateEl, el);
+                }
+                else if (isElementNS(el, contentNamespace, "encoded"))
+                {
+                    keepFirst(contentEncodedEl, el);
+                }
+                else if (isElementNS(el, torrentNamespace, "magnetURI"))
+                {
+                    keepFirst(magnetURIEl, el);
+                }
+                else if (isElementNS(el, torrentNamespace, "contentLength"))
+                {
+                    keepFirst(contentLengthEl, el);
+                }
+            }
+
+            if (name == "enclosure")
+            {
+                Post::Enclosure e;
+                e.url = el->hasAttribute("url") ? el->getAttribute("url") : "";
+                e.mimeType = el->hasAttribute("type") ? el->getAttribute("type") : "";
+                if (el->hasAttribute("length"))
+                {
+                    auto sizeStr = el->getAttribute("length");
+                    Poco::NumberParser::tryParseUnsigned64(sizeStr, e.size);
+                }
+                item.enclosures.emplace_back(e);
+            }
+            else if (name == "category")
+            {
+                item.categories.emplace_back(el->innerText());
+            }
+        };
+        forEachDescendantElement(itemEl, visit);
+
+        item.title = innerText(titleEl);
+        item.link = innerText(linkEl);
+        item.author = innerText(authorEl);
+        item.content = innerXML(descriptionEl);
+
+        // see if there's a content:encoded with more information present, if so, replace the body of the text with that
+        if (contentEncodedEl != nullptr)
+        {
+            item.content = contentEncodedEl->innerText();
+        }
+
+        // see if there's a torrent:magnetURI and torrent:contentLength present, if so, add that as an enclosure
+        auto magnetURI = innerText(magnetURIEl);
+        if (!magnetURI.empty())
+        {
+            Post::Enclosure e;
+            e.url = magnetURI;
+            e.mimeType = "application/x-bittorrent";
+            Poco::NumberParser::tryParseUnsigned64(innerText(contentLengthEl), e.size);
+            item.enclosures.emplace_back(e);
+        }
+
+        item.commentsURL = innerText(commentsEl);
+
+        if (guidEl != nullptr)
+        {
+            item.guid = guidEl->innerText();
+        }
+        else
+        {
+            // create a guid out of the link if present, or either title or description (all are optional, but either title or description must be present)
+            auto guidSrc = item.link;
+            if (guidSrc.empty())
+            {
+                guidSrc = item.title;
+            }
+            if (guidSrc.empty())
+            {
+                guidSrc = item.content;
+            }
+            if (guidSrc.empty()) // shouldn't happen, but just in case, use a random uuid
+            {
+                guidSrc = Poco::UUIDGenerator::defaultGenerator().createRandom().toString();
+            }
+
+            Poco::MD5Engine md5;
+            Poco::DigestOutputStream ds(md5);
+            ds << guidSrc;
+            ds.close();
+            item.guid = Poco::DigestEngine::digestToHex(md5.digest());
+        }
+
+        if (item.link.empty() && item.guid.starts_with("http"))
+        {
+            item.link = item.guid;
+        }
+
+        item.datePublished = DateParser::normalize(innerText(pubDateEl)).value_or("");
+
+        items.emplace_back(std::move(item));
+    }
+
+    return items;
+}
+
+ZapFR::Engine::FeedParser::WebSubLinks ZapFR::Engine::FeedParserRSS20::webSubLinks() const
+{
+    return fetchWebSubLinks(mXMLDoc->documentElement()->getNodeByPath("/channel"));
+}
+
+ZapFR::Engine::FeedParser::RefreshHints ZapFR::Engine::FeedParserRSS20::refreshHints() const
+{
+    RefreshHints hints;
+    auto channel = mXMLDoc->documentElement()->getNodeByPath("/channel");
+    if (channel == nullptr)
+    {
+        return hints;
+    }
+
+    uint64_t ttlInMinutes{0};
+    if (Poco::NumberParser::tryParseUnsigned64(Poco::trim(fetchNodeValue(channel, "ttl")), ttlInMinutes) && ttlInMinutes > 0)
+    {
+        hints.ttl = ttlInMinutes * 60;
+    }
+    hints.updatePeriod = fetchSyndicationUpdatePeriod(channel);
+
+    auto skipHoursNode = fetchNode(channel, "skipHours");
+    if (skipHoursNode != nullptr)
+    {
+        auto hourNodes = dynamic_cast<Poco::XML::Element*>(skipHoursNode)->getElementsByTagName("hour");
+        for (size_t i = 0; i < hourNodes->length(); ++i)
+        {
+            uint64_t hour{0};
+            if (Poco::NumberParser::tryParseUnsigned64(Poco::trim(hourNodes->item(i)->innerText()), hour))
+            {
+                hints.skipHours.set(hour % 24); // some feeds use 1-24 instead of 0-23
+            }
+        }
+        hourNodes->release();
+    }
+
+    auto skipDaysNode = fetchNode(channel, "skipDays");
+    if (skipDaysNode != nullptr)
+    {
+        static const std::vector<std::string> dayNames{"sunday", "monday", "tuesday", "wednesday", "thursday", "friday", "saturday"};
+        auto dayNodes = dynamic_cast<Poco::XML::Element*>(skipDaysNode)->getElementsByTagName("day");
+        for (size_t i = 0; i < dayNodes->length(); ++i)
+        {
+            auto it = std::find(dayNames.begin(), dayNames.end(), Poco::toLower(Poco::trim(dayNodes->item(i)->innerText())));
+            if (it != dayNames.end())
+            {
+                hints.skipDays.set(static_cast<size_t>(std::distance(dayNames.begin(), it)));
+            }
+        }
+        dayNodes->release();
+    }
+
+    return hints;
+}
@@ -0,0 +1,204 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <unordered_map>
+
+#include <Poco/DOM/DOMWriter.h>
+#include <Poco/DOM/Element.h>
+#include <Poco/NumberParser.h>
+#include <Poco/String.h>
+#include <Poco/XML/XMLWriter.h>
+
+#include "ZapFR/Helpers.h"
+#include "FeedParserXML.h"
+
+ZapFR::Engine::FeedParserXML::FeedParserXML(const std::string& url) : FeedParser(url)
+{
+}
+
+std::string ZapFR::Engine::FeedParserXML::fetchNodeValue(const std::string& nodeName) const
+{
+    return cachedFeedField(nodeName, [&]() { return innerText(mXMLDoc->documentElement()->getNodeByPath(nodeName)); });
+}
+
+std::string ZapFR::Engine::FeedParserXML::fetchNodeValue(Poco::XML::Node* parent, const std::string& nodeName) const
+{
+    auto node = parent->getNodeByPath(nodeName);
+    if (node != nullptr)
+    {
+        return node->innerText();
+    }
+    return "";
+}
+
+std::string ZapFR::Engine::FeedParserXML::fetchNodeValueNS(Poco::XML::Node* parent, const std::string& nodeName, const Poco::XML::Node::NSMap& nsMap) const
+{
+    auto node = parent->getNodeByPathNS(nodeName, nsMap);
+    if (node != nullptr)
+    {
+        return node->innerText();
+    }
+    return "";
+}
+
+std::string ZapFR::Engine::FeedParserXML::innerXML(Poco::XML::Node* node) const
+{
+    if (node == nullptr)
+    {
+        return "";
+    }
+
+    std::stringstream ss;
+    auto writer = Poco::XML::DOMWriter();
+    writer.setOptions(Poco::XML::XMLWriter::CANONICAL_XML);
+    for (auto child = node->firstChild(); child != nullptr; child = child->nextSibling())
+    {
+        auto childType = child->nodeType();
+        if (childType == Poco::XML::Node::ELEMENT_NODE)
+        {
+            writer.writeNode(ss, child);
+        }
+        else if (childType == Poco::XML::Node::CDATA_SECTION_NODE || childType == Poco::XML::Node::TEXT_NODE)
+        {
+            ss << child->innerText();
+        }
+    }
+    return ss.str();
+}
+
+Poco::XML::Node* ZapFR::Engine::FeedParserXML::fetchNode(Poco::XML::Node* parent, const std::string& nodeName) const
+{
+    return parent->getNodeByPath(nodeName);
+}
+
+std::optional<uint64_t> ZapFR::Engine::FeedParserXML::fetchSyndicationUpdatePeriod(Poco::XML::Node* channel) const
+{
+    Poco::XML::Element::NSMap nsMap;
+    nsMap.declarePrefix("sy", "http://purl.org/rss/1.0/modules/syndication/");
+
+    static const std::unordered_map<std::string, uint64_t> periods{
+        {"hourly", 60 * 60}, {"daily", 24 * 60 * 60}, {"weekly", 7 * 24 * 60 * 60}, {"monthly", 30 * 24 * 60 * 60}, {"yearly", 365 * 24 * 60 * 60}};
+
+    auto period = Poco::toLower(Poco::trim(fetchNodeValueNS(channel, "sy:updatePeriod", nsMap)));
+    auto it = periods.find(period);
+    if (it == periods.end())
+    {
+        return {};
+    }
+
+    uint64_t frequency{1};
+    Poco::NumberParser::tryParseUnsigned64(Poco::trim(fetchNodeValueNS(channel, "sy:updateFrequency", nsMap)), frequency);
+    return it->second / std::max(frequency, static_cast<uint64_t>(1));
+}
+
+ZapFR::Engine::FeedParser::WebSubLinks ZapFR::Engine::FeedParserXML::fetchWebSubLinks(Poco::XML::Node* parent) const
+{
+    // both Atom feeds and RSS feeds (through the atom namespace) advertise the hub as <link rel="hub">, next to a <link rel="self">
+    static const std::string atomNamespace{"http://www.w3.org/2005/Atom"};
+
+    WebSubLinks links;
+    if (parent == nullptr)
+    {
+        return links;
+    }
+
+    for (auto child = parent->firstChild(); child != nullptr; child = child->nextSibling())
+    {
+        if (child->nodeType() != Poco::XML::Node::ELEMENT_NODE || child->localName() != "link" || child->namespaceURI() != atomNamespace)
+        {
+            continue;
+        }
+
+        auto linkEl = dynamic_cast<Poco::XML::Element*>(child);
+        auto href = Poco::trim(linkEl->getAttribute("href"));
+        if (href.empty())
+        {
+            continue;
+        }
+
+        std::vector<std::string> rels;
+        Helpers::splitString(Poco::toLower(linkEl->getAttribute("rel")), ' ', rels);
+        for (const auto& rel : rels)
+        {
+            if (rel == "hub" && links.hub.empty())
+            {
+                links.hub = href;
+            }
+            else if (rel == "self" && links.self.empty())
+            {
+                links.self = href;
+            }
+        }
+    }
+    return links;
+}
+
+const std::string& ZapFR::Engine::FeedParserXML::cachedFeedField(const std::string& key, const std::function<std::string()>& lookup) const
+{
+    auto it = mFeedFieldCache.find(key);
+    if (it == mFeedFieldCache.end())
+    {
+        it = mFeedFieldCache.emplace(key, lookup()).first;
+    }
+    return it->second;
+}
+
+void ZapFR::Engine::FeedParserXML::forEachDescendantElement(Poco::XML::Node* parent, const std::function<void(Poco::XML::Element*, size_t)>& visitor)
+{
+    size_t depth{1};
+    auto node = parent->firstChild();
+    while (node != nullptr)
+    {
+        if (node->nodeType() == Poco::XML::Node::ELEMENT_NODE)
+        {
+            visitor(static_cast<Poco::XML::Element*>(node), depth);
+            if (node->hasChildNodes())
+            {
+                node = node->firstChild();
+                ++depth;
+                continue;
+            }
+        }
+
+        while (node->nextSibling() == nullptr)
+        {
+            node = node->parentNode();
+            --depth;
+            if (node == parent)
+            {
+                return;
+            }
+        }
+        node = node->nextSibling();
+    }
+}
+
+std::vector<Poco::XML::Element*> ZapFR::Engine::FeedParserXML::elementsByTagName(const std::string& tagName) const
+{
+    // Poco's NodeList from getElementsByTagName searches from the start of the document on every item() call, which is quadratic over a whole feed
+    std::vector<Poco::XML::Element*> elements;
+    forEachDescendantElement(mXMLDoc.get(),
+                             [&](Poco::XML::Element* element, size_t)
+                             {
+                                 if (element->nodeName() == tagName)
+                                 {
+                                     elements.emplace_back(element);
+                                 }
+                             });
+    return elements;
+}
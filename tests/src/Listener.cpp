@@ -27,6 +27,7 @@
 
 #include "Daemon.h"
 #include "ZapFR/Database.h"
+#include "ZapFR/feed_handling/FeedDiscovery.h"
 #include "ZapFR/local/SourceLocal.h"
 
 CATCH_REGISTER_LISTENER(ZapFR::Tests::TestRunListener)
@@ -39,6 +40,7 @@ void ZapFR::Tests::TestRunListener::testRunStarting(Catch::TestRunInfo const&)
 
 void ZapFR::Tests::TestRunListener::testRunEnded(Catch::TestRunStats const&)
 {
+    ZapFR::Engine::FeedDiscovery::joinAll();
     mRunServer = false;
     mServerThread.join();
     if (!mTemporaryDirectory.empty())
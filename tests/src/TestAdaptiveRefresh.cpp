@@ -0,0 +1,96 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <set>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ZapFR/AdaptiveRefresh.h"
+#include "ZapFR/AutoRefresh.h"
+
+using AdaptiveRefresh = ZapFR::Engine::AdaptiveRefresh;
+
+TEST_CASE("Adaptive refresh - posting frequency", "[adaptiverefresh]")
+{
+    Poco::DateTime now(2023, 10, 4, 12, 0, 0); // a Wednesday
+
+    // no history: the default interval
+    AdaptiveRefresh::Input input;
+    input.defaultInterval = 900;
+    REQUIRE(AdaptiveRefresh::calculateInterval(input, now) == 900);
+
+    // a post every hour, the latest one just now: poll every half hour
+    for (auto i = 0; i < 10; ++i)
+    {
+        input.postDates.emplace_back((now - Poco::Timespan(0, i, 0, 0, 0)).timestamp());
+    }
+    REQUIRE(AdaptiveRefresh::calculateInterval(input, now) == 30 * 60);
+
+    // the same feed, but quiet for two days: back off
+    auto quietInterval = AdaptiveRefresh::calculateInterval(input, now + Poco::Timespan(2, 0, 0, 0, 0));
+    REQUIRE(quietInterval == 12 * 60 * 60);
+
+    // a post every minute is clamped to the minimum interval
+    input.postDates.clear();
+    for (auto i = 0; i < 10; ++i)
+    {
+        input.postDates.emplace_back((now - Poco::Timespan(0, 0, i, 0, 0)).timestamp());
+    }
+    REQUIRE(AdaptiveRefresh::calculateInterval(input, now) == AdaptiveRefresh::MinInterval);
+}
+
+TEST_CASE("Adaptive refresh - feed and HTTP hints", "[adaptiverefresh]")
+{
+    Poco::DateTime now(2023, 10, 4, 12, 0, 0); // a Wednesday
+
+    AdaptiveRefresh::Input input;
+    input.defaultInterval = 900;
+    input.freshnessLifetime = 3600;
+    REQUIRE(AdaptiveRefresh::calculateInterval(input, now) == 3600);
+
+    input.hints.ttl = 2 * 3600;
+    REQUIRE(AdaptiveRefresh::calculateInterval(input, now) == 2 * 3600);
+
+    // 14:00 and 15:00 UTC are skipped, so the check moves to 16:00
+    input.hints.skipHours.set(14);
+    input.hints.skipHours.set(15);
+    REQUIRE(AdaptiveRefresh::calculateInterval(input, now) == 4 * 3600);
+
+    // skipping Wednesday moves it to midnight
+    input.hints.skipHours.reset();
+    input.hints.skipDays.set(3);
+    REQUIRE(AdaptiveRefresh::calculateInterval(input, now) == 12 * 3600);
+}
+
+TEST_CASE("Auto refresh - deterministic jitter", "[adaptiverefresh]")
+{
+    using AutoRefresh = ZapFR::Engine::AutoRefresh;
+
+    REQUIRE(AutoRefresh::jitter(42, 900) == AutoRefresh::jitter(42, 900));
+    REQUIRE(AutoRefresh::jitter(42, 5) == 0);
+
+    // feeds with the same interval are spread out instead of all landing on the same offset
+    std::set<uint64_t> offsets;
+    for (uint64_t feedID = 1; feedID <= 100; ++feedID)
+    {
+        auto offset = AutoRefresh::jitter(feedID, 900);
+        REQUIRE(offset < 900 / AutoRefresh::JitterDivisor);
+        offsets.insert(offset);
+    }
+    REQUIRE(offsets.size() > 50);
+}
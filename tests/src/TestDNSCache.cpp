@@ -0,0 +1,122 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <Poco/Net/HTTPCredentials.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/URI.h>
+
+#include "TestHTTPServer.h"
+#include "ZapFR/DNSCache.h"
+#include "ZapFR/Helpers.h"
+
+TEST_CASE("DNS cache - positive entries", "[dnscache]")
+{
+    auto cache = ZapFR::Engine::DNSCache::getInstance();
+    cache->clear();
+
+    // address literals never touch the cache
+    auto hits = cache->hitCount();
+    auto misses = cache->missCount();
+    REQUIRE(cache->resolve("127.0.0.1").toString() == "127.0.0.1");
+    REQUIRE(cache->hitCount() == hits);
+    REQUIRE(cache->missCount() == misses);
+
+    auto address = cache->resolve("localhost");
+    REQUIRE(address.isLoopback());
+    REQUIRE(cache->missCount() == misses + 1);
+
+    REQUIRE(cache->resolve("LocalHost") == address);
+    REQUIRE(cache->hitCount() == hits + 1);
+    REQUIRE(cache->missCount() == misses + 1);
+
+    cache->clear();
+}
+
+TEST_CASE("DNS cache - negative entries", "[dnscache]")
+{
+    auto cache = ZapFR::Engine::DNSCache::getInstance();
+    cache->clear();
+
+    auto negativeHits = cache->negativeHitCount();
+    auto misses = cache->missCount();
+    REQUIRE_THROWS(cache->resolve("nonexistent.invalid"));
+    REQUIRE(cache->missCount() == misses + 1);
+
+    REQUIRE_THROWS(cache->resolve("nonexistent.invalid"));
+    REQUIRE(cache->negativeHitCount() == negativeHits + 1);
+    REQUIRE(cache->missCount() == misses + 1);
+
+    // without a negative TTL, the failure isn't remembered
+    auto originalNegativeTTL = cache->negativeTTL();
+    cache->setNegativeTTL(0);
+    REQUIRE_THROWS(cache->resolve("nonexistent.invalid"));
+    REQUIRE_THROWS(cache->resolve("nonexistent.invalid"));
+    REQUIRE(cache->missCount() == misses + 3);
+
+    cache->setNegativeTTL(originalNegativeTTL);
+    cache->clear();
+}
+
+TEST_CASE("DNS cache - invalidated entries", "[dnscache]")
+{
+    auto cache = ZapFR::Engine::DNSCache::getInstance();
+    cache->clear();
+
+    auto misses = cache->missCount();
+    cache->resolve("localhost");
+    REQUIRE(cache->invalidate("LocalHost"));
+    REQUIRE(!cache->invalidate("localhost"));
+    REQUIRE(!cache->invalidate("127.0.0.1"));
+
+    cache->resolve("localhost");
+    REQUIRE(cache->missCount() == misses + 2);
+
+    cache->clear();
+}
+
+TEST_CASE("DNS cache - resolve again after failing to connect", "[dnscache]")
+{
+    // a port that nothing listens on anymore
+    uint16_t closedPort{0};
+    {
+        ZapFR::Tests::TestHTTPServer server;
+        closedPort = server.port();
+    }
+
+    auto cache = ZapFR::Engine::DNSCache::getInstance();
+    cache->clear();
+
+    // the cached address might be outdated, so the connection is retried once with a freshly resolved one
+    auto misses = cache->missCount();
+    Poco::URI url(fmt::format("http://localhost:{}/feed.xml", closedPort));
+    Poco::Net::HTTPCredentials creds;
+    REQUIRE_THROWS(ZapFR::Engine::Helpers::performHTTPRequest(url, Poco::Net::HTTPRequest::HTTP_GET, creds, {}));
+    REQUIRE(cache->missCount() == misses + 2);
+
+    // an address literal has nothing to resolve again, so it isn't retried
+    misses = cache->missCount();
+    url = Poco::URI(fmt::format("http://127.0.0.1:{}/feed.xml", closedPort));
+    REQUIRE_THROWS(ZapFR::Engine::Helpers::performHTTPRequest(url, Poco::Net::HTTPRequest::HTTP_GET, creds, {}));
+    REQUIRE(cache->missCount() == misses);
+
+    cache->clear();
+}
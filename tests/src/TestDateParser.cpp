@@ -0,0 +1,174 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <Poco/DateTimeFormatter.h>
+#include <Poco/DateTimeParser.h>
+
+#include "ZapFR/DateParser.h"
+
+using DateParser = ZapFR::Engine::DateParser;
+
+TEST_CASE("Parse ISO 8601 dates", "[dateparser]")
+{
+    REQUIRE(DateParser::parse("1970-01-01T00:00:00Z") == 0);
+    REQUIRE(DateParser::normalize("2023-10-05T23:57:09Z") == "2023-10-05T23:57:09Z");
+    REQUIRE(DateParser::normalize("2023-10-05T19:57:09-04:00") == "2023-10-05T23:57:09Z");
+    REQUIRE(DateParser::normalize("2023-10-05T23:57:09+0530") == "2023-10-05T18:27:09Z");
+    REQUIRE(DateParser::normalize("2023-10-05T23:57:09.123456+00:00") == "2023-10-05T23:57:09Z");
+    REQUIRE(DateParser::normalize("2023-10-05 23:57:09") == "2023-10-05T23:57:09Z"); // sqlite's datetime('now')
+    REQUIRE(DateParser::normalize("2023-10-05T23:57Z") == "2023-10-05T23:57:00Z");
+    REQUIRE(DateParser::normalize("2023-10-05") == "2023-10-05T00:00:00Z");
+    REQUIRE(DateParser::normalize("  2024-02-29T12:00:00Z\n") == "2024-02-29T12:00:00Z");
+    REQUIRE(DateParser::normalize("2023-10-05T24:00:00Z") == "2023-10-06T00:00:00Z");
+    REQUIRE(DateParser::normalize("1969-12-31T23:59:59Z") == "1969-12-31T23:59:59Z");
+}
+
+TEST_CASE("Parse RFC 822 dates", "[dateparser]")
+{
+    REQUIRE(DateParser::normalize("Thu, 05 Oct 2023 23:57:09 +0000") == "2023-10-05T23:57:09Z");
+    REQUIRE(DateParser::normalize("Thu, 5 Oct 2023 19:57:09 -0400") == "2023-10-05T23:57:09Z");
+    REQUIRE(DateParser::normalize("Thu, 05 Oct 2023 23:57:09 GMT") == "2023-10-05T23:57:09Z");
+    REQUIRE(DateParser::normalize("Thu, 05 Oct 2023 16:57:09 PDT") == "2023-10-05T23:57:09Z");
+    REQUIRE(DateParser::normalize("Fri, 06 Oct 2023 01:57:09 CEST") == "2023-10-05T23:57:09Z");
+    REQUIRE(DateParser::normalize("Thu, 05 Oct 2023 23:57:09 +0000 (UTC)") == "2023-10-05T23:57:09Z");
+    REQUIRE(DateParser::normalize("Fri, 06 Oct 2023 01:57:09 GMT+2") == "2023-10-05T23:57:09Z");
+    REQUIRE(DateParser::normalize("Sun, 8 Oct 23 10:00:00 GMT") == "2023-10-08T10:00:00Z");
+    REQUIRE(DateParser::normalize("Sun, 8 Oct 99 10:00:00 GMT") == "1999-10-08T10:00:00Z");
+    REQUIRE(DateParser::normalize("Thursday, 05 October 2023 23:57 UT") == "2023-10-05T23:57:00Z");
+    REQUIRE(DateParser::normalize("Thu,05-Oct-2023 23:57:09") == "2023-10-05T23:57:09Z");
+    REQUIRE(DateParser::normalize("05 Oct 2023") == "2023-10-05T00:00:00Z");
+    REQUIRE(DateParser::normalize("Oct 5, 2023 23:57:09 +0000") == "2023-10-05T23:57:09Z");
+}
+
+TEST_CASE("Reject dates that can't be made sense of", "[dateparser]")
+{
+    REQUIRE_FALSE(DateParser::parse("").has_value());
+    REQUIRE_FALSE(DateParser::parse("   ").has_value());
+    REQUIRE_FALSE(DateParser::parse("yesterday").has_value());
+    REQUIRE_FALSE(DateParser::parse("2023-02-29T00:00:00Z").has_value());
+    REQUIRE_FALSE(DateParser::parse("2023-13-01").has_value());
+    REQUIRE_FALSE(DateParser::parse("2023-10-05T25:00:00Z").has_value());
+    REQUIRE_FALSE(DateParser::parse("2023-10-05T23:57:09+25:00").has_value());
+    REQUIRE_FALSE(DateParser::parse("Thu, 32 Oct 2023 23:57:09 GMT").has_value());
+    REQUIRE_FALSE(DateParser::parse("Thu, 05 Foo 2023 23:57:09 GMT").has_value());
+    REQUIRE_FALSE(DateParser::parse("Thu, 05 Oct 2023 23").has_value());
+}
+
+TEST_CASE("Parse dates the same way Poco does", "[dateparser]")
+{
+    std::mt19937 rng(20231005);
+    std::uniform_int_distribution<int64_t> epochs(0, 4102444800); // up to 2100
+    std::uniform_int_distribution<int> offsets(-12 * 4, 14 * 4);  // in quarter hours
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        auto epoch = epochs(rng);
+        auto offset = offsets(rng) * 15 * 60;
+        Poco::DateTime date(Poco::Timestamp::fromEpochTime(static_cast<std::time_t>(epoch)));
+        Poco::DateTime local(Poco::Timestamp::fromEpochTime(static_cast<std::time_t>(epoch + offset)));
+
+        // what we store is what Poco writes, and that has to come back as the same moment
+        auto iso = Poco::DateTimeFormatter::format(date, Poco::DateTimeFormat::ISO8601_FORMAT);
+        REQUIRE(DateParser::formatISO8601(epoch) == iso);
+        REQUIRE(DateParser::parse(iso) == epoch);
+
+        for (const auto& format : {Poco::DateTimeFormat::RFC1123_FORMAT, Poco::DateTimeFormat::RFC822_FORMAT, Poco::DateTimeFormat::ISO8601_FORMAT,
+                                   Poco::DateTimeFormat::ISO8601_FRAC_FORMAT})
+        {
+            auto formatted = Poco::DateTimeFormatter::format(local, format, offset);
+            Poco::DateTime pocoDate;
+            int tzDiff;
+            REQUIRE(Poco::DateTimeParser::tryParse(format, formatted, pocoDate, tzDiff));
+            pocoDate.makeUTC(tzDiff);
+            REQUIRE(DateParser::parse(formatted) == pocoDate.timestamp().epochTime());
+        }
+    }
+}
+
+TEST_CASE("Parse dates with DateParser and Poco::DateTimeParser", "[.][benchmark][dateparser]")
+{
+    const std::vector<std::string> rfc822{"Thu, 05 Oct 2023 23:57:09 +0000", "Fri, 6 Oct 2023 01:57:09 +0200", "Sat, 07 Oct 2023 10:00:00 GMT",
+                                          "Sun, 08 Oct 2023 16:57:09 PDT"};
+    const std::vector<std::string> iso8601{"2023-10-05T23:57:09Z", "2023-10-05T19:57:09-04:00", "2023-10-06T01:57:09+02:00", "2023-10-05T23:57:09.123Z"};
+
+    const auto poco = [](const std::string& format, const std::vector<std::string>& dates)
+    {
+        int64_t sum{0};
+        for (const auto& date : dates)
+        {
+            Poco::DateTime parsedDate;
+            int tzDiff;
+            if (Poco::DateTimeParser::tryParse(format, date, parsedDate, tzDiff))
+            {
+                parsedDate.makeUTC(tzDiff);
+                sum += parsedDate.timestamp().epochTime();
+            }
+        }
+        return sum;
+    };
+
+    const auto dateParser = [](const std::vector<std::string>& dates)
+    {
+        int64_t sum{0};
+        for (const auto& date : dates)
+        {
+            sum += DateParser::parse(date).value_or(0);
+        }
+        return sum;
+    };
+
+    BENCHMARK("Poco: RFC 822")
+    {
+        return poco(Poco::DateTimeFormat::RFC1123_FORMAT, rfc822);
+    };
+
+    BENCHMARK("DateParser: RFC 822")
+    {
+        return dateParser(rfc822);
+    };
+
+    BENCHMARK("Poco: ISO 8601")
+    {
+        return poco(Poco::DateTimeFormat::ISO8601_FORMAT, iso8601);
+    };
+
+    BENCHMARK("DateParser: ISO 8601")
+    {
+        return dateParser(iso8601);
+    };
+
+    BENCHMARK("Poco: parse and format as ISO 8601")
+    {
+        Poco::DateTime parsedDate;
+        int tzDiff;
+        Poco::DateTimeParser::tryParse(Poco::DateTimeFormat::RFC1123_FORMAT, rfc822.at(1), parsedDate, tzDiff);
+        parsedDate.makeUTC(tzDiff);
+        return Poco::DateTimeFormatter::format(parsedDate, Poco::DateTimeFormat::ISO8601_FORMAT);
+    };
+
+    BENCHMARK("DateParser: parse and format as ISO 8601")
+    {
+        return DateParser::normalize(rfc822.at(1));
+    };
+}
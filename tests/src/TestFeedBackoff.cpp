@@ -0,0 +1,157 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <optional>
+
+#include <catch2/catch_test_macros.hpp>
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <Poco/JSON/Object.h>
+#include <Poco/Timestamp.h>
+
+#include "TestHTTPServer.h"
+#include "ZapFR/AutoRefresh.h"
+#include "ZapFR/Global.h"
+#include "ZapFR/base/Source.h"
+#include "ZapFR/local/FeedLocal.h"
+
+namespace
+{
+    static constexpr uint64_t gsRefreshInterval{60};
+
+    uint64_t epochNow()
+    {
+        return static_cast<uint64_t>(Poco::Timestamp().epochTime());
+    }
+
+    uint64_t scheduledNextRefresh(ZapFR::Engine::Source* source, uint64_t feedID)
+    {
+        for (const auto& info : ZapFR::Engine::FeedLocal::querySchedule(source))
+        {
+            if (info.feedID == feedID)
+            {
+                REQUIRE(info.nextRefresh.has_value());
+                return info.nextRefresh.value();
+            }
+        }
+        FAIL("Feed not found in the schedule");
+        return 0;
+    }
+
+    // the feed errors as the server reports them on /status, fetched through the remote source pointing at the in-process server
+    std::optional<Poco::JSON::Object::Ptr> reportedFeedError(uint64_t feedID)
+    {
+        auto remoteSource = ZapFR::Engine::Source::getSource(2);
+        REQUIRE(remoteSource.has_value());
+        auto status = remoteSource.value()->getStatus();
+        REQUIRE(status.isArray(ZapFR::Engine::JSON::SourceStatus::FeedErrors));
+        auto feedErrors = status.getArray(ZapFR::Engine::JSON::SourceStatus::FeedErrors);
+        for (size_t i = 0; i < feedErrors->size(); ++i)
+        {
+            auto feedError = feedErrors->getObject(static_cast<uint32_t>(i));
+            if (feedError->getValue<uint64_t>(ZapFR::Engine::JSON::SourceStatus::FeedID) == feedID)
+            {
+                return feedError;
+            }
+        }
+        return {};
+    }
+
+    // refreshes the feed and checks it got rescheduled delay seconds from now, give or take the feed's jitter
+    void refreshAndExpectDelay(ZapFR::Engine::Source* source, ZapFR::Engine::FeedLocal* feed, uint64_t delay)
+    {
+        auto before = epochNow();
+        feed->refresh();
+        auto after = epochNow();
+
+        auto jitter = ZapFR::Engine::AutoRefresh::jitter(feed->id(), delay);
+        auto nextRefresh = scheduledNextRefresh(source, feed->id());
+        REQUIRE(nextRefresh >= before + delay + jitter);
+        REQUIRE(nextRefresh <= after + delay + jitter);
+    }
+} // namespace
+
+TEST_CASE("Back off from a failing feed and suspend it", "[feedrefresh]")
+{
+    ZapFR::Tests::TestHTTPServer server;
+    server.route("/feed.xml",
+                 [](const ZapFR::Tests::TestHTTPServer::Request&)
+                 {
+                     ZapFR::Tests::TestHTTPServer::Response response;
+                     response.status = Poco::Net::HTTPResponse::HTTP_INTERNAL_SERVER_ERROR;
+                     response.body = "Internal server error";
+                     return response;
+                 });
+
+    auto source = ZapFR::Engine::Source::getSource(1);
+    REQUIRE(source.has_value());
+    auto feed = ZapFR::Engine::FeedLocal::create(source.value().get(), server.url("/feed.xml"), "Failing feed", 0);
+    auto feedID = feed->id();
+    feed->updateProperties(server.url("/feed.xml"), gsRefreshInterval);
+
+    // every failure doubles the delay from the feed's refresh interval
+    for (uint64_t failures = 1; failures < ZapFR::Engine::FeedCircuitBreakerThreshold; ++failures)
+    {
+        refreshAndExpectDelay(source.value().get(), feed.get(), gsRefreshInterval << (failures - 1));
+        REQUIRE(feed->lastRefreshError().has_value());
+        REQUIRE(feed->lastRefreshError().value().starts_with("HTTP status 500"));
+
+        auto feedError = reportedFeedError(feedID);
+        REQUIRE(feedError.has_value());
+        REQUIRE(feedError.value()->getValue<uint64_t>(ZapFR::Engine::JSON::SourceStatus::ConsecutiveFailures) == failures);
+        REQUIRE(!feedError.value()->getValue<bool>(ZapFR::Engine::JSON::SourceStatus::Suspended));
+        REQUIRE(feedError.value()->getValue<uint64_t>(ZapFR::Engine::JSON::SourceStatus::NextAttempt) == scheduledNextRefresh(source.value().get(), feedID));
+    }
+
+    // the circuit breaker trips, from now on the feed is only probed once per MaxFeedBackoffDelay
+    for (uint64_t failures = ZapFR::Engine::FeedCircuitBreakerThreshold; failures <= ZapFR::Engine::FeedCircuitBreakerThreshold + 1; ++failures)
+    {
+        refreshAndExpectDelay(source.value().get(), feed.get(), ZapFR::Engine::MaxFeedBackoffDelay);
+        REQUIRE(feed->lastRefreshError().has_value());
+        REQUIRE(feed->lastRefreshError().value().starts_with(fmt::format("Suspended after {} consecutive failures: HTTP status 500", failures)));
+
+        auto feedError = reportedFeedError(feedID);
+        REQUIRE(feedError.has_value());
+        REQUIRE(feedError.value()->getValue<uint64_t>(ZapFR::Engine::JSON::SourceStatus::ConsecutiveFailures) == failures);
+        REQUIRE(feedError.value()->getValue<bool>(ZapFR::Engine::JSON::SourceStatus::Suspended));
+        REQUIRE(feedError.value()->getValue<uint64_t>(ZapFR::Engine::JSON::SourceStatus::NextAttempt) == scheduledNextRefresh(source.value().get(), feedID));
+    }
+
+    // a successful refresh closes the circuit again and clears the error
+    server.serve("/feed.xml", "application/rss+xml", ZapFR::Tests::TestHTTPServer::rssFeed("Recovered feed"));
+    feed->refresh();
+    REQUIRE(!feed->lastRefreshError().has_value());
+    REQUIRE(!reportedFeedError(feedID).has_value());
+
+    // so the next failure starts backing off from the refresh interval all over again
+    server.route("/feed.xml",
+                 [](const ZapFR::Tests::TestHTTPServer::Request&)
+                 {
+                     ZapFR::Tests::TestHTTPServer::Response response;
+                     response.status = Poco::Net::HTTPResponse::HTTP_INTERNAL_SERVER_ERROR;
+                     return response;
+                 });
+    refreshAndExpectDelay(source.value().get(), feed.get(), gsRefreshInterval);
+    auto feedError = reportedFeedError(feedID);
+    REQUIRE(feedError.has_value());
+    REQUIRE(feedError.value()->getValue<uint64_t>(ZapFR::Engine::JSON::SourceStatus::ConsecutiveFailures) == 1);
+    REQUIRE(!feedError.value()->getValue<bool>(ZapFR::Engine::JSON::SourceStatus::Suspended));
+
+    source.value()->removeFeed(feedID);
+}
@@ -16,9 +16,14 @@
     along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include "DataFetcher.h"
+#include "TestHTTPServer.h"
 #include "ZapFR/feed_handling/FeedDiscovery.h"
 
 TEST_CASE("Feed Discovery on hackernews", "[feeddiscovery]")
@@ -173,3 +178,83 @@ TEST_CASE("Feed Discovery with throwing/invalid http request", "[feeddiscovery]"
     fd.discover();
     REQUIRE(fd.discoveredFeeds().size() == 0);
 }
+
+TEST_CASE("Feed Discovery verification keeps already verified feeds", "[feeddiscovery]")
+{
+    auto fd = ZapFR::Engine::FeedDiscovery("https://zapfeedreader.zappatic.net/unittests/rss.xml", R"(<?xml version="1.0"?><rss version="2.0"><channel></channel></rss>)");
+    fd.discover();
+    REQUIRE(fd.discoveredFeeds().size() == 1);
+    REQUIRE(fd.discoveredFeeds().at(0).verified);
+
+    std::vector<std::string> verifiedURLs;
+    fd.verify([&](const ZapFR::Engine::DiscoveredFeed& feed) { verifiedURLs.emplace_back(feed.url); });
+    REQUIRE(fd.discoveredFeeds().size() == 1);
+    REQUIRE(verifiedURLs.size() == 1);
+    REQUIRE(verifiedURLs.at(0) == "https://zapfeedreader.zappatic.net/unittests/rss.xml");
+}
+
+TEST_CASE("Feed Discovery in the background stops reporting back once aborted", "[feeddiscovery]")
+{
+    std::atomic<bool> slowProbeAnswered{false};
+    ZapFR::Tests::TestHTTPServer server;
+    server.serve("/", "text/html", R"(<html><head>
+        <link rel="alternate" type="application/rss+xml" title="Fast" href="/fast.xml" />
+        <link rel="alternate" type="application/rss+xml" title="Slow" href="/slow.xml" />
+    </head><body></body></html>)");
+    server.serve("/fast.xml", "application/rss+xml", ZapFR::Tests::TestHTTPServer::rssFeed("Fast"));
+    server.route("/slow.xml",
+                 [&](const ZapFR::Tests::TestHTTPServer::Request&)
+                 {
+                     std::this_thread::sleep_for(std::chrono::seconds(2));
+                     slowProbeAnswered = true;
+                     ZapFR::Tests::TestHTTPServer::Response response;
+                     response.headers["Content-Type"] = "application/rss+xml";
+                     response.body = ZapFR::Tests::TestHTTPServer::rssFeed("Slow");
+                     return response;
+                 });
+
+    // abort as soon as the first feed is in, while the slow one is still being probed
+    std::atomic<bool> aborted{false};
+    std::atomic<size_t> verifiedCount{0};
+    std::atomic<bool> finishedCalled{false};
+    std::promise<std::string> firstVerifiedURL;
+    ZapFR::Engine::FeedDiscovery::discoverInBackground(
+        server.url("/"),
+        [&](const ZapFR::Engine::DiscoveredFeed& feed)
+        {
+            if (verifiedCount++ == 0)
+            {
+                aborted = true;
+                firstVerifiedURL.set_value(feed.url);
+            }
+        },
+        [&](const std::vector<ZapFR::Engine::DiscoveredFeed>&) { finishedCalled = true; }, [&]() { return aborted.load(); });
+    auto firstVerified = firstVerifiedURL.get_future();
+    REQUIRE(firstVerified.wait_for(std::chrono::seconds(ZapFR::Engine::FeedDiscovery::ProbeDeadline)) == std::future_status::ready);
+    REQUIRE(firstVerified.get() == server.url("/fast.xml"));
+
+    // a probe that was underway is waited for, but nothing is reported anymore
+    ZapFR::Engine::FeedDiscovery::joinAll();
+    REQUIRE(server.requestCount("/slow.xml") == (slowProbeAnswered ? 1 : 0));
+    REQUIRE(verifiedCount == 1);
+    REQUIRE(!finishedCalled);
+}
+
+TEST_CASE("Feed Discovery sniffing of truncated documents", "[feeddiscovery]")
+{
+    using ZapFR::Engine::FeedDiscovery;
+    using ZapFR::Engine::Feed;
+
+    REQUIRE(FeedDiscovery::sniffFeedType(R"(<?xml version="1.0" encoding="UTF-8"?>)"
+                                         "\n"
+                                         R"(<rss version="2.0"><channel><title>Cut o)") == Feed::Type::RSS);
+    REQUIRE(FeedDiscovery::sniffFeedType("\xEF\xBB\xBF<!-- generator --><!DOCTYPE rdf><rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">") == Feed::Type::RSS);
+    REQUIRE(FeedDiscovery::sniffFeedType(R"(  <feed xmlns="http://www.w3.org/2005/Atom"><title>)") == Feed::Type::Atom);
+    REQUIRE(FeedDiscovery::sniffFeedType(R"({"version": "https:\/\/jsonfeed.org\/version\/1.1", "title": "Cut o)") == Feed::Type::JSON);
+    REQUIRE(FeedDiscovery::sniffFeedType(R"({"version":"https://jsonfeed.org/version/1","items":[)") == Feed::Type::JSON);
+
+    REQUIRE(!FeedDiscovery::sniffFeedType(R"(<!DOCTYPE html><html><head><title>Not a feed</title>)").has_value());
+    REQUIRE(!FeedDiscovery::sniffFeedType(R"({"name": "not a feed"})").has_value());
+    REQUIRE(!FeedDiscovery::sniffFeedType(R"(<?xml version="1.0" enc)").has_value());
+    REQUIRE(!FeedDiscovery::sniffFeedType("").has_value());
+}
@@ -74,6 +74,7 @@ TEST_CASE("Feed Fetcher - fetch valid rss from remote site", "[feedfetcher]")
 
     REQUIRE(feedParser.has_value());
     REQUIRE(feedParser.value()->type() == ZapFR::Engine::Feed::Type::RSS);
+    REQUIRE(feedFetcher.permanentRedirectURL().empty());
 }
 
 TEST_CASE("Feed Fetcher - fetch empty file from remote site", "[feedfetcher]")
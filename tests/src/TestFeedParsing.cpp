@@ -20,14 +20,86 @@
 #include <Poco/DigestStream.h>
 #include <Poco/JSON/Parser.h>
 #include <Poco/MD5Engine.h>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "DataFetcher.h"
+#include "FeedParserATOM10.h"
+#include "FeedParserJSON11.h"
+#include "FeedParserRSS10.h"
+#include "FeedParserRSS20.h"
 #include "ZapFR/feed_handling/FeedParser.h"
-#include "ZapFR/feed_handling/FeedParserATOM10.h"
-#include "ZapFR/feed_handling/FeedParserJSON11.h"
-#include "ZapFR/feed_handling/FeedParserRSS10.h"
-#include "ZapFR/feed_handling/FeedParserRSS20.h"
+#include "ZapFR/feed_handling/FeedParserJSON11OnDemand.h"
+#include "ZapFR/feed_handling/FeedParserXMLStreaming.h"
+
+void requireSameOutput(const ZapFR::Engine::FeedParser* feed, const ZapFR::Engine::FeedParser& domFeed)
+{
+    REQUIRE(feed != nullptr);
+    REQUIRE(feed->type() == domFeed.type());
+    REQUIRE(feed->guid() == domFeed.guid());
+    REQUIRE(feed->title() == domFeed.title());
+    REQUIRE(feed->subtitle() == domFeed.subtitle());
+    REQUIRE(feed->link() == domFeed.link());
+    REQUIRE(feed->description() == domFeed.description());
+    REQUIRE(feed->iconURL() == domFeed.iconURL());
+    REQUIRE(feed->language() == domFeed.language());
+    REQUIRE(feed->copyright() == domFeed.copyright());
+
+    auto items = feed->items();
+    auto domItems = domFeed.items();
+    REQUIRE(items.size() == domItems.size());
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        const auto& item = items.at(i);
+        const auto& domItem = domItems.at(i);
+        REQUIRE(item.title == domItem.title);
+        REQUIRE(item.link == domItem.link);
+        REQUIRE(item.content == domItem.content);
+        REQUIRE(item.author == domItem.author);
+        REQUIRE(item.commentsURL == domItem.commentsURL);
+        REQUIRE(item.datePublished == domItem.datePublished);
+        REQUIRE(item.thumbnail == domItem.thumbnail);
+        REQUIRE(item.categories == domItem.categories);
+        if (!item.link.empty() || !item.title.empty() || !item.content.empty()) // otherwise both parsers made up a random guid
+        {
+            REQUIRE(item.guid == domItem.guid);
+        }
+
+        REQUIRE(item.enclosures.size() == domItem.enclosures.size());
+        for (size_t j = 0; j < item.enclosures.size(); ++j)
+        {
+            REQUIRE(item.enclosures.at(j).url == domItem.enclosures.at(j).url);
+            REQUIRE(item.enclosures.at(j).mimeType == domItem.enclosures.at(j).mimeType);
+            REQUIRE(item.enclosures.at(j).size == domItem.enclosures.at(j).size);
+        }
+    }
+
+    auto hints = feed->refreshHints();
+    auto domHints = domFeed.refreshHints();
+    REQUIRE(hints.ttl == domHints.ttl);
+    REQUIRE(hints.updatePeriod == domHints.updatePeriod);
+    REQUIRE(hints.skipHours == domHints.skipHours);
+    REQUIRE(hints.skipDays == domHints.skipDays);
+
+    auto webSubLinks = feed->webSubLinks();
+    auto domWebSubLinks = domFeed.webSubLinks();
+    REQUIRE(webSubLinks.hub == domWebSubLinks.hub);
+    REQUIRE(webSubLinks.self == domWebSubLinks.self);
+}
+
+// the streaming parsers must produce exactly what the DOM parsers produce for the same document
+void requireStreamingParserMatches(const ZapFR::Engine::FeedParser& domFeed, const std::string& input)
+{
+    auto feed = ZapFR::Engine::FeedParserXMLStreaming::parse(input, "https://example.com");
+    requireSameOutput(feed.get(), domFeed);
+}
+
+// and the on-demand JSON parser exactly what the one working on the Poco::JSON object tree produces
+void requireOnDemandParserMatches(const ZapFR::Engine::FeedParser& domFeed, const std::string& input)
+{
+    auto feed = ZapFR::Engine::FeedParserJSON11OnDemand::parse(input, "https://example.com");
+    requireSameOutput(feed.get(), domFeed);
+}
 
 TEST_CASE("Parse ATOM 1.0 (Daring Fireball)", "[feedparsing]")
 {
@@ -60,6 +132,8 @@ TEST_CASE("Parse ATOM 1.0 (Daring Fireball)", "[feedparsing]")
     REQUIRE(item.commentsURL == "");
     REQUIRE(item.datePublished == "2023-10-05T23:57:09Z");
     REQUIRE(item.thumbnail == "");
+
+    requireStreamingParserMatches(*feed, input);
 }
 
 TEST_CASE("Parse ATOM 1.0 (YouTube @cppweekly)", "[feedparsing]")
@@ -93,6 +167,8 @@ TEST_CASE("Parse ATOM 1.0 (YouTube @cppweekly)", "[feedparsing]")
     REQUIRE(item.commentsURL == "");
     REQUIRE(item.datePublished == "2024-01-17T16:29:54Z");
     REQUIRE(item.thumbnail == "https://i1.ytimg.com/vi/46Czrc2Uwvc/hqdefault.jpg");
+
+    requireStreamingParserMatches(*feed, input);
 }
 
 TEST_CASE("Parse ATOM 1.0 (custom example)", "[feedparsing]")
@@ -131,6 +207,8 @@ TEST_CASE("Parse ATOM 1.0 (custom example)", "[feedparsing]")
 
     item = items.at(2);
     REQUIRE(Poco::trim(item.content).starts_with("<p>")); // TODO: this needs looking at, the <p> is added by us, but not sure whether content should be tag-stripped or not
+
+    requireStreamingParserMatches(*feed, input);
 }
 
 TEST_CASE("Parse JSON 1.1 (Daring Fireball)", "[feedparsing]")
@@ -166,6 +244,8 @@ TEST_CASE("Parse JSON 1.1 (Daring Fireball)", "[feedparsing]")
     REQUIRE(item.commentsURL == "");
     REQUIRE(item.datePublished == "2023-10-05T23:57:09Z");
     REQUIRE(item.thumbnail == "");
+
+    requireOnDemandParserMatches(*feed, input);
 }
 
 TEST_CASE("Parse JSON 1.1 (custom example)", "[feedparsing]")
@@ -196,6 +276,8 @@ TEST_CASE("Parse JSON 1.1 (custom example)", "[feedparsing]")
     REQUIRE(item.datePublished == "2023-10-05T23:57:08Z");
     REQUIRE(item.categories.size() == 2);
     REQUIRE(item.categories.at(0) == "tag1");
+
+    requireOnDemandParserMatches(*feed, input);
 }
 
 TEST_CASE("Parse JSON 1.1 (custom example 2)", "[feedparsing]")
@@ -217,6 +299,8 @@ TEST_CASE("Parse JSON 1.1 (custom example 2)", "[feedparsing]")
 
     const auto& item = items.at(0);
     REQUIRE(item.author == "Overriding author");
+
+    requireOnDemandParserMatches(*feed, input);
 }
 
 TEST_CASE("Parse JSON 1.1 (custom example 3)", "[feedparsing]")
@@ -236,6 +320,17 @@ TEST_CASE("Parse JSON 1.1 (custom example 3)", "[feedparsing]")
 
     const auto& item = items.at(0);
     REQUIRE(item.author == "");
+
+    requireOnDemandParserMatches(*feed, input);
+}
+
+TEST_CASE("Parse JSON 1.1 (unicode escapes)", "[feedparsing]")
+{
+    // a high surrogate followed by an escape that isn't a low surrogate must leave that escape intact
+    const std::string input{R"({"version": "https://jsonfeed.org/version/1.1", "title": "\uD83D\uDE00 \uD800\u0041 \uDC00\u00e9 \uD800", "items": []})"};
+
+    auto feed = ZapFR::Engine::FeedParserJSON11OnDemand::parse(input, "https://example.com");
+    REQUIRE(feed->title() == "\xF0\x9F\x98\x80 \xEF\xBF\xBD" "A \xEF\xBF\xBD\xC3\xA9 \xEF\xBF\xBD");
 }
 
 std::string md5Hash(const std::string& input)
@@ -279,6 +374,8 @@ TEST_CASE("Parse RSS 1.0 (Slashdot)", "[feedparsing]")
     REQUIRE(item.commentsURL == "");
     REQUIRE(item.datePublished == "2023-10-03T13:00:00Z");
     REQUIRE(item.thumbnail == "");
+
+    requireStreamingParserMatches(*feed, input);
 }
 
 TEST_CASE("Parse RSS 1.0 (custom example)", "[feedparsing]")
@@ -307,6 +404,8 @@ TEST_CASE("Parse RSS 1.0 (custom example)", "[feedparsing]")
 
     const auto& item3 = items.at(2);
     REQUIRE(!item3.guid.empty());
+
+    requireStreamingParserMatches(*feed, input);
 }
 
 TEST_CASE("Parse RSS 2.0 (Hackernews)", "[feedparsing]")
@@ -340,6 +439,8 @@ TEST_CASE("Parse RSS 2.0 (Hackernews)", "[feedparsing]")
     REQUIRE(item.commentsURL == "https://news.ycombinator.com/item?id=37785300");
     REQUIRE(item.datePublished == "2023-10-05T22:59:44Z");
     REQUIRE(item.thumbnail == "");
+
+    requireStreamingParserMatches(*feed, input);
 }
 
 TEST_CASE("Parse RSS 2.0 (custom example)", "[feedparsing]")
@@ -385,4 +486,62 @@ TEST_CASE("Parse RSS 2.0 (custom example)", "[feedparsing]")
     REQUIRE(item6.guid == "http://example.com/guid");
     REQUIRE(item6.categories.size() == 2);
     REQUIRE(item6.categories.at(0) == "cat1");
+
+    requireStreamingParserMatches(*feed, input);
+}
+
+TEST_CASE("Parse XML feeds through the DOM and streaming parsers", "[.][benchmark][feedparsing]")
+{
+    const auto& atomInput = ZapFR::Tests::DataFetcher::fetch(ZapFR::Tests::DataFetcher::Source::Input, "FeedATOM10DaringFireball.xml");
+    const auto& rssInput = ZapFR::Tests::DataFetcher::fetch(ZapFR::Tests::DataFetcher::Source::Input, "FeedRSS20Hackernews.xml");
+
+    BENCHMARK("DOM: ATOM 1.0 (Daring Fireball, 48 entries)")
+    {
+        Poco::XML::DOMParser parser;
+        Poco::AutoPtr<Poco::XML::Document> xmlDoc = parser.parseString(atomInput);
+        auto feed = std::make_unique<ZapFR::Engine::FeedParserATOM10>("https://example.com");
+        feed->setXMLDoc(xmlDoc);
+        return feed->title().size() + feed->link().size() + feed->items().size();
+    };
+
+    BENCHMARK("DOM: RSS 2.0 (Hackernews, 30 items)")
+    {
+        Poco::XML::DOMParser parser;
+        Poco::AutoPtr<Poco::XML::Document> xmlDoc = parser.parseString(rssInput);
+        auto feed = std::make_unique<ZapFR::Engine::FeedParserRSS20>("https://example.com");
+        feed->setXMLDoc(xmlDoc);
+        return feed->title().size() + feed->link().size() + feed->items().size();
+    };
+
+    BENCHMARK("Streaming: ATOM 1.0 (Daring Fireball, 48 entries)")
+    {
+        auto feed = ZapFR::Engine::FeedParserXMLStreaming::parse(atomInput, "https://example.com");
+        return feed->title().size() + feed->link().size() + feed->items().size();
+    };
+
+    BENCHMARK("Streaming: RSS 2.0 (Hackernews, 30 items)")
+    {
+        auto feed = ZapFR::Engine::FeedParserXMLStreaming::parse(rssInput, "https://example.com");
+        return feed->title().size() + feed->link().size() + feed->items().size();
+    };
+}
+
+TEST_CASE("Parse JSON feeds through the object tree and on-demand parsers", "[.][benchmark][feedparsing]")
+{
+    const auto& input = ZapFR::Tests::DataFetcher::fetch(ZapFR::Tests::DataFetcher::Source::Input, "FeedJSON11DaringFireball.json");
+
+    BENCHMARK("Object tree: JSON 1.1 (Daring Fireball, 48 items)")
+    {
+        Poco::JSON::Parser parser;
+        auto root = parser.parse(input);
+        auto feed = std::make_unique<ZapFR::Engine::FeedParserJSON11>("https://example.com");
+        feed->setRootObj(root.extract<Poco::JSON::Object::Ptr>());
+        return feed->title().size() + feed->link().size() + feed->items().size();
+    };
+
+    BENCHMARK("On-demand: JSON 1.1 (Daring Fireball, 48 items)")
+    {
+        auto feed = ZapFR::Engine::FeedParserJSON11OnDemand::parse(input, "https://example.com");
+        return feed->title().size() + feed->link().size() + feed->items().size();
+    };
 }
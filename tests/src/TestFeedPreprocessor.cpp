@@ -0,0 +1,189 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "DataFetcher.h"
+#include "ZapFR/feed_handling/FeedFetcher.h"
+#include "ZapFR/feed_handling/FeedParser.h"
+#include "ZapFR/feed_handling/FeedPreprocessor.h"
+
+using FeedPreprocessor = ZapFR::Engine::FeedPreprocessor;
+
+namespace
+{
+    std::string prepareStreamed(const std::string& input, size_t chunkSize)
+    {
+        std::istringstream source(input.substr(FeedPreprocessor::significantOffset(input)));
+        FeedPreprocessor::StreamBuffer buffer(source, chunkSize);
+        std::istream prepared(&buffer);
+        return std::string(std::istreambuf_iterator<char>(prepared), {});
+    }
+} // namespace
+
+TEST_CASE("Sniff the feed format past byte order marks and whitespace", "[preprocessing]")
+{
+    REQUIRE(FeedPreprocessor::sniff("") == FeedPreprocessor::Format::Unknown);
+    REQUIRE(FeedPreprocessor::sniff(" \r\n\t") == FeedPreprocessor::Format::Unknown);
+    REQUIRE(FeedPreprocessor::sniff("<rss/>") == FeedPreprocessor::Format::XML);
+    REQUIRE(FeedPreprocessor::sniff("\xEF\xBB\xBF\n  <rss/>") == FeedPreprocessor::Format::XML);
+    REQUIRE(FeedPreprocessor::sniff(std::string_view("\xFF\xFE<\0", 4)) == FeedPreprocessor::Format::XML);
+    REQUIRE(FeedPreprocessor::sniff("\n{\"version\": \"\"}") == FeedPreprocessor::Format::JSON);
+    REQUIRE(FeedPreprocessor::sniff("<html") == FeedPreprocessor::Format::XML);
+    REQUIRE(FeedPreprocessor::sniff("Not found") == FeedPreprocessor::Format::Unknown);
+    REQUIRE(FeedPreprocessor::significantOffset("\xEF\xBB\xBF  <rss/>") == 5);
+
+    std::istringstream stream("\xEF\xBB\xBF\r\n<rss/>");
+    REQUIRE(FeedPreprocessor::sniff(stream) == FeedPreprocessor::Format::XML);
+    REQUIRE(stream.peek() == '<');
+
+    const auto& input = ZapFR::Tests::DataFetcher::fetch(ZapFR::Tests::DataFetcher::Source::Input, "FeedRSS20Hackernews.xml");
+    auto padded = std::string("\xEF\xBB\xBF\n\n") + input;
+    auto feedFetcher = ZapFR::Engine::FeedFetcher();
+    auto feed = feedFetcher.parseString(padded, "https://news.ycombinator.com/rss");
+    REQUIRE(feed != nullptr);
+    REQUIRE(feed->items().size() == 30);
+
+    std::istringstream paddedStream(padded);
+    feed = feedFetcher.parseStream(paddedStream, "https://news.ycombinator.com/rss");
+    REQUIRE(feed != nullptr);
+    REQUIRE(feed->items().size() == 30);
+}
+
+TEST_CASE("Rewrite HTML entities into character references", "[preprocessing]")
+{
+    REQUIRE(FeedPreprocessor::prepare("<a>&nbsp;&eacute;&hellip;</a>") == "<a>&#160;&#233;&#8230;</a>");
+    REQUIRE(FeedPreprocessor::prepare("<a b=\"&copy;\">&amp;&lt;&#169;&#xA9;</a>") == "<a b=\"&#169;\">&amp;&lt;&#169;&#xA9;</a>");
+    REQUIRE(FeedPreprocessor::prepare("<a>&unknown; AT&T &nbsp</a>") == "<a>&unknown; AT&T &nbsp</a>");
+    REQUIRE(FeedPreprocessor::prepare("<a><![CDATA[&nbsp;]]>&nbsp;<!-- &nbsp; --></a>") == "<a><![CDATA[&nbsp;]]>&#160;<!-- &nbsp; --></a>");
+    REQUIRE(FeedPreprocessor::prepare("<!DOCTYPE a [<!ENTITY nbsp \" \">]><a>&nbsp;</a>") == "<!DOCTYPE a [<!ENTITY nbsp \" \">]><a>&nbsp;</a>");
+
+    auto feedFetcher = ZapFR::Engine::FeedFetcher();
+    auto feed = feedFetcher.parseString("<rss version=\"2.0\"><channel><title>Caf&eacute;&nbsp;news</title><link>https://example.com</link></channel></rss>",
+                                        "https://example.com/rss");
+    REQUIRE(feed != nullptr);
+    REQUIRE(feed->title() == "Caf\xC3\xA9\xC2\xA0news");
+}
+
+TEST_CASE("Repair documents that aren't the UTF-8 they claim to be", "[preprocessing]")
+{
+    // Windows-1252 curly quotes and a Latin-1 e-acute in a document without an encoding declaration
+    REQUIRE(FeedPreprocessor::prepare("<a>\x93quoted\x94 caf\xE9</a>") == "<a>\xE2\x80\x9Cquoted\xE2\x80\x9D caf\xC3\xA9</a>");
+    REQUIRE(FeedPreprocessor::prepare("<?xml version=\"1.0\" encoding=\"UTF-8\"?><a>\xE9</a>") == "<?xml version=\"1.0\" encoding=\"UTF-8\"?><a>\xC3\xA9</a>");
+
+    // valid UTF-8 and documents in other declared charsets are left alone
+    REQUIRE(FeedPreprocessor::prepare("<a>caf\xC3\xA9 \xF0\x9F\x98\x80</a>") == "<a>caf\xC3\xA9 \xF0\x9F\x98\x80</a>");
+    REQUIRE(FeedPreprocessor::prepare("<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?><a>\xE9</a>") == "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?><a>\xE9</a>");
+
+    auto feedFetcher = ZapFR::Engine::FeedFetcher();
+    auto feed = feedFetcher.parseString("<rss version=\"2.0\"><channel><title>Caf\xE9</title><link>https://example.com</link></channel></rss>", "https://example.com/rss");
+    REQUIRE(feed != nullptr);
+    REQUIRE(feed->title() == "Caf\xC3\xA9");
+}
+
+TEST_CASE("Validate UTF-8", "[preprocessing]")
+{
+    REQUIRE(FeedPreprocessor::isValidUTF8(""));
+    REQUIRE(FeedPreprocessor::isValidUTF8("plain ascii that is long enough to fill a couple of vector registers"));
+    REQUIRE(FeedPreprocessor::isValidUTF8("\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xF4\x8F\xBF\xBF"));
+
+    // overlong, surrogate, beyond U+10FFFF, cut off and a stray continuation byte
+    REQUIRE_FALSE(FeedPreprocessor::isValidUTF8("\xC0\xAF"));
+    REQUIRE_FALSE(FeedPreprocessor::isValidUTF8("\xE0\x80\xAF"));
+    REQUIRE_FALSE(FeedPreprocessor::isValidUTF8("\xED\xA0\x80"));
+    REQUIRE_FALSE(FeedPreprocessor::isValidUTF8("\xF4\x90\x80\x80"));
+    REQUIRE_FALSE(FeedPreprocessor::isValidUTF8("0123456789abcdef\xE2\x82"));
+    REQUIRE_FALSE(FeedPreprocessor::isValidUTF8("0123456789abcdef0123456789abcdef\x80"));
+}
+
+TEST_CASE("Fuzz the preprocessor against its scalar and in-memory counterparts", "[preprocessing]")
+{
+    std::mt19937 rng(20231018);
+    const auto random = [&](size_t bound) { return static_cast<size_t>(rng() % bound); };
+
+    // random bytes, biased towards ASCII and continuation bytes, so both the fast paths and the sequence checks get exercised
+    for (size_t run = 0; run < 20000; ++run)
+    {
+        std::string data;
+        auto length = random(100);
+        for (size_t i = 0; i < length; ++i)
+        {
+            auto kind = random(4);
+            data += static_cast<char>(kind == 0 ? random(256) : (kind == 1 ? 0x80 + random(64) : random(128)));
+        }
+        REQUIRE(FeedPreprocessor::isValidUTF8(data) == FeedPreprocessor::isValidUTF8Scalar(data));
+    }
+
+    // documents glued together from the constructs the filter cares about, streamed in chunks of every small size;
+    // whatever comes out has to match the in-memory result and be valid UTF-8
+    const std::vector<std::string> pieces{
+        "<a>", "text ", "&nbsp;", "&amp;", "&eacute;", "&copyright;", "&", "<", "]]>", "-->", "\n", "<![CDATA[ &nbsp; ]]>", "<!-- &copy; -->",
+        "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\x93", "\xFF",
+    };
+    for (size_t run = 0; run < 5000; ++run)
+    {
+        std::string document = random(3) == 0 ? "<?xml version=\"1.0\" encoding=\"utf-8\"?>" : "";
+        auto count = random(40);
+        for (size_t i = 0; i < count; ++i)
+        {
+            document += pieces.at(random(pieces.size()));
+        }
+
+        auto prepared = FeedPreprocessor::prepare(document);
+        REQUIRE(FeedPreprocessor::isValidUTF8Scalar(prepared));
+        REQUIRE(prepareStreamed(document, 1 + random(17)) == prepared);
+    }
+}
+
+TEST_CASE("Preprocess feed bodies", "[.][benchmark][preprocessing]")
+{
+    const auto& atomInput = ZapFR::Tests::DataFetcher::fetch(ZapFR::Tests::DataFetcher::Source::Input, "FeedATOM10DaringFireball.xml");
+    const auto& rssInput = ZapFR::Tests::DataFetcher::fetch(ZapFR::Tests::DataFetcher::Source::Input, "FeedRSS20Hackernews.xml");
+    WARN("Dispatched to " << FeedPreprocessor::instructionSet());
+
+    BENCHMARK("Validate UTF-8, scalar: ATOM 1.0 (Daring Fireball)")
+    {
+        return FeedPreprocessor::isValidUTF8Scalar(atomInput);
+    };
+
+    BENCHMARK("Validate UTF-8, dispatched: ATOM 1.0 (Daring Fireball)")
+    {
+        return FeedPreprocessor::isValidUTF8(atomInput);
+    };
+
+    BENCHMARK("Prepare: ATOM 1.0 (Daring Fireball)")
+    {
+        return FeedPreprocessor::prepare(atomInput).size();
+    };
+
+    BENCHMARK("Prepare: RSS 2.0 (Hackernews)")
+    {
+        return FeedPreprocessor::prepare(rssInput).size();
+    };
+
+    BENCHMARK("Prepare, streamed: RSS 2.0 (Hackernews)")
+    {
+        return prepareStreamed(rssInput, 16384).size();
+    };
+}
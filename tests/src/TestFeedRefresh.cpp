@@ -0,0 +1,126 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <future>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <Poco/DigestEngine.h>
+#include <Poco/MD5Engine.h>
+
+#include "TestHTTPServer.h"
+#include "ZapFR/Agent.h"
+#include "ZapFR/base/Source.h"
+#include "ZapFR/local/FeedLocal.h"
+
+TEST_CASE("Refresh a feed through the agent", "[feedrefresh]")
+{
+    const auto body = ZapFR::Tests::TestHTTPServer::rssFeed("Refreshed feed");
+    ZapFR::Tests::TestHTTPServer server;
+    server.serve("/feed.xml", "application/rss+xml", body);
+
+    auto source = ZapFR::Engine::Source::getSource(1);
+    REQUIRE(source.has_value());
+    auto feed = ZapFR::Engine::FeedLocal::create(source.value().get(), server.url("/feed.xml"), "Refreshed feed", 0);
+    auto feedID = feed->id();
+
+    // the network stage and the ingest stage run as separate agents, the telemetry of the former has to survive the handoff to the latter
+    std::promise<void> refreshed;
+    ZapFR::Engine::Agent::getInstance()->queueRefreshFeed(source.value()->id(), feedID, [&](uint64_t, ZapFR::Engine::Feed*) { refreshed.set_value(); });
+    REQUIRE(refreshed.get_future().wait_for(std::chrono::seconds(30)) == std::future_status::ready);
+
+    auto telemetry = feed->getTelemetry();
+    REQUIRE(telemetry.size() == 1);
+    REQUIRE(telemetry.at(0).result == ZapFR::Engine::Feed::Telemetry::Result::Parsed);
+    REQUIRE(telemetry.at(0).transferredBytes > 0);
+    REQUIRE(telemetry.at(0).bodyBytes == body.size());
+    REQUIRE(telemetry.at(0).newItems == 1);
+
+    // the server doesn't do conditional GETs, so the second time around the body is recognized by its hash
+    std::promise<void> refreshedAgain;
+    ZapFR::Engine::Agent::getInstance()->queueRefreshFeed(source.value()->id(), feedID, [&](uint64_t, ZapFR::Engine::Feed*) { refreshedAgain.set_value(); });
+    REQUIRE(refreshedAgain.get_future().wait_for(std::chrono::seconds(30)) == std::future_status::ready);
+
+    telemetry = feed->getTelemetry();
+    REQUIRE(telemetry.size() == 2);
+    REQUIRE(telemetry.at(0).result == ZapFR::Engine::Feed::Telemetry::Result::Unchanged);
+    REQUIRE(telemetry.at(0).bodyBytes == body.size());
+    REQUIRE(telemetry.at(0).parseTime == 0); // recognized before it got to the parser
+
+    source.value()->removeFeed(feedID);
+}
+
+TEST_CASE("Refresh the icon a feed declares in the background", "[feedrefresh]")
+{
+    static const std::string iconData{"not really a png"};
+
+    ZapFR::Tests::TestHTTPServer server;
+    const auto iconURL = server.url("/icon.png");
+    const auto imageElement = fmt::format(R"(
+    <image>
+      <url>{}</url>
+      <title>Icon feed</title>
+      <link>https://example.com/</link>
+    </image>)",
+                                          iconURL);
+    server.serve("/feed.xml", "application/rss+xml", ZapFR::Tests::TestHTTPServer::rssFeed("Icon feed", 1, imageElement));
+    server.serve("/icon.png", "image/png", iconData);
+
+    auto source = ZapFR::Engine::Source::getSource(1);
+    REQUIRE(source.has_value());
+    auto feed = ZapFR::Engine::FeedLocal::create(source.value().get(), server.url("/feed.xml"), "Icon feed", 0);
+    auto feedID = feed->id();
+
+    auto agent = ZapFR::Engine::Agent::getInstance();
+    const auto iconAgentsFinished = [&]()
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        while (agent->totalCountOfType(ZapFR::Engine::AgentRunnable::Type::FeedRefreshIcon) > 0 && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        return agent->totalCountOfType(ZapFR::Engine::AgentRunnable::Type::FeedRefreshIcon) == 0;
+    };
+
+    // the icon agent loads the feed by its ID only, and still has to pick the declared icon over scraping the site
+    feed->refresh();
+    REQUIRE(iconAgentsFinished());
+    REQUIRE(server.requestCount("/icon.png") == 1);
+
+    Poco::MD5Engine md5;
+    md5.update(iconData);
+    auto reloadedFeed = source.value()->getFeed(feedID, ZapFR::Engine::Source::FetchInfo::Data);
+    REQUIRE(reloadedFeed.has_value());
+    REQUIRE(reloadedFeed.value()->iconURL() == iconURL);
+    REQUIRE(reloadedFeed.value()->iconHash() == Poco::DigestEngine::digestToHex(md5.digest()));
+    REQUIRE(!reloadedFeed.value()->iconLastFetched().empty());
+
+    // the icon is fresh now, so ingesting a changed body, through a feed loaded the way the agents load it, mustn't queue another fetch
+    server.serve("/feed.xml", "application/rss+xml", ZapFR::Tests::TestHTTPServer::rssFeed("Icon feed", 2, imageElement));
+    auto agentFeed = source.value()->getFeed(feedID, ZapFR::Engine::Source::FetchInfo::None);
+    REQUIRE(agentFeed.has_value());
+    agentFeed.value()->refresh();
+    REQUIRE(agent->totalCountOfType(ZapFR::Engine::AgentRunnable::Type::FeedRefreshIcon) == 0);
+    REQUIRE(agentFeed.value()->getTelemetry().at(0).newItems == 1);
+    REQUIRE(server.requestCount("/icon.png") == 1);
+
+    source.value()->removeFeed(feedID);
+}
@@ -0,0 +1,190 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <Poco/File.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/TemporaryFile.h>
+#include <Poco/URI.h>
+
+#include "DataFetcher.h"
+#include "TestHTTPServer.h"
+#include "ZapFR/HTTPCorpusTransport.h"
+#include "ZapFR/Helpers.h"
+#include "ZapFR/feed_handling/FeedFetcher.h"
+#include "ZapFR/feed_handling/FeedParser.h"
+
+namespace
+{
+    std::string temporaryCorpusDirectory()
+    {
+        auto tmpFile = Poco::TemporaryFile();
+        tmpFile.keepUntilExit();
+        Poco::File(tmpFile.path()).createDirectories();
+        return tmpFile.path();
+    }
+} // namespace
+
+TEST_CASE("Record and replay HTTP exchanges", "[httpcorpus]")
+{
+    auto corpusDirectory = temporaryCorpusDirectory();
+    auto server = std::make_unique<ZapFR::Tests::TestHTTPServer>();
+    auto feedURL = server->url("/moved.xml");
+    auto finalURL = server->url("/feed.xml");
+    auto otherURL = server->url("/other.xml");
+
+    // record, following the redirect on the way
+    {
+        server->redirect("/moved.xml", "/feed.xml", Poco::Net::HTTPResponse::HTTP_MOVED_PERMANENTLY);
+        server->route("/feed.xml",
+                      [](const ZapFR::Tests::TestHTTPServer::Request&)
+                      {
+                          ZapFR::Tests::TestHTTPServer::Response response;
+                          response.headers["ETag"] = "\"recorded\"";
+                          response.headers["Content-Type"] = "application/rss+xml";
+                          response.body = ZapFR::Tests::TestHTTPServer::rssFeed("Recorded feed");
+                          return response;
+                      });
+
+        auto recorder = std::make_shared<ZapFR::Engine::HTTPRecordingTransport>(corpusDirectory, std::make_shared<ZapFR::Engine::HTTPNetworkTransport>());
+        ZapFR::Engine::Helpers::setHTTPTransport(recorder);
+        auto ff = ZapFR::Engine::FeedFetcher();
+        auto parser = ff.parseURL(feedURL, 0, {});
+        REQUIRE(parser.has_value());
+        REQUIRE(parser.value()->title() == "Recorded feed");
+        REQUIRE(recorder->recordedCount() == 2);
+        REQUIRE(ff.transferStats().bodyBytes > 0);
+        REQUIRE(ff.transferStats().transferredBytes > 0);
+
+        server.reset();
+    }
+
+    // replay with the server gone
+    auto replayer = std::make_shared<ZapFR::Engine::HTTPReplayTransport>(corpusDirectory, 0.0);
+    ZapFR::Engine::Helpers::setHTTPTransport(replayer);
+    auto ff = ZapFR::Engine::FeedFetcher();
+    auto parser = ff.parseURL(feedURL, 0, {});
+    REQUIRE(parser.has_value());
+    REQUIRE(parser.value()->title() == "Recorded feed");
+    REQUIRE(parser.value()->items().size() == 1);
+    REQUIRE(ff.permanentRedirectURL() == finalURL);
+    REQUIRE(ff.conditionalGETInfo().find("recorded") != std::string::npos);
+    REQUIRE(replayer->replayedCount() == 2);
+    REQUIRE(ff.transferStats().bodyBytes > 0);
+    REQUIRE(ff.transferStats().dnsTime == 0); // nothing was looked up
+
+    // anything that wasn't recorded can't be reached
+    REQUIRE_THROWS(ff.parseURL(otherURL, 0, {}));
+    REQUIRE(replayer->missedCount() == 1);
+
+    ZapFR::Engine::Helpers::setHTTPTransport(nullptr);
+}
+
+TEST_CASE("Record repeated refreshes of the same feed", "[httpcorpus]")
+{
+    auto corpusDirectory = temporaryCorpusDirectory();
+    auto server = std::make_unique<ZapFR::Tests::TestHTTPServer>();
+    auto feedURL = server->url("/feed.xml");
+
+    // a server that does conditional GETs, so the second refresh gets a 304
+    server->route("/feed.xml",
+                  [](const ZapFR::Tests::TestHTTPServer::Request& request)
+                  {
+                      ZapFR::Tests::TestHTTPServer::Response response;
+                      response.headers["ETag"] = "\"recorded\"";
+                      if (request.headers.get("If-None-Match", "") == "\"recorded\"")
+                      {
+                          response.status = Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED;
+                          return response;
+                      }
+                      response.headers["Content-Type"] = "application/rss+xml";
+                      response.body = ZapFR::Tests::TestHTTPServer::rssFeed("Recorded feed");
+                      return response;
+                  });
+
+    std::string conditionalGETInfo;
+    {
+        auto recorder = std::make_shared<ZapFR::Engine::HTTPRecordingTransport>(corpusDirectory, std::make_shared<ZapFR::Engine::HTTPNetworkTransport>());
+        ZapFR::Engine::Helpers::setHTTPTransport(recorder);
+        auto ff = ZapFR::Engine::FeedFetcher();
+        REQUIRE(ff.parseURL(feedURL, 0, {}).has_value());
+        conditionalGETInfo = ff.conditionalGETInfo();
+        REQUIRE(!ff.parseURL(feedURL, 0, conditionalGETInfo).has_value());
+        REQUIRE(server->requestCount("/feed.xml") == 2);
+        REQUIRE(recorder->recordedCount() == 2);
+        server.reset();
+    }
+
+    // replaying against an empty database gets the content, and the revalidation the 304, in whichever order they come in
+    auto replayer = std::make_shared<ZapFR::Engine::HTTPReplayTransport>(corpusDirectory, 0.0);
+    ZapFR::Engine::Helpers::setHTTPTransport(replayer);
+    auto ff = ZapFR::Engine::FeedFetcher();
+    REQUIRE(!ff.parseURL(feedURL, 0, conditionalGETInfo).has_value());
+    auto parser = ff.parseURL(feedURL, 0, {});
+    REQUIRE(parser.has_value());
+    REQUIRE(parser.value()->title() == "Recorded feed");
+    REQUIRE(!ff.parseURL(feedURL, 0, conditionalGETInfo).has_value());
+
+    // validators that were never recorded get the full response
+    parser = ff.parseURL(feedURL, 0, R"({"l":"","e":"\"something else\""})");
+    REQUIRE(parser.has_value());
+    REQUIRE(parser.value()->title() == "Recorded feed");
+    REQUIRE(replayer->missedCount() == 0);
+
+    ZapFR::Engine::Helpers::setHTTPTransport(nullptr);
+}
+
+TEST_CASE("Replay a corpus of feeds", "[.][benchmark][httpcorpus]")
+{
+    static constexpr size_t feedCount{1000};
+    const auto& feedBody = ZapFR::Tests::DataFetcher::fetch(ZapFR::Tests::DataFetcher::Source::Input, "FeedRSS20Hackernews.xml");
+
+    auto corpusDirectory = temporaryCorpusDirectory();
+    std::vector<std::string> feedURLs;
+    for (size_t i = 0; i < feedCount; ++i)
+    {
+        auto url = Poco::URI(fmt::format("https://feed{}.example.com/rss", i));
+        Poco::Net::HTTPRequest request(Poco::Net::HTTPRequest::HTTP_GET, url.getPathAndQuery(), Poco::Net::HTTPMessage::HTTP_1_1);
+
+        ZapFR::Engine::HTTPCorpus::Entry entry;
+        entry.method = request.getMethod();
+        entry.url = url.toString();
+        entry.headers = {{"Content-Type", "application/rss+xml"}, {"Content-Length", std::to_string(feedBody.size())}};
+        entry.body = feedBody;
+        ZapFR::Engine::HTTPCorpus::write(corpusDirectory, ZapFR::Engine::HTTPCorpus::key(request, url, ""), entry);
+        feedURLs.emplace_back(url.toString());
+    }
+
+    ZapFR::Engine::Helpers::setHTTPTransport(std::make_shared<ZapFR::Engine::HTTPReplayTransport>(corpusDirectory, 0.0));
+    BENCHMARK("Fetch and parse 1000 replayed feeds")
+    {
+        size_t itemCount{0};
+        for (const auto& url : feedURLs)
+        {
+            auto ff = ZapFR::Engine::FeedFetcher();
+            auto parser = ff.parseURL(url, 0, {});
+            itemCount += parser.value()->items().size();
+        }
+        return itemCount;
+    };
+    ZapFR::Engine::Helpers::setHTTPTransport(nullptr);
+}
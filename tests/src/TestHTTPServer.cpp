@@ -0,0 +1,199 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <Poco/Net/HTTPRequestHandler.h>
+#include <Poco/Net/HTTPRequestHandlerFactory.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/StreamCopier.h>
+#include <Poco/URI.h>
+
+#include "TestHTTPServer.h"
+
+namespace ZapFR
+{
+    namespace Tests
+    {
+        class TestHTTPServerHandler : public Poco::Net::HTTPRequestHandler
+        {
+          public:
+            explicit TestHTTPServerHandler(TestHTTPServer* server) : mServer(server) {}
+
+            void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) override
+            {
+                auto uri = Poco::URI(request.getURI());
+                TestHTTPServer::Request r;
+                r.method = request.getMethod();
+                r.path = uri.getPath();
+                r.query = uri.getRawQuery();
+                for (const auto& [name, value] : request)
+                {
+                    r.headers.add(name, value);
+                }
+                Poco::StreamCopier::copyToString(request.stream(), r.body);
+
+                auto result = mServer->handle(std::move(r));
+                for (const auto& [name, value] : result.headers)
+                {
+                    response.set(name, value);
+                }
+                response.setStatusAndReason(result.status);
+                if (result.status == Poco::Net::HTTPResponse::HTTP_NOT_MODIFIED || result.status == Poco::Net::HTTPResponse::HTTP_NO_CONTENT)
+                {
+                    response.send();
+                    return;
+                }
+                response.setContentLength(static_cast<std::streamsize>(result.body.size()));
+                response.send() << result.body;
+            }
+
+          private:
+            TestHTTPServer* mServer{nullptr};
+        };
+
+        class TestHTTPServerHandlerFactory : public Poco::Net::HTTPRequestHandlerFactory
+        {
+          public:
+            explicit TestHTTPServerHandlerFactory(TestHTTPServer* server) : mServer(server) {}
+            Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest&) override { return new TestHTTPServerHandler(mServer); }
+
+          private:
+            TestHTTPServer* mServer{nullptr};
+        };
+    } // namespace Tests
+} // namespace ZapFR
+
+ZapFR::Tests::TestHTTPServer::TestHTTPServer()
+{
+    // port 0 lets the OS pick a free one, so the tests don't collide with each other or with whatever else runs on the machine
+    Poco::Net::ServerSocket socket(Poco::Net::SocketAddress("127.0.0.1", 0));
+    mPort = socket.address().port();
+    mServer = std::make_unique<Poco::Net::HTTPServer>(new TestHTTPServerHandlerFactory(this), socket, new Poco::Net::HTTPServerParams());
+    mServer->start();
+}
+
+ZapFR::Tests::TestHTTPServer::~TestHTTPServer()
+{
+    mServer->stopAll(true);
+}
+
+std::string ZapFR::Tests::TestHTTPServer::url(const std::string& path) const
+{
+    return fmt::format("http://127.0.0.1:{}{}", mPort, path);
+}
+
+void ZapFR::Tests::TestHTTPServer::route(const std::string& path, Handler handler)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRoutes[path] = std::move(handler);
+}
+
+void ZapFR::Tests::TestHTTPServer::serve(const std::string& path, const std::string& contentType, const std::string& body)
+{
+    route(path,
+          [contentType, body](const Request&)
+          {
+              Response response;
+              response.headers["Content-Type"] = contentType;
+              response.body = body;
+              return response;
+          });
+}
+
+void ZapFR::Tests::TestHTTPServer::redirect(const std::string& path, const std::string& location, Poco::Net::HTTPResponse::HTTPStatus status)
+{
+    route(path,
+          [location, status](const Request&)
+          {
+              Response response;
+              response.status = status;
+              response.headers["Location"] = location;
+              return response;
+          });
+}
+
+std::vector<ZapFR::Tests::TestHTTPServer::Request> ZapFR::Tests::TestHTTPServer::requests(const std::string& path) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::vector<Request> matching;
+    for (const auto& request : mRequests)
+    {
+        if (request.path == path)
+        {
+            matching.emplace_back(request);
+        }
+    }
+    return matching;
+}
+
+size_t ZapFR::Tests::TestHTTPServer::requestCount(const std::string& path) const
+{
+    return requests(path).size();
+}
+
+ZapFR::Tests::TestHTTPServer::Response ZapFR::Tests::TestHTTPServer::handle(Request request)
+{
+    Handler handler;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRequests.emplace_back(request);
+        auto it = mRoutes.find(request.path);
+        if (it != mRoutes.end())
+        {
+            handler = it->second;
+        }
+    }
+
+    // the handler runs unlocked, so it's free to call back into the server (e.g. to see what was requested before)
+    if (!handler)
+    {
+        Response notFound;
+        notFound.status = Poco::Net::HTTPResponse::HTTP_NOT_FOUND;
+        return notFound;
+    }
+    return handler(request);
+}
+
+std::string ZapFR::Tests::TestHTTPServer::rssFeed(const std::string& title, size_t itemCount, const std::string& extraChannelElements)
+{
+    std::string items;
+    for (size_t i = 1; i <= itemCount; ++i)
+    {
+        items += fmt::format(R"(
+    <item>
+      <title>Item {0}</title>
+      <link>https://example.com/{0}</link>
+      <guid>https://example.com/{0}</guid>
+    </item>)",
+                             i);
+    }
+
+    return fmt::format(R"(<?xml version="1.0" encoding="utf-8"?>
+<rss version="2.0">
+  <channel>
+    <title>{0}</title>
+    <link>https://example.com/</link>
+    <description>{0}</description>{1}{2}
+  </channel>
+</rss>)",
+                       title, extraChannelElements, items);
+}
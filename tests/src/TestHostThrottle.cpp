@@ -0,0 +1,111 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ZapFR/HostThrottle.h"
+
+TEST_CASE("Host throttle - concurrency and spacing", "[hostthrottle]")
+{
+    auto throttle = ZapFR::Engine::HostThrottle::getInstance();
+    throttle->clear();
+    auto originalLimits = throttle->limits();
+
+    ZapFR::Engine::HostThrottle::Limits limits;
+    limits.maxConcurrentRequests = 1;
+    limits.minSpacingInMilliseconds = 0;
+    limits.requestsPerMinute = 0; // no token bucket
+    throttle->setLimits(limits);
+
+    ZapFR::Engine::HostThrottle::Clock::time_point retryAt;
+    auto permit = throttle->tryAcquire("example.com", retryAt);
+    REQUIRE(permit != nullptr);
+
+    // a second request to the same host has to wait, other hosts are unaffected
+    REQUIRE(throttle->tryAcquire("EXAMPLE.com", retryAt) == nullptr);
+    REQUIRE(retryAt > ZapFR::Engine::HostThrottle::Clock::now());
+    auto otherPermit = throttle->tryAcquire("example.org", retryAt);
+    REQUIRE(otherPermit != nullptr);
+
+    permit.reset();
+    REQUIRE(throttle->tryAcquire("example.com", retryAt) != nullptr);
+
+    otherPermit.reset();
+    throttle->setLimits(originalLimits);
+    throttle->clear();
+}
+
+TEST_CASE("Host throttle - token bucket and Retry-After", "[hostthrottle]")
+{
+    auto throttle = ZapFR::Engine::HostThrottle::getInstance();
+    throttle->clear();
+    auto originalLimits = throttle->limits();
+
+    ZapFR::Engine::HostThrottle::Limits limits;
+    limits.maxConcurrentRequests = 10;
+    limits.minSpacingInMilliseconds = 0;
+    limits.requestsPerMinute = 1;
+    limits.burstSize = 2;
+    throttle->setLimits(limits);
+
+    ZapFR::Engine::HostThrottle::Clock::time_point retryAt;
+    REQUIRE(throttle->tryAcquire("tokens.example.com", retryAt) != nullptr);
+    REQUIRE(throttle->tryAcquire("tokens.example.com", retryAt) != nullptr);
+    REQUIRE(throttle->tryAcquire("tokens.example.com", retryAt) == nullptr); // burst used up
+
+    auto now = ZapFR::Engine::HostThrottle::Clock::now();
+    throttle->deferUntil("deferred.example.com", now + std::chrono::seconds(120));
+    REQUIRE(throttle->tryAcquire("deferred.example.com", retryAt) == nullptr);
+    REQUIRE(retryAt >= now + std::chrono::seconds(119));
+
+    throttle->setLimits(originalLimits);
+    throttle->clear();
+}
+
+TEST_CASE("Host throttle - forget idle hosts", "[hostthrottle]")
+{
+    auto throttle = ZapFR::Engine::HostThrottle::getInstance();
+    throttle->clear();
+    auto originalLimits = throttle->limits();
+
+    ZapFR::Engine::HostThrottle::Limits limits;
+    limits.maxConcurrentRequests = 1;
+    limits.minSpacingInMilliseconds = 0;
+    limits.requestsPerMinute = 0; // no token bucket
+    throttle->setLimits(limits);
+
+    ZapFR::Engine::HostThrottle::Clock::time_point retryAt;
+    auto hostCount = throttle->hostCount();
+    auto busyPermit = throttle->tryAcquire("busy.example.com", retryAt);
+    REQUIRE(busyPermit != nullptr);
+    REQUIRE(throttle->tryAcquire("idle.example.com", retryAt) != nullptr); // released right away
+    throttle->deferUntil("deferred.example.com", ZapFR::Engine::HostThrottle::Clock::now() + std::chrono::seconds(120));
+    REQUIRE(throttle->hostCount() == hostCount + 3);
+
+    // only the host that's done and isn't waiting for anything is forgotten
+    throttle->pruneIdleHosts();
+    REQUIRE(throttle->hostCount() == hostCount + 2);
+    REQUIRE(throttle->tryAcquire("deferred.example.com", retryAt) == nullptr);
+
+    busyPermit.reset();
+    throttle->pruneIdleHosts();
+    REQUIRE(throttle->hostCount() == hostCount + 1);
+
+    throttle->setLimits(originalLimits);
+    throttle->clear();
+}
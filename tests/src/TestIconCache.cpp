@@ -0,0 +1,59 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "ZapFR/IconCache.h"
+
+TEST_CASE("Icon cache - store and retrieve", "[iconcache]")
+{
+    auto cache = ZapFR::Engine::IconCache::getInstance();
+    cache->clear();
+
+    REQUIRE(!cache->get("hash1").has_value());
+    cache->put("hash1", "icondata1");
+    REQUIRE(cache->contains("hash1"));
+    REQUIRE(cache->get("hash1").value() == "icondata1");
+
+    // empty hashes or data are never cached
+    cache->put("", "icondata");
+    cache->put("hash2", "");
+    REQUIRE(cache->size() == 1);
+
+    cache->clear();
+}
+
+TEST_CASE("Icon cache - least recently used eviction", "[iconcache]")
+{
+    auto cache = ZapFR::Engine::IconCache::getInstance();
+    cache->clear();
+    cache->setCapacity(2);
+
+    cache->put("hash1", "icondata1");
+    cache->put("hash2", "icondata2");
+    REQUIRE(cache->get("hash1").has_value()); // hash1 is now the most recently used
+    cache->put("hash3", "icondata3");
+
+    REQUIRE(cache->size() == 2);
+    REQUIRE(cache->contains("hash1"));
+    REQUIRE(!cache->contains("hash2"));
+    REQUIRE(cache->contains("hash3"));
+
+    cache->setCapacity(ZapFR::Engine::DefaultIconCacheCapacity);
+    cache->clear();
+}
@@ -0,0 +1,213 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <new>
+
+#include <catch2/catch_test_macros.hpp>
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <Poco/DOM/DOMParser.h>
+
+#include "DataFetcher.h"
+#include "FeedParserATOM10.h"
+#include "FeedParserRSS20.h"
+#include "ZapFR/base/Source.h"
+#include "ZapFR/feed_handling/FeedParserXMLStreaming.h"
+#include "ZapFR/local/FeedLocal.h"
+
+namespace
+{
+    // per thread, so the agent and server threads running alongside the tests don't end up in the counts
+    thread_local uint64_t gsAllocationCount{0};
+    thread_local uint64_t gsAllocatedBytes{0};
+
+    struct AllocationCount
+    {
+        uint64_t allocations{0};
+        uint64_t bytes{0};
+    };
+
+    template <typename F> AllocationCount countAllocations(F&& f)
+    {
+        auto allocationsBefore = gsAllocationCount;
+        auto bytesBefore = gsAllocatedBytes;
+        f();
+        return AllocationCount{gsAllocationCount - allocationsBefore, gsAllocatedBytes - bytesBefore};
+    }
+
+    void* allocate(std::size_t size, std::size_t alignment)
+    {
+        gsAllocationCount++;
+        gsAllocatedBytes += size;
+        if (size == 0)
+        {
+            size = 1;
+        }
+
+        void* p{nullptr};
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            p = std::malloc(size);
+        }
+        else
+        {
+            // aligned_alloc wants the size to be a multiple of the alignment
+            p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+        }
+        if (p == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+} // namespace
+
+// replaced for the whole tests-allocations binary (which is why these tests have one of their own), so they can count the heap allocations
+// made on their behalf; the nothrow variants forward to these by default
+void* operator new(std::size_t size)
+{
+    return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+TEST_CASE("Storing parsed items doesn't copy their content", "[feedparsing][allocations]")
+{
+    static constexpr size_t itemCount{8};
+    static constexpr size_t contentSize{256 * 1024};
+
+    std::string items;
+    for (size_t i = 0; i < itemCount; ++i)
+    {
+        items += fmt::format("<item><title>Item {0}</title><link>https://example.com/{0}</link><guid>https://example.com/{0}</guid><description>{1}</description></item>", i,
+                             std::string(contentSize, 'x'));
+    }
+    auto input = fmt::format(R"(<?xml version="1.0" encoding="utf-8"?><rss version="2.0"><channel><title>Large items</title>{}</channel></rss>)", items);
+    auto parsedFeed = ZapFR::Engine::FeedParserXMLStreaming::parse(input, "https://example.com");
+
+    auto source = ZapFR::Engine::Source::getSource(1);
+    REQUIRE(source.has_value());
+    auto feed = ZapFR::Engine::FeedLocal::create(source.value().get(), "https://example.com/large.xml", "Large items", 0);
+
+    // the database binds the content by reference and copies it with its own allocator, so a single copy of the content made on the way
+    // from the parsed item into the post shows up here as at least contentSize bytes
+    std::tuple<uint64_t, uint64_t> result;
+    auto counted = countAllocations([&]() { result = feed->processItems(parsedFeed.get()); });
+    INFO(fmt::format("Storing {} items of {} bytes: {} allocations, {} bytes", itemCount, contentSize, counted.allocations, counted.bytes));
+    REQUIRE(std::get<0>(result) == itemCount);
+    REQUIRE(counted.bytes < contentSize);
+
+    source.value()->removeFeed(feed->id());
+}
+
+TEST_CASE("Count the allocations of parsing a feed", "[.][benchmark][feedparsing][allocations]")
+{
+    const auto& atomInput = ZapFR::Tests::DataFetcher::fetch(ZapFR::Tests::DataFetcher::Source::Input, "FeedATOM10DaringFireball.xml");
+    const auto& rssInput = ZapFR::Tests::DataFetcher::fetch(ZapFR::Tests::DataFetcher::Source::Input, "FeedRSS20Hackernews.xml");
+
+    auto domAtom = countAllocations(
+        [&]()
+        {
+            Poco::XML::DOMParser parser;
+            Poco::AutoPtr<Poco::XML::Document> xmlDoc = parser.parseString(atomInput);
+            auto feed = std::make_unique<ZapFR::Engine::FeedParserATOM10>("https://example.com");
+            feed->setXMLDoc(xmlDoc);
+            auto items = feed->takeItems();
+        });
+    auto streamingAtom = countAllocations(
+        [&]()
+        {
+            auto feed = ZapFR::Engine::FeedParserXMLStreaming::parse(atomInput, "https://example.com");
+            auto items = feed->takeItems();
+        });
+    WARN(fmt::format("ATOM 1.0 (Daring Fireball): {} allocations through the DOM, {} streaming", domAtom.allocations, streamingAtom.allocations));
+    CHECK(streamingAtom.allocations < domAtom.allocations);
+
+    auto domRSS = countAllocations(
+        [&]()
+        {
+            Poco::XML::DOMParser parser;
+            Poco::AutoPtr<Poco::XML::Document> xmlDoc = parser.parseString(rssInput);
+            auto feed = std::make_unique<ZapFR::Engine::FeedParserRSS20>("https://example.com");
+            feed->setXMLDoc(xmlDoc);
+            auto items = feed->takeItems();
+        });
+    auto streamingRSS = countAllocations(
+        [&]()
+        {
+            auto feed = ZapFR::Engine::FeedParserXMLStreaming::parse(rssInput, "https://example.com");
+            auto items = feed->takeItems();
+        });
+    WARN(fmt::format("RSS 2.0 (Hackernews): {} allocations through the DOM, {} streaming", domRSS.allocations, streamingRSS.allocations));
+    CHECK(streamingRSS.allocations < domRSS.allocations);
+}
@@ -0,0 +1,171 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include "TestHTTPServer.h"
+#include "ZapFR/Global.h"
+#include "ZapFR/Helpers.h"
+#include "ZapFR/base/Source.h"
+#include "ZapFR/feed_handling/FeedFetcher.h"
+#include "ZapFR/local/FeedLocal.h"
+
+TEST_CASE("Follow permanent and temporary redirects", "[redirects]")
+{
+    ZapFR::Tests::TestHTTPServer server;
+    server.serve("/feed.xml", "application/rss+xml", ZapFR::Tests::TestHTTPServer::rssFeed("Redirected feed"));
+    server.redirect("/moved", server.url("/feed.xml"), Poco::Net::HTTPResponse::HTTP_MOVED_PERMANENTLY);
+    server.redirect("/found", server.url("/feed.xml"), Poco::Net::HTTPResponse::HTTP_FOUND);
+    server.redirect("/moved-then-found", "/found", Poco::Net::HTTPResponse::HTTP_MOVED_PERMANENTLY);
+
+    // only a chain of nothing but permanent redirects reports where the feed moved to
+    ZapFR::Engine::FeedFetcher ff;
+    REQUIRE(ff.parseURL(server.url("/moved"), 0, {}).has_value());
+    REQUIRE(ff.permanentRedirectURL() == server.url("/feed.xml"));
+
+    REQUIRE(ff.parseURL(server.url("/found"), 0, {}).has_value());
+    REQUIRE(ff.permanentRedirectURL().empty());
+
+    REQUIRE(ff.parseURL(server.url("/moved-then-found"), 0, {}).has_value());
+    REQUIRE(ff.permanentRedirectURL().empty());
+    REQUIRE(server.requestCount("/feed.xml") == 3);
+}
+
+TEST_CASE("Detect redirect loops", "[redirects]")
+{
+    ZapFR::Tests::TestHTTPServer server;
+    server.redirect("/ping", server.url("/pong"), Poco::Net::HTTPResponse::HTTP_FOUND);
+    server.redirect("/pong", server.url("/ping"), Poco::Net::HTTPResponse::HTTP_MOVED_PERMANENTLY);
+    server.redirect("/self", "/self", Poco::Net::HTTPResponse::HTTP_FOUND);
+
+    ZapFR::Engine::FeedFetcher ff;
+    REQUIRE_THROWS_WITH(ff.parseURL(server.url("/ping"), 0, {}), Catch::Matchers::ContainsSubstring("Redirect loop detected"));
+    REQUIRE(server.requestCount("/ping") == 1);
+    REQUIRE(server.requestCount("/pong") == 1);
+
+    REQUIRE_THROWS_WITH(ff.parseURL(server.url("/self"), 0, {}), Catch::Matchers::ContainsSubstring("Redirect loop detected"));
+    REQUIRE(server.requestCount("/self") == 1);
+}
+
+TEST_CASE("Give up after the maximum amount of redirects", "[redirects]")
+{
+    ZapFR::Tests::TestHTTPServer server;
+    server.serve("/feed.xml", "application/rss+xml", ZapFR::Tests::TestHTTPServer::rssFeed("Far away feed"));
+    server.redirect("/hop1", "/hop2", Poco::Net::HTTPResponse::HTTP_FOUND);
+    server.redirect("/hop2", "/hop3", Poco::Net::HTTPResponse::HTTP_FOUND);
+    server.redirect("/hop3", "/feed.xml", Poco::Net::HTTPResponse::HTTP_FOUND);
+
+    const auto originalLimits = ZapFR::Engine::Helpers::httpTransferLimits();
+    auto limits = originalLimits;
+
+    limits.maxRedirects = 3;
+    ZapFR::Engine::Helpers::setHTTPTransferLimits(limits);
+    ZapFR::Engine::FeedFetcher ff;
+    REQUIRE(ff.parseURL(server.url("/hop1"), 0, {}).has_value());
+    REQUIRE(server.requestCount("/hop3") == 1);
+    REQUIRE(server.requestCount("/feed.xml") == 1);
+
+    limits.maxRedirects = 2;
+    ZapFR::Engine::Helpers::setHTTPTransferLimits(limits);
+    REQUIRE_THROWS_WITH(ff.parseURL(server.url("/hop1"), 0, {}), Catch::Matchers::ContainsSubstring("Too many redirects (more than 2)"));
+    REQUIRE(server.requestCount("/hop3") == 2);
+    REQUIRE(server.requestCount("/feed.xml") == 1); // the third redirect isn't followed anymore
+
+    ZapFR::Engine::Helpers::setHTTPTransferLimits(originalLimits);
+}
+
+TEST_CASE("Cache temporary redirects that have a freshness lifetime", "[redirects]")
+{
+    const auto temporaryRedirect = [](const std::string& location, const std::string& cacheControl)
+    {
+        return [location, cacheControl](const ZapFR::Tests::TestHTTPServer::Request&)
+        {
+            ZapFR::Tests::TestHTTPServer::Response response;
+            response.status = Poco::Net::HTTPResponse::HTTP_FOUND;
+            response.headers["Location"] = location;
+            response.headers["Cache-Control"] = cacheControl;
+            return response;
+        };
+    };
+
+    ZapFR::Tests::TestHTTPServer server;
+    server.serve("/feed.xml", "application/rss+xml", ZapFR::Tests::TestHTTPServer::rssFeed("Cached redirect feed"));
+    server.route("/cacheable", temporaryRedirect("/feed.xml", "max-age=300"));
+    server.route("/uncacheable", temporaryRedirect("/feed.xml", "no-cache"));
+
+    ZapFR::Engine::FeedFetcher ff;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        REQUIRE(ff.parseURL(server.url("/cacheable"), 0, {}).has_value());
+        REQUIRE(ff.permanentRedirectURL().empty()); // a cached temporary redirect is still a temporary one
+        REQUIRE(ff.parseURL(server.url("/uncacheable"), 0, {}).has_value());
+    }
+    REQUIRE(server.requestCount("/cacheable") == 1);
+    REQUIRE(server.requestCount("/uncacheable") == 2);
+    REQUIRE(server.requestCount("/feed.xml") == 4);
+}
+
+TEST_CASE("Update the feed URL once a permanent redirect is confirmed", "[redirects]")
+{
+    const auto body = ZapFR::Tests::TestHTTPServer::rssFeed("Moved feed");
+    ZapFR::Tests::TestHTTPServer server;
+    server.serve("/new.xml", "application/rss+xml", body);
+    server.redirect("/old.xml", server.url("/new.xml"), Poco::Net::HTTPResponse::HTTP_MOVED_PERMANENTLY);
+
+    auto source = ZapFR::Engine::Source::getSource(1);
+    REQUIRE(source.has_value());
+    auto feed = ZapFR::Engine::FeedLocal::create(source.value().get(), server.url("/old.xml"), "Moved feed", 0);
+    auto feedID = feed->id();
+
+    const auto storedURL = [&]()
+    {
+        auto reloadedFeed = source.value()->getFeed(feedID, ZapFR::Engine::Source::FetchInfo::Data);
+        REQUIRE(reloadedFeed.has_value());
+        return reloadedFeed.value()->url();
+    };
+
+    // a permanent redirect that goes away again before it's confirmed doesn't count
+    for (uint64_t i = 1; i < ZapFR::Engine::PermanentRedirectConfirmations; ++i)
+    {
+        feed->refresh();
+    }
+    server.serve("/old.xml", "application/rss+xml", body);
+    feed->refresh();
+    REQUIRE(storedURL() == server.url("/old.xml"));
+
+    server.redirect("/old.xml", server.url("/new.xml"), Poco::Net::HTTPResponse::HTTP_MOVED_PERMANENTLY);
+    for (uint64_t i = 1; i < ZapFR::Engine::PermanentRedirectConfirmations; ++i)
+    {
+        feed->refresh();
+        REQUIRE(feed->url() == server.url("/old.xml"));
+        REQUIRE(storedURL() == server.url("/old.xml"));
+    }
+
+    feed->refresh();
+    REQUIRE(feed->url() == server.url("/new.xml"));
+    REQUIRE(storedURL() == server.url("/new.xml"));
+
+    // from now on the old location isn't requested anymore
+    auto oldRequestCount = server.requestCount("/old.xml");
+    feed->refresh();
+    REQUIRE(server.requestCount("/old.xml") == oldRequestCount);
+    REQUIRE(!feed->lastRefreshError().has_value());
+
+    source.value()->removeFeed(feedID);
+}
@@ -18,6 +18,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include "ZapFR/HTTPConnectionPool.h"
+#include "ZapFR/Helpers.h"
 #include "ZapFR/remote/SourceRemote.h"
 
 TEST_CASE("Get sources", "[remote-source]")
@@ -98,3 +100,46 @@ TEST_CASE("Get source status", "[remote-source]")
     REQUIRE(status.isArray(ZapFR::Engine::JSON::SourceStatus::UnreadCounts));
     REQUIRE(status.getArray(ZapFR::Engine::JSON::SourceStatus::UnreadCounts)->size() == 0);
 }
+
+TEST_CASE("Reuse pooled connections", "[remote-source]")
+{
+    auto source = ZapFR::Engine::Source::getSource(2);
+    REQUIRE(source.has_value());
+
+    auto pool = ZapFR::Engine::HTTPConnectionPool::getInstance();
+    source.value()->getStatus();
+    auto createdCount = pool->createdConnectionCount();
+    auto reusedCount = pool->reusedConnectionCount();
+    source.value()->getStatus();
+    REQUIRE(pool->createdConnectionCount() == createdCount);
+    REQUIRE(pool->reusedConnectionCount() == reusedCount + 1);
+}
+
+TEST_CASE("Abort oversized response body", "[remote-source]")
+{
+    auto source = ZapFR::Engine::Source::getSource(2);
+    REQUIRE(source.has_value());
+
+    auto originalLimits = ZapFR::Engine::Helpers::httpTransferLimits();
+    auto limits = originalLimits;
+    limits.maxBodySize = 10;
+    ZapFR::Engine::Helpers::setHTTPTransferLimits(limits);
+    REQUIRE_THROWS(source.value()->getStatus());
+    ZapFR::Engine::Helpers::setHTTPTransferLimits(originalLimits);
+
+    REQUIRE_NOTHROW(source.value()->getStatus());
+}
+
+TEST_CASE("Negotiate the response content coding", "[remote-source]")
+{
+    REQUIRE(ZapFR::Engine::Helpers::acceptsContentCoding("gzip, deflate", "gzip"));
+    REQUIRE(ZapFR::Engine::Helpers::acceptsContentCoding("deflate, GZIP;q=0.5", "gzip"));
+    REQUIRE(ZapFR::Engine::Helpers::acceptsContentCoding("*", "gzip"));
+    REQUIRE_FALSE(ZapFR::Engine::Helpers::acceptsContentCoding("", "gzip"));
+    REQUIRE_FALSE(ZapFR::Engine::Helpers::acceptsContentCoding("identity", "gzip"));
+    REQUIRE_FALSE(ZapFR::Engine::Helpers::acceptsContentCoding("x-gzip", "gzip"));
+    REQUIRE_FALSE(ZapFR::Engine::Helpers::acceptsContentCoding("gzip;q=0", "gzip"));
+    REQUIRE_FALSE(ZapFR::Engine::Helpers::acceptsContentCoding("deflate, gzip ; q=0.000", "gzip"));
+    REQUIRE_FALSE(ZapFR::Engine::Helpers::acceptsContentCoding("*, gzip;q=0", "gzip"));
+    REQUIRE_FALSE(ZapFR::Engine::Helpers::acceptsContentCoding("*;q=0", "gzip"));
+}
@@ -0,0 +1,236 @@
+/*
+    ZapFeedReader - RSS/Atom feed reader
+    Copyright (C) 2023-present  Kasper Nauwelaerts (zapfr at zappatic dot net)
+
+    ZapFeedReader is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    ZapFeedReader is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with ZapFeedReader.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#define FMT_HEADER_ONLY
+#include <fmt/core.h>
+
+#include <sstream>
+
+#include <Poco/DigestEngine.h>
+#include <Poco/HMACEngine.h>
+#include <Poco/Net/HTMLForm.h>
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/SHA1Engine.h>
+#include <Poco/SHA2Engine.h>
+#include <Poco/StreamCopier.h>
+#include <Poco/URI.h>
+
+#include "Listener.h"
+#include "TestHTTPServer.h"
+#include "ZapFR/WebSub.h"
+#include "ZapFR/feed_handling/FeedFetcher.h"
+#include "ZapFR/feed_handling/FeedParser.h"
+
+namespace
+{
+    static constexpr uint64_t gsFeedID{9999};
+    static const std::string gsTopic{"https://example.com/feed.xml"};
+
+    // what the stand-in hub was asked to do
+    struct HubRequest
+    {
+        std::string mode{""};
+        std::string topic{""};
+        std::string callback{""};
+        std::string secret{""};
+    };
+
+    std::optional<HubRequest> lastHubRequest(const ZapFR::Tests::TestHTTPServer& hub, const std::string& mode)
+    {
+        auto requests = hub.requests("/hub");
+        for (auto it = requests.rbegin(); it != requests.rend(); ++it)
+        {
+            Poco::Net::HTMLForm form;
+            std::istringstream body(it->body);
+            form.read(body);
+            if (form.get("hub.mode", "") == mode)
+            {
+                return HubRequest{mode, form.get("hub.topic", ""), form.get("hub.callback", ""), form.get("hub.secret", "")};
+            }
+        }
+        return {};
+    }
+
+    // talks to the callback endpoint of the unit test server the way a hub would
+    std::tuple<Poco::Net::HTTPResponse::HTTPStatus, std::string> callCallback(const std::string& method, const std::string& callbackURL,
+                                                                              const std::string& body = "", const std::string& signature = "")
+    {
+        auto uri = Poco::URI(callbackURL);
+        Poco::Net::HTTPClientSession session("127.0.0.1", ZapFR::Tests::TestRunListener::serverPort());
+        Poco::Net::HTTPRequest request(method, uri.getPathAndQuery(), Poco::Net::HTTPMessage::HTTP_1_1);
+        if (!signature.empty())
+        {
+            request.set("X-Hub-Signature", signature);
+        }
+        if (method == Poco::Net::HTTPRequest::HTTP_POST)
+        {
+            request.setContentType("application/atom+xml");
+            request.setContentLength(static_cast<std::streamsize>(body.size()));
+            session.sendRequest(request) << body;
+        }
+        else
+        {
+            session.sendRequest(request);
+        }
+
+        Poco::Net::HTTPResponse response;
+        auto& rs = session.receiveResponse(response);
+        std::string responseBody;
+        Poco::StreamCopier::copyToString(rs, responseBody);
+        return {response.getStatus(), responseBody};
+    }
+
+    template <typename Engine = Poco::SHA1Engine> std::string sign(const std::string& secret, const std::string& body, const std::string& method = "sha1")
+    {
+        Poco::HMACEngine<Engine> hmac(secret);
+        hmac.update(body);
+        return method + "=" + Poco::DigestEngine::digestToHex(hmac.digest());
+    }
+
+    static const std::string gsPushedAtom{R"(<?xml version="1.0" encoding="utf-8"?>
+<feed xmlns="http://www.w3.org/2005/Atom">
+  <title>Pushed</title>
+  <id>urn:uuid:60a76c80-d399-11d9-b93C-0003939e0af6</id>
+  <updated>2023-01-01T00:00:00Z</updated>
+</feed>)"};
+} // namespace
+
+TEST_CASE("WebSub hub detection in Atom 1.0", "[websub]")
+{
+    const std::string atom{R"(<?xml version="1.0" encoding="utf-8"?>
+<feed xmlns="http://www.w3.org/2005/Atom">
+  <title>Example</title>
+  <link rel="hub" href="https://hub.example.com/"/>
+  <link rel="self" href="https://example.com/atom.xml"/>
+  <link rel="alternate" href="https://example.com/"/>
+  <id>urn:uuid:60a76c80-d399-11d9-b93C-0003939e0af6</id>
+  <updated>2023-01-01T00:00:00Z</updated>
+</feed>)"};
+
+    ZapFR::Engine::FeedFetcher ff;
+    auto parser = ff.parseString(atom, "https://example.com/feed");
+    auto links = parser->webSubLinks();
+    REQUIRE(links.hub == "https://hub.example.com/");
+    REQUIRE(links.self == "https://example.com/atom.xml");
+}
+
+TEST_CASE("WebSub hub detection in RSS 2.0", "[websub]")
+{
+    const std::string rss{R"(<?xml version="1.0" encoding="utf-8"?>
+<rss version="2.0" xmlns:atom="http://www.w3.org/2005/Atom">
+  <channel>
+    <title>Example</title>
+    <link>https://example.com/</link>
+    <description>Example</description>
+    <atom:link rel="hub" href="https://hub.example.com/"/>
+    <atom:link rel="self" type="application/rss+xml" href="https://example.com/rss.xml"/>
+  </channel>
+</rss>)"};
+
+    ZapFR::Engine::FeedFetcher ff;
+    auto parser = ff.parseString(rss, "https://example.com/feed");
+    auto links = parser->webSubLinks();
+    REQUIRE(links.hub == "https://hub.example.com/");
+    REQUIRE(links.self == "https://example.com/rss.xml");
+
+    const std::string rssWithoutHub{R"(<?xml version="1.0" encoding="utf-8"?>
+<rss version="2.0">
+  <channel>
+    <title>Example</title>
+    <link>https://example.com/</link>
+    <description>Example</description>
+  </channel>
+</rss>)"};
+    parser = ff.parseString(rssWithoutHub, "https://example.com/feed");
+    REQUIRE(parser->webSubLinks().hub.empty());
+}
+
+TEST_CASE("WebSub subscription against a stand-in hub", "[websub]")
+{
+    // stands in for a WebSub hub: it accepts every (un)subscribe request, so the test can play the hub's side afterwards
+    ZapFR::Tests::TestHTTPServer hub;
+    hub.route("/hub",
+              [](const ZapFR::Tests::TestHTTPServer::Request&)
+              {
+                  ZapFR::Tests::TestHTTPServer::Response response;
+                  response.status = Poco::Net::HTTPResponse::HTTP_ACCEPTED;
+                  return response;
+              });
+
+    auto webSub = ZapFR::Engine::WebSub::getInstance();
+    webSub->setCallbackURL(fmt::format("http://127.0.0.1:{}/", ZapFR::Tests::TestRunListener::serverPort()));
+
+    // subscribing
+    webSub->updateFeed(gsFeedID, hub.url("/hub"), gsTopic);
+    webSub->processDueSubscriptions();
+    auto subscribe = lastHubRequest(hub, "subscribe");
+    REQUIRE(subscribe.has_value());
+    REQUIRE(subscribe->topic == gsTopic);
+    REQUIRE(!subscribe->secret.empty());
+    REQUIRE(!webSub->hasActiveSubscription(gsFeedID));
+
+    // the hub verifying our intent
+    auto [wrongTopicStatus, wrongTopicBody] = callCallback("GET", subscribe->callback + "?hub.mode=subscribe&hub.topic=https%3A%2F%2Fother.com%2F&hub.challenge=abc");
+    REQUIRE(wrongTopicStatus == Poco::Net::HTTPResponse::HTTP_NOT_FOUND);
+    auto [verifyStatus, verifyBody] =
+        callCallback("GET", subscribe->callback + "?hub.mode=subscribe&hub.topic=https%3A%2F%2Fexample.com%2Ffeed.xml&hub.challenge=abc&hub.lease_seconds=3600");
+    REQUIRE(verifyStatus == Poco::Net::HTTPResponse::HTTP_OK);
+    REQUIRE(verifyBody == "abc");
+    REQUIRE(webSub->hasActiveSubscription(gsFeedID));
+    REQUIRE(webSub->activelySubscribedFeeds().contains(gsFeedID));
+
+    // the hub pushing content
+    auto pushedBefore = webSub->pushedUpdateCount();
+    auto [badSignatureStatus, badSignatureBody] = callCallback("POST", subscribe->callback, gsPushedAtom, sign("not the secret", gsPushedAtom));
+    REQUIRE(badSignatureStatus == Poco::Net::HTTPResponse::HTTP_OK);
+    REQUIRE(webSub->pushedUpdateCount() == pushedBefore);
+    auto [signedStatus, signedBody] = callCallback("POST", subscribe->callback, gsPushedAtom, sign(subscribe->secret, gsPushedAtom));
+    REQUIRE(signedStatus == Poco::Net::HTTPResponse::HTTP_OK);
+    REQUIRE(webSub->pushedUpdateCount() == pushedBefore + 1);
+
+    // hubs may sign with any of the SHA-1 and SHA-2 variants, but nothing else
+    callCallback("POST", subscribe->callback, gsPushedAtom, sign<Poco::SHA2Engine256>(subscribe->secret, gsPushedAtom, "sha256"));
+    REQUIRE(webSub->pushedUpdateCount() == pushedBefore + 2);
+    callCallback("POST", subscribe->callback, gsPushedAtom, sign<Poco::SHA2Engine384>(subscribe->secret, gsPushedAtom, "sha384"));
+    REQUIRE(webSub->pushedUpdateCount() == pushedBefore + 3);
+    callCallback("POST", subscribe->callback, gsPushedAtom, sign<Poco::SHA2Engine512>(subscribe->secret, gsPushedAtom, "SHA512"));
+    REQUIRE(webSub->pushedUpdateCount() == pushedBefore + 4);
+    callCallback("POST", subscribe->callback, gsPushedAtom, sign<Poco::SHA2Engine256>("not the secret", gsPushedAtom, "sha256"));
+    callCallback("POST", subscribe->callback, gsPushedAtom, sign<Poco::SHA2Engine256>(subscribe->secret, gsPushedAtom, "sha1"));
+    callCallback("POST", subscribe->callback, gsPushedAtom, sign<Poco::SHA2Engine256>(subscribe->secret, gsPushedAtom, "md5"));
+    REQUIRE(webSub->pushedUpdateCount() == pushedBefore + 4);
+    auto [unknownStatus, unknownBody] = callCallback("POST", fmt::format("http://127.0.0.1:{}/websub/00000000-0000-0000-0000-000000000000",
+                                                                         ZapFR::Tests::TestRunListener::serverPort()),
+                                                     gsPushedAtom, sign(subscribe->secret, gsPushedAtom));
+    REQUIRE(unknownStatus == Poco::Net::HTTPResponse::HTTP_GONE);
+
+    // unsubscribing when the feed goes away
+    webSub->removeFeed(gsFeedID);
+    REQUIRE(!webSub->hasActiveSubscription(gsFeedID));
+    webSub->processDueSubscriptions();
+    auto unsubscribe = lastHubRequest(hub, "unsubscribe");
+    REQUIRE(unsubscribe.has_value());
+    REQUIRE(unsubscribe->callback == subscribe->callback);
+    auto [unsubscribeStatus, unsubscribeBody] =
+        callCallback("GET", subscribe->callback + "?hub.mode=unsubscribe&hub.topic=https%3A%2F%2Fexample.com%2Ffeed.xml&hub.challenge=def");
+    REQUIRE(unsubscribeStatus == Poco::Net::HTTPResponse::HTTP_OK);
+    REQUIRE(unsubscribeBody == "def");
+
+    webSub->setCallbackURL("");
+}